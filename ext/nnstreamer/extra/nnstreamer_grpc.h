@@ -42,6 +42,20 @@ typedef enum {
   GRPC_DIRECTION_BUFFER_TO_TENSORS  /* from protobuf/flatbuf to tensors */
 } grpc_direction;
 
+/**
+ * @brief enum for dispatching buffers to the parallel streams
+ */
+typedef enum {
+  GRPC_DISPATCH_NONE = 0,
+  GRPC_DISPATCH_ROUND_ROBIN, /* each stream has its own queue */
+  GRPC_DISPATCH_LEAST_OUTSTANDING /* idle streams take the next buffer */
+} grpc_dispatch;
+
+/**
+ * @brief the max number of parallel streams
+ */
+#define GRPC_MAX_STREAMS (16U)
+
 /**
  * @brief structure for grpc configuration
  */
@@ -55,6 +69,9 @@ typedef struct {
   gboolean is_server;
   gboolean is_blocking;
 
+  guint num_streams;
+  grpc_dispatch dispatch;
+
   grpc_cb cb;
   void *cb_data;
 
@@ -76,6 +93,8 @@ enum
   PROP_IDL,
   PROP_HOST,
   PROP_PORT,
+  PROP_STREAMS,
+  PROP_DISPATCH,
   PROP_OUT,
 };
 
@@ -87,6 +106,7 @@ extern "C" {
 #endif
 
 grpc_idl grpc_get_idl (const gchar *idl_str);
+grpc_dispatch grpc_get_dispatch (const gchar *dispatch_str);
 
 void * grpc_new (const grpc_config * config);
 void grpc_destroy (void * instance);
@@ -26,6 +26,12 @@ static constexpr const char *NNS_GRPC_PROTOBUF_NAME = "libnnstreamer_grpc_protob
 static constexpr const char *NNS_GRPC_FLATBUF_NAME = "libnnstreamer_grpc_flatbuf";
 static constexpr const char *NNS_GRPC_CREATE_INSTANCE = "create_instance";
 
+/* the max number of buffers waiting for a missing one in the reordering */
+static constexpr guint NNS_GRPC_REORDER_LIMIT = 64;
+
+/* the first sequence number over a connection, 0 means not numbered */
+static constexpr guint64 NNS_GRPC_SEQ_FIRST = 1;
+
 using namespace grpc;
 
 /** @brief create new instance of NNStreamerRPC */
@@ -82,16 +88,42 @@ NNStreamerRPC::NNStreamerRPC (const grpc_config * config):
   host_ (config->host), port_ (config->port),
   is_server_ (config->is_server), is_blocking_ (config->is_blocking),
   direction_ (config->dir), cb_ (config->cb), cb_data_ (config->cb_data),
-  config_ (config->config), server_instance_ (nullptr), handle_ (nullptr),
-  stop_ (false)
+  num_streams_ (CLAMP (config->num_streams, 1U, GRPC_MAX_STREAMS)),
+  dispatch_ (config->dispatch), config_ (config->config),
+  seq_ (NNS_GRPC_SEQ_FIRST),
+  server_instance_ (nullptr), handle_ (nullptr), stop_ (false)
 {
-  queue_ = gst_data_queue_new (_data_queue_check_full_cb,
-      NULL, NULL, NULL);
+  guint num_queues = 1;
+
+  if (!is_blocking_ && num_streams_ > 1) {
+    ml_logw ("Multiple streams are supported in blocking mode only\n");
+    num_streams_ = 1;
+  }
+
+  /**
+   * A client sending buffers has a queue for each stream in round-robin dispatch.
+   * Otherwise, the streams share a queue and the idle one takes the next buffer.
+   */
+  if (!is_server_ && direction_ == GRPC_DIRECTION_TENSORS_TO_BUFFER &&
+      dispatch_ == GRPC_DISPATCH_ROUND_ROBIN)
+    num_queues = num_streams_;
+
+  for (guint i = 0; i < num_queues; i++)
+    queues_.push_back (gst_data_queue_new (_data_queue_check_full_cb,
+        NULL, NULL, NULL));
 }
 
 /** @brief destructor of NNStreamerRPC */
 NNStreamerRPC::~NNStreamerRPC () {
-  g_clear_pointer (&queue_, gst_object_unref);
+  for (GstDataQueue *queue : queues_)
+    gst_object_unref (queue);
+  queues_.clear ();
+
+  for (auto &it : reorder_) {
+    for (auto &pending : it.second.pending)
+      gst_buffer_unref (pending.second);
+  }
+  reorder_.clear ();
 }
 
 /** @brief start gRPC server */
@@ -115,14 +147,15 @@ NNStreamerRPC::stop () {
   /* notify to the worker */
   stop_ = true;
 
-  if (queue_) {
-    /* wait until the queue's flushed */
-    while (!gst_data_queue_is_empty (queue_))
+  /* wait until the queues are flushed */
+  for (GstDataQueue *queue : queues_) {
+    while (!gst_data_queue_is_empty (queue))
       g_usleep (G_USEC_PER_SEC / 100);
-
-    gst_data_queue_set_flushing (queue_, TRUE);
   }
 
+  for (GstDataQueue *queue : queues_)
+    gst_data_queue_set_flushing (queue, TRUE);
+
   if (is_server_) {
     if (server_instance_.get ())
       server_instance_->Shutdown ();
@@ -131,31 +164,122 @@ NNStreamerRPC::stop () {
       completion_queue_->Shutdown ();
   }
 
-  if (worker_.joinable ())
-    worker_.join ();
+  for (std::thread &worker : workers_) {
+    if (worker.joinable ())
+      worker.join ();
+  }
 }
 
 /** @brief send buffer holding tensors */
 gboolean
 NNStreamerRPC::send (GstBuffer *buffer) {
-  GstDataQueueItem *item;
+  grpc_queue_item *item;
+  GstDataQueue *queue;
 
   buffer = gst_buffer_ref (buffer);
 
-  item = g_new0 (GstDataQueueItem, 1);
-  item->object = GST_MINI_OBJECT (buffer);
-  item->size = gst_buffer_get_size (buffer);
-  item->visible = TRUE;
-  item->destroy = (GDestroyNotify) _data_queue_item_free;
+  item = g_new0 (grpc_queue_item, 1);
+  item->item.object = GST_MINI_OBJECT (buffer);
+  item->item.size = gst_buffer_get_size (buffer);
+  item->item.visible = TRUE;
+  item->item.destroy = (GDestroyNotify) _data_queue_item_free;
+  item->seq = seq_++;
 
-  if (!gst_data_queue_push (queue_, item)) {
-    item->destroy (item);
+  queue = queues_[item->seq % queues_.size ()];
+
+  if (!gst_data_queue_push (queue, (GstDataQueueItem *) item)) {
+    item->item.destroy (item);
     return FALSE;
   }
 
   return TRUE;
 }
 
+/** @brief pop the buffer to be sent over the given stream to the peer */
+gboolean
+NNStreamerRPC::pop (guint stream, const std::string & peer,
+    GstBuffer ** buffer, guint64 * seq) {
+  GstDataQueueItem *item;
+
+  if (!is_server_) {
+    if (!gst_data_queue_pop (queues_[stream % queues_.size ()], &item))
+      return FALSE;
+
+    *seq = ((grpc_queue_item *) item)->seq;
+  } else {
+    /**
+     * The clients share the queue of the server and each one receives a part
+     * of the buffers. Number them per connection when popping so that the
+     * receiver gets the sequence without a gap, from the first one.
+     */
+    std::lock_guard<std::mutex> lock (pop_lock_);
+
+    if (!gst_data_queue_pop (queues_[0], &item))
+      return FALSE;
+
+    std::lock_guard<std::mutex> seq_lock (reorder_lock_);
+    *seq = _get_reorder (peer).next_seq++;
+  }
+
+  *buffer = GST_BUFFER (gst_mini_object_ref (item->object));
+
+  GDestroyNotify destroy = (item->destroy) ? item->destroy : g_free;
+  destroy (item);
+
+  return TRUE;
+}
+
+/** @brief deliver the received buffer via callback in the order of sequence */
+void
+NNStreamerRPC::deliver (const std::string & peer, GstBuffer * buffer,
+    guint64 seq) {
+  std::lock_guard<std::mutex> lock (reorder_lock_);
+
+  /* the peer does not number the buffers, or a single stream keeps the order */
+  if (seq == 0 || (!is_server_ && num_streams_ == 1)) {
+    _deliver_buffer (buffer);
+    return;
+  }
+
+  grpc_reorder &state = _get_reorder (peer);
+
+  if (seq < state.next_seq || state.pending.count (seq) > 0) {
+    /* late or duplicated one, cannot restore the order */
+    _deliver_buffer (buffer);
+    return;
+  }
+
+  state.pending[seq] = buffer;
+  _flush_pending (state, FALSE);
+}
+
+/** @brief notify that a stream from (or to) the peer is started */
+void
+NNStreamerRPC::begin_stream (const std::string & peer) {
+  std::lock_guard<std::mutex> lock (reorder_lock_);
+
+  _get_reorder (peer).num_streams++;
+}
+
+/** @brief notify that a stream from (or to) the peer is finished */
+void
+NNStreamerRPC::end_stream (const std::string & peer) {
+  std::lock_guard<std::mutex> lock (reorder_lock_);
+  auto it = reorder_.find (peer);
+
+  if (it == reorder_.end ())
+    return;
+
+  if (it->second.num_streams > 0)
+    it->second.num_streams--;
+
+  /* no more buffer from the peer, deliver the remaining ones */
+  if (it->second.num_streams == 0) {
+    _flush_pending (it->second, TRUE);
+    reorder_.erase (it);
+  }
+}
+
 /** @brief start server service */
 gboolean
 NNStreamerRPC::_start_server () {
@@ -178,6 +302,49 @@ NNStreamerRPC::_start_client () {
   return start_client (address);
 }
 
+/** @brief get the sequence state of the peer, reorder_lock_ should be held */
+grpc_reorder &
+NNStreamerRPC::_get_reorder (const std::string & peer) {
+  auto it = reorder_.find (peer);
+
+  if (it == reorder_.end ()) {
+    grpc_reorder state;
+
+    /* the sender numbers the buffers over a connection from the first one */
+    state.next_seq = NNS_GRPC_SEQ_FIRST;
+    state.num_streams = 0;
+    it = reorder_.emplace (peer, state).first;
+  }
+
+  return it->second;
+}
+
+/** @brief deliver the pending buffers in order, reorder_lock_ should be held */
+void
+NNStreamerRPC::_flush_pending (grpc_reorder & state, gboolean force) {
+  while (!state.pending.empty ()) {
+    auto it = state.pending.begin ();
+
+    /* give up the missing one if too many buffers are waiting for it */
+    if (it->first != state.next_seq && !force &&
+        state.pending.size () <= NNS_GRPC_REORDER_LIMIT)
+      break;
+
+    state.next_seq = it->first + 1;
+    _deliver_buffer (it->second);
+    state.pending.erase (it);
+  }
+}
+
+/** @brief invoke the registered callback with the buffer */
+void
+NNStreamerRPC::_deliver_buffer (GstBuffer * buffer) {
+  if (cb_)
+    cb_ (cb_data_, buffer);
+  else
+    gst_buffer_unref (buffer);
+}
+
 /** @brief private method to check full  */
 gboolean
 NNStreamerRPC::_data_queue_check_full_cb (GstDataQueue * queue,
@@ -209,6 +376,20 @@ grpc_get_idl (const gchar *idl_str)
     return GRPC_IDL_NONE;
 }
 
+/**
+ * @brief get gRPC dispatch enum from a given string
+ */
+grpc_dispatch
+grpc_get_dispatch (const gchar *dispatch_str)
+{
+  if (g_ascii_strcasecmp (dispatch_str, "round-robin") == 0)
+    return GRPC_DISPATCH_ROUND_ROBIN;
+  else if (g_ascii_strcasecmp (dispatch_str, "least-outstanding") == 0)
+    return GRPC_DISPATCH_LEAST_OUTSTANDING;
+  else
+    return GRPC_DISPATCH_NONE;
+}
+
 /**
  * @brief gRPC C++ wrapper to create the class instance
  */
@@ -367,6 +548,25 @@ grpc_common_set_property (GObject * self, gboolean * silent,
       grpc->config.port = g_value_get_int (value);
       silent_debug ("Set port = %d", grpc->config.port);
       break;
+    case PROP_STREAMS:
+      grpc->config.num_streams = g_value_get_uint (value);
+      silent_debug ("Set num-streams = %u", grpc->config.num_streams);
+      break;
+    case PROP_DISPATCH:
+    {
+      const gchar * dispatch_str = g_value_get_string (value);
+
+      if (dispatch_str) {
+        grpc_dispatch dispatch = grpc_get_dispatch (dispatch_str);
+        if (dispatch != GRPC_DISPATCH_NONE) {
+          grpc->config.dispatch = dispatch;
+          silent_debug ("Set dispatch = %s", dispatch_str);
+        } else {
+          ml_loge ("Invalid dispatch string provided: %s", dispatch_str);
+        }
+      }
+      break;
+    }
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (self, prop_id, pspec);
       break;
@@ -408,6 +608,21 @@ grpc_common_get_property (GObject * self, gboolean silent, guint out,
     case PROP_PORT:
       g_value_set_int (value, grpc->config.port);
       break;
+    case PROP_STREAMS:
+      g_value_set_uint (value, grpc->config.num_streams);
+      break;
+    case PROP_DISPATCH:
+      switch (grpc->config.dispatch) {
+        case GRPC_DISPATCH_ROUND_ROBIN:
+          g_value_set_string (value, "round-robin");
+          break;
+        case GRPC_DISPATCH_LEAST_OUTSTANDING:
+          g_value_set_string (value, "least-outstanding");
+          break;
+        default:
+          break;
+      }
+      break;
     case PROP_OUT:
       g_value_set_uint (value, out);
       break;
@@ -21,11 +21,31 @@
 #include <grpcpp/grpcpp.h>
 
 #include <cstring>
+#include <map>
+#include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace grpc {
 
+/**
+ * @brief data queue item holding the sequence number of the buffer
+ */
+typedef struct {
+  GstDataQueueItem item;
+  guint64 seq;
+} grpc_queue_item;
+
+/**
+ * @brief sequence state of the streams from (or to) a peer
+ */
+typedef struct {
+  guint64 next_seq;
+  guint num_streams;
+  std::map<guint64, GstBuffer *> pending;
+} grpc_reorder;
+
 /**
  * @brief NNStreamer RPC service
  */
@@ -64,6 +84,12 @@ class NNStreamerRPC {
       return direction_;
     }
 
+    gboolean pop (guint stream, const std::string & peer, GstBuffer ** buffer,
+        guint64 * seq);
+    void deliver (const std::string & peer, GstBuffer * buffer, guint64 seq);
+    void begin_stream (const std::string & peer);
+    void end_stream (const std::string & peer);
+
   protected:
     const gchar *host_;
     gint port_;
@@ -76,13 +102,17 @@ class NNStreamerRPC {
     grpc_cb cb_;
     void * cb_data_;
 
+    guint num_streams_;
+    grpc_dispatch dispatch_;
+
     GstTensorsConfig *config_;
-    GstDataQueue *queue_;
+    std::vector<GstDataQueue *> queues_;
+    guint64 seq_;
 
     std::unique_ptr<Server> server_instance_;
     std::unique_ptr<ServerCompletionQueue> completion_queue_;
 
-    std::thread worker_;
+    std::vector<std::thread> workers_;
 
     void * handle_;
     gboolean stop_;
@@ -96,6 +126,14 @@ class NNStreamerRPC {
     gboolean _start_server ();
     gboolean _start_client ();
 
+    grpc_reorder & _get_reorder (const std::string & peer);
+    void _flush_pending (grpc_reorder & state, gboolean force);
+    void _deliver_buffer (GstBuffer * buffer);
+
+    std::mutex reorder_lock_;
+    std::map<std::string, grpc_reorder> reorder_;
+    std::mutex pop_lock_;
+
     static gboolean _data_queue_check_full_cb (GstDataQueue * queue,
         guint visible, guint bytes, guint64 time, gpointer checkdata);
     static void _data_queue_item_free (GstDataQueueItem * item);
@@ -20,6 +20,8 @@
 
 #include <thread>
 
+#include <grpc/slice.h>
+
 #include <grpcpp/grpcpp.h>
 #include <grpcpp/channel.h>
 #include <grpcpp/client_context.h>
@@ -36,6 +38,23 @@ using flatbuffers::grpc::MessageBuilder;
 
 using namespace grpc;
 
+/**
+ * @brief The overhead of a tensor in the message, to reserve the builder.
+ */
+#define FB_TENSOR_OVERHEAD (128)
+
+/**
+ * @brief Release the slice of the received message.
+ */
+static void
+_fb_slice_unref (gpointer data)
+{
+  grpc_slice *slice = (grpc_slice *) data;
+
+  grpc_slice_unref (*slice);
+  g_free (slice);
+}
+
 /** @brief Constructor of ServiceImplFlatbuf */
 ServiceImplFlatbuf::ServiceImplFlatbuf (const grpc_config * config)
   : NNStreamerRPC (config), client_stub_ (nullptr)
@@ -44,65 +63,74 @@ ServiceImplFlatbuf::ServiceImplFlatbuf (const grpc_config * config)
 
 /** @brief parse tensors and deliver the buffer via callback */
 void
-ServiceImplFlatbuf::parse_tensors (Message<Tensors> &tensors)
+ServiceImplFlatbuf::parse_tensors (Message<Tensors> &tensors,
+    const std::string &peer)
 {
   GstBuffer *buffer;
 
   _get_buffer_from_tensors (tensors, &buffer);
 
-  if (cb_)
-    cb_ (cb_data_, buffer);
-  else
-    gst_buffer_unref (buffer);
+  deliver (peer, buffer, tensors.GetRoot ()->seq ());
 }
 
 /** @brief fill tensors from the buffer */
 gboolean
-ServiceImplFlatbuf::fill_tensors (Message<Tensors> &tensors)
+ServiceImplFlatbuf::fill_tensors (Message<Tensors> &tensors, guint stream,
+    const std::string &peer)
 {
-  GstDataQueueItem *item;
+  GstBuffer *buffer;
+  guint64 seq;
 
-  if (!gst_data_queue_pop (queue_, &item))
+  if (!pop (stream, peer, &buffer, &seq))
     return FALSE;
 
-  _get_tensors_from_buffer (GST_BUFFER (item->object), tensors);
-
-  GDestroyNotify destroy = (item->destroy) ? item->destroy : g_free;
-  destroy (item);
+  _get_tensors_from_buffer (buffer, seq, tensors);
+  gst_buffer_unref (buffer);
 
   return TRUE;
 }
 
 /** @brief read tensors and invoke the registered callback */
 template <typename T>
-Status ServiceImplFlatbuf::_read_tensors (T reader)
+Status ServiceImplFlatbuf::_read_tensors (T reader, const std::string &peer)
 {
+  begin_stream (peer);
+
   while (1) {
     Message<Tensors> tensors;
 
     if (!reader->Read (&tensors))
       break;
 
-    parse_tensors (tensors);
+    parse_tensors (tensors, peer);
   }
 
+  end_stream (peer);
+
   return Status::OK;
 }
 
 /** @brief obtain tensors from data queue and send them over gRPC */
 template <typename T>
-Status ServiceImplFlatbuf::_write_tensors (T writer)
+Status ServiceImplFlatbuf::_write_tensors (T writer, guint stream,
+    const std::string &peer)
 {
+  begin_stream (peer);
+
   while (1) {
     Message<Tensors> tensors;
 
     /* until flushing */
-    if (!fill_tensors (tensors))
+    if (!fill_tensors (tensors, stream, peer))
       break;
 
-    writer->Write (tensors);
+    /* the peer is gone, leave the rest to the other streams */
+    if (!writer->Write (tensors))
+      break;
   }
 
+  end_stream (peer);
+
   return Status::OK;
 }
 
@@ -119,12 +147,15 @@ ServiceImplFlatbuf::_get_buffer_from_tensors (Message<Tensors> &msg,
 
   for (guint i = 0; i < num_tensor; i++) {
     const Tensor * tensor = tensors->tensor ()->Get (i);
-    const void * data = tensor->data ()->data ();
+    gpointer data = (gpointer) tensor->data ()->data ();
     gsize size = VectorLength (tensor->data ());
-    gpointer new_data = _g_memdup (data, size);
+    grpc_slice *slice = g_new (grpc_slice, 1);
+
+    /* refer to the received message without copying the tensor data */
+    *slice = grpc_slice_ref (msg.BorrowSlice ());
 
-    memory = gst_memory_new_wrapped ((GstMemoryFlags) 0, new_data, size,
-        0, size, new_data, g_free);
+    memory = gst_memory_new_wrapped ((GstMemoryFlags) 0, data, size,
+        0, size, slice, _fb_slice_unref);
     gst_buffer_append_memory (*buffer, memory);
   }
 }
@@ -132,9 +163,13 @@ ServiceImplFlatbuf::_get_buffer_from_tensors (Message<Tensors> &msg,
 /** @brief convert buffer to tensors */
 void
 ServiceImplFlatbuf::_get_tensors_from_buffer (GstBuffer *buffer,
-    Message<Tensors> &msg)
+    guint64 seq, Message<Tensors> &msg)
 {
-  MessageBuilder builder;
+  unsigned int num_tensors = config_->info.num_tensors;
+  gsize buf_size = gst_buffer_get_size (buffer);
+
+  /* reserve the builder, so that it does not grow (and copy) the message */
+  MessageBuilder builder (buf_size + FB_TENSOR_OVERHEAD * (num_tensors + 1));
 
   flatbuffers::Offset<flatbuffers::Vector<uint32_t>> tensor_dim;
   flatbuffers::Offset<flatbuffers::String> tensor_name;
@@ -144,22 +179,16 @@ ServiceImplFlatbuf::_get_tensors_from_buffer (GstBuffer *buffer,
   std::vector<flatbuffers::Offset<Tensor>> tensor_vector;
   Tensor_type tensor_type;
   Tensor_format format = (Tensor_format) config_->format;
-  unsigned int num_tensors = config_->info.num_tensors;
   frame_rate fr = frame_rate (config_->rate_n, config_->rate_d);
 
-  GstMapInfo map;
   gsize data_ptr = 0;
 
-  if (!gst_buffer_map (buffer, &map, GST_MAP_READ)) {
-    ml_loge ("Unable to map the buffer\n");
-    return;
-  }
-
   for (guint i = 0; i < num_tensors; i++) {
     const GstTensorInfo * info = &config_->info.info[i];
     gsize tsize = gst_tensor_info_get_size (info);
+    unsigned char *data;
 
-    if (data_ptr + tsize > map.size) {
+    if (data_ptr + tsize > buf_size) {
       ml_logw ("Setting invalid tensor data");
       break;
     }
@@ -167,7 +196,10 @@ ServiceImplFlatbuf::_get_tensors_from_buffer (GstBuffer *buffer,
     tensor_dim = builder.CreateVector (info->dimension, NNS_TENSOR_RANK_LIMIT);
     tensor_name = builder.CreateString ("Anonymous");
     tensor_type = (Tensor_type) info->type;
-    tensor_data = builder.CreateVector<unsigned char> (map.data + data_ptr, tsize);
+
+    /* copy the tensor data from the memories into the message directly */
+    tensor_data = builder.CreateUninitializedVector<unsigned char> (tsize, &data);
+    gst_buffer_extract (buffer, data_ptr, data, tsize);
 
     data_ptr += tsize;
 
@@ -175,12 +207,11 @@ ServiceImplFlatbuf::_get_tensors_from_buffer (GstBuffer *buffer,
     tensor_vector.push_back (tensor);
   }
 
-  tensors = CreateTensors (builder, num_tensors, &fr, builder.CreateVector (tensor_vector), format);
+  tensors = CreateTensors (builder, num_tensors, &fr,
+      builder.CreateVector (tensor_vector), format, seq);
 
   builder.Finish (tensors);
   msg = builder.ReleaseMessage<Tensors>();
-
-  gst_buffer_unmap (buffer, &map);
 }
 
 /** @brief Constructor of SyncServiceImplFlatbuf */
@@ -195,7 +226,7 @@ SyncServiceImplFlatbuf::SendTensors (ServerContext *context,
     ServerReader<Message<Tensors>> *reader,
     Message<Empty> *replay)
 {
-  return _read_tensors (reader);
+  return _read_tensors (reader, context->peer ());
 }
 
 /** @brief server-to-client streaming: a client receives tensors */
@@ -204,7 +235,7 @@ SyncServiceImplFlatbuf::RecvTensors (ServerContext *context,
     const Message<Empty> *request,
     ServerWriter<Message<Tensors>> *writer)
 {
-  return _write_tensors (writer);
+  return _write_tensors (writer, 0, context->peer ());
 }
 
 /** @brief start gRPC server handling flatbuf */
@@ -237,14 +268,16 @@ SyncServiceImplFlatbuf::start_client (std::string address)
   if (client_stub_.get () == nullptr)
     return FALSE;
 
-  worker_ = std::thread ([this] { this->_client_thread (); });
+  /* the streams share the channel */
+  for (guint i = 0; i < num_streams_; i++)
+    workers_.push_back (std::thread ([this, i] { this->_client_thread (i); }));
 
   return TRUE;
 }
 
 /** @brief gRPC client thread */
 void
-SyncServiceImplFlatbuf::_client_thread ()
+SyncServiceImplFlatbuf::_client_thread (guint stream)
 {
   ClientContext context;
 
@@ -255,7 +288,7 @@ SyncServiceImplFlatbuf::_client_thread ()
     std::unique_ptr< ClientWriter<Message<Tensors>> > writer(
         client_stub_->SendTensors (&context, &empty));
 
-    _write_tensors (writer.get ());
+    _write_tensors (writer.get (), stream);
 
     writer->WritesDone ();
     /**
@@ -275,7 +308,7 @@ SyncServiceImplFlatbuf::_client_thread ()
     std::unique_ptr< ClientReader<Message<Tensors>> > reader(
         client_stub_->RecvTensors (&context, builder.ReleaseMessage <Empty> ()));
 
-    _read_tensors (reader.get ());
+    _read_tensors (reader.get (), std::string ());
 
     reader->Finish ();
   } else {
@@ -314,7 +347,7 @@ AsyncServiceImplFlatbuf::start_server (std::string address)
   if (server_instance_.get () == nullptr)
     return FALSE;
 
-  worker_ = std::thread ([this] { this->_server_thread (); });
+  workers_.push_back (std::thread ([this] { this->_server_thread (); }));
 
   return TRUE;
 }
@@ -332,7 +365,7 @@ AsyncServiceImplFlatbuf::start_client (std::string address)
   if (client_stub_.get () == nullptr)
     return FALSE;
 
-  worker_ = std::thread ([this] { this->_client_thread (); });
+  workers_.push_back (std::thread ([this] { this->_client_thread (); }));
 
   return TRUE;
 }
@@ -353,7 +386,7 @@ class AsyncCallDataServer : public AsyncCallData {
       if (state_ == PROCESS && !ok) {
         if (count_ != 0) {
           if (reader_.get () != nullptr)
-            service_->parse_tensors (rpc_tensors_);
+            service_->parse_tensors (rpc_tensors_, ctx_.peer ());
           state_ = FINISH;
         } else {
           return;
@@ -373,21 +406,24 @@ class AsyncCallDataServer : public AsyncCallData {
         if (count_ == 0) {
           /* spawn a new instance to serve new clients */
           service_->set_last_call (new AsyncCallDataServer (service_, cq_));
+
+          service_->begin_stream (ctx_.peer ());
         }
 
         if (reader_.get () != nullptr) {
           if (count_ != 0)
-            service_->parse_tensors (rpc_tensors_);
+            service_->parse_tensors (rpc_tensors_, ctx_.peer ());
           reader_->Read (&rpc_tensors_, this);
           /* can't read tensors yet. use the next turn */
           count_++;
         } else if (writer_.get () != nullptr) {
           Message<Tensors> tensors;
-          if (service_->fill_tensors (tensors)) {
+          if (service_->fill_tensors (tensors, 0, ctx_.peer ())) {
             writer_->Write (tensors, this);
             count_++;
           } else {
             Status status;
+            service_->end_stream (ctx_.peer ());
             writer_->Finish (status, this);
             state_ = DESTROY;
           }
@@ -396,6 +432,8 @@ class AsyncCallDataServer : public AsyncCallData {
         if (reader_.get () != nullptr) {
           MessageBuilder builder;
 
+          service_->end_stream (ctx_.peer ());
+
           auto empty_offset = nnstreamer::flatbuf::CreateEmpty (builder);
           builder.Finish (empty_offset);
 
@@ -403,6 +441,7 @@ class AsyncCallDataServer : public AsyncCallData {
         }
         if (writer_.get () != nullptr) {
           Status status;
+          service_->end_stream (ctx_.peer ());
           writer_->Finish (status, this);
         }
         state_ = DESTROY;
@@ -436,7 +475,7 @@ class AsyncCallDataClient : public AsyncCallData {
       if (state_ == PROCESS && !ok) {
         if (count_ != 0) {
           if (reader_.get () != nullptr)
-            service_->parse_tensors (rpc_tensors_);
+            service_->parse_tensors (rpc_tensors_, std::string ());
           state_ = FINISH;
         } else {
           return;
@@ -459,7 +498,7 @@ class AsyncCallDataClient : public AsyncCallData {
       } else if (state_ == PROCESS) {
         if (reader_.get () != nullptr) {
           if (count_ != 0)
-            service_->parse_tensors (rpc_tensors_);
+            service_->parse_tensors (rpc_tensors_, std::string ());
           reader_->Read (&rpc_tensors_, this);
           /* can't read tensors yet. use the next turn */
           count_++;
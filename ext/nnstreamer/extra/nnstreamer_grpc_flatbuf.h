@@ -35,17 +35,19 @@ class ServiceImplFlatbuf : public NNStreamerRPC
   public:
     ServiceImplFlatbuf (const grpc_config * config);
 
-    void parse_tensors (Message<Tensors> &tensors);
-    gboolean fill_tensors (Message<Tensors> &tensors);
+    void parse_tensors (Message<Tensors> &tensors, const std::string &peer);
+    gboolean fill_tensors (Message<Tensors> &tensors, guint stream = 0,
+        const std::string &peer = std::string ());
 
   protected:
     template <typename T>
-    grpc::Status _write_tensors (T writer);
+    grpc::Status _write_tensors (T writer, guint stream = 0,
+        const std::string &peer = std::string ());
 
     template <typename T>
-    grpc::Status _read_tensors (T reader);
+    grpc::Status _read_tensors (T reader, const std::string &peer);
 
-    void _get_tensors_from_buffer (GstBuffer *buffer, Message<Tensors> &tensors);
+    void _get_tensors_from_buffer (GstBuffer *buffer, guint64 seq, Message<Tensors> &tensors);
     void _get_buffer_from_tensors (Message<Tensors> &tensors, GstBuffer **buffer);
 
     std::unique_ptr<nnstreamer::flatbuf::TensorService::Stub> client_stub_;
@@ -70,7 +72,7 @@ class SyncServiceImplFlatbuf final
     gboolean start_server (std::string address) override;
     gboolean start_client (std::string address) override;
 
-    void _client_thread ();
+    void _client_thread (guint stream);
 };
 
 class AsyncCallData;
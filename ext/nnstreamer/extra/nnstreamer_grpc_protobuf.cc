@@ -26,77 +26,209 @@
 #include <grpcpp/create_channel.h>
 #include <grpcpp/security/credentials.h>
 
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
+
 #include <gst/base/gstdataqueue.h>
 
+using google::protobuf::io::CodedOutputStream;
+using google::protobuf::internal::WireFormatLite;
+
 using namespace grpc;
 
+/**
+ * @brief The full name of the client-to-server streaming method.
+ */
+static constexpr const char *NNS_GRPC_PROTOBUF_SEND_TENSORS =
+    "/nnstreamer.protobuf.TensorService/SendTensors";
+
+/**
+ * @brief The name of tensors in the message.
+ */
+static constexpr const char *NNS_GRPC_PROTOBUF_TENSOR_NAME = "Anonymous";
+
+/**
+ * @brief The max size of the serialized fields preceding the tensor data.
+ */
+#define PB_HEADER_MAX_SIZE (256)
+
+/**
+ * @brief Get the size of the tag.
+ */
+#define PB_TAG_SIZE(field, wire) \
+  CodedOutputStream::VarintSize32 (WireFormatLite::MakeTag ((field), WireFormatLite::wire))
+
+/**
+ * @brief Get the size of the length-delimited field.
+ */
+#define PB_LEN_FIELD_SIZE(field, len)                       \
+  (PB_TAG_SIZE ((field), WIRETYPE_LENGTH_DELIMITED)         \
+      + CodedOutputStream::VarintSize32 ((guint32) (len)) + (len))
+
+/**
+ * @brief Data structure for the mapped memory which a slice refers to.
+ */
+typedef struct {
+  GstMemory *mem;
+  GstMapInfo map;
+} pb_slice_memory;
+
+/**
+ * @brief Write the tag and length of the length-delimited field.
+ */
+static guint8 *
+_pb_write_len_field (int field, size_t len, guint8 *target)
+{
+  target = CodedOutputStream::WriteTagToArray (
+      WireFormatLite::MakeTag (field, WireFormatLite::WIRETYPE_LENGTH_DELIMITED), target);
+  return CodedOutputStream::WriteVarint32ToArray ((guint32) len, target);
+}
+
+/**
+ * @brief Get the size of the packed dimension.
+ */
+static size_t
+_pb_get_dimension_size (const tensor_dim dim)
+{
+  size_t size = 0;
+
+  for (guint i = 0; i < NNS_TENSOR_RANK_LIMIT; i++)
+    size += CodedOutputStream::VarintSize32 (dim[i]);
+
+  return size;
+}
+
+/**
+ * @brief Unmap and release the memory when the slice is destroyed.
+ */
+static void
+_pb_slice_memory_free (void *data)
+{
+  pb_slice_memory *slice_mem = (pb_slice_memory *) data;
+
+  gst_memory_unmap (slice_mem->mem, &slice_mem->map);
+  gst_memory_unref (slice_mem->mem);
+  g_free (slice_mem);
+}
+
+/**
+ * @brief Get the slice referring to the data in the buffer.
+ * @note The data is copied only if it spans multiple memories.
+ */
+static Slice
+_pb_get_slice (GstBuffer *buffer, gsize offset, gsize size)
+{
+  pb_slice_memory *slice_mem;
+  guint idx, length;
+  gsize skip;
+  gpointer data;
+
+  if (gst_buffer_find_memory (buffer, offset, size, &idx, &length, &skip) &&
+      length == 1) {
+    slice_mem = g_new0 (pb_slice_memory, 1);
+    slice_mem->mem = gst_buffer_get_memory (buffer, idx);
+
+    if (gst_memory_map (slice_mem->mem, &slice_mem->map, GST_MAP_READ))
+      return Slice (slice_mem->map.data + skip, size,
+          _pb_slice_memory_free, slice_mem);
+
+    gst_memory_unref (slice_mem->mem);
+    g_free (slice_mem);
+  }
+
+  data = g_malloc (size);
+  gst_buffer_extract (buffer, offset, data, size);
+
+  return Slice (data, size, g_free);
+}
+
+/**
+ * @brief Release the string holding the received tensor data.
+ */
+static void
+_pb_free_string (gpointer data)
+{
+  delete static_cast<std::string *> (data);
+}
+
 /** @brief constructor */
 ServiceImplProtobuf::ServiceImplProtobuf (const grpc_config * config):
-  NNStreamerRPC (config), client_stub_ (nullptr)
+  NNStreamerRPC (config), client_stub_ (nullptr), channel_ (nullptr)
 {
 }
 
 /** @brief parse tensors and deliver the buffer via callback */
 void
-ServiceImplProtobuf::parse_tensors (Tensors &tensors)
+ServiceImplProtobuf::parse_tensors (Tensors &tensors, const std::string &peer)
 {
   GstBuffer *buffer;
 
+  /* the tensor data has been moved to the buffer already */
+  if (tensors.tensor_size () == 0)
+    return;
+
   _get_buffer_from_tensors (tensors, &buffer);
+  deliver (peer, buffer, tensors.seq ());
 
-  if (cb_)
-    cb_ (cb_data_, buffer);
-  else
-    gst_buffer_unref (buffer);
+  tensors.Clear ();
 }
 
 /** @brief fill tensors from the buffer */
 gboolean
-ServiceImplProtobuf::fill_tensors (Tensors &tensors)
+ServiceImplProtobuf::fill_tensors (Tensors &tensors, const std::string &peer)
 {
-  GstDataQueueItem *item;
+  GstBuffer *buffer;
+  guint64 seq;
 
-  if (!gst_data_queue_pop (queue_, &item))
+  if (!pop (0, peer, &buffer, &seq))
     return FALSE;
 
-  _get_tensors_from_buffer (GST_BUFFER (item->object), tensors);
-
-  GDestroyNotify destroy = (item->destroy) ? item->destroy : g_free;
-  destroy (item);
+  _get_tensors_from_buffer (buffer, seq, tensors);
+  gst_buffer_unref (buffer);
 
   return TRUE;
 }
 
 /** @brief read tensors and invoke the registered callback */
 template <typename T>
-Status ServiceImplProtobuf::_read_tensors (T reader)
+Status ServiceImplProtobuf::_read_tensors (T reader, const std::string &peer)
 {
+  begin_stream (peer);
+
   while (1) {
     Tensors tensors;
 
     if (!reader->Read (&tensors))
       break;
 
-    parse_tensors (tensors);
+    parse_tensors (tensors, peer);
   }
 
+  end_stream (peer);
+
   return Status::OK;
 }
 
 /** @brief obtain tensors from data queue and send them over gRPC */
 template <typename T>
-Status ServiceImplProtobuf::_write_tensors (T writer)
+Status ServiceImplProtobuf::_write_tensors (T writer, const std::string &peer)
 {
+  begin_stream (peer);
+
   while (1) {
     Tensors tensors;
 
     /* until flushing */
-    if (!fill_tensors (tensors))
+    if (!fill_tensors (tensors, peer))
       break;
 
-    writer->Write (tensors);
+    /* the peer is gone, leave the rest to the other streams */
+    if (!writer->Write (tensors))
+      break;
   }
 
+  end_stream (peer);
+
   return Status::OK;
 }
 
@@ -105,19 +237,19 @@ void
 ServiceImplProtobuf::_get_buffer_from_tensors (Tensors &tensors,
     GstBuffer **buffer)
 {
-  guint num_tensor = tensors.num_tensor ();
+  guint num_tensor = MIN (tensors.num_tensor (), (guint) tensors.tensor_size ());
   GstMemory *memory;
 
   *buffer = gst_buffer_new ();
 
   for (guint i = 0; i < num_tensor; i++) {
-    const Tensor * tensor = &tensors.tensor (i);
-    const void * data = tensor->data ().c_str ();
-    gsize size = tensor->data ().length ();
-    gpointer new_data = _g_memdup (data, size);
+    Tensor * tensor = tensors.mutable_tensor (i);
+    /* move the received data to the buffer without copying it */
+    std::string * data = new std::string (std::move (*tensor->mutable_data ()));
+    gsize size = data->size ();
 
-    memory = gst_memory_new_wrapped ((GstMemoryFlags) 0, new_data, size,
-        0, size, new_data, g_free);
+    memory = gst_memory_new_wrapped ((GstMemoryFlags) 0,
+        (gpointer) data->data (), size, 0, size, data, _pb_free_string);
     gst_buffer_append_memory (*buffer, memory);
   }
 }
@@ -125,13 +257,14 @@ ServiceImplProtobuf::_get_buffer_from_tensors (Tensors &tensors,
 /** @brief convert buffer to tensors */
 void
 ServiceImplProtobuf::_get_tensors_from_buffer (GstBuffer *buffer,
-    Tensors &tensors)
+    guint64 seq, Tensors &tensors)
 {
   Tensors::frame_rate *fr;
   GstMapInfo map;
   gsize data_ptr = 0;
 
   tensors.set_num_tensor (config_->info.num_tensors);
+  tensors.set_seq (seq);
 
   fr = tensors.mutable_fr ();
   fr->set_rate_n (config_->rate_n);
@@ -153,7 +286,7 @@ ServiceImplProtobuf::_get_tensors_from_buffer (GstBuffer *buffer,
     }
 
     /* set tensor info */
-    tensor->set_name ("Anonymous");
+    tensor->set_name (NNS_GRPC_PROTOBUF_TENSOR_NAME);
     tensor->set_type ((Tensor::Tensor_type) info->type);
 
     for (guint j = 0; j < NNS_TENSOR_RANK_LIMIT; j++)
@@ -166,6 +299,87 @@ ServiceImplProtobuf::_get_tensors_from_buffer (GstBuffer *buffer,
   gst_buffer_unmap (buffer, &map);
 }
 
+/**
+ * @brief convert buffer to the serialized message 'Tensors'.
+ * @note The slices of the message refer to the tensor data in the buffer.
+ */
+void
+ServiceImplProtobuf::_get_message_from_buffer (GstBuffer *buffer,
+    guint64 seq, ByteBuffer *message)
+{
+  std::vector<Slice> slices;
+  guint8 header[PB_HEADER_MAX_SIZE];
+  guint8 *target = header;
+  size_t name_len = strlen (NNS_GRPC_PROTOBUF_TENSOR_NAME);
+  size_t fr_size, tensor_size, dim_size;
+  gsize offset = 0, buf_size = gst_buffer_get_size (buffer);
+
+  /* fields of the message 'Tensors' except the tensors */
+  target = WireFormatLite::WriteUInt32ToArray (Tensors::kNumTensorFieldNumber,
+      config_->info.num_tensors, target);
+
+  fr_size = WireFormatLite::Int32Size (config_->rate_n)
+      + WireFormatLite::Int32Size (config_->rate_d)
+      + PB_TAG_SIZE (Tensors::frame_rate::kRateNFieldNumber, WIRETYPE_VARINT)
+      + PB_TAG_SIZE (Tensors::frame_rate::kRateDFieldNumber, WIRETYPE_VARINT);
+  target = _pb_write_len_field (Tensors::kFrFieldNumber, fr_size, target);
+  target = WireFormatLite::WriteInt32ToArray (
+      Tensors::frame_rate::kRateNFieldNumber, config_->rate_n, target);
+  target = WireFormatLite::WriteInt32ToArray (
+      Tensors::frame_rate::kRateDFieldNumber, config_->rate_d, target);
+
+  target = WireFormatLite::WriteEnumToArray (Tensors::kFormatFieldNumber,
+      (int) config_->format, target);
+  target = WireFormatLite::WriteUInt64ToArray (Tensors::kSeqFieldNumber,
+      seq, target);
+
+  slices.emplace_back (header, (size_t) (target - header));
+
+  for (guint i = 0; i < config_->info.num_tensors; i++) {
+    const GstTensorInfo * info = &config_->info.info[i];
+    gsize tsize = gst_tensor_info_get_size (info);
+
+    if (offset + tsize > buf_size) {
+      ml_logw ("Setting invalid tensor data");
+      break;
+    }
+
+    dim_size = _pb_get_dimension_size (info->dimension);
+    tensor_size = PB_LEN_FIELD_SIZE (Tensor::kNameFieldNumber, name_len)
+        + PB_LEN_FIELD_SIZE (Tensor::kDimensionFieldNumber, dim_size)
+        + PB_LEN_FIELD_SIZE (Tensor::kDataFieldNumber, tsize);
+    if (info->type != 0)
+      tensor_size += PB_TAG_SIZE (Tensor::kTypeFieldNumber, WIRETYPE_VARINT)
+          + WireFormatLite::EnumSize ((int) info->type);
+
+    /* the tensor data is the last field of the message 'Tensor' */
+    target = header;
+    target = _pb_write_len_field (Tensors::kTensorFieldNumber, tensor_size, target);
+
+    target = _pb_write_len_field (Tensor::kNameFieldNumber, name_len, target);
+    target = CodedOutputStream::WriteRawToArray (NNS_GRPC_PROTOBUF_TENSOR_NAME,
+        (int) name_len, target);
+
+    if (info->type != 0)
+      target = WireFormatLite::WriteEnumToArray (Tensor::kTypeFieldNumber,
+          (int) info->type, target);
+
+    target = _pb_write_len_field (Tensor::kDimensionFieldNumber, dim_size, target);
+    for (guint j = 0; j < NNS_TENSOR_RANK_LIMIT; j++)
+      target = WireFormatLite::WriteUInt32NoTagToArray (info->dimension[j], target);
+
+    target = _pb_write_len_field (Tensor::kDataFieldNumber, tsize, target);
+    slices.emplace_back (header, (size_t) (target - header));
+
+    if (tsize > 0)
+      slices.push_back (_pb_get_slice (buffer, offset, tsize));
+
+    offset += tsize;
+  }
+
+  *message = ByteBuffer (slices.data (), slices.size ());
+}
+
 /** @brief Constructor of SyncServiceImplProtobuf */
 SyncServiceImplProtobuf::SyncServiceImplProtobuf (const grpc_config * config)
   : ServiceImplProtobuf (config)
@@ -177,7 +391,7 @@ Status
 SyncServiceImplProtobuf::SendTensors (ServerContext *context,
     ServerReader<Tensors> *reader, Empty *reply)
 {
-  return _read_tensors (reader);
+  return _read_tensors (reader, context->peer ());
 }
 
 /** @brief server-to-client streaming: a client receives tensors */
@@ -185,7 +399,7 @@ Status
 SyncServiceImplProtobuf::RecvTensors (ServerContext *context,
     const Empty *request, ServerWriter<Tensors> *writer)
 {
-  return _write_tensors (writer);
+  return _write_tensors (writer, context->peer ());
 }
 
 /** @brief start gRPC server handling protobuf */
@@ -210,43 +424,56 @@ gboolean
 SyncServiceImplProtobuf::start_client (std::string address)
 {
   /* create a gRPC channel */
-  std::shared_ptr<Channel> channel = grpc::CreateChannel(
-      address, grpc::InsecureChannelCredentials());
+  channel_ = grpc::CreateChannel(address, grpc::InsecureChannelCredentials());
 
   /* connect the server */
-  client_stub_ = TensorService::NewStub (channel);
+  client_stub_ = TensorService::NewStub (channel_);
   if (client_stub_.get () == nullptr)
     return FALSE;
 
-  worker_ = std::thread ([this] { this->_client_thread (); });
+  /* the streams share the channel */
+  for (guint i = 0; i < num_streams_; i++)
+    workers_.push_back (std::thread ([this, i] { this->_client_thread (i); }));
 
   return TRUE;
 }
 
 /** @brief gRPC client thread */
 void
-SyncServiceImplProtobuf::_client_thread ()
+SyncServiceImplProtobuf::_client_thread (guint stream)
 {
   ClientContext context;
   Empty empty;
 
   if (direction_ == GRPC_DIRECTION_TENSORS_TO_BUFFER) {
-    /* initiate the RPC call */
-    std::unique_ptr< ClientWriter<Tensors> > writer(
-        client_stub_->SendTensors (&context, &empty));
+    internal::RpcMethod method (NNS_GRPC_PROTOBUF_SEND_TENSORS,
+        internal::RpcMethod::CLIENT_STREAMING, channel_);
+    GstBuffer *buffer;
+    guint64 seq;
 
-    _write_tensors (writer.get ());
+    /* initiate the RPC call with the messages serialized by hand */
+    std::unique_ptr< ClientWriter<ByteBuffer> > writer(
+        internal::ClientWriterFactory<ByteBuffer>::Create (channel_.get (),
+            method, &context, &empty));
+
+    /* until flushing */
+    while (pop (stream, std::string (), &buffer, &seq)) {
+      ByteBuffer message;
+
+      _get_message_from_buffer (buffer, seq, &message);
+      gst_buffer_unref (buffer);
+
+      writer->Write (message);
+    }
 
     writer->WritesDone ();
     writer->Finish ();
   } else if (direction_ == GRPC_DIRECTION_BUFFER_TO_TENSORS) {
-    Tensors tensors;
-
     /* initiate the RPC call */
     std::unique_ptr< ClientReader<Tensors> > reader(
         client_stub_->RecvTensors (&context, empty));
 
-    _read_tensors (reader.get ());
+    _read_tensors (reader.get (), std::string ());
 
     reader->Finish ();
   } else {
@@ -284,7 +511,7 @@ AsyncServiceImplProtobuf::start_server (std::string address)
   if (server_instance_.get () == nullptr)
     return FALSE;
 
-  worker_ = std::thread ([this] { this->_server_thread (); });
+  workers_.push_back (std::thread ([this] { this->_server_thread (); }));
 
   return TRUE;
 }
@@ -302,7 +529,7 @@ AsyncServiceImplProtobuf::start_client (std::string address)
   if (client_stub_.get () == nullptr)
     return FALSE;
 
-  worker_ = std::thread ([this] { this->_client_thread (); });
+  workers_.push_back (std::thread ([this] { this->_client_thread (); }));
 
   return TRUE;
 }
@@ -323,7 +550,7 @@ class AsyncCallDataServer : public AsyncCallData {
       if (state_ == PROCESS && !ok) {
         if (count_ != 0) {
           if (reader_.get () != nullptr)
-            service_->parse_tensors (rpc_tensors_);
+            service_->parse_tensors (rpc_tensors_, ctx_.peer ());
           state_ = FINISH;
         } else {
           return;
@@ -343,30 +570,36 @@ class AsyncCallDataServer : public AsyncCallData {
         if (count_ == 0) {
           /* spawn a new instance to serve new clients */
           service_->set_last_call (new AsyncCallDataServer (service_, cq_));
+
+          service_->begin_stream (ctx_.peer ());
         }
 
         if (reader_.get () != nullptr) {
           if (count_ != 0)
-            service_->parse_tensors (rpc_tensors_);
+            service_->parse_tensors (rpc_tensors_, ctx_.peer ());
           reader_->Read (&rpc_tensors_, this);
           /* can't read tensors yet. use the next turn */
           count_++;
         } else if (writer_.get () != nullptr) {
           Tensors tensors;
-          if (service_->fill_tensors (tensors)) {
+          if (service_->fill_tensors (tensors, ctx_.peer ())) {
             writer_->Write (tensors, this);
             count_++;
           } else {
             Status status;
+            service_->end_stream (ctx_.peer ());
             writer_->Finish (status, this);
             state_ = DESTROY;
           }
         }
       } else if (state_ == FINISH) {
-        if (reader_.get () != nullptr)
+        if (reader_.get () != nullptr) {
+          service_->end_stream (ctx_.peer ());
           reader_->Finish (rpc_empty_, Status::OK, this);
+        }
         if (writer_.get () != nullptr) {
           Status status;
+          service_->end_stream (ctx_.peer ());
           writer_->Finish (status, this);
         }
         state_ = DESTROY;
@@ -400,7 +633,7 @@ class AsyncCallDataClient : public AsyncCallData {
       if (state_ == PROCESS && !ok) {
         if (count_ != 0) {
           if (reader_.get () != nullptr)
-            service_->parse_tensors (rpc_tensors_);
+            service_->parse_tensors (rpc_tensors_, std::string ());
           state_ = FINISH;
         } else {
           return;
@@ -417,7 +650,7 @@ class AsyncCallDataClient : public AsyncCallData {
       } else if (state_ == PROCESS) {
         if (reader_.get () != nullptr) {
           if (count_ != 0)
-            service_->parse_tensors (rpc_tensors_);
+            service_->parse_tensors (rpc_tensors_, std::string ());
           reader_->Read (&rpc_tensors_, this);
           /* can't read tensors yet. use the next turn */
           count_++;
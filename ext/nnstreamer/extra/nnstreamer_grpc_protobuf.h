@@ -34,20 +34,24 @@ class ServiceImplProtobuf : public NNStreamerRPC
   public:
     ServiceImplProtobuf (const grpc_config * config);
 
-    void parse_tensors (Tensors &tensors);
-    gboolean fill_tensors (Tensors &tensors);
+    void parse_tensors (Tensors &tensors, const std::string &peer);
+    gboolean fill_tensors (Tensors &tensors,
+        const std::string &peer = std::string ());
 
   protected:
     template <typename T>
-    grpc::Status _write_tensors (T writer);
+    grpc::Status _write_tensors (T writer,
+        const std::string &peer = std::string ());
 
     template <typename T>
-    grpc::Status _read_tensors (T reader);
+    grpc::Status _read_tensors (T reader, const std::string &peer);
 
-    void _get_tensors_from_buffer (GstBuffer *buffer, Tensors &tensors);
+    void _get_tensors_from_buffer (GstBuffer *buffer, guint64 seq, Tensors &tensors);
     void _get_buffer_from_tensors (Tensors &tensors, GstBuffer **buffer);
+    void _get_message_from_buffer (GstBuffer *buffer, guint64 seq, ByteBuffer *message);
 
     std::unique_ptr<nnstreamer::protobuf::TensorService::Stub> client_stub_;
+    std::shared_ptr<Channel> channel_;
 };
 
 /**
@@ -69,7 +73,7 @@ class SyncServiceImplProtobuf final
     gboolean start_server (std::string address) override;
     gboolean start_client (std::string address) override;
 
-    void _client_thread ();
+    void _client_thread (guint stream);
 };
 
 class AsyncCallData;
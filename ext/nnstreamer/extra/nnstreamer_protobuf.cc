@@ -24,12 +24,135 @@
  * protobuf-compiler17
  */
 
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
 #include <nnstreamer_log.h>
 #include <nnstreamer_plugin_api.h>
 #include <nnstreamer_util.h>
+#include <string.h>
 #include "nnstreamer.pb.h" /* Generated by `protoc` */
 #include "nnstreamer_protobuf.h"
 
+using google::protobuf::io::CodedOutputStream;
+using google::protobuf::internal::WireFormatLite;
+using nnstreamer::protobuf::Tensor;
+using nnstreamer::protobuf::Tensors;
+
+/**
+ * @brief The size of the tag of the field.
+ */
+#define PB_TAG_SIZE(field, wire) \
+  (CodedOutputStream::VarintSize32 (WireFormatLite::MakeTag ((field), WireFormatLite::wire)))
+
+/**
+ * @brief The size of the length-delimited field.
+ */
+#define PB_LEN_FIELD_SIZE(field, len)                       \
+  (PB_TAG_SIZE ((field), WIRETYPE_LENGTH_DELIMITED)         \
+      + CodedOutputStream::VarintSize32 ((guint32) (len)) + (len))
+
+/**
+ * @brief Write the tag and length of the length-delimited field.
+ */
+static inline guint8 *
+_pb_write_len_field (int field, size_t len, guint8 *target)
+{
+  target = CodedOutputStream::WriteTagToArray (
+      WireFormatLite::MakeTag (field, WireFormatLite::WIRETYPE_LENGTH_DELIMITED), target);
+  return CodedOutputStream::WriteVarint32ToArray ((guint32) len, target);
+}
+
+/**
+ * @brief Get the size of the packed dimension.
+ */
+static size_t
+_pb_get_dimension_size (const tensor_dim dim)
+{
+  size_t size = 0;
+
+  for (guint i = 0; i < NNS_TENSOR_RANK_LIMIT; i++)
+    size += WireFormatLite::UInt32Size (dim[i]);
+
+  return size;
+}
+
+/**
+ * @brief Get the size of the serialized message 'Tensor'.
+ */
+static size_t
+_pb_get_tensor_size (const GstTensorInfo *info, size_t data_size)
+{
+  size_t size = 0, len;
+
+  /* proto3 does not serialize the field of default value */
+  len = info->name ? strlen (info->name) : 0;
+  if (len > 0)
+    size += PB_LEN_FIELD_SIZE (Tensor::kNameFieldNumber, len);
+
+  if (info->type != 0)
+    size += PB_TAG_SIZE (Tensor::kTypeFieldNumber, WIRETYPE_VARINT)
+            + WireFormatLite::EnumSize ((int) info->type);
+
+  size += PB_LEN_FIELD_SIZE (Tensor::kDimensionFieldNumber,
+      _pb_get_dimension_size (info->dimension));
+
+  if (data_size > 0)
+    size += PB_LEN_FIELD_SIZE (Tensor::kDataFieldNumber, data_size);
+
+  return size;
+}
+
+/**
+ * @brief Get the size of the serialized message 'frame_rate'.
+ */
+static size_t
+_pb_get_frame_rate_size (const GstTensorsConfig *config)
+{
+  size_t size = 0;
+
+  if (config->rate_n != 0)
+    size += PB_TAG_SIZE (Tensors::frame_rate::kRateNFieldNumber, WIRETYPE_VARINT)
+            + WireFormatLite::Int32Size (config->rate_n);
+
+  if (config->rate_d != 0)
+    size += PB_TAG_SIZE (Tensors::frame_rate::kRateDFieldNumber, WIRETYPE_VARINT)
+            + WireFormatLite::Int32Size (config->rate_d);
+
+  return size;
+}
+
+/**
+ * @brief Write the message 'Tensor'. The tensor data is copied into the target directly.
+ */
+static guint8 *
+_pb_write_tensor (const GstTensorInfo *info, const GstTensorMemory *mem, guint8 *target)
+{
+  size_t len;
+
+  len = info->name ? strlen (info->name) : 0;
+  if (len > 0) {
+    target = _pb_write_len_field (Tensor::kNameFieldNumber, len, target);
+    target = CodedOutputStream::WriteRawToArray (info->name, (int) len, target);
+  }
+
+  if (info->type != 0)
+    target = WireFormatLite::WriteEnumToArray (
+        Tensor::kTypeFieldNumber, (int) info->type, target);
+
+  target = _pb_write_len_field (Tensor::kDimensionFieldNumber,
+      _pb_get_dimension_size (info->dimension), target);
+  for (guint i = 0; i < NNS_TENSOR_RANK_LIMIT; i++)
+    target = WireFormatLite::WriteUInt32NoTagToArray (info->dimension[i], target);
+
+  if (mem->size > 0) {
+    target = _pb_write_len_field (Tensor::kDataFieldNumber, mem->size, target);
+    memcpy (target, mem->data, mem->size);
+    target += mem->size;
+  }
+
+  return target;
+}
+
 /** @brief tensordec-plugin's GstTensorDecoderDef callback */
 GstFlowReturn
 gst_tensor_decoder_protobuf (const GstTensorsConfig *config,
@@ -37,13 +160,13 @@ gst_tensor_decoder_protobuf (const GstTensorsConfig *config,
 {
   GstMapInfo out_info;
   GstMemory *out_mem;
-  size_t size, outbuf_size;
-  nnstreamer::protobuf::Tensors tensors;
-  nnstreamer::protobuf::Tensors::frame_rate *fr = NULL;
+  size_t size, outbuf_size, fr_size;
+  size_t tensor_size[NNS_TENSOR_SIZE_LIMIT];
   guint num_tensors;
   gboolean is_flexible;
   GstTensorMetaInfo meta;
   GstTensorsConfig pbd_config;
+  guint8 *target;
 
   if (!config || !input || !outbuf) {
     ml_loge ("NULL parameter is passed to tensor_decoder::protobuf");
@@ -57,49 +180,41 @@ gst_tensor_decoder_protobuf (const GstTensorsConfig *config,
     ml_loge ("The number of input tenosrs "
              "exceeds more than NNS_TENSOR_SIZE_LIMIT, %s",
         NNS_TENSOR_SIZE_LIMIT_STR);
-    return GST_FLOW_ERROR;
-  }
-  tensors.set_num_tensor (num_tensors);
-
-  fr = tensors.mutable_fr ();
-  if (!fr) {
-    nns_loge ("Failed to get pointer of tensors / tensordec-protobuf");
+    gst_tensors_config_free (&pbd_config);
     return GST_FLOW_ERROR;
   }
 
-  fr->set_rate_n (pbd_config.rate_n);
-  fr->set_rate_d (pbd_config.rate_d);
+  /**
+   * Write the message 'Tensors' without the generated classes,
+   * so the tensor data is copied once into the output memory.
+   * The fields are written in the order of field number, as protoc does.
+   */
+  size = PB_TAG_SIZE (Tensors::kNumTensorFieldNumber, WIRETYPE_VARINT)
+         + WireFormatLite::UInt32Size (num_tensors);
 
-  tensors.set_format (
-      (nnstreamer::protobuf::Tensors::Tensor_format) pbd_config.format);
-
-  for (unsigned int i = 0; i < num_tensors; ++i) {
-    nnstreamer::protobuf::Tensor *tensor = tensors.add_tensor ();
-    gchar *name = NULL;
+  fr_size = _pb_get_frame_rate_size (&pbd_config);
+  size += PB_LEN_FIELD_SIZE (Tensors::kFrFieldNumber, fr_size);
 
+  for (guint i = 0; i < num_tensors; ++i) {
     if (is_flexible) {
       gst_tensor_meta_info_parse_header (&meta, input[i].data);
       gst_tensor_meta_info_convert (&meta, &pbd_config.info.info[i]);
     }
-    name = pbd_config.info.info[i].name;
-
-    if (name == NULL) {
-      tensor->set_name ("");
-    } else {
-      tensor->set_name (name);
-    }
 
-    tensor->set_type (
-        (nnstreamer::protobuf::Tensor::Tensor_type) pbd_config.info.info[i].type);
+    tensor_size[i] = _pb_get_tensor_size (&pbd_config.info.info[i], input[i].size);
+    size += PB_LEN_FIELD_SIZE (Tensors::kTensorFieldNumber, tensor_size[i]);
+  }
 
-    for (int j = 0; j < NNS_TENSOR_RANK_LIMIT; ++j) {
-      tensor->add_dimension (pbd_config.info.info[i].dimension[j]);
-    }
+  if (pbd_config.format != _NNS_TENSOR_FORMAT_STATIC)
+    size += PB_TAG_SIZE (Tensors::kFormatFieldNumber, WIRETYPE_VARINT)
+            + WireFormatLite::EnumSize ((int) pbd_config.format);
 
-    tensor->set_data (input[i].data, (int)input[i].size);
+  if (size > G_MAXINT32) {
+    nns_loge ("The size of protobuf message exceeds 2GB / tensordec-protobuf");
+    gst_tensors_config_free (&pbd_config);
+    return GST_FLOW_ERROR;
   }
 
-  size = tensors.ByteSizeLong ();
   outbuf_size = gst_buffer_get_size (outbuf);
 
   if (outbuf_size == 0) {
@@ -114,12 +229,35 @@ gst_tensor_decoder_protobuf (const GstTensorsConfig *config,
   if (!gst_memory_map (out_mem, &out_info, GST_MAP_WRITE)) {
     nns_loge ("Cannot map output memory / tensordec-protobuf");
     gst_memory_unref (out_mem);
+    gst_tensors_config_free (&pbd_config);
     return GST_FLOW_ERROR;
   }
 
-  tensors.SerializeToArray (out_info.data, size);
+  target = out_info.data;
+  target = WireFormatLite::WriteUInt32ToArray (
+      Tensors::kNumTensorFieldNumber, num_tensors, target);
+
+  target = _pb_write_len_field (Tensors::kFrFieldNumber, fr_size, target);
+  if (pbd_config.rate_n != 0)
+    target = WireFormatLite::WriteInt32ToArray (
+        Tensors::frame_rate::kRateNFieldNumber, pbd_config.rate_n, target);
+  if (pbd_config.rate_d != 0)
+    target = WireFormatLite::WriteInt32ToArray (
+        Tensors::frame_rate::kRateDFieldNumber, pbd_config.rate_d, target);
+
+  for (guint i = 0; i < num_tensors; ++i) {
+    target = _pb_write_len_field (Tensors::kTensorFieldNumber, tensor_size[i], target);
+    target = _pb_write_tensor (&pbd_config.info.info[i], &input[i], target);
+  }
+
+  if (pbd_config.format != _NNS_TENSOR_FORMAT_STATIC)
+    target = WireFormatLite::WriteEnumToArray (
+        Tensors::kFormatFieldNumber, (int) pbd_config.format, target);
+
+  g_assert ((size_t) (target - out_info.data) == size);
 
   gst_memory_unmap (out_mem, &out_info);
+  gst_tensors_config_free (&pbd_config);
 
   if (outbuf_size == 0)
     gst_buffer_append_memory (outbuf, out_mem);
@@ -129,17 +267,193 @@ gst_tensor_decoder_protobuf (const GstTensorsConfig *config,
   return GST_FLOW_OK;
 }
 
+/**
+ * @brief Read a varint from the serialized message.
+ */
+static gboolean
+_pb_read_varint (const guint8 **pos, const guint8 *end, guint64 *value)
+{
+  guint shift;
+
+  *value = 0;
+  for (shift = 0; shift < 64 && *pos < end; shift += 7) {
+    guint8 byte = *(*pos)++;
+
+    *value |= (guint64) (byte & 0x7F) << shift;
+    if (!(byte & 0x80))
+      return TRUE;
+  }
+
+  return FALSE;
+}
+
+/**
+ * @brief Read the length of the length-delimited field, and get the end of the field.
+ */
+static gboolean
+_pb_read_len (const guint8 **pos, const guint8 *end, const guint8 **field_end)
+{
+  guint64 len;
+
+  if (!_pb_read_varint (pos, end, &len) || len > (guint64) (end - *pos))
+    return FALSE;
+
+  *field_end = *pos + len;
+  return TRUE;
+}
+
+/**
+ * @brief Skip the field of unknown field number.
+ */
+static gboolean
+_pb_skip_field (const guint8 **pos, const guint8 *end, WireFormatLite::WireType wire)
+{
+  const guint8 *field_end;
+  guint64 value;
+
+  switch (wire) {
+    case WireFormatLite::WIRETYPE_VARINT:
+      return _pb_read_varint (pos, end, &value);
+    case WireFormatLite::WIRETYPE_FIXED64:
+      field_end = *pos + 8;
+      break;
+    case WireFormatLite::WIRETYPE_FIXED32:
+      field_end = *pos + 4;
+      break;
+    case WireFormatLite::WIRETYPE_LENGTH_DELIMITED:
+      if (!_pb_read_len (pos, end, &field_end))
+        return FALSE;
+      break;
+    default:
+      /* groups are not used in nnstreamer.proto */
+      return FALSE;
+  }
+
+  if (field_end > end)
+    return FALSE;
+
+  *pos = field_end;
+  return TRUE;
+}
+
+/**
+ * @brief Data structure for the location of the message 'Tensor' in the serialized data.
+ */
+typedef struct {
+  const guint8 *data; /**< the field 'data', NULL if not given */
+  gsize size; /**< the size of the field 'data' */
+} pb_tensor_data;
+
+/**
+ * @brief Parse the message 'Tensor'. The field 'data' is not copied, this gets its location only.
+ */
+static gboolean
+_pb_parse_tensor (const guint8 *pos, const guint8 *end, GstTensorInfo *info, pb_tensor_data *tdata)
+{
+  const guint8 *field_end;
+  guint64 tag, value;
+  guint rank = 0;
+
+  gst_tensor_info_init (info);
+  tdata->data = NULL;
+  tdata->size = 0;
+
+  while (pos < end) {
+    if (!_pb_read_varint (&pos, end, &tag))
+      return FALSE;
+
+    const int field = WireFormatLite::GetTagFieldNumber ((guint32) tag);
+    const WireFormatLite::WireType wire = WireFormatLite::GetTagWireType ((guint32) tag);
+
+    if (field == Tensor::kNameFieldNumber && wire == WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+      if (!_pb_read_len (&pos, end, &field_end))
+        return FALSE;
+
+      g_free (info->name);
+      info->name = (field_end > pos) ? g_strndup ((const gchar *) pos, field_end - pos) : NULL;
+      pos = field_end;
+    } else if (field == Tensor::kTypeFieldNumber && wire == WireFormatLite::WIRETYPE_VARINT) {
+      if (!_pb_read_varint (&pos, end, &value))
+        return FALSE;
+
+      info->type = (tensor_type) value;
+    } else if (field == Tensor::kDimensionFieldNumber
+               && wire == WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+      /* packed repeated field */
+      if (!_pb_read_len (&pos, end, &field_end))
+        return FALSE;
+
+      while (pos < field_end) {
+        if (!_pb_read_varint (&pos, field_end, &value))
+          return FALSE;
+        if (rank < NNS_TENSOR_RANK_LIMIT)
+          info->dimension[rank++] = (guint32) value;
+      }
+    } else if (field == Tensor::kDimensionFieldNumber && wire == WireFormatLite::WIRETYPE_VARINT) {
+      /* unpacked repeated field is also acceptable */
+      if (!_pb_read_varint (&pos, end, &value))
+        return FALSE;
+      if (rank < NNS_TENSOR_RANK_LIMIT)
+        info->dimension[rank++] = (guint32) value;
+    } else if (field == Tensor::kDataFieldNumber && wire == WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+      if (!_pb_read_len (&pos, end, &field_end))
+        return FALSE;
+
+      tdata->data = pos;
+      tdata->size = field_end - pos;
+      pos = field_end;
+    } else if (!_pb_skip_field (&pos, end, wire)) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Parse the message 'frame_rate'.
+ */
+static gboolean
+_pb_parse_frame_rate (const guint8 *pos, const guint8 *end, GstTensorsConfig *config)
+{
+  guint64 tag, value;
+
+  while (pos < end) {
+    if (!_pb_read_varint (&pos, end, &tag))
+      return FALSE;
+
+    const int field = WireFormatLite::GetTagFieldNumber ((guint32) tag);
+    const WireFormatLite::WireType wire = WireFormatLite::GetTagWireType ((guint32) tag);
+
+    if (wire == WireFormatLite::WIRETYPE_VARINT
+        && (field == Tensors::frame_rate::kRateNFieldNumber
+            || field == Tensors::frame_rate::kRateDFieldNumber)) {
+      if (!_pb_read_varint (&pos, end, &value))
+        return FALSE;
+
+      if (field == Tensors::frame_rate::kRateNFieldNumber)
+        config->rate_n = (gint32) value;
+      else
+        config->rate_d = (gint32) value;
+    } else if (!_pb_skip_field (&pos, end, wire)) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
 /** @brief tensor converter plugin's NNStreamerExternalConverter callback */
 GstBuffer *
 gst_tensor_converter_protobuf (GstBuffer *in_buf, GstTensorsConfig *config, void *priv_data)
 {
-  nnstreamer::protobuf::Tensors tensors;
-  nnstreamer::protobuf::Tensors::frame_rate *fr = NULL;
   GstMemory *in_mem, *out_mem;
   GstMapInfo in_info;
-  GstBuffer *out_buf;
-  gsize mem_size;
-  gpointer mem_data;
+  GstBuffer *out_buf = NULL;
+  pb_tensor_data tdata[NNS_TENSOR_SIZE_LIMIT];
+  const guint8 *pos, *end, *field_end;
+  guint64 tag, value;
+  guint num_tensors = 0, parsed = 0;
   UNUSED (priv_data);
 
   if (!in_buf || !config) {
@@ -154,30 +468,83 @@ gst_tensor_converter_protobuf (GstBuffer *in_buf, GstTensorsConfig *config, void
     return NULL;
   }
 
-  tensors.ParseFromArray (in_info.data, in_info.size);
+  /**
+   * Parse the message 'Tensors' without the generated classes.
+   * Each field 'data' is shared with the input memory, the tensor data is not copied.
+   */
+  config->rate_n = config->rate_d = 0;
+  config->format = _NNS_TENSOR_FORMAT_STATIC;
+
+  pos = in_info.data;
+  end = in_info.data + in_info.size;
+
+  while (pos < end) {
+    if (!_pb_read_varint (&pos, end, &tag))
+      goto error;
+
+    const int field = WireFormatLite::GetTagFieldNumber ((guint32) tag);
+    const WireFormatLite::WireType wire = WireFormatLite::GetTagWireType ((guint32) tag);
+
+    if (field == Tensors::kNumTensorFieldNumber && wire == WireFormatLite::WIRETYPE_VARINT) {
+      if (!_pb_read_varint (&pos, end, &value))
+        goto error;
+
+      num_tensors = (guint) value;
+    } else if (field == Tensors::kFrFieldNumber && wire == WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+      if (!_pb_read_len (&pos, end, &field_end)
+          || !_pb_parse_frame_rate (pos, field_end, config))
+        goto error;
+
+      pos = field_end;
+    } else if (field == Tensors::kTensorFieldNumber
+               && wire == WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+      if (parsed >= NNS_TENSOR_SIZE_LIMIT) {
+        nns_loge ("The number of tensors is limited to %d", NNS_TENSOR_SIZE_LIMIT);
+        goto error;
+      }
+
+      if (!_pb_read_len (&pos, end, &field_end)
+          || !_pb_parse_tensor (pos, field_end, &config->info.info[parsed], &tdata[parsed]))
+        goto error;
+
+      parsed++;
+      pos = field_end;
+    } else if (field == Tensors::kFormatFieldNumber && wire == WireFormatLite::WIRETYPE_VARINT) {
+      if (!_pb_read_varint (&pos, end, &value))
+        goto error;
+
+      config->format = (tensor_format) value;
+    } else if (!_pb_skip_field (&pos, end, wire)) {
+      goto error;
+    }
+  }
 
-  config->info.num_tensors = tensors.num_tensor ();
-  config->format = (tensor_format) tensors.format ();
-  fr = tensors.mutable_fr ();
-  config->rate_n = fr->rate_n ();
-  config->rate_d = fr->rate_d ();
-  out_buf = gst_buffer_new ();
+  if (num_tensors > parsed) {
+    nns_loge ("The number of tensors (%u) is larger than the given tensors (%u)",
+        num_tensors, parsed);
+    goto error;
+  }
 
-  for (guint i = 0; i < config->info.num_tensors; i++) {
-    const nnstreamer::protobuf::Tensor *tensor = &tensors.tensor (i);
-    std::string _name = tensor->name ();
-    const gchar *name = _name.c_str ();
+  /* release the names of the tensors not counted in num_tensors */
+  for (guint i = num_tensors; i < parsed; i++) {
+    g_free (config->info.info[i].name);
+    config->info.info[i].name = NULL;
+  }
 
-    config->info.info[i].name = (name && strlen (name) > 0) ? g_strdup (name) : NULL;
-    config->info.info[i].type = (tensor_type)tensor->type ();
-    for (guint j = 0; j < NNS_TENSOR_RANK_LIMIT; j++) {
-      config->info.info[i].dimension[j] = tensor->dimension (j);
-    }
-    mem_size = tensor->data ().length ();
-    mem_data = _g_memdup (tensor->data ().c_str (), mem_size);
+  config->info.num_tensors = num_tensors;
+  out_buf = gst_buffer_new ();
 
-    out_mem = gst_memory_new_wrapped ((GstMemoryFlags) 0, mem_data, mem_size,
-        0, mem_size, NULL, NULL);
+  for (guint i = 0; i < num_tensors; i++) {
+    if (tdata[i].size == 0) {
+      out_mem = gst_allocator_alloc (NULL, 0, NULL);
+    } else if (GST_MEMORY_IS_NO_SHARE (in_mem)) {
+      /* the input memory cannot be shared, copy the tensor data */
+      out_mem = gst_memory_copy (
+          in_mem, tdata[i].data - in_info.data, tdata[i].size);
+    } else {
+      out_mem = gst_memory_share (
+          in_mem, tdata[i].data - in_info.data, tdata[i].size);
+    }
 
     gst_buffer_append_memory (out_buf, out_mem);
   }
@@ -188,4 +555,14 @@ gst_tensor_converter_protobuf (GstBuffer *in_buf, GstTensorsConfig *config, void
   gst_memory_unmap (in_mem, &in_info);
 
   return out_buf;
+
+error:
+  nns_loge ("Failed to parse the protobuf message / tensor_converter_protobuf");
+  for (guint i = 0; i <= parsed && i < NNS_TENSOR_SIZE_LIMIT; i++) {
+    g_free (config->info.info[i].name);
+    config->info.info[i].name = NULL;
+  }
+  gst_memory_unmap (in_mem, &in_info);
+
+  return NULL;
 }
@@ -349,6 +349,44 @@ dv_decode (void **pdata, const GstTensorsConfig * config,
   return GST_FLOW_OK;
 }
 
+/** @brief tensordec-plugin's GstTensorDecoderDef callback */
+static GstFlowReturn
+dv_decodeMemory (void **pdata, const GstTensorsConfig * config,
+    GstMemory ** input, GstBuffer * outbuf)
+{
+  GstMemory *out_mem;
+  gsize in_size;
+  /* Direct video uses the first tensor only even if it's multi-tensor */
+  const uint32_t *dim = &(config->info.info[0].dimension[0]);
+  size_t size = _get_video_xraw_bufsize (dim);
+  UNUSED (pdata);
+
+  g_assert (outbuf);
+  g_assert (config->info.info[0].type == _NNS_UINT8);
+
+  /**
+   * The input tensor can be pushed as it is if the rows need no padding.
+   * Otherwise, copy the rows with dv_decode.
+   * If the output buffer is already allocated (e.g., from downstream pool), fill it with dv_decode.
+   */
+  if (gst_buffer_get_size (outbuf) != 0
+      || 0 != ((dim[0] * dim[1]) % 4) || gst_tensors_config_is_flexible (config)
+      || GST_MEMORY_FLAG_IS_SET (input[0], GST_MEMORY_FLAG_NO_SHARE))
+    return GST_TENSOR_DECODER_FALLBACK;
+
+  in_size = gst_memory_get_sizes (input[0], NULL, NULL);
+  if (in_size < size)
+    return GST_TENSOR_DECODER_FALLBACK;
+
+  if (in_size == size)
+    out_mem = gst_memory_ref (input[0]);
+  else
+    out_mem = gst_memory_share (input[0], 0, size);
+
+  gst_buffer_append_memory (outbuf, out_mem);
+  return GST_FLOW_OK;
+}
+
 static gchar decoder_subplugin_direct_video[] = "direct_video";
 
 /** @brief Direct-Video tensordec-plugin GstTensorDecoderDef instance */
@@ -367,6 +405,7 @@ void
 init_dv (void)
 {
   nnstreamer_decoder_probe (&directVideo);
+  nnstreamer_decoder_set_decode_memory (directVideo.modename, dv_decodeMemory);
 }
 
 /** @brief Destruct this object for tensordec-plugin */
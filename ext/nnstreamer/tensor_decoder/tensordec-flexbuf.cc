@@ -112,6 +112,38 @@ flxd_getOutCaps (void **pdata, const GstTensorsConfig *config)
   return caps;
 }
 
+/**
+ * @brief The size of a tensor in the map except the tensor data (key, name, dimension and vector).
+ */
+#define FLXD_TENSOR_OVERHEAD (128)
+
+/**
+ * @brief Get the initial size of the builder, so that the builder does not grow (and copy) the buffer.
+ */
+static size_t
+flxd_get_initial_size (const GstTensorsConfig *config, const GstTensorMemory *input)
+{
+  size_t size = FLXD_TENSOR_OVERHEAD;
+  guint i;
+
+  for (i = 0; i < config->info.num_tensors; i++) {
+    size += input[i].size + FLXD_TENSOR_OVERHEAD;
+    if (config->info.info[i].name)
+      size += strlen (config->info.info[i].name);
+  }
+
+  return size;
+}
+
+/**
+ * @brief Free the builder, when the output memory holding its buffer is released.
+ */
+static void
+flxd_free_builder (gpointer data)
+{
+  delete static_cast<flexbuffers::Builder *> (data);
+}
+
 /** @brief tensordec-plugin's GstTensorDecoderDef callback */
 static GstFlowReturn
 flxd_decode (void **pdata, const GstTensorsConfig *config,
@@ -122,7 +154,7 @@ flxd_decode (void **pdata, const GstTensorsConfig *config,
   guint i, num_tensors;
   gboolean need_alloc;
   size_t flex_size;
-  flexbuffers::Builder fbb;
+  flexbuffers::Builder *builder;
   gboolean is_flexible;
   GstTensorMetaInfo meta;
   GstTensorsConfig flxd_config;
@@ -135,6 +167,10 @@ flxd_decode (void **pdata, const GstTensorsConfig *config,
   gst_tensors_config_copy (&flxd_config, config);
   is_flexible = gst_tensors_config_is_flexible (&flxd_config);
 
+  /* The builder is released with the output memory, see below. */
+  builder = new flexbuffers::Builder (flxd_get_initial_size (config, input));
+  flexbuffers::Builder &fbb = *builder;
+
   num_tensors = flxd_config.info.num_tensors;
   fbb.Map ([&]() {
     fbb.UInt ("num_tensors", num_tensors);
@@ -168,20 +204,28 @@ flxd_decode (void **pdata, const GstTensorsConfig *config,
   });
   fbb.Finish ();
   flex_size = fbb.GetSize ();
+  gst_tensors_config_free (&flxd_config);
 
   need_alloc = (gst_buffer_get_size (outbuf) == 0);
 
   if (need_alloc) {
-    out_mem = gst_allocator_alloc (NULL, flex_size, NULL);
-  } else {
-    if (gst_buffer_get_size (outbuf) < flex_size) {
-      gst_buffer_set_size (outbuf, flex_size);
-    }
-    out_mem = gst_buffer_get_all_memory (outbuf);
+    /* Hand the buffer of the builder over to the output memory without copying it */
+    out_mem = gst_memory_new_wrapped ((GstMemoryFlags) 0,
+        (gpointer) fbb.GetBuffer ().data (), flex_size, 0, flex_size,
+        builder, flxd_free_builder);
+
+    gst_buffer_append_memory (outbuf, out_mem);
+    return GST_FLOW_OK;
+  }
+
+  if (gst_buffer_get_size (outbuf) < flex_size) {
+    gst_buffer_set_size (outbuf, flex_size);
   }
+  out_mem = gst_buffer_get_all_memory (outbuf);
 
   if (!gst_memory_map (out_mem, &out_info, GST_MAP_WRITE)) {
     gst_memory_unref (out_mem);
+    delete builder;
     nns_loge ("Cannot map gst memory (tensor decoder flexbuf)\n");
     return GST_FLOW_ERROR;
   }
@@ -189,11 +233,8 @@ flxd_decode (void **pdata, const GstTensorsConfig *config,
   memcpy (out_info.data, fbb.GetBuffer ().data (), flex_size);
 
   gst_memory_unmap (out_mem, &out_info);
-
-  if (need_alloc)
-    gst_buffer_append_memory (outbuf, out_mem);
-  else
-    gst_memory_unref (out_mem);
+  gst_memory_unref (out_mem);
+  delete builder;
 
   return GST_FLOW_OK;
 }
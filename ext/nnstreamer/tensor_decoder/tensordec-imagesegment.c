@@ -34,6 +34,13 @@
  *
  * option2: Maximum number of class labels (except background), default is 20 (Pascal)
  *
+ * option3: Number of threads to decode the rows of a frame, default is the number of
+ *          processors (up to 4). Set 1 to decode in the streaming thread only.
+ *
+ * The SIMD kernels are selected according to the cpu features. In the test build
+ * (ENABLE_IMAGE_SEGMENT_KERNEL_OVERRIDE), set NNSTREAMER_IMAGE_SEGMENT_KERNEL to
+ * scalar, sse2, avx2 or neon to force the kernels (ignored if the cpu does not support it).
+ *
  * expected models
  * - tflite-deeplab : deeplabv3_257_mv_gpu.tflite (designed for embedded devices)
  * - snpe-deeplab   : deeplabv3_mnv2_pascal_train_aug.dlc (converted from a TF model)
@@ -89,12 +96,24 @@
 
 #define NEON64_ENABLED
 #define GRAYSCALE_HEX (0x00010101)
-#define ALPHA_HEX     (0xFF000000)
+#elif (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#include <immintrin.h>
+
+#define X86_SIMD_ENABLED
 #endif
 
+#define ALPHA_HEX       (0xFF000000)
 #define DEFAULT_LABELS  (20)
 #define RGBA_CHANNEL    (4)
 #define MAX_RGB         (255)
+#define DEFAULT_THREADS (4)
+#define MAX_THREADS     (16)
+#define MIN_TASK_ROWS   (16)
+
+#ifdef ENABLE_IMAGE_SEGMENT_KERNEL_OVERRIDE
+/** @brief Environment variable to force the kernels (test build only) */
+#define KERNEL_ENVVAR   "NNSTREAMER_IMAGE_SEGMENT_KERNEL"
+#endif
 
 void init_is (void) __attribute__ ((constructor));
 void fini_is (void) __attribute__ ((destructor));
@@ -122,10 +141,27 @@ static const char *is_modes[] = {
   NULL,
 };
 
+/**
+ * @brief Data structure for image segmentation info, defined below.
+ */
+typedef struct _image_segments image_segments;
+
+/**
+ * @brief Kernel to find the label of the highest probability for each pixel.
+ */
+typedef void (*label_index_kernel) (const float *prob_map, float *segment_map,
+    guint num_pixels, guint total_labels);
+
+/**
+ * @brief Kernel to set the RGBA color of each pixel according to its label.
+ */
+typedef void (*color_label_kernel) (const image_segments * idata,
+    const float *labels, uint32_t * output, guint num_pixels);
+
 /**
  * @brief Data structure for image segmentation info
  */
-typedef struct
+struct _image_segments
 {
   image_segment_modes mode; /**< The image segmentation decoding mode */
   float *segment_map;       /**< The image segmentated map */
@@ -136,9 +172,32 @@ typedef struct
   guint width;              /**< Input video width */
   guint height;             /**< Input video height */
 
-  GRand *rand;              /**< random value generator */
   guint rgb_modifier;       /**< rgb modifier according to # labels */
-} image_segments;
+
+  guint num_threads;        /**< The number of threads to decode a frame */
+  GThreadPool *pool;        /**< The worker threads to decode the rows */
+  GMutex lock;              /**< The lock to wait for the workers */
+  GCond cond;               /**< The condition to wait for the workers */
+  guint pending;            /**< The number of tasks in the workers */
+
+  label_index_kernel set_label_index; /**< The kernel to find the label of each pixel */
+  color_label_kernel set_color_label; /**< The kernel to set the color of each pixel */
+};
+
+/**
+ * @brief Data structure for the rows of a frame to be decoded in a thread
+ */
+typedef struct
+{
+  image_segments *idata;    /**< The image segmentation info */
+  const float *prob_map;    /**< The label probabilities (NULL if labels are given) */
+  uint32_t *output;         /**< The output RGBA pixels */
+  guint row_start;          /**< The first row to be decoded */
+  guint row_end;            /**< The row after the last row to be decoded */
+} image_segment_task;
+
+
+static void _select_kernels (image_segments * idata);
 
 /** @brief tensordec-plugin's GstTensorDecoderDef callback */
 static int
@@ -152,7 +211,6 @@ is_init (void **pdata)
     return FALSE;
   }
 
-  idata->rand = g_rand_new ();
   idata->mode = MODE_UNKNOWN;
   idata->width = 0;
   idata->height = 0;
@@ -160,6 +218,12 @@ is_init (void **pdata)
   idata->segment_map = NULL;
   idata->color_map = NULL;
   idata->rgb_modifier = 0;
+  idata->num_threads = MIN (g_get_num_processors (), DEFAULT_THREADS);
+  idata->pool = NULL;
+  idata->pending = 0;
+  g_mutex_init (&idata->lock);
+  g_cond_init (&idata->cond);
+  _select_kernels (idata);
 
   return TRUE;
 }
@@ -168,13 +232,16 @@ is_init (void **pdata)
 static void
 _free_resources (image_segments * idata)
 {
+  if (idata->pool) {
+    g_thread_pool_free (idata->pool, TRUE, TRUE);
+    idata->pool = NULL;
+  }
+
   g_free (idata->segment_map);
   g_free (idata->color_map);
-  g_rand_free (idata->rand);
 
   idata->segment_map = NULL;
   idata->color_map = NULL;
-  idata->rand = NULL;
 }
 
 /** @brief tensordec-plugin's GstTensorDecoderDef callback */
@@ -184,6 +251,8 @@ is_exit (void **pdata)
   image_segments *idata = *pdata;
 
   _free_resources (idata);
+  g_mutex_clear (&idata->lock);
+  g_cond_clear (&idata->cond);
 
   g_free (*pdata);
   *pdata = NULL;
@@ -197,20 +266,12 @@ _fill_color_map (image_segments * idata)
 
   idata->color_map[0] = 0;      /* background */
 
-#if defined (NEON64_ENABLED)
   idata->rgb_modifier = 0xFFFFFF / (idata->max_labels + 1);
   for (i = 1; i <= idata->max_labels; i++) {
-    /* colors should be the same with neon calculations */
+    /* colors should be the same with simd calculations */
     idata->color_map[i] = idata->rgb_modifier * i;
     ((guint8 *) & idata->color_map[i])[3] = '\xff';     /* alpha */
   }
-#else
-  for (i = 1; i <= idata->max_labels; i++) {
-    /* any color value would be acceptable */
-    idata->color_map[i] = g_rand_int_range (idata->rand, 0x101010, 0xFFFFFF);
-    ((guint8 *) & idata->color_map[i])[3] = '\xff';     /* alpha */
-  }
-#endif
 }
 
 /** @brief tensordec-plugin's GstTensorDecoderDef callback */
@@ -237,6 +298,17 @@ is_setOption (void **pdata, int op_num, const char *param)
     guint64 max_labels_64 = g_ascii_strtoll (param, NULL, 10);
     if (max_labels_64 != 0 && max_labels_64 <= UINT_MAX)
       idata->max_labels = (guint) max_labels_64;
+    return TRUE;
+  } else if (op_num == 2) {
+    guint64 threads_64 = g_ascii_strtoull (param, NULL, 10);
+    if (threads_64 != 0) {
+      idata->num_threads = (guint) MIN (threads_64, MAX_THREADS);
+      if (idata->pool) {
+        g_thread_pool_free (idata->pool, TRUE, TRUE);
+        idata->pool = NULL;
+      }
+    }
+    return TRUE;
   }
 
   GST_WARNING ("mode-option-\"%d\" is not definded.", op_num);
@@ -325,14 +397,28 @@ is_getTransformSize (void **pdata, const GstTensorsConfig * config,
 
 /** @brief Set color according to each pixel's label (RGBA) */
 static void
-set_color_according_to_label (image_segments * idata, GstMapInfo * out_info)
+set_color_label_scalar (const image_segments * idata, const float *labels,
+    uint32_t * output, guint num_pixels)
 {
-  float *input = idata->segment_map;
-  uint32_t *output = (uint32_t *) out_info->data;
-  guint num_pixels = idata->height * idata->width;
-  guint label_idx, idx = 0;
+  guint label_idx, idx;
+
+  for (idx = 0; idx < num_pixels; idx++) {
+    label_idx = (guint) labels[idx];
+
+    /* If out-of-range, don't draw it */
+    if (G_UNLIKELY (label_idx > idata->max_labels))
+      continue;
+
+    output[idx] = idata->color_map[label_idx];
+  }
+}
 
 #if defined (NEON64_ENABLED)
+/** @brief Set color according to each pixel's label (RGBA) with NEON */
+static void
+set_color_label_neon (const image_segments * idata, const float *labels,
+    uint32_t * output, guint num_pixels)
+{
   float32x4_t v_src_float;
 
   uint32x4_t v_src_uint;
@@ -342,15 +428,15 @@ set_color_according_to_label (image_segments * idata, GstMapInfo * out_info)
   uint32x4_t v_zero;
 
   guint num_lanes = 4;
+  guint idx;
 
   v_magic = vdupq_n_u32 (idata->rgb_modifier);
   v_alpha = vdupq_n_u32 (ALPHA_HEX);
   v_zero = vdupq_n_u32 (0);
 
-  for (idx = 0; idx < num_pixels; idx += num_lanes) {
+  for (idx = 0; idx + num_lanes <= num_pixels; idx += num_lanes) {
     /* load float32 vector */
-    v_src_float = vld1q_f32 (input);
-    input += num_lanes;
+    v_src_float = vld1q_f32 (labels + idx);
 
     /* convert float32 vector to uint32 vector */
     v_src_uint = vcvtq_u32_f32 (v_src_float);
@@ -366,29 +452,93 @@ set_color_according_to_label (image_segments * idata, GstMapInfo * out_info)
     v_src_uint = vorrq_u32 (v_src_uint, v_mask);
 
     /* store uint32 vector */
-    vst1q_u32 (output, v_src_uint);
-    output += num_lanes;
+    vst1q_u32 (output + idx, v_src_uint);
   }
 
-  if (num_pixels == idx)
-    return;
-
   /* handle remaining data */
-  input = (float *) idata->segment_map;
-  output = (uint32_t *) out_info->data;
-  idx -= num_lanes;
+  set_color_label_scalar (idata, labels + idx, output + idx, num_pixels - idx);
+}
 #endif
-  for (; idx < num_pixels; idx++) {
-    label_idx = (guint) input[idx];
+
+#if defined (X86_SIMD_ENABLED)
+/**
+ * @brief Set color according to each pixel's label (RGBA) with SSE2
+ * @note The color (label x rgb_modifier) is less than 2^24, thus float multiplication is exact.
+ * The output of out-of-range label is zero, as the scalar path leaves the cleared output.
+ */
+__attribute__ ((target ("sse2")))
+static void
+set_color_label_sse2 (const image_segments * idata, const float *labels,
+    uint32_t * output, guint num_pixels)
+{
+  const __m128 v_magic = _mm_set1_ps ((float) idata->rgb_modifier);
+  const __m128i v_max = _mm_set1_epi32 ((int) MIN (idata->max_labels, G_MAXINT));
+  const __m128i v_alpha = _mm_set1_epi32 ((int) ALPHA_HEX);
+  const __m128i v_zero = _mm_setzero_si128 ();
+  __m128i v_label, v_color, v_mask;
+  guint idx;
+
+  for (idx = 0; idx + 4 <= num_pixels; idx += 4) {
+    /* truncate float32 labels to int32 */
+    v_label = _mm_cvttps_epi32 (_mm_loadu_ps (labels + idx));
+
+    /* multiply by magic number to fill RGB values */
+    v_color = _mm_cvttps_epi32 (_mm_mul_ps (_mm_cvtepi32_ps (v_label), v_magic));
+
+    /* set the alpha value unless it's background */
+    v_mask = _mm_cmpeq_epi32 (v_label, v_zero);
+    v_color = _mm_or_si128 (v_color, _mm_andnot_si128 (v_mask, v_alpha));
 
     /* If out-of-range, don't draw it */
-    if (G_UNLIKELY (label_idx > idata->max_labels))
-      continue;
+    v_mask = _mm_or_si128 (_mm_cmpgt_epi32 (v_label, v_max),
+        _mm_cmplt_epi32 (v_label, v_zero));
+    v_color = _mm_andnot_si128 (v_mask, v_color);
 
-    output[idx] = idata->color_map[label_idx];
+    _mm_storeu_si128 ((__m128i *) (output + idx), v_color);
   }
+
+  /* handle remaining data */
+  set_color_label_scalar (idata, labels + idx, output + idx, num_pixels - idx);
 }
 
+/** @brief Set color according to each pixel's label (RGBA) with AVX2 */
+__attribute__ ((target ("avx2")))
+static void
+set_color_label_avx2 (const image_segments * idata, const float *labels,
+    uint32_t * output, guint num_pixels)
+{
+  const __m256i v_magic = _mm256_set1_epi32 ((int) idata->rgb_modifier);
+  const __m256i v_max =
+      _mm256_set1_epi32 ((int) MIN (idata->max_labels, G_MAXINT));
+  const __m256i v_alpha = _mm256_set1_epi32 ((int) ALPHA_HEX);
+  const __m256i v_zero = _mm256_setzero_si256 ();
+  __m256i v_label, v_color, v_mask;
+  guint idx;
+
+  for (idx = 0; idx + 8 <= num_pixels; idx += 8) {
+    /* truncate float32 labels to int32 */
+    v_label = _mm256_cvttps_epi32 (_mm256_loadu_ps (labels + idx));
+
+    /* multiply by magic number to fill RGB values */
+    v_color = _mm256_mullo_epi32 (v_label, v_magic);
+
+    /* set the alpha value unless it's background */
+    v_mask = _mm256_cmpeq_epi32 (v_label, v_zero);
+    v_color = _mm256_or_si256 (v_color, _mm256_andnot_si256 (v_mask, v_alpha));
+
+    /* If out-of-range, don't draw it */
+    v_mask = _mm256_or_si256 (_mm256_cmpgt_epi32 (v_label, v_max),
+        _mm256_cmpgt_epi32 (v_zero, v_label));
+    v_color = _mm256_andnot_si256 (v_mask, v_color);
+
+    _mm256_storeu_si256 ((__m256i *) (output + idx), v_color);
+  }
+
+  /* handle remaining data */
+  set_color_label_scalar (idata, labels + idx, output + idx, num_pixels - idx);
+}
+#endif
+
 /** @brief Find the maximum grayscale value */
 static float
 find_max_grayscale (image_segments * idata)
@@ -509,44 +659,212 @@ set_color_grayscale (image_segments * idata, GstMapInfo * out_info)
 
 /** @brief Set label index according to each pixel's label probabilities */
 static void
-set_label_index (image_segments * idata, void *data)
+set_label_index_scalar (const float *prob_map, float *segment_map,
+    guint num_pixels, guint total_labels)
 {
-  float *prob_map = (float *) data;
-  guint idx, i, j;
-  int max_idx;
+  guint idx, i;
+  guint max_idx;
   float max_prob;
-  guint total_labels = idata->max_labels + 1;
 
-  memset (idata->segment_map, '\x00',
-      (size_t) idata->width * idata->height * sizeof (float));
-
-  for (i = 0; i < idata->height; i++) {
-    for (j = 0; j < idata->width; j++) {
-      max_idx = 0;
-      max_prob = prob_map[i * idata->width * total_labels + j * total_labels];
-      for (idx = 1; idx < total_labels; idx++) {
-        float prob = prob_map[i * idata->width * total_labels
-            + j * total_labels + idx];
-        if (prob > max_prob) {
-          max_prob = prob;
-          max_idx = idx;
-        }
+  for (i = 0; i < num_pixels; i++) {
+    const float *prob = prob_map + (gsize) i * total_labels;
+
+    max_idx = 0;
+    max_prob = prob[0];
+    for (idx = 1; idx < total_labels; idx++) {
+      if (prob[idx] > max_prob) {
+        max_prob = prob[idx];
+        max_idx = idx;
       }
-      if (max_prob > DETECTION_THRESHOLD) {
-        idata->segment_map[i * idata->width + j] = (float) max_idx;
-      }                         /* otherwise, regarded as background */
+    }
+
+    /* otherwise, regarded as background */
+    segment_map[i] = (max_prob > DETECTION_THRESHOLD) ? (float) max_idx : 0.0f;
+  }
+}
+
+#if defined (X86_SIMD_ENABLED)
+/**
+ * @brief Set label index according to each pixel's label probabilities with SSE2
+ * @note Each lane handles a pixel. The first label is kept if the probabilities are the same.
+ */
+__attribute__ ((target ("sse2")))
+static void
+set_label_index_sse2 (const float *prob_map, float *segment_map,
+    guint num_pixels, guint total_labels)
+{
+  const __m128 v_threshold = _mm_set1_ps (DETECTION_THRESHOLD);
+  const gsize stride = total_labels;
+  __m128 v_prob, v_max, v_gt;
+  __m128i v_idx, v_max_idx;
+  guint idx, i;
+
+  for (i = 0; i + 4 <= num_pixels; i += 4) {
+    const float *prob = prob_map + (gsize) i * stride;
+
+    v_max = _mm_setr_ps (prob[0], prob[stride], prob[2 * stride],
+        prob[3 * stride]);
+    v_max_idx = _mm_setzero_si128 ();
+
+    for (idx = 1; idx < total_labels; idx++) {
+      v_prob = _mm_setr_ps (prob[idx], prob[stride + idx],
+          prob[2 * stride + idx], prob[3 * stride + idx]);
+      v_idx = _mm_set1_epi32 ((int) idx);
+
+      v_gt = _mm_cmpgt_ps (v_prob, v_max);
+      v_max = _mm_or_ps (_mm_and_ps (v_gt, v_prob), _mm_andnot_ps (v_gt, v_max));
+      v_max_idx = _mm_or_si128 (_mm_and_si128 (_mm_castps_si128 (v_gt), v_idx),
+          _mm_andnot_si128 (_mm_castps_si128 (v_gt), v_max_idx));
+    }
+
+    /* otherwise, regarded as background */
+    v_gt = _mm_cmpgt_ps (v_max, v_threshold);
+    _mm_storeu_ps (segment_map + i,
+        _mm_and_ps (v_gt, _mm_cvtepi32_ps (v_max_idx)));
+  }
+
+  /* handle remaining data */
+  set_label_index_scalar (prob_map + (gsize) i * stride, segment_map + i,
+      num_pixels - i, total_labels);
+}
+
+/** @brief Set label index according to each pixel's label probabilities with AVX2 */
+__attribute__ ((target ("avx2")))
+static void
+set_label_index_avx2 (const float *prob_map, float *segment_map,
+    guint num_pixels, guint total_labels)
+{
+  const __m256 v_threshold = _mm256_set1_ps (DETECTION_THRESHOLD);
+  const __m256i v_offset = _mm256_mullo_epi32 (_mm256_setr_epi32 (0, 1, 2, 3,
+          4, 5, 6, 7), _mm256_set1_epi32 ((int) total_labels));
+  __m256 v_prob, v_max, v_gt;
+  __m256i v_max_idx;
+  guint idx, i;
+
+  for (i = 0; i + 8 <= num_pixels; i += 8) {
+    const float *prob = prob_map + (gsize) i * total_labels;
+
+    v_max = _mm256_i32gather_ps (prob, v_offset, 4);
+    v_max_idx = _mm256_setzero_si256 ();
+
+    for (idx = 1; idx < total_labels; idx++) {
+      v_prob = _mm256_i32gather_ps (prob + idx, v_offset, 4);
+
+      v_gt = _mm256_cmp_ps (v_prob, v_max, _CMP_GT_OQ);
+      v_max = _mm256_blendv_ps (v_max, v_prob, v_gt);
+      v_max_idx = _mm256_blendv_epi8 (v_max_idx,
+          _mm256_set1_epi32 ((int) idx), _mm256_castps_si256 (v_gt));
+    }
+
+    /* otherwise, regarded as background */
+    v_gt = _mm256_cmp_ps (v_max, v_threshold, _CMP_GT_OQ);
+    _mm256_storeu_ps (segment_map + i,
+        _mm256_and_ps (v_gt, _mm256_cvtepi32_ps (v_max_idx)));
+  }
+
+  /* handle remaining data */
+  set_label_index_scalar (prob_map + (gsize) i * total_labels,
+      segment_map + i, num_pixels - i, total_labels);
+}
+#endif
+
+/** @brief Decode the rows of a frame */
+static void
+_decode_rows (image_segment_task * task)
+{
+  image_segments *idata = task->idata;
+  guint total_labels = idata->max_labels + 1;
+  gsize offset = (gsize) task->row_start * idata->width;
+  guint num_pixels = (task->row_end - task->row_start) * idata->width;
+
+  /* tflite-deeplab needs to perform extra post-processing to set labels */
+  if (task->prob_map) {
+    idata->set_label_index (task->prob_map + offset * total_labels,
+        idata->segment_map + offset, num_pixels, total_labels);
+  }
+
+  idata->set_color_label (idata, idata->segment_map + offset,
+      task->output + offset, num_pixels);
+}
+
+/** @brief Worker thread to decode the rows of a frame */
+static void
+_decode_rows_worker (gpointer data, gpointer user_data)
+{
+  image_segments *idata = user_data;
+
+  _decode_rows ((image_segment_task *) data);
+
+  g_mutex_lock (&idata->lock);
+  if (--idata->pending == 0)
+    g_cond_signal (&idata->cond);
+  g_mutex_unlock (&idata->lock);
+}
+
+/**
+ * @brief Set color according to each pixel's label (RGBA).
+ * The rows are split into the worker threads, and the first rows are decoded in this thread.
+ */
+static void
+set_color_according_to_label (image_segments * idata, const float *prob_map,
+    GstMapInfo * out_info)
+{
+  image_segment_task tasks[MAX_THREADS];
+  GError *error = NULL;
+  guint num_tasks, rows, i;
+
+  num_tasks = MIN (idata->num_threads, idata->height / MIN_TASK_ROWS);
+  num_tasks = MAX (num_tasks, 1U);
+
+  if (num_tasks > 1 && idata->pool == NULL) {
+    idata->pool = g_thread_pool_new (_decode_rows_worker, idata,
+        idata->num_threads - 1, FALSE, &error);
+
+    if (idata->pool == NULL) {
+      ml_logw ("Failed to create worker threads: %s",
+          error ? error->message : "unknown reason");
+      g_clear_error (&error);
+      num_tasks = 1;
+    }
+  }
+
+  rows = idata->height / num_tasks;
+  for (i = 0; i < num_tasks; i++) {
+    tasks[i].idata = idata;
+    tasks[i].prob_map = prob_map;
+    tasks[i].output = (uint32_t *) out_info->data;
+    tasks[i].row_start = i * rows;
+    tasks[i].row_end = (i == num_tasks - 1) ? idata->height : (i + 1) * rows;
+  }
+
+  g_mutex_lock (&idata->lock);
+  idata->pending = num_tasks - 1;
+  g_mutex_unlock (&idata->lock);
+
+  for (i = 1; i < num_tasks; i++) {
+    g_thread_pool_push (idata->pool, &tasks[i], &error);
+
+    if (error) {
+      ml_logw ("Failed to push the task: %s", error->message);
+      g_clear_error (&error);
+      _decode_rows_worker (&tasks[i], idata);
     }
   }
+
+  _decode_rows (&tasks[0]);
+
+  g_mutex_lock (&idata->lock);
+  while (idata->pending > 0)
+    g_cond_wait (&idata->cond, &idata->lock);
+  g_mutex_unlock (&idata->lock);
 }
 
 /** @brief set color to output buffer depending on each mode */
 static void
 set_color (image_segments * idata, void *data, GstMapInfo * out_info)
 {
-  /* tflite-deeplab needs to perform extra post-processing to set labels */
   if (idata->mode == MODE_TFLITE_DEEPLAB) {
-    set_label_index (idata, data);
-    set_color_according_to_label (idata, out_info);
+    set_color_according_to_label (idata, (const float *) data, out_info);
     return;
   }
 
@@ -554,7 +872,7 @@ set_color (image_segments * idata, void *data, GstMapInfo * out_info)
   idata->segment_map = data;
 
   if (idata->mode == MODE_SNPE_DEEPLAB)
-    set_color_according_to_label (idata, out_info);
+    set_color_according_to_label (idata, NULL, out_info);
   else if (idata->mode == MODE_SNPE_DEPTH)
     set_color_grayscale (idata, out_info);
 
@@ -645,6 +963,43 @@ static GstTensorDecoderDef imageSegment = {
   .decode = is_decode
 };
 
+/**
+ * @brief Select the kernels according to the cpu features.
+ * @details In the test build, the kernels given by NNSTREAMER_IMAGE_SEGMENT_KERNEL are selected if the cpu supports them, to test each kernel.
+ */
+static void
+_select_kernels (image_segments * idata)
+{
+#ifdef ENABLE_IMAGE_SEGMENT_KERNEL_OVERRIDE
+  const gchar *force = g_getenv (KERNEL_ENVVAR);
+#else
+  const gchar *force = NULL;
+#endif
+
+  idata->set_label_index = set_label_index_scalar;
+  idata->set_color_label = set_color_label_scalar;
+
+  if (g_strcmp0 (force, "scalar") == 0)
+    return;
+
+#if defined (NEON64_ENABLED)
+  if (!force || g_str_equal (force, "neon"))
+    idata->set_color_label = set_color_label_neon;
+#elif defined (X86_SIMD_ENABLED)
+  __builtin_cpu_init ();
+
+  if ((!force || g_str_equal (force, "avx2")) &&
+      __builtin_cpu_supports ("avx2")) {
+    idata->set_label_index = set_label_index_avx2;
+    idata->set_color_label = set_color_label_avx2;
+  } else if ((!force || g_str_equal (force, "sse2")) &&
+      __builtin_cpu_supports ("sse2")) {
+    idata->set_label_index = set_label_index_sse2;
+    idata->set_color_label = set_color_label_sse2;
+  }
+#endif
+}
+
 /** @brief Initialize this object for tensordec-plugin */
 void
 init_is (void)
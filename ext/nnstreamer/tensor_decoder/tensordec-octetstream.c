@@ -102,6 +102,59 @@ os_decode (void **pdata, const GstTensorsConfig * config,
   return GST_FLOW_OK;
 }
 
+/** @brief tensordec-plugin's GstTensorDecoderDef callback */
+static GstFlowReturn
+os_decodeMemory (void **pdata, const GstTensorsConfig * config,
+    GstMemory ** input, GstBuffer * outbuf)
+{
+  guint i;
+  gboolean is_flexible;
+  GstTensorMetaInfo meta;
+  gsize offset[NNS_TENSOR_SIZE_LIMIT], data_size[NNS_TENSOR_SIZE_LIMIT];
+  UNUSED (pdata);
+
+  if (!config || !input || !outbuf) {
+    ml_loge ("NULL parameter is passed to tensor_decoder::octet_stream");
+    return GST_FLOW_ERROR;
+  }
+  is_flexible = gst_tensors_config_is_flexible (config);
+
+  /* the output buffer is already allocated, copy the data with os_decode */
+  if (gst_buffer_get_size (outbuf) != 0)
+    return GST_TENSOR_DECODER_FALLBACK;
+
+  /* check all tensors first, not to append the memory partially before falling back */
+  for (i = 0; i < config->info.num_tensors; i++) {
+    if (GST_MEMORY_FLAG_IS_SET (input[i], GST_MEMORY_FLAG_NO_SHARE))
+      return GST_TENSOR_DECODER_FALLBACK;
+
+    if (is_flexible) {
+      if (!gst_tensor_meta_info_parse_memory (&meta, input[i])) {
+        ml_loge ("Failed to get the header of tensor %u.", i);
+        return GST_FLOW_ERROR;
+      }
+      offset[i] = gst_tensor_meta_info_get_header_size (&meta);
+      data_size[i] = gst_tensor_meta_info_get_data_size (&meta);
+    } else {
+      offset[i] = 0;
+      data_size[i] = gst_tensors_info_get_size (&config->info, i);
+    }
+
+    if (offset[i] + data_size[i] > gst_memory_get_sizes (input[i], NULL, NULL)) {
+      ml_loge ("The size of tensor %u is smaller than the given info.", i);
+      return GST_FLOW_ERROR;
+    }
+  }
+
+  /* share the data of each tensor without copying */
+  for (i = 0; i < config->info.num_tensors; i++) {
+    gst_buffer_append_memory (outbuf,
+        gst_memory_share (input[i], offset[i], data_size[i]));
+  }
+
+  return GST_FLOW_OK;
+}
+
 static gchar decoder_subplugin_octet_stream[] = "octet_stream";
 
 /** @brief octet stream tensordec-plugin GstTensorDecoderDef instance */
@@ -120,6 +173,7 @@ void
 init_os (void)
 {
   nnstreamer_decoder_probe (&octetSTream);
+  nnstreamer_decoder_set_decode_memory (octetSTream.modename, os_decodeMemory);
 }
 
 /** @brief Destruct this object for tensordec-plugin */
@@ -120,6 +120,11 @@ extern uint8_t rasters[][13];
 #define POSE_MD_MAX_LABEL_SZ 16
 #define POSE_MD_MAX_CONNECTIONS_SZ 8
 
+/**
+ * @brief The number of output memories to be recycled.
+ */
+#define POSE_OUT_MEM_CACHE_SZ 4
+
 /**
  * @brief Macro for calculating sigmoid
  */
@@ -196,6 +201,16 @@ typedef struct pose_metadata_s pose_metadata_t;
  */
 static singleLineSprite_t singleLineSprite;
 
+/**
+ * @brief Data structure for the output memory drawn before.
+ */
+typedef struct
+{
+  GstMemory *mem; /**< The output memory, NULL if not allocated */
+  gsize dirty_offset; /**< The offset of the first row drawn in the memory */
+  gsize dirty_size; /**< The size of the rows drawn in the memory */
+} pose_out_mem;
+
 /**
  * @brief Data structure for boundig box info.
  */
@@ -215,6 +230,9 @@ typedef struct
 
   /* From option4 */
   pose_modes mode; /**< The pose estimation decoding mode */
+
+  pose_out_mem out_mems[POSE_OUT_MEM_CACHE_SZ]; /**< The output memories to be recycled */
+  guint out_mem_next; /**< The index of the cache to be replaced */
 } pose_data;
 
 /**
@@ -315,6 +333,19 @@ pose_get_metadata_by_id (pose_data * data, guint id)
   return &md[id];
 }
 
+/**
+ * @brief Release the output memory in the cache.
+ */
+static void
+pose_free_out_mem (pose_out_mem * entry)
+{
+  if (entry->mem) {
+    gst_memory_unlock (entry->mem, GST_LOCK_FLAG_EXCLUSIVE);
+    gst_memory_unref (entry->mem);
+    entry->mem = NULL;
+  }
+}
+
 /** @brief tensordec-plugin's TensorDecDef callback */
 static int
 pose_init (void **pdata)
@@ -348,9 +379,14 @@ pose_exit (void **pdata)
 {
   pose_data *data = *pdata;
 
+  guint i;
+
   if (data->metadata != pose_metadata_default)
     g_free (data->metadata);
 
+  for (i = 0; i < POSE_OUT_MEM_CACHE_SZ; i++)
+    pose_free_out_mem (&data->out_mems[i]);
+
   g_free (*pdata);
   *pdata = NULL;
 }
@@ -700,6 +736,86 @@ draw (GstMapInfo * out_info, pose_data * data, GArray * results)
   g_free (XYdata);
 }
 
+/**
+ * @brief Get the output memory and clear it.
+ * The memory drawn before is recycled if nobody else uses it, then only its dirty rows are cleared.
+ * The cache keeps an exclusive lock of the memory, so downstream elements writing the frame get a copy.
+ * @return The cache entry of the output memory, NULL if failed to allocate it.
+ */
+static pose_out_mem *
+pose_get_out_mem (pose_data * data, size_t size, GstMapInfo * out_info)
+{
+  pose_out_mem *entry = NULL;
+  gboolean recycled = FALSE;
+  guint i;
+
+  for (i = 0; i < POSE_OUT_MEM_CACHE_SZ; i++) {
+    GstMemory *mem = data->out_mems[i].mem;
+
+    /* only the cache refers the memory */
+    if (mem && gst_memory_get_sizes (mem, NULL, NULL) == size &&
+        GST_MINI_OBJECT_REFCOUNT_VALUE (mem) == 1) {
+      entry = &data->out_mems[i];
+      recycled = TRUE;
+      break;
+    }
+  }
+
+  if (entry == NULL) {
+    entry = &data->out_mems[data->out_mem_next];
+    data->out_mem_next = (data->out_mem_next + 1) % POSE_OUT_MEM_CACHE_SZ;
+
+    pose_free_out_mem (entry);
+    entry->mem = gst_allocator_alloc (NULL, size, NULL);
+    if (entry->mem == NULL)
+      return NULL;
+
+    gst_memory_lock (entry->mem, GST_LOCK_FLAG_EXCLUSIVE);
+  }
+
+  if (!gst_memory_map (entry->mem, out_info, GST_MAP_WRITE)) {
+    pose_free_out_mem (entry);
+    return NULL;
+  }
+
+  /** reset the buffer with alpha 0 / black */
+  if (recycled) {
+    memset (out_info->data + entry->dirty_offset, 0, entry->dirty_size);
+  } else {
+    memset (out_info->data, 0, size);
+  }
+
+  entry->dirty_offset = entry->dirty_size = 0;
+  return entry;
+}
+
+/**
+ * @brief Find the cell of the highest value for each keypoint.
+ * The heatmap is read once in memory order, the keypoints of a cell are contiguous.
+ */
+static void
+pose_find_max (const float *arr, guint num_cells, guint pose_size,
+    float init, float *max, guint * max_cell)
+{
+  guint cell, index;
+
+  for (index = 0; index < pose_size; index++) {
+    max[index] = init;
+    max_cell[index] = 0;
+  }
+
+  for (cell = 0; cell < num_cells; cell++) {
+    const float *cen = arr + (gsize) cell * pose_size;
+
+    for (index = 0; index < pose_size; index++) {
+      if (cen[index] > max[index]) {
+        max[index] = cen[index];
+        max_cell[index] = cell;
+      }
+    }
+  }
+}
+
 /** @brief tensordec-plugin's TensorDecDef callback */
 static GstFlowReturn
 pose_decode (void **pdata, const GstTensorsConfig * config,
@@ -709,30 +825,37 @@ pose_decode (void **pdata, const GstTensorsConfig * config,
   const size_t size = (size_t) data->width * data->height * 4;   /* RGBA */
   GstMapInfo out_info;
   GstMemory *out_mem;
+  pose_out_mem *entry = NULL;
   GArray *results = NULL;
   const GstTensorMemory *detections = NULL;
   float *arr;
-  int i, j;
+  float *max;
+  guint *max_cell;
   int grid_xsize, grid_ysize;
   guint pose_size, index;
 
   g_assert (outbuf); /** GST Internal Bug */
   /* Ensure we have outbuf properly allocated */
   if (gst_buffer_get_size (outbuf) == 0) {
-    out_mem = gst_allocator_alloc (NULL, size, NULL);
+    entry = pose_get_out_mem (data, size, &out_info);
+    if (entry == NULL) {
+      ml_loge ("Cannot get output memory / tensordec-pose.\n");
+      return GST_FLOW_ERROR;
+    }
+    out_mem = gst_memory_ref (entry->mem);
   } else {
     if (gst_buffer_get_size (outbuf) < size) {
       gst_buffer_set_size (outbuf, size);
     }
     out_mem = gst_buffer_get_all_memory (outbuf);
+    if (!gst_memory_map (out_mem, &out_info, GST_MAP_WRITE)) {
+      gst_memory_unref (out_mem);
+      ml_loge ("Cannot map output memory / tensordec-pose.\n");
+      return GST_FLOW_ERROR;
+    }
+    /** reset the buffer with alpha 0 / black */
+    memset (out_info.data, 0, size);
   }
-  if (!gst_memory_map (out_mem, &out_info, GST_MAP_WRITE)) {
-    gst_memory_unref (out_mem);
-    ml_loge ("Cannot map output memory / tensordec-pose.\n");
-    return GST_FLOW_ERROR;
-  }
-  /** reset the buffer with alpha 0 / black */
-  memset (out_info.data, 0, size);
 
   pose_size = data->total_labels;
 
@@ -742,31 +865,27 @@ pose_decode (void **pdata, const GstTensorsConfig * config,
   results = g_array_sized_new (FALSE, TRUE, sizeof (pose), pose_size);
   detections = &input[0];
   arr = detections->data;
+
+  /**
+   * Sigmoid is monotonic, find the max of the raw values and apply it to the winners only.
+   * The initial value is the raw value whose sigmoid is not larger than G_MINFLOAT.
+   */
+  max = g_new (float, pose_size);
+  max_cell = g_new (guint, pose_size);
+  pose_find_max (arr, grid_xsize * grid_ysize, pose_size,
+      (data->mode == HEATMAP_OFFSET) ? -G_MAXFLOAT : G_MINFLOAT, max, max_cell);
+
   for (index = 0; index < pose_size; index++) {
-    int maxX = 0;
-    int maxY = 0;
-    float max = G_MINFLOAT;
+    int maxX = max_cell[index] % grid_xsize;
+    int maxY = max_cell[index] / grid_xsize;
     pose p;
-    for (j = 0; j < grid_ysize; j++) {
-      for (i = 0; i < grid_xsize; i++) {
-        float cen = arr[i * pose_size + j * grid_xsize * pose_size + index];
-        if (data->mode == HEATMAP_OFFSET) {
-          cen = _sigmoid (cen);
-        }
-        if (cen > max) {
-          max = cen;
-          maxX = i;
-          maxY = j;
-        }
-      }
-    }
 
     p.valid = TRUE;
-    p.prob = max;
     if (data->mode == HEATMAP_OFFSET) {
       const gfloat *offset = ((const GstTensorMemory *) &input[1])->data;
       gfloat offsetX, offsetY, posX, posY;
       int offsetIdx;
+      p.prob = MAX (_sigmoid (max[index]), G_MINFLOAT);
       offsetIdx = (maxY * grid_xsize + maxX) * pose_size * 2 + index;
       offsetY = offset[offsetIdx];
       offsetX = offset[offsetIdx + pose_size];
@@ -776,6 +895,7 @@ pose_decode (void **pdata, const GstTensorsConfig * config,
       p.y = posY * data->height / data->i_height;
 
     } else {
+      p.prob = max[index];
       p.x = (maxX * data->width) / data->i_width;
       p.y = (maxY * data->height) / data->i_height;;
     }
@@ -786,7 +906,32 @@ pose_decode (void **pdata, const GstTensorsConfig * config,
     g_array_append_val (results, p);
   }
 
+  g_free (max);
+  g_free (max_cell);
+
   draw (&out_info, data, results);
+
+  if (entry) {
+    /* the rows of the labels, lines and dots around the valid keypoints */
+    guint start = data->height, end = 0;
+
+    for (index = 0; index < pose_size; index++) {
+      pose *p = &g_array_index (results, pose, index);
+
+      if (!p->valid)
+        continue;
+
+      start = MIN (start, (guint) MAX (0, p->y - 14));
+      end = MAX (end, (guint) MAX (MAX (0, p->y - 14) + 13, p->y + 5));
+    }
+
+    start = MIN (start, data->height);
+    end = MAX (start, MIN (end, data->height));
+
+    entry->dirty_offset = (gsize) start * data->width * 4;
+    entry->dirty_size = (gsize) (end - start) * data->width * 4;
+  }
+
   g_array_free (results, TRUE);
   gst_memory_unmap (out_mem, &out_info);
   if (gst_buffer_get_size (outbuf) == 0)
@@ -65,6 +65,21 @@
  *   end
  * end
  *
+ *   Accessing each element with input[i] calls C once per element.
+ * For the whole tensors, use the built-in functions running in C:
+ * "tensor_fill(t, value)", "tensor_copy(dst, src)",
+ * "tensor_map(dst, src, func)", "tensor_axpy(a, x, y)" (y = a * x + y),
+ * "tensor_argmax(t)" (returns the index and the value) and "tensor_sum(t)".
+ * "#t" is the number of elements of the tensor.
+ *
+ *   With LuaJIT (-Denable-luajit=true), "tensor_pointer(t)" returns
+ * the FFI pointer (index from 0) and the number of elements.
+ *   An Example:
+ *   ptr, num = tensor_pointer(output_tensor(1))
+ *   for i=0,num-1 do
+ *     ptr[i] = 255 - ptr[i]
+ *   end
+ *
  *   In "script mode", not "file mode", the script should NOT have
  * double quote ("), and double dashes ( -- COMMENT ) for comment.
  * Use single quote and --[[ COMMENT --]] format instead.
@@ -78,6 +93,7 @@ extern "C" {
 }
 
 #include <glib.h>
+#include <string.h>
 #include <string>
 #include <memory>
 #include <nnstreamer_cppplugin_api_filter.hh>
@@ -108,64 +124,165 @@ typedef struct lua_tensor {
   size_t size;
 } lua_tensor;
 
-/** @brief For getting value in Lua */
-static int
-tensor_index (lua_State *L)
+/** @brief Function to get an element of the tensor as a number */
+typedef double (*tensor_get_func) (const void *data, size_t idx);
+
+/** @brief Function to set an element of the tensor with a number */
+typedef void (*tensor_set_func) (void *data, size_t idx, double value);
+
+/** @brief Get an element of the tensor */
+template <typename T>
+static double
+tensor_get (const void *data, size_t idx)
 {
-  lua_tensor *lt = *((lua_tensor **) luaL_checkudata(L, 1, "lua_tensor"));
-  int tidx = luaL_checkint (L, 2) - 1;
+  return (double) ((const T *) data)[idx];
+}
 
-  uint element_size = gst_tensor_get_element_size (lt->type);
-  if (tidx < 0 || (size_t) tidx * element_size >= lt->size)
-    throw std::runtime_error ("Invalid index for tensor");
+/** @brief Set an element of the tensor */
+template <typename T>
+static void
+tensor_set (void *data, size_t idx, double value)
+{
+  ((T *) data)[idx] = (T) value;
+}
+
+/** @brief Set an element of the unsigned tensor, the value is converted to the signed type first */
+template <typename T, typename S>
+static void
+tensor_set_unsigned (void *data, size_t idx, double value)
+{
+  S temp = (S) value;
+  ((T *) data)[idx] = (T) temp;
+}
+
+/** @brief Throw an exception if float16 is not supported */
+static void
+check_float16_support (void)
+{
+#ifndef FLOAT16_SUPPORT
+  nns_loge
+      ("NNStreamer requires -DFLOAT16_SUPPORT as a build option to enable float16 type. This binary does not have float16 feature enabled; thus, float16 type is not supported in this instance.\n");
+  throw std::runtime_error ("Float16 not supported. Recompile with -DFLOAT16_SUPPORT.");
+#endif
+}
 
-  double value = 0.0;
-  switch (lt->type) {
+/** @brief Get the function to read the elements of the given type */
+static tensor_get_func
+get_tensor_getter (tensor_type type)
+{
+  switch (type) {
     case _NNS_INT32:
-      value = (double) ((int32_t *) lt->data)[tidx];
-      break;
+      return tensor_get<int32_t>;
     case _NNS_UINT32:
-      value = (double) ((uint32_t *) lt->data)[tidx];
-      break;
+      return tensor_get<uint32_t>;
     case _NNS_INT16:
-      value = (double) ((int16_t *) lt->data)[tidx];
-      break;
+      return tensor_get<int16_t>;
     case _NNS_UINT16:
-      value = (double) ((uint16_t *) lt->data)[tidx];
-      break;
+      return tensor_get<uint16_t>;
     case _NNS_INT8:
-      value = (double) ((int8_t *) lt->data)[tidx];
-      break;
+      return tensor_get<int8_t>;
     case _NNS_UINT8:
-      value = (double) ((uint8_t *) lt->data)[tidx];
-      break;
+      return tensor_get<uint8_t>;
     case _NNS_FLOAT64:
-      value = (double) ((double *) lt->data)[tidx];
-      break;
+      return tensor_get<double>;
     case _NNS_FLOAT32:
-      value = (double) ((float *) lt->data)[tidx];
-      break;
+      return tensor_get<float>;
     case _NNS_FLOAT16:
+      check_float16_support ();
 #ifdef FLOAT16_SUPPORT
-      value = (double) ((float16 *) lt->data)[tidx];
-#else
-      nns_loge
-          ("NNStreamer requires -DFLOAT16_SUPPORT as a build option to enable float16 type. This binary does not have float16 feature enabled; thus, float16 type is not supported in this instance.\n");
-      throw std::runtime_error ("Float16 not supported. Recompile with -DFLOAT16_SUPPORT.");
+      return tensor_get<float16>;
 #endif
       break;
     case _NNS_INT64:
-      value = (double) ((int64_t *) lt->data)[tidx];
-      break;
+      return tensor_get<int64_t>;
     case _NNS_UINT64:
-      value = (double) ((uint64_t *) lt->data)[tidx];
+      return tensor_get<uint64_t>;
+    default:
       break;
+  }
+
+  throw std::runtime_error ("Error occurred during get tensor value");
+}
+
+/** @brief Get the function to write the elements of the given type */
+static tensor_set_func
+get_tensor_setter (tensor_type type)
+{
+  switch (type) {
+    case _NNS_INT32:
+      return tensor_set<int32_t>;
+    case _NNS_UINT32:
+      return tensor_set_unsigned<uint32_t, int32_t>;
+    case _NNS_INT16:
+      return tensor_set<int16_t>;
+    case _NNS_UINT16:
+      return tensor_set_unsigned<uint16_t, int16_t>;
+    case _NNS_INT8:
+      return tensor_set<int8_t>;
+    case _NNS_UINT8:
+      return tensor_set_unsigned<uint8_t, int8_t>;
+    case _NNS_FLOAT64:
+      return tensor_set<double>;
+    case _NNS_FLOAT32:
+      return tensor_set<float>;
+    case _NNS_FLOAT16:
+      check_float16_support ();
+#ifdef FLOAT16_SUPPORT
+      return tensor_set<float16>;
+#endif
+      break;
+    case _NNS_INT64:
+      return tensor_set<int64_t>;
+    case _NNS_UINT64:
+      return tensor_set_unsigned<uint64_t, int64_t>;
     default:
-      throw std::runtime_error ("Error occurred during get tensor value");
       break;
   }
 
-  lua_pushnumber (L, value);
+  throw std::runtime_error ("Error occurred during set tensor value");
+}
+
+/** @brief Get the tensor at the given index of the Lua stack */
+static lua_tensor *
+check_tensor (lua_State *L, int idx)
+{
+  return *((lua_tensor **) luaL_checkudata (L, idx, "lua_tensor"));
+}
+
+/** @brief Get the number of elements in the tensor */
+static size_t
+get_num_elements (lua_tensor *lt)
+{
+  size_t element_size = gst_tensor_get_element_size (lt->type);
+
+  return (element_size > 0) ? lt->size / element_size : 0;
+}
+
+/** @brief Check the two tensors have the same number of elements */
+static size_t
+check_num_elements (lua_tensor *lt1, lua_tensor *lt2)
+{
+  size_t num = get_num_elements (lt1);
+
+  if (num != get_num_elements (lt2))
+    throw std::runtime_error ("The number of elements in the tensors does not match");
+
+  return num;
+}
+
+/** @brief For getting value in Lua */
+static int
+tensor_index (lua_State *L)
+{
+  lua_tensor *lt = check_tensor (L, 1);
+  int tidx = luaL_checkint (L, 2) - 1;
+  tensor_get_func get_value = get_tensor_getter (lt->type);
+
+  uint element_size = gst_tensor_get_element_size (lt->type);
+  if (tidx < 0 || (size_t) tidx * element_size >= lt->size)
+    throw std::runtime_error ("Invalid index for tensor");
+
+  lua_pushnumber (L, get_value (lt->data, tidx));
 
   return 1;
 }
@@ -174,73 +291,229 @@ tensor_index (lua_State *L)
 static int
 tensor_newindex (lua_State* L)
 {
-  lua_tensor *lt = *((lua_tensor **) luaL_checkudata (L, 1, "lua_tensor"));
+  lua_tensor *lt = check_tensor (L, 1);
   int tidx = luaL_checkint(L, 2) - 1;
   double value = luaL_checknumber (L, 3);
+  tensor_set_func set_value = get_tensor_setter (lt->type);
 
   uint element_size = gst_tensor_get_element_size (lt->type);
   if (tidx < 0 || (size_t) tidx * element_size >= lt->size)
     throw std::runtime_error ("Invalid index for tensor");
 
-  switch (lt->type) {
+  set_value (lt->data, tidx, value);
+
+  return 0;
+}
+
+/** @brief For getting the number of elements (#tensor) in Lua */
+static int
+tensor_len (lua_State *L)
+{
+  lua_tensor *lt = check_tensor (L, 1);
+
+  lua_pushinteger (L, (lua_Integer) get_num_elements (lt));
+
+  return 1;
+}
+
+/** @brief tensor_fill (t, value): Set all elements of the tensor with the value */
+static int
+tensor_fill (lua_State *L)
+{
+  lua_tensor *lt = check_tensor (L, 1);
+  double value = luaL_checknumber (L, 2);
+  tensor_set_func set_value = get_tensor_setter (lt->type);
+  size_t total = get_num_elements (lt) * gst_tensor_get_element_size (lt->type);
+  size_t filled;
+
+  if (total == 0)
+    return 0;
+
+  /* set the first element, then double the filled region */
+  set_value (lt->data, 0, value);
+  for (filled = gst_tensor_get_element_size (lt->type); filled < total; filled *= 2)
+    memcpy ((uint8_t *) lt->data + filled, lt->data, MIN (filled, total - filled));
+
+  return 0;
+}
+
+/** @brief tensor_copy (dst, src): Copy the elements of src to dst, converting the type if needed */
+static int
+tensor_copy (lua_State *L)
+{
+  lua_tensor *dst = check_tensor (L, 1);
+  lua_tensor *src = check_tensor (L, 2);
+  tensor_set_func set_value = get_tensor_setter (dst->type);
+  tensor_get_func get_value = get_tensor_getter (src->type);
+  size_t i, num = check_num_elements (dst, src);
+
+  if (dst->type == src->type) {
+    memmove (dst->data, src->data, num * gst_tensor_get_element_size (src->type));
+    return 0;
+  }
+
+  for (i = 0; i < num; i++)
+    set_value (dst->data, i, get_value (src->data, i));
+
+  return 0;
+}
+
+/** @brief tensor_map (dst, src, func): Set dst[i] = func (src[i]) for all elements */
+static int
+tensor_map (lua_State *L)
+{
+  lua_tensor *dst = check_tensor (L, 1);
+  lua_tensor *src = check_tensor (L, 2);
+  tensor_set_func set_value = get_tensor_setter (dst->type);
+  tensor_get_func get_value = get_tensor_getter (src->type);
+  size_t i, num = check_num_elements (dst, src);
+
+  luaL_checktype (L, 3, LUA_TFUNCTION);
+
+  for (i = 0; i < num; i++) {
+    lua_pushvalue (L, 3);
+    lua_pushnumber (L, get_value (src->data, i));
+    lua_call (L, 1, 1);
+    set_value (dst->data, i, luaL_checknumber (L, -1));
+    lua_pop (L, 1);
+  }
+
+  return 0;
+}
+
+/** @brief tensor_axpy (a, x, y): Set y[i] = a * x[i] + y[i] for all elements */
+static int
+tensor_axpy (lua_State *L)
+{
+  double a = luaL_checknumber (L, 1);
+  lua_tensor *x = check_tensor (L, 2);
+  lua_tensor *y = check_tensor (L, 3);
+  tensor_get_func get_x = get_tensor_getter (x->type);
+  tensor_get_func get_y = get_tensor_getter (y->type);
+  tensor_set_func set_y = get_tensor_setter (y->type);
+  size_t i, num = check_num_elements (x, y);
+
+  if (x->type == _NNS_FLOAT32 && y->type == _NNS_FLOAT32) {
+    const float *xf = (const float *) x->data;
+    float *yf = (float *) y->data;
+    float af = (float) a;
+
+    for (i = 0; i < num; i++)
+      yf[i] += af * xf[i];
+    return 0;
+  }
+
+  for (i = 0; i < num; i++)
+    set_y (y->data, i, a * get_x (x->data, i) + get_y (y->data, i));
+
+  return 0;
+}
+
+/** @brief tensor_argmax (t): Get the index (from 1) and the value of the largest element */
+static int
+tensor_argmax (lua_State *L)
+{
+  lua_tensor *lt = check_tensor (L, 1);
+  tensor_get_func get_value = get_tensor_getter (lt->type);
+  size_t i, max_idx = 0, num = get_num_elements (lt);
+  double value, max_value;
+
+  if (num == 0)
+    throw std::runtime_error ("Cannot find the largest element in an empty tensor");
+
+  max_value = get_value (lt->data, 0);
+  for (i = 1; i < num; i++) {
+    value = get_value (lt->data, i);
+    if (value > max_value) {
+      max_value = value;
+      max_idx = i;
+    }
+  }
+
+  lua_pushinteger (L, (lua_Integer) max_idx + 1);
+  lua_pushnumber (L, max_value);
+
+  return 2;
+}
+
+/** @brief tensor_sum (t): Get the sum of all elements */
+static int
+tensor_sum (lua_State *L)
+{
+  lua_tensor *lt = check_tensor (L, 1);
+  tensor_get_func get_value = get_tensor_getter (lt->type);
+  size_t i, num = get_num_elements (lt);
+  double sum = 0.0;
+
+  for (i = 0; i < num; i++)
+    sum += get_value (lt->data, i);
+
+  lua_pushnumber (L, sum);
+
+  return 1;
+}
+
+#ifdef LUAJIT_FFI_SUPPORT
+/**
+ * @brief Script to wrap tensor_pointer () with FFI.
+ * tensor_pointer (t) returns the cdata pointer (index from 0) and the number of elements.
+ */
+static const char *ffi_tensor_pointer_script = R""""(
+do
+  local ffi = require ('ffi')
+  local get_pointer = tensor_pointer
+  function tensor_pointer (t)
+    local ptr, ctype, num = get_pointer (t)
+    return ffi.cast (ctype, ptr), num
+  end
+end
+)"""";
+
+/** @brief Get the C type of the pointer to the elements */
+static const char *
+get_tensor_ctype (tensor_type type)
+{
+  switch (type) {
     case _NNS_INT32:
-      ((int32_t *) lt->data)[tidx] = (int32_t) value;
-      break;
+      return "int32_t *";
     case _NNS_UINT32:
-    {
-      int32_t temp = (int32_t) value;
-      ((uint32_t *) lt->data)[tidx] = (uint32_t) temp;
-      break;
-    }
+      return "uint32_t *";
     case _NNS_INT16:
-      ((int16_t *) lt->data)[tidx] = (int16_t) value;
-      break;
+      return "int16_t *";
     case _NNS_UINT16:
-    {
-      int16_t temp = (int16_t) value;
-      ((uint16_t *) lt->data)[tidx] = (uint16_t) temp;
-      break;
-    }
+      return "uint16_t *";
     case _NNS_INT8:
-      ((int8_t *) lt->data)[tidx] = (int8_t) value;
-      break;
+      return "int8_t *";
     case _NNS_UINT8:
-    {
-      int8_t temp = (int8_t) value;
-      ((uint8_t *) lt->data)[tidx] = (uint8_t) temp;
-      break;
-    }
+      return "uint8_t *";
     case _NNS_FLOAT64:
-      ((double *) lt->data)[tidx] = (uint8_t) value;
-      break;
+      return "double *";
     case _NNS_FLOAT32:
-      ((float *) lt->data)[tidx] = (float) value;
-      break;
-    case _NNS_FLOAT16:
-#ifdef FLOAT16_SUPPORT
-      ((float16 *) lt->data)[tidx] = (float16) value;
-#else
-      nns_loge
-          ("NNStreamer requires -DFLOAT16_SUPPORT as a build option to enable float16 type. This binary does not have float16 feature enabled; thus, float16 type is not supported in this instance.\n");
-      throw std::runtime_error ("Float16 not supported. Recompile with -DFLOAT16_SUPPORT.");
-#endif
-      break;
+      return "float *";
     case _NNS_INT64:
-      ((int64_t *) lt->data)[tidx] = (int64_t) value;
-      break;
+      return "int64_t *";
     case _NNS_UINT64:
-    {
-      int64_t temp = (int64_t) value;
-      ((uint64_t *) lt->data)[tidx] = (uint64_t) temp;
-      break;
-    }
+      return "uint64_t *";
     default:
-      throw std::runtime_error ("Error occurred during set tensor value");
       break;
   }
 
-  return 0;
+  throw std::runtime_error ("The tensor type is not supported with FFI");
+}
+
+/** @brief Get the raw pointer, its C type and the number of elements of the tensor */
+static int
+getTensorPointer (lua_State *L)
+{
+  lua_tensor *lt = check_tensor (L, 1);
+
+  lua_pushlightuserdata (L, lt->data);
+  lua_pushstring (L, get_tensor_ctype (lt->type));
+  lua_pushinteger (L, (lua_Integer) get_num_elements (lt));
+
+  return 3;
 }
+#endif /* LUAJIT_FFI_SUPPORT */
 
 /** @brief Expose C array to Lua */
 static int
@@ -293,6 +566,7 @@ create_tensor_type (lua_State *L)
   static const struct luaL_reg tensor[] = {
     {"__index", tensor_index},
     {"__newindex", tensor_newindex},
+    {"__len", tensor_len},
     {NULL, NULL}
   };
 
@@ -300,6 +574,22 @@ create_tensor_type (lua_State *L)
   luaL_openlib (L, NULL, tensor, 0);
   lua_register (L, "input_tensor", getInputTensor);
   lua_register (L, "output_tensor", getOutputTensor);
+
+  /* built-in functions processing the whole tensor */
+  lua_register (L, "tensor_fill", tensor_fill);
+  lua_register (L, "tensor_copy", tensor_copy);
+  lua_register (L, "tensor_map", tensor_map);
+  lua_register (L, "tensor_axpy", tensor_axpy);
+  lua_register (L, "tensor_argmax", tensor_argmax);
+  lua_register (L, "tensor_sum", tensor_sum);
+
+#ifdef LUAJIT_FFI_SUPPORT
+  lua_register (L, "tensor_pointer", getTensorPointer);
+  if (luaL_dostring (L, ffi_tensor_pointer_script) != 0) {
+    throw std::runtime_error (std::string ("Failed to load FFI. Error message: ") +
+        lua_tostring (L, -1));
+  }
+#endif
 }
 
 /** @brief lua subplugin class */
@@ -22,6 +22,11 @@
  * @bug     No known bugs except for NYI items
  *
  * This is the per-NN-framework plugin (OpenVino) for tensor_filter.
+ *
+ * The sub-plugin keeps a pool of infer requests. With the 'max-inflight'
+ * property of tensor_filter, the inputs are submitted to the idle requests
+ * without waiting for the previous results, and tensor_filter pushes the
+ * outputs in the order of the inputs.
  */
 
 #include <glib.h>
@@ -53,6 +58,11 @@ static const gchar *openvino_accl_support[]
     = { ACCL_NPU_MOVIDIUS_STR, /** ACCL for default and auto config */
         ACCL_NPU_STR, ACCL_CPU_STR, NULL };
 
+static const accl_hw openvino_hw_list[]
+    = { ACCL_NPU_MOVIDIUS, ACCL_NPU, ACCL_CPU };
+
+static gchar filter_subplugin_openvino[] = "openvino";
+
 std::map<accl_hw, std::string> TensorFilterOpenvino::_nnsAcclHwToOVDevMap = {
   { ACCL_CPU, "CPU" }, { ACCL_NPU, "MYRIAD" }, { ACCL_NPU_MOVIDIUS, "MYRIAD" },
 };
@@ -181,6 +191,8 @@ TensorFilterOpenvino::TensorFilterOpenvino (std::string pathModelXml, std::strin
   this->_outputsDataMap = (this->_networkCNN).getOutputsInfo ();
   this->_isLoaded = false;
   this->_hw = ACCL_NONE;
+  this->_numRequests = 0;
+  this->_numThreads = 0;
 }
 
 /**
@@ -189,7 +201,78 @@ TensorFilterOpenvino::TensorFilterOpenvino (std::string pathModelXml, std::strin
  */
 TensorFilterOpenvino::~TensorFilterOpenvino ()
 {
-  ;
+  std::unique_lock<std::mutex> lock (this->_requestLock);
+
+  /* wait for the infer requests running asynchronously */
+  this->_requestCond.wait (lock,
+      [this] { return this->_idleRequests.size () == this->_requestSlots.size (); });
+}
+
+/**
+ * @brief Parse the custom properties of tensor_filter
+ * @param custom the custom properties, e.g., 'NumRequests:4,ThroughputStreams:auto'
+ * @return 0 (TensorFilterOpenvino::RetSuccess) if OK, negative values if error
+ */
+int
+TensorFilterOpenvino::parseCustomProperties (const gchar *custom)
+{
+  gchar **options;
+  guint i, len;
+  int ret = RetSuccess;
+
+  if (this->_isLoaded) {
+    ml_loge ("Cannot change the options after the model is loaded.");
+    return RetEBusy;
+  }
+
+  if (custom == NULL)
+    return RetSuccess;
+
+  options = g_strsplit (custom, ",", -1);
+  len = g_strv_length (options);
+
+  for (i = 0; i < len && ret == RetSuccess; ++i) {
+    gchar **pair = g_strsplit (options[i], ":", -1);
+    gchar *endptr = NULL;
+    guint64 val;
+
+    if (g_strv_length (pair) > 1) {
+      g_strstrip (pair[0]);
+      g_strstrip (pair[1]);
+
+      if (g_ascii_strcasecmp (pair[0], "NumRequests") == 0
+          || g_ascii_strcasecmp (pair[0], "NumThreads") == 0) {
+        val = g_ascii_strtoull (pair[1], &endptr, 10);
+        if (pair[1][0] == '\0' || *endptr != '\0' || val > G_MAXINT) {
+          ml_loge ("Invalid value of %s (%s).", pair[0], pair[1]);
+          ret = RetEInval;
+        } else if (g_ascii_strcasecmp (pair[0], "NumRequests") == 0) {
+          this->_numRequests = (guint) val;
+        } else {
+          this->_numThreads = (guint) val;
+        }
+      } else if (g_ascii_strcasecmp (pair[0], "ThroughputStreams") == 0) {
+        if (g_ascii_strcasecmp (pair[1], "auto") == 0) {
+          this->_throughputStreams = CONFIG_VALUE (CPU_THROUGHPUT_AUTO);
+        } else {
+          val = g_ascii_strtoull (pair[1], &endptr, 10);
+          if (pair[1][0] == '\0' || *endptr != '\0' || val == 0 || val > G_MAXINT) {
+            ml_loge ("Invalid value of ThroughputStreams (%s).", pair[1]);
+            ret = RetEInval;
+          } else {
+            this->_throughputStreams = std::to_string (val);
+          }
+        }
+      } else {
+        ml_logw ("Unknown custom property of openvino (%s).", pair[0]);
+      }
+    }
+
+    g_strfreev (pair);
+  }
+
+  g_strfreev (options);
+  return ret;
 }
 
 /**
@@ -203,6 +286,8 @@ TensorFilterOpenvino::loadModel (accl_hw hw)
   std::string targetDevice;
   std::vector<std::string> strVector;
   std::vector<std::string>::iterator strVectorIter;
+  std::map<std::string, std::string> config;
+  guint numRequests;
 
   if (this->_isLoaded) {
     /** @todo Can OpenVino support to replace the loaded model with a new one? */
@@ -230,12 +315,58 @@ TensorFilterOpenvino::loadModel (accl_hw hw)
         _nnsAcclHwToOVDevMap[hw]);
   }
 #endif
-  /** @todo Catch the IE exception */
-  this->_executableNet
-      = this->_ieCore.LoadNetwork (this->_networkCNN, _nnsAcclHwToOVDevMap[hw]);
+  if (hw == ACCL_CPU) {
+    if (!this->_throughputStreams.empty ())
+      config[CONFIG_KEY (CPU_THROUGHPUT_STREAMS)] = this->_throughputStreams;
+    if (this->_numThreads > 0)
+      config[CONFIG_KEY (CPU_THREADS_NUM)] = std::to_string (this->_numThreads);
+  } else if (!this->_throughputStreams.empty () || this->_numThreads > 0) {
+    ml_logw ("ThroughputStreams and NumThreads are only for the CPU, ignored.");
+  }
+
+  try {
+    this->_executableNet = this->_ieCore.LoadNetwork (
+        this->_networkCNN, _nnsAcclHwToOVDevMap[hw], config);
+  } catch (const std::exception &e) {
+    ml_loge ("Failed to load the model onto the device: %s", e.what ());
+    return RetEInval;
+  }
+
+  numRequests = this->_numRequests;
+  if (numRequests == 0) {
+    try {
+      numRequests = this->_executableNet
+                        .GetMetric (METRIC_KEY (OPTIMAL_NUMBER_OF_INFER_REQUESTS))
+                        .as<unsigned int> ();
+    } catch (const std::exception &e) {
+      ml_logw ("Failed to get the optimal number of infer requests: %s", e.what ());
+    }
+    numRequests = MAX (numRequests, 1U);
+  }
+
+  try {
+    for (guint i = 0; i < numRequests; ++i) {
+      InferRequestSlot slot;
+
+      slot.request = this->_executableNet.CreateInferRequest ();
+      slot.request.SetCompletionCallback<InferCallback> (
+          [this, i] (InferenceEngine::InferRequest, InferenceEngine::StatusCode code) {
+            this->completeRequest (i, code);
+          });
+      slot.done_cb = nullptr;
+      slot.user_data = nullptr;
+      this->_requestSlots.push_back (slot);
+      this->_idleRequests.push (i);
+    }
+  } catch (const std::exception &e) {
+    ml_loge ("Failed to create the infer requests: %s", e.what ());
+    this->_requestSlots.clear ();
+    this->_idleRequests = std::queue<size_t> ();
+    return RetEInval;
+  }
+
   this->_hw = hw;
   this->_isLoaded = true;
-  this->_inferRequest = this->_executableNet.CreateInferRequest ();
 
   return RetSuccess;
 }
@@ -389,15 +520,17 @@ failed:
 }
 
 /**
- * @brief Do inference using Inference Engine of the OpenVino framework
+ * @brief Set the input and output tensors to the infer request
+ * @param request the infer request to run
  * @param prop property of tensor_filter instance
  * @param[in] input the array of input tensors
  * @param[out] output the array of output tensors
  * @return RetSuccess if OK. non-zero if error
  */
 int
-TensorFilterOpenvino::invoke (const GstTensorFilterProperties *prop,
-    const GstTensorMemory *input, GstTensorMemory *output)
+TensorFilterOpenvino::setBlobs (InferenceEngine::InferRequest &request,
+    const GstTensorFilterProperties *prop, const GstTensorMemory *input,
+    GstTensorMemory *output)
 {
   InferenceEngine::BlobMap inBlobMap;
   InferenceEngine::BlobMap outBlobMap;
@@ -415,7 +548,7 @@ TensorFilterOpenvino::invoke (const GstTensorFilterProperties *prop,
     }
     inBlobMap.insert (make_pair (std::string (info->name), blob));
   }
-  this->_inferRequest.SetInput (inBlobMap);
+  request.SetInput (inBlobMap);
 
   num_tensors = (prop->output_meta).num_tensors;
   for (i = 0; i < num_tensors; ++i) {
@@ -428,15 +561,146 @@ TensorFilterOpenvino::invoke (const GstTensorFilterProperties *prop,
       return RetEInval;
     }
   }
-  this->_inferRequest.SetOutput (outBlobMap);
-
-  this->_inferRequest.Infer ();
+  request.SetOutput (outBlobMap);
 
   return RetSuccess;
 }
 
+/**
+ * @brief Get an idle infer request from the pool, wait if all requests are running
+ * @return the index of the infer request
+ */
+size_t
+TensorFilterOpenvino::acquireRequest ()
+{
+  std::unique_lock<std::mutex> lock (this->_requestLock);
+  size_t idx;
+
+  this->_requestCond.wait (lock, [this] { return !this->_idleRequests.empty (); });
+  idx = this->_idleRequests.front ();
+  this->_idleRequests.pop ();
+
+  return idx;
+}
+
+/**
+ * @brief Return the infer request to the pool
+ * @param idx the index of the infer request
+ */
+void
+TensorFilterOpenvino::releaseRequest (size_t idx)
+{
+  std::lock_guard<std::mutex> lock (this->_requestLock);
+
+  this->_idleRequests.push (idx);
+  this->_requestCond.notify_all ();
+}
+
+/**
+ * @brief Notify the result of the asynchronous invoke and return the infer request to the pool
+ * @param idx the index of the infer request
+ * @param code the status of the infer request
+ */
+void
+TensorFilterOpenvino::completeRequest (size_t idx, InferenceEngine::StatusCode code)
+{
+  InferRequestSlot &slot = this->_requestSlots[idx];
+  GstTensorFilterInvokeDoneCallback done_cb = slot.done_cb;
+  void *user_data = slot.user_data;
+
+  slot.done_cb = nullptr;
+  slot.user_data = nullptr;
+
+  if (code != InferenceEngine::StatusCode::OK)
+    ml_loge ("Failed to run the infer request (status %d).", (int)code);
+
+  /* the request is started by invoke, no callback to notify */
+  if (done_cb == nullptr)
+    return;
+
+  done_cb ((code == InferenceEngine::StatusCode::OK) ? RetSuccess : RetEInval, user_data);
+  this->releaseRequest (idx);
+}
+
+/**
+ * @brief Do inference using Inference Engine of the OpenVino framework
+ * @param prop property of tensor_filter instance
+ * @param[in] input the array of input tensors
+ * @param[out] output the array of output tensors
+ * @return RetSuccess if OK. non-zero if error
+ */
+int
+TensorFilterOpenvino::invoke (const GstTensorFilterProperties *prop,
+    const GstTensorMemory *input, GstTensorMemory *output)
+{
+  size_t idx;
+  int ret;
+
+  if (!this->_isLoaded)
+    return RetEInval;
+
+  idx = this->acquireRequest ();
+
+  try {
+    InferenceEngine::InferRequest &request = this->_requestSlots[idx].request;
+
+    ret = this->setBlobs (request, prop, input, output);
+    if (ret == RetSuccess)
+      request.Infer ();
+  } catch (const std::exception &e) {
+    ml_loge ("Failed to run the infer request: %s", e.what ());
+    ret = RetEInval;
+  }
+
+  this->releaseRequest (idx);
+  return ret;
+}
+
+/**
+ * @brief Submit the input to an idle infer request and return without waiting for the result
+ * @param prop property of tensor_filter instance
+ * @param[in] input the array of input tensors
+ * @param[out] output the array of output tensors, valid until done_cb is called
+ * @param done_cb the callback called when the infer request is done
+ * @param user_data the data passed to done_cb
+ * @return RetSuccess if the input is submitted. non-zero if error, then done_cb is not called.
+ * @note This waits for an idle infer request if all requests are running.
+ */
+int
+TensorFilterOpenvino::invokeAsync (const GstTensorFilterProperties *prop,
+    const GstTensorMemory *input, GstTensorMemory *output,
+    GstTensorFilterInvokeDoneCallback done_cb, void *user_data)
+{
+  size_t idx;
+  int ret;
+
+  if (!this->_isLoaded || done_cb == nullptr)
+    return RetEInval;
+
+  idx = this->acquireRequest ();
+
+  try {
+    InferRequestSlot &slot = this->_requestSlots[idx];
+
+    ret = this->setBlobs (slot.request, prop, input, output);
+    if (ret == RetSuccess) {
+      slot.done_cb = done_cb;
+      slot.user_data = user_data;
+      slot.request.StartAsync ();
+      return RetSuccess;
+    }
+  } catch (const std::exception &e) {
+    ml_loge ("Failed to start the infer request: %s", e.what ());
+    ret = RetEInval;
+  }
+
+  this->releaseRequest (idx);
+  return ret;
+}
+
 /**
  * @brief The mandatory callback for GstTensorFilterFramework
+ * @param self the subplugin
  * @param prop property of tensor_filter instance
  * @param private_data TensorFilterOpenvino plugin's private data
  * @param[in] input the array of input tensors
@@ -444,49 +708,121 @@ TensorFilterOpenvino::invoke (const GstTensorFilterProperties *prop,
  * @return 0 if OK. non-zero if error
  */
 static int
-ov_invoke (const GstTensorFilterProperties *prop, void **private_data,
-    const GstTensorMemory *input, GstTensorMemory *output)
+ov_invoke (const GstTensorFilterFramework *self, const GstTensorFilterProperties *prop,
+    void *private_data, const GstTensorMemory *input, GstTensorMemory *output)
 {
-  TensorFilterOpenvino *tfOv = static_cast<TensorFilterOpenvino *> (*private_data);
+  UNUSED (self);
+  TensorFilterOpenvino *tfOv = static_cast<TensorFilterOpenvino *> (private_data);
+
+  g_return_val_if_fail (tfOv != nullptr, TensorFilterOpenvino::RetEInval);
 
   return tfOv->invoke (prop, input, output);
 }
 
 /**
- * @brief The optional callback for GstTensorFilterFramework
+ * @brief The optional callback for GstTensorFilterFramework, submit the input to an idle infer request
+ * @param self the subplugin
  * @param prop property of tensor_filter instance
  * @param private_data TensorFilterOpenvino plugin's private data
- * @param[out] info the dimesions and types of input tensors
- * @return 0 (TensorFilterOpenvino::RetSuccess) if OK, negative values if error
+ * @param[in] input the array of input tensors
+ * @param[out] output the array of output tensors
+ * @param done_cb the callback called when the infer request is done
+ * @param user_data the data passed to done_cb
+ * @return 0 if the input is submitted. non-zero if error
  */
 static int
-ov_getInputDim (const GstTensorFilterProperties *prop, void **private_data, GstTensorsInfo *info)
+ov_invoke_async (const GstTensorFilterFramework *self,
+    const GstTensorFilterProperties *prop, void *private_data,
+    const GstTensorMemory *input, GstTensorMemory *output,
+    GstTensorFilterInvokeDoneCallback done_cb, void *user_data)
 {
-  UNUSED (prop);
-  TensorFilterOpenvino *tfOv = static_cast<TensorFilterOpenvino *> (*private_data);
+  UNUSED (self);
+  TensorFilterOpenvino *tfOv = static_cast<TensorFilterOpenvino *> (private_data);
 
   g_return_val_if_fail (tfOv != nullptr, TensorFilterOpenvino::RetEInval);
 
-  return tfOv->getInputTensorDim (info);
+  return tfOv->invokeAsync (prop, input, output, done_cb, user_data);
 }
 
 /**
- * @brief The optional callback for GstTensorFilterFramework
+ * @brief The mandatory callback for GstTensorFilterFramework
+ * @param self the subplugin
+ * @param prop property of tensor_filter instance
+ * @param private_data TensorFilterOpenvino plugin's private data
+ * @param[out] info the information of the framework
+ * @return 0 if OK. non-zero if error
+ */
+static int
+ov_getFrameworkInfo (const GstTensorFilterFramework *self,
+    const GstTensorFilterProperties *prop, void *private_data,
+    GstTensorFilterFrameworkInfo *info)
+{
+  UNUSED (self);
+  UNUSED (prop);
+  UNUSED (private_data);
+
+  info->name = filter_subplugin_openvino;
+  info->allow_in_place = FALSE;
+  info->allocate_in_invoke = FALSE;
+  info->run_without_model = FALSE;
+  info->verify_model_path = FALSE;
+  info->hw_list = openvino_hw_list;
+  info->num_hw = G_N_ELEMENTS (openvino_hw_list);
+  info->accl_auto = ACCL_NPU_MOVIDIUS;
+  info->accl_default = ACCL_NPU_MOVIDIUS;
+  info->statistics = nullptr;
+
+  return 0;
+}
+
+/**
+ * @brief The mandatory callback for GstTensorFilterFramework
+ * @param self the subplugin
  * @param prop property of tensor_filter instance
  * @param private_data TensorFilterOpenvino plugin's private data
- * @param[out] info The dimesions and types of output tensors
+ * @param ops the operation to get the information of the model
+ * @param[out] in_info the dimesions and types of input tensors
+ * @param[out] out_info the dimesions and types of output tensors
  * @return 0 (TensorFilterOpenvino::RetSuccess) if OK, negative values if error
  */
 static int
-ov_getOutputDim (const GstTensorFilterProperties *prop, void **private_data,
-    GstTensorsInfo *info)
+ov_getModelInfo (const GstTensorFilterFramework *self,
+    const GstTensorFilterProperties *prop, void *private_data,
+    model_info_ops ops, GstTensorsInfo *in_info, GstTensorsInfo *out_info)
 {
+  UNUSED (self);
   UNUSED (prop);
-  TensorFilterOpenvino *tfOv = static_cast<TensorFilterOpenvino *> (*private_data);
+  TensorFilterOpenvino *tfOv = static_cast<TensorFilterOpenvino *> (private_data);
+  int ret;
 
   g_return_val_if_fail (tfOv != nullptr, TensorFilterOpenvino::RetEInval);
 
-  return tfOv->getOutputTensorDim (info);
+  if (ops != GET_IN_OUT_INFO)
+    return -ENOENT;
+
+  ret = tfOv->getInputTensorDim (in_info);
+  if (ret != TensorFilterOpenvino::RetSuccess)
+    return ret;
+
+  return tfOv->getOutputTensorDim (out_info);
+}
+
+/**
+ * @brief The mandatory callback for GstTensorFilterFramework
+ * @return -ENOENT, no events are supported.
+ */
+static int
+ov_eventHandler (const GstTensorFilterFramework *self,
+    const GstTensorFilterProperties *prop, void *private_data, event_ops ops,
+    GstTensorFilterFrameworkEventData *data)
+{
+  UNUSED (self);
+  UNUSED (prop);
+  UNUSED (private_data);
+  UNUSED (ops);
+  UNUSED (data);
+
+  return -ENOENT;
 }
 
 /**
@@ -516,8 +852,12 @@ ov_open (const GstTensorFilterProperties *prop, void **private_data)
   guint num_models_bin = 0;
   TensorFilterOpenvino *tfOv;
   accl_hw accelerator;
+  int ret;
 
-  accelerator = parse_accl_hw (prop->accl_str, openvino_accl_support, NULL, NULL);
+  if (prop->num_hw > 0 && prop->hw_list != NULL)
+    accelerator = prop->hw_list[0];
+  else
+    accelerator = parse_accl_hw (prop->accl_str, openvino_accl_support, NULL, NULL);
 #ifndef __OPENVINO_CPU_EXT__
   if (accelerator == ACCL_CPU) {
     ml_loge ("Accelerating via CPU is not supported on the current platform");
@@ -594,44 +934,23 @@ ov_open (const GstTensorFilterProperties *prop, void **private_data)
   tfOv = new TensorFilterOpenvino (model_path_xml, model_path_bin);
   *private_data = tfOv;
 
-  return tfOv->loadModel (accelerator);
-}
-
-/**
- * @brief The optional callback for GstTensorFilterFramework
- * @param[in] hw backend accelerator hardware
- * @return 0 if supported. -errno if not supported.
- */
-static int
-ov_checkAvailability (accl_hw hw)
-{
-  if (g_strv_contains (openvino_accl_support, get_accl_hw_str (hw)))
-    return 0;
+  ret = tfOv->parseCustomProperties (prop->custom_properties);
+  if (ret != TensorFilterOpenvino::RetSuccess)
+    return ret;
 
-  return -ENOENT;
+  return tfOv->loadModel (accelerator);
 }
 
-static gchar filter_subplugin_openvino[] = "openvino";
-
-static GstTensorFilterFramework NNS_support_openvino = {.version = GST_TENSOR_FILTER_FRAMEWORK_V0,
+static GstTensorFilterFramework NNS_support_openvino = {.version = GST_TENSOR_FILTER_FRAMEWORK_V1,
   .open = ov_open,
   .close = ov_close,
-  {.v0 = {
-       .name = filter_subplugin_openvino,
-       .allow_in_place = FALSE,
-       .allocate_in_invoke = FALSE,
-       .run_without_model = FALSE,
-       .verify_model_path = FALSE,
-       .statistics = nullptr,
-       .invoke_NN = ov_invoke,
-       .getInputDimension = ov_getInputDim,
-       .getOutputDimension = ov_getOutputDim,
-       .setInputDimension = nullptr,
-       .destroyNotify = nullptr,
-       .reloadModel = nullptr,
-       .handleEvent = nullptr,
-       .checkAvailability = ov_checkAvailability,
-       .allocateInInvoke = nullptr,
+  {.v1 = {
+       .invoke = ov_invoke,
+       .getFrameworkInfo = ov_getFrameworkInfo,
+       .getModelInfo = ov_getModelInfo,
+       .eventHandler = ov_eventHandler,
+       .subplugin_data = nullptr,
+       .invoke_async = ov_invoke_async,
    } } };
 
 /**
@@ -649,5 +968,5 @@ init_filter_openvino (void)
 void
 fini_filter_openvino (void)
 {
-  nnstreamer_filter_exit (NNS_support_openvino.v0.name);
+  nnstreamer_filter_exit (filter_subplugin_openvino);
 }
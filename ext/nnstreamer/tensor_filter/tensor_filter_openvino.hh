@@ -40,7 +40,11 @@
 #include <ext_list.hpp>
 #endif /* __OPENVINO_CPU_EXT__ */
 #include <inference_engine.hpp>
+#include <condition_variable>
+#include <functional>
 #include <iostream>
+#include <mutex>
+#include <queue>
 #include <string>
 #include <vector>
 
@@ -66,6 +70,7 @@ public:
   TensorFilterOpenvino (std::string path_model_xml, std::string path_model_bin);
   ~TensorFilterOpenvino ();
 
+  int parseCustomProperties (const gchar * custom);
   /** @todo Need to support other acceleration devices */
   int loadModel (accl_hw hw);
   bool isModelLoaded () {
@@ -76,6 +81,12 @@ public:
   int getOutputTensorDim (GstTensorsInfo * info);
   int invoke (const GstTensorFilterProperties * prop,
       const GstTensorMemory * input, GstTensorMemory * output);
+  int invokeAsync (const GstTensorFilterProperties * prop,
+      const GstTensorMemory * input, GstTensorMemory * output,
+      GstTensorFilterInvokeDoneCallback done_cb, void *user_data);
+  guint getNumRequests () {
+    return (guint) _requestSlots.size ();
+  }
   std::string getPathModelXml ();
   void setPathModelXml (std::string pathXml);
   std::string getPathModelBin ();
@@ -89,7 +100,26 @@ protected:
   InferenceEngine::OutputsDataMap _outputsDataMap;
 
 private:
+  /**
+   * @brief An infer request in the pool and the callback of the asynchronous invoke running on it
+   */
+  typedef struct
+  {
+    InferenceEngine::InferRequest request;
+    GstTensorFilterInvokeDoneCallback done_cb;
+    void *user_data;
+  } InferRequestSlot;
+
+  typedef std::function<void (InferenceEngine::InferRequest,
+      InferenceEngine::StatusCode)> InferCallback;
+
   TensorFilterOpenvino ();
+  int setBlobs (InferenceEngine::InferRequest & request,
+      const GstTensorFilterProperties * prop,
+      const GstTensorMemory * input, GstTensorMemory * output);
+  size_t acquireRequest ();
+  void releaseRequest (size_t idx);
+  void completeRequest (size_t idx, InferenceEngine::StatusCode code);
 
   InferenceEngine::Core _ieCore;
   InferenceEngine::CNNNetReader _networkReaderCNN;
@@ -97,13 +127,19 @@ private:
   InferenceEngine::TensorDesc _inputTensorDescs[NNS_TENSOR_SIZE_LIMIT];
   InferenceEngine::TensorDesc _outputTensorDescs[NNS_TENSOR_SIZE_LIMIT];
   InferenceEngine::ExecutableNetwork _executableNet;
-  InferenceEngine::InferRequest _inferRequest;
+  std::vector<InferRequestSlot> _requestSlots;
+  std::queue<size_t> _idleRequests;
+  std::mutex _requestLock;
+  std::condition_variable _requestCond;
   static std::map<accl_hw, std::string> _nnsAcclHwToOVDevMap;
 
   std::string _pathModelXml;
   std::string _pathModelBin;
   bool _isLoaded;
   accl_hw _hw;
+  guint _numRequests; /**< the number of infer requests, 0 to use the optimal number of the device */
+  guint _numThreads; /**< the number of CPU threads, 0 to use the default of the device */
+  std::string _throughputStreams; /**< the number of CPU throughput streams or 'auto' */
 };
 
 #endif /* __TENSOR_FILTER_OPENVINO_H__ */
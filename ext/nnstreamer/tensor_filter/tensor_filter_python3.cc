@@ -95,6 +95,12 @@ class PYCore
 
   void freeOutputTensors (void *data);
 
+  /** @brief Return whether the script writes the outputs in preallocated memory */
+  bool isInvokeInto ()
+  {
+    return invoke_into;
+  }
+
   /** @brief Return callback type */
   cb_type getCbType ()
   {
@@ -116,6 +122,17 @@ class PYCore
   PyObject *core_obj;
   PyObject *shape_cls;
 
+  bool shaped; /**< True to pass N-D arrays with the tensor shape (shaped_tensors attribute of the script) */
+  bool invoke_into; /**< True if the script writes the outputs in preallocated memory (invoke_into method) */
+  PyObject *invoke_name; /**< name of the method to invoke */
+  PyObject *invoke_func; /**< bound method to invoke */
+  PyObject *invoke_args; /**< argument tuple, reused if the script does not keep it */
+  PyObject *input_list; /**< list of input arrays, reused if the script does not keep it */
+  PyObject *output_list; /**< list of output arrays (invoke_into), reused if the script does not keep it */
+
+  PyObject *newArray (const GstTensorInfo *info, void *data, size_t size, bool writable);
+  PyObject *prepareList (PyObject **list, unsigned int num);
+
   GstTensorsInfo inputTensorMeta; /**< The tensor info of input tensors */
   GstTensorsInfo outputTensorMeta; /**< The tensor info of output tensors */
 
@@ -170,6 +187,14 @@ PYCore::PYCore (const char *_script_path, const char *_custom)
   configured = false;
   shape_cls = NULL;
 
+  shaped = false;
+  invoke_into = false;
+  invoke_name = NULL;
+  invoke_func = NULL;
+  invoke_args = NULL;
+  input_list = NULL;
+  output_list = NULL;
+
 }
 
 /**
@@ -182,6 +207,11 @@ PYCore::~PYCore ()
   gst_tensors_info_free (&outputTensorMeta);
 
   PyGILState_STATE gstate = Py_LOCK ();
+  Py_SAFEDECREF (invoke_args);
+  Py_SAFEDECREF (input_list);
+  Py_SAFEDECREF (output_list);
+  Py_SAFEDECREF (invoke_func);
+  Py_SAFEDECREF (invoke_name);
   Py_SAFEDECREF (core_obj);
   Py_SAFEDECREF (shape_cls);
 
@@ -292,6 +322,23 @@ PYCore::loadScript ()
           callback_type = CB_GETDIM;
         else
           callback_type = CB_END;
+
+        /** optional features of the script */
+        PyObject *attr = PyObject_GetAttrString (core_obj, "shaped_tensors");
+        if (attr) {
+          shaped = PyObject_IsTrue (attr) == 1;
+          Py_SAFEDECREF (attr);
+        }
+        PyErr_Clear ();
+
+        invoke_into = PyObject_HasAttrString (core_obj, "invoke_into");
+        invoke_name = PyUnicode_InternFromString (invoke_into ? "invoke_into" : "invoke");
+        invoke_func = PyObject_GetAttr (core_obj, invoke_name);
+        if (invoke_func == NULL) {
+          Py_ERRMSG ("Cannot find 'invoke' method in the script\n");
+          ret = -2;
+          goto exit;
+        }
       } else {
         Py_ERRMSG ("Fail to create an instance 'CustomFilter'\n");
         ret = -3;
@@ -515,6 +562,52 @@ PYCore::freeOutputTensors (void *data)
   Py_UNLOCK (gstate);
 }
 
+/**
+ * @brief	create a numpy array wrapping the tensor data (without copy).
+ * @param info : tensor info
+ * @param data : tensor data
+ * @param size : tensor size
+ * @param writable : false to create a read-only array
+ * @return new reference of numpy array, NULL if failed.
+ */
+PyObject *
+PYCore::newArray (const GstTensorInfo *info, void *data, size_t size, bool writable)
+{
+  npy_intp dims[NNS_TENSOR_RANK_LIMIT];
+  int nd = 0;
+
+  if (shaped) {
+    /** numpy shape is in the reverse order of tensor dimension */
+    nd = (int) gst_tensor_info_get_rank (info);
+
+    for (int i = 0; i < nd; i++)
+      dims[i] = (npy_intp) info->dimension[nd - 1 - i];
+  } else {
+    dims[0] = (npy_intp) (size / gst_tensor_get_element_size (info->type));
+    nd = 1;
+  }
+
+  return PyArray_New (&PyArray_Type, nd, dims, getNumpyType (info->type), NULL,
+      data, 0, writable ? NPY_ARRAY_CARRAY : NPY_ARRAY_CARRAY_RO, NULL);
+}
+
+/**
+ * @brief	get the list object to pass the arrays, reuse it if the script does not keep it.
+ * @param list : the list object to be reused
+ * @param num : the number of items
+ * @return borrowed reference of the list
+ */
+PyObject *
+PYCore::prepareList (PyObject **list, unsigned int num)
+{
+  if (*list == NULL || Py_REFCNT (*list) > 1 || (unsigned int) PyList_GET_SIZE (*list) != num) {
+    Py_SAFEDECREF (*list);
+    *list = PyList_New (num);
+  }
+
+  return *list;
+}
+
 /**
  * @brief	run the script with the input.
  * @param[in] input : The array of input tensors
@@ -528,6 +621,7 @@ PYCore::run (const GstTensorMemory *input, GstTensorMemory *output)
 {
   int res = 0;
   PyObject *result;
+  PyObject *in_list, *out_list = NULL;
 
 #if (DBG)
   gint64 start_time = g_get_real_time ();
@@ -538,54 +632,112 @@ PYCore::run (const GstTensorMemory *input, GstTensorMemory *output)
 
   PyGILState_STATE gstate = Py_LOCK ();
 
-  PyObject *param = PyList_New (inputTensorMeta.num_tensors);
-  for (unsigned int i = 0; i < inputTensorMeta.num_tensors; i++) {
-    /** create a Numpy array wrapper (1-D) for NNS tensor data */
-    tensor_type nns_type = inputTensorMeta.info[i].type;
-    npy_intp input_dims[]
-        = { (npy_intp) (input[i].size / gst_tensor_get_element_size (nns_type)) };
-    PyObject *input_array = PyArray_SimpleNewFromData (
-        1, input_dims, getNumpyType (nns_type), input[i].data);
-    PyList_SetItem (param, i, input_array);
+  in_list = prepareList (&input_list, inputTensorMeta.num_tensors);
+  if (in_list == NULL) {
+    Py_ERRMSG ("Failed to create the list of input tensors");
+    res = -1;
+    goto exit;
   }
 
+  for (unsigned int i = 0; i < inputTensorMeta.num_tensors; i++) {
+    /** create a Numpy array wrapper for NNS tensor data, read-only if shaped */
+    PyObject *input_array = newArray (&inputTensorMeta.info[i], input[i].data,
+        input[i].size, !shaped);
+    if (input_array == NULL) {
+      Py_ERRMSG ("Failed to create the array of input tensor");
+      res = -1;
+      goto exit;
+    }
 
-  result
-      = PyObject_CallMethod (core_obj, (char *)"invoke", (char *)"(O)", param);
+    PyList_SetItem (in_list, i, input_array);
+  }
 
-  if (result) {
-    if ((unsigned int)PyList_Size (result) != outputTensorMeta.num_tensors) {
-      res = -EINVAL;
-      ml_logf ("The Python allocated size mismatched. Cannot proceed.\n");
-      Py_SAFEDECREF (result);
-      goto exit_decref;
+  if (invoke_into) {
+    /** the script writes the outputs in the memory allocated by tensor_filter */
+    out_list = prepareList (&output_list, outputTensorMeta.num_tensors);
+    if (out_list == NULL) {
+      Py_ERRMSG ("Failed to create the list of output tensors");
+      res = -1;
+      goto exit;
     }
 
     for (unsigned int i = 0; i < outputTensorMeta.num_tensors; i++) {
-      PyArrayObject *output_array
-          = (PyArrayObject *)PyList_GetItem (result, (Py_ssize_t)i);
-      /** type/size checking */
-      if (checkTensorType (outputTensorMeta.info[i].type, PyArray_TYPE (output_array))
-          && checkTensorSize (&output[i], output_array)) {
-        /** obtain the pointer to the buffer for the output array */
-        output[i].data = PyArray_DATA (output_array);
-        Py_XINCREF (output_array);
-        outputArrayMap.insert (std::make_pair (output[i].data, output_array));
-      } else {
-        ml_loge ("Output tensor type/size is not matched\n");
-        res = -2;
-        break;
+      PyObject *output_array = newArray (&outputTensorMeta.info[i],
+          output[i].data, output[i].size, true);
+      if (output_array == NULL) {
+        Py_ERRMSG ("Failed to create the array of output tensor");
+        res = -1;
+        goto exit;
       }
+
+      PyList_SetItem (out_list, i, output_array);
     }
+  }
 
-    Py_SAFEDECREF (result);
-  } else {
+#if PY_VERSION_HEX >= 0x03090000
+  {
+    PyObject *call_args[] = { core_obj, in_list, out_list };
+    size_t nargs = invoke_into ? 3 : 2;
+
+    result = PyObject_VectorcallMethod (invoke_name, call_args, nargs, NULL);
+  }
+#else
+  if (invoke_args == NULL || Py_REFCNT (invoke_args) > 1) {
+    Py_SAFEDECREF (invoke_args);
+    invoke_args = PyTuple_New (invoke_into ? 2 : 1);
+  }
+
+  Py_INCREF (in_list);
+  PyTuple_SetItem (invoke_args, 0, in_list);
+  if (invoke_into) {
+    Py_INCREF (out_list);
+    PyTuple_SetItem (invoke_args, 1, out_list);
+  }
+
+  result = PyObject_Call (invoke_func, invoke_args, NULL);
+#endif
+
+  if (result == NULL) {
     Py_ERRMSG ("Fail to call 'invoke'");
     res = -1;
+    goto exit;
   }
 
-exit_decref:
-  Py_SAFEDECREF (param);
+  if (invoke_into) {
+    /** the outputs are already written, ignore the return value */
+    Py_SAFEDECREF (result);
+    goto exit;
+  }
+
+  if (!PyList_Check (result)
+      || (unsigned int)PyList_Size (result) != outputTensorMeta.num_tensors) {
+    res = -EINVAL;
+    ml_logf ("The Python allocated size mismatched. Cannot proceed.\n");
+    Py_SAFEDECREF (result);
+    goto exit;
+  }
+
+  for (unsigned int i = 0; i < outputTensorMeta.num_tensors; i++) {
+    PyArrayObject *output_array
+        = (PyArrayObject *)PyList_GetItem (result, (Py_ssize_t)i);
+    /** type/size checking */
+    if (checkTensorType (outputTensorMeta.info[i].type, PyArray_TYPE (output_array))
+        && checkTensorSize (&output[i], output_array)) {
+      /** the array may be a view of other array, make it contiguous */
+      output_array = PyArray_GETCONTIGUOUS (output_array);
+      /** obtain the pointer to the buffer for the output array */
+      output[i].data = PyArray_DATA (output_array);
+      outputArrayMap.insert (std::make_pair (output[i].data, output_array));
+    } else {
+      ml_loge ("Output tensor type/size is not matched\n");
+      res = -2;
+      break;
+    }
+  }
+
+  Py_SAFEDECREF (result);
+
+exit:
   Py_UNLOCK (gstate);
 
 #if (DBG)
@@ -632,6 +784,22 @@ py_destroyNotify (void **private_data, void *data)
   }
 }
 
+/**
+ * @brief The optional callback for GstTensorFilterFramework
+ * @param private_data : python plugin's private data
+ * @return 0 if the script allocates the outputs, -ENOENT if the outputs are written in preallocated memory (invoke_into).
+ */
+static int
+py_allocateInInvoke (void **private_data)
+{
+  PYCore *core = static_cast<PYCore *> (*private_data);
+
+  if (core && !core->isInvokeInto ())
+    return 0;
+
+  return -ENOENT;
+}
+
 /**
  * @brief The optional callback for GstTensorFilterFramework
  * @param[in] prop read-only property values
@@ -822,7 +990,7 @@ static GstTensorFilterFramework NNS_support_python = {.version = GST_TENSOR_FILT
        .reloadModel = nullptr,
        .handleEvent = nullptr,
        .checkAvailability = py_checkAvailability,
-       .allocateInInvoke = nullptr,
+       .allocateInInvoke = py_allocateInInvoke,
    } } };
 
 static PyThreadState *st;
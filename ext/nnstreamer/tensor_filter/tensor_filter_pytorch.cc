@@ -35,6 +35,9 @@
 #include <nnstreamer_conf.h>
 #include <nnstreamer_util.h>
 
+#include <mutex>
+#include <unordered_map>
+
 #include <torch/script.h>
 /**
   * Array.h and reverse_iterator.h of PyTorch is GPL-3.0 w/ GCC runtime
@@ -56,6 +59,14 @@
 
 static const gchar *torch_accl_support[] = { ACCL_CPU_STR, ACCL_GPU_STR, NULL };
 
+/**
+ * @brief Output tensors handed to tensor_filter without memcpy, kept until destroyNotify.
+ * @details This is shared by all instances, so that the output memory is valid
+ * even if the model is closed before the buffers are released.
+ */
+static std::unordered_multimap<void *, at::Tensor> torch_outputs;
+static std::mutex torch_outputs_lock;
+
 /**
  * @brief	ring cache structure
  */
@@ -84,10 +95,14 @@ class TorchCore
 
   std::shared_ptr<torch::jit::script::Module> model;
 
+  const GstTensorMemory *invoke_input; /**< input tensors of the current invoke */
+  std::vector<at::Tensor> invoke_output; /**< output tensors of the current invoke */
+
   void setAccelerator (const char *accelerators);
   tensor_type getTensorTypeFromTorch (torch::Dtype torchType);
   bool getTensorTypeToTorch (tensor_type tensorType, torch::Dtype *torchType);
   int validateOutputTensor (at::Tensor output, unsigned int idx);
+  bool isInputData (const at::Tensor &tensor);
   int fillTensorDim (torch::autograd::Variable tensor_meta, tensor_dim dim);
   int processIValue (const torch::jit::IValue &value, GstTensorMemory *output,
       unsigned int idx);
@@ -114,6 +129,7 @@ TorchCore::TorchCore (const char *_model_path)
   use_gpu = false;
   first_run = true;
   accelerator = ACCL_NONE;
+  invoke_input = nullptr;
 
   gst_tensors_info_init (&inputTensorMeta);
   gst_tensors_info_init (&outputTensorMeta);
@@ -403,6 +419,26 @@ TorchCore::getOutputTensorDim (GstTensorsInfo *info)
   return 0;
 }
 
+/**
+ * @brief	check if the tensor refers to the memory of input tensors.
+ * @param[in] tensor the output tensor
+ * @return true if the data of the tensor is in one of input tensors.
+ */
+bool
+TorchCore::isInputData (const at::Tensor &tensor)
+{
+  const char *data = static_cast<const char *> (tensor.data_ptr ());
+
+  for (uint i = 0; i < inputTensorMeta.num_tensors; ++i) {
+    const char *in_data = static_cast<const char *> (invoke_input[i].data);
+
+    if (data >= in_data && data < in_data + invoke_input[i].size)
+      return true;
+  }
+
+  return false;
+}
+
 /**
  * @brief	process the IValue after forward and extract data from ivalue.
  * @param[in] value IValue containing the output in tensor form
@@ -432,8 +468,17 @@ TorchCore::processIValue (
     return -1;
   }
 
-  /** @todo avoid this memcpy */
-  std::memcpy (output[idx].data, output_tensor.data_ptr (), output_tensor.nbytes ());
+  /**
+   * The input memory is released by tensor_filter after invoke.
+   * If the model returns the input (or a view of it), copy the output.
+   */
+  if (isInputData (output_tensor)) {
+    output_tensor = output_tensor.clone ();
+  }
+
+  /** pass the memory of libtorch without memcpy, released in destroyNotify */
+  output[idx].data = output_tensor.data_ptr ();
+  invoke_output.push_back (output_tensor);
   return 0;
 }
 
@@ -513,6 +558,10 @@ TorchCore::invoke (const GstTensorFilterProperties *prop, const GstTensorMemory
   torch::Dtype type;
   at::Tensor tensor;
 
+  invoke_input = input;
+  invoke_output.clear ();
+  input_feeds.reserve (inputTensorMeta.num_tensors);
+
   /** @todo Support other input types other than at::Tensor */
   for (uint i = 0; i < inputTensorMeta.num_tensors; ++i) {
     std::vector<int64_t> input_shape;
@@ -526,6 +575,7 @@ TorchCore::invoke (const GstTensorFilterProperties *prop, const GstTensorMemory
     at::TensorOptions options = torch::TensorOptions ().dtype (type);
     input_shape.resize(prop->input_ranks[i]);
     std::reverse (input_shape.begin (), input_shape.end ());
+    /** the input memory is contiguous, wrap it without copy */
     tensor = torch::from_blob (input[i].data, input_shape, options);
 
     if (use_gpu) {
@@ -562,9 +612,19 @@ TorchCore::invoke (const GstTensorFilterProperties *prop, const GstTensorMemory
   if (retval) {
     ml_loge ("Error %d: failed to serialize the output of the model at index %d.",
         retval, idx);
+    invoke_output.clear ();
     return retval;
   }
 
+  /** keep the output tensors until tensor_filter releases the memory */
+  {
+    std::lock_guard<std::mutex> lock (torch_outputs_lock);
+
+    for (auto &out : invoke_output)
+      torch_outputs.emplace (out.data_ptr (), out);
+  }
+  invoke_output.clear ();
+
 #if (DBG)
   gint64 stop_time = g_get_real_time ();
   g_message ("Invoke() is finished: %" G_GINT64_FORMAT, (stop_time - start_time));
@@ -723,6 +783,22 @@ torch_getOutputDim (const GstTensorFilterProperties *prop, void **private_data,
   return core->getOutputTensorDim (info);
 }
 
+/**
+ * @brief The optional callback for GstTensorFilterFramework
+ * @param private_data : pytorch plugin's private data
+ * @param data : The data element.
+ */
+static void
+torch_destroyNotify (void **private_data, void *data)
+{
+  std::lock_guard<std::mutex> lock (torch_outputs_lock);
+  auto it = torch_outputs.find (data);
+  UNUSED (private_data);
+
+  if (it != torch_outputs.end ())
+    torch_outputs.erase (it);
+}
+
 /**
  * @brief The optional callback for GstTensorFilterFramework
  * @param[in] hw backend accelerator hardware
@@ -745,7 +821,7 @@ static GstTensorFilterFramework NNS_support_pytorch = {.version = GST_TENSOR_FIL
   {.v0 = {
        .name = filter_subplugin_pytorch,
        .allow_in_place = FALSE, /** @todo: support this to optimize performance later. */
-       .allocate_in_invoke = FALSE,
+       .allocate_in_invoke = TRUE, /* output memory of libtorch is passed without memcpy */
        .run_without_model = FALSE,
        .verify_model_path = TRUE, /* check that the given .pt files are valid */
        .statistics = nullptr,
@@ -753,7 +829,7 @@ static GstTensorFilterFramework NNS_support_pytorch = {.version = GST_TENSOR_FIL
        .getInputDimension = torch_getInputDim,
        .getOutputDimension = torch_getOutputDim,
        .setInputDimension = nullptr,
-       .destroyNotify = nullptr,
+       .destroyNotify = torch_destroyNotify,
        .reloadModel = nullptr,
        .handleEvent = nullptr,
        .checkAvailability = torch_checkAvailability,
@@ -173,6 +173,24 @@ class TFLiteInterpreter
     return model_path;
   }
 
+  /** @brief return true if the model is loaded */
+  bool isModelLoaded ()
+  {
+    return (interpreter != nullptr);
+  }
+
+  /** @brief return the number of threads requested when the model is loaded */
+  int getNumThreads ()
+  {
+    return loaded_num_threads;
+  }
+
+  /** @brief return the delegate requested when the model is loaded */
+  tflite_delegate_e getDelegateType ()
+  {
+    return loaded_delegate;
+  }
+
   /** @brief return input tensor meta */
   const GstTensorsInfo *getInputTensorsInfo ()
   {
@@ -216,6 +234,8 @@ class TFLiteInterpreter
   bool is_xnnpack_delegated; /**< To check if XNNPACK delegate is used */
   char *ext_delegate_path; /**< path to external delegate lib */
   GHashTable *ext_delegate_kv_table; /**< external delegate key values options */
+  int loaded_num_threads; /**< the number of threads requested when the model is loaded */
+  tflite_delegate_e loaded_delegate; /**< the delegate requested when the model is loaded */
 
   std::unique_ptr<tflite::Interpreter> interpreter;
   std::unique_ptr<tflite::FlatBufferModel> model;
@@ -289,6 +309,8 @@ TFLiteInterpreter::TFLiteInterpreter ()
   model_path = nullptr;
   ext_delegate_path = nullptr;
   ext_delegate_kv_table = nullptr;
+  loaded_num_threads = -1;
+  loaded_delegate = TFLITE_DELEGATE_NONE;
 
   g_mutex_init (&mutex);
 
@@ -432,6 +454,9 @@ TFLiteInterpreter::loadModel (int num_threads, tflite_delegate_e delegate_e)
     return -2;
   }
 
+  loaded_num_threads = num_threads;
+  loaded_delegate = delegate_e;
+
   if (num_threads > 0) {
     int n = static_cast<int> (std::thread::hardware_concurrency ());
 
@@ -963,12 +988,42 @@ TFLiteCore::setAccelerator (const char *accelerators, tflite_delegate_e d)
 int
 TFLiteCore::init (tflite_option_s *option)
 {
-  interpreter->setModelPath (option->model_file);
-  interpreter->setExtDelegate (option->ext_delegate_path, option->ext_delegate_kv_table);
-  num_threads = option->num_threads;
   int err;
 
+  num_threads = option->num_threads;
   setAccelerator (option->accelerators, option->delegate);
+
+  if (shared_tensor_filter_key) {
+    bool loaded;
+    int shared_num_threads = -1;
+    tflite_delegate_e shared_delegate = TFLITE_DELEGATE_NONE;
+
+    interpreter->lock ();
+    loaded = interpreter->isModelLoaded ();
+    if (loaded) {
+      shared_num_threads = interpreter->getNumThreads ();
+      shared_delegate = interpreter->getDelegateType ();
+    }
+    interpreter->unlock ();
+
+    /* The shared interpreter is already loaded by other instance. */
+    if (loaded) {
+      if (shared_num_threads != num_threads || shared_delegate != delegate) {
+        ml_loge ("The shared model (key=[%s]) is already loaded with the number of threads %d and delegate %d, "
+                 "but this instance requests the number of threads %d and delegate %d. "
+                 "Use the same options or another shared key.",
+            shared_tensor_filter_key, shared_num_threads, shared_delegate,
+            num_threads, delegate);
+        return -1;
+      }
+
+      ml_logd ("The shared model is already loaded: key=[%s]", shared_tensor_filter_key);
+      return 0;
+    }
+  }
+
+  interpreter->setModelPath (option->model_file);
+  interpreter->setExtDelegate (option->ext_delegate_path, option->ext_delegate_kv_table);
   g_message ("accl = %s", get_accl_hw_str (accelerator));
 
   if ((err = loadModel ())) {
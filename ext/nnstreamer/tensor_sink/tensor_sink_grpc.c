@@ -90,6 +90,12 @@ GST_DEBUG_CATEGORY_STATIC (gst_tensor_sink_grpc_debug);
 #define DEFAULT_PROP_HOST  "localhost"
 #define DEFAULT_PROP_PORT  55115
 
+/**
+ * @brief Default number of parallel streams and the dispatch policy (client only)
+ */
+#define DEFAULT_PROP_STREAMS  1
+#define DEFAULT_PROP_DISPATCH "least-outstanding"
+
 #define CAPS_STRING GST_TENSOR_CAP_DEFAULT "; " GST_TENSORS_CAP_DEFAULT
 
 static GstStaticPadTemplate sinktemplate = GST_STATIC_PAD_TEMPLATE ("sink",
@@ -170,6 +176,18 @@ gst_tensor_sink_grpc_class_init (GstTensorSinkGRPCClass * klass)
           0, G_MAXUSHORT, DEFAULT_PROP_PORT,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  g_object_class_install_property (gobject_class, PROP_STREAMS,
+      g_param_spec_uint ("num-streams", "Number of streams",
+          "The number of parallel streams to open as a client (blocking mode only)",
+          1, GRPC_MAX_STREAMS, DEFAULT_PROP_STREAMS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_DISPATCH,
+      g_param_spec_string ("dispatch", "Dispatch",
+          "The policy to dispatch buffers to the streams of a client "
+          "(round-robin, least-outstanding)",
+          DEFAULT_PROP_DISPATCH, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   g_object_class_install_property (gobject_class, PROP_OUT,
       g_param_spec_uint ("out", "Out",
           "The number of output messages generated",
@@ -208,6 +226,8 @@ grpc_config_init (GstTensorSinkGRPC * self)
   grpc->config.dir = GRPC_DIRECTION_TENSORS_TO_BUFFER;
   grpc->config.port = DEFAULT_PROP_PORT;
   grpc->config.host = g_strdup (DEFAULT_PROP_HOST);
+  grpc->config.num_streams = DEFAULT_PROP_STREAMS;
+  grpc->config.dispatch = grpc_get_dispatch (DEFAULT_PROP_DISPATCH);
   grpc->config.config = &self->config;
 }
 
@@ -88,6 +88,11 @@ GST_DEBUG_CATEGORY_STATIC (gst_tensor_src_grpc_debug);
 #define DEFAULT_PROP_HOST  "localhost"
 #define DEFAULT_PROP_PORT  55115
 
+/**
+ * @brief Default number of parallel streams (client only)
+ */
+#define DEFAULT_PROP_STREAMS  1
+
 #define GST_TENSOR_SRC_GRPC_SCALED_TIME(self, count)\
   gst_util_uint64_scale (count, \
       self->config.rate_d * GST_SECOND, self->config.rate_n)
@@ -170,6 +175,12 @@ gst_tensor_src_grpc_class_init (GstTensorSrcGRPCClass * klass)
           0, G_MAXUSHORT, DEFAULT_PROP_PORT,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  g_object_class_install_property (gobject_class, PROP_STREAMS,
+      g_param_spec_uint ("num-streams", "Number of streams",
+          "The number of parallel streams to open as a client (blocking mode only)",
+          1, GRPC_MAX_STREAMS, DEFAULT_PROP_STREAMS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   g_object_class_install_property (gobject_class, PROP_OUT,
       g_param_spec_uint ("out", "Out",
           "The number of output buffers generated",
@@ -305,6 +316,7 @@ grpc_config_init (GstTensorSrcGRPC * self)
   grpc->config.dir = GRPC_DIRECTION_BUFFER_TO_TENSORS;
   grpc->config.port = DEFAULT_PROP_PORT;
   grpc->config.host = g_strdup (DEFAULT_PROP_HOST);
+  grpc->config.num_streams = DEFAULT_PROP_STREAMS;
   grpc->config.cb = _grpc_callback;
   grpc->config.cb_data = (void *) self;
   grpc->config.config = &self->config;
@@ -359,6 +359,7 @@ gst_tensor_converter_init (GstTensorConverter * self)
   self->in_media_type = _NNS_MEDIA_INVALID;
   self->frame_size = 0;
   self->remove_padding = FALSE;
+  self->video_stride = 0;
   self->externalConverter = NULL;
   self->priv_data = NULL;
   self->mode = _CONVERTER_MODE_NONE;
@@ -688,6 +689,26 @@ gst_tensor_converter_sink_query (GstPad * pad, GstObject * parent,
       gst_query_set_accept_caps_result (query, res);
       return TRUE;
     }
+    case GST_QUERY_ALLOCATION:
+    {
+      GstCaps *caps;
+      GstStructure *st;
+
+      gst_query_parse_allocation (query, &caps, NULL);
+      if (caps == NULL)
+        break;
+
+      /**
+       * Accept the video meta, then upstream may send packed frames
+       * (or describe the stride) and the converter may avoid removing the padding.
+       */
+      st = gst_caps_get_structure (caps, 0);
+      if (gst_structure_has_name (st, "video/x-raw")) {
+        add_video_meta_allocation (query);
+        return TRUE;
+      }
+      break;
+    }
     default:
       break;
   }
@@ -878,6 +899,27 @@ _gst_tensor_converter_chain_octet (GstTensorConverter * self, GstBuffer * buf)
   return buffer;
 }
 
+/**
+ * @brief Allocate a buffer for the converted frame, with the header of flexible tensor in the headroom.
+ * @note The header is same as the one appended when converting to flexible tensor, so it can be shared without copying the frame.
+ */
+static GstBuffer *
+_gst_tensor_converter_new_frame_buffer (GstTensorConverter * self,
+    gsize frame_size)
+{
+  GstBuffer *buffer;
+  GstTensorMetaInfo meta;
+
+  gst_tensor_info_convert_to_meta (&self->tensors_config.info.info[0], &meta);
+  meta.media_type = self->in_media_type;
+
+  buffer = gst_buffer_new ();
+  gst_buffer_append_memory (buffer,
+      gst_tensor_alloc_with_headroom (&meta, frame_size));
+
+  return buffer;
+}
+
 /** @brief Chain function's private routine to process flex tensor */
 static GstBuffer *
 _gst_tensor_converter_chain_flex_tensor (GstTensorConverter * self,
@@ -1045,8 +1087,9 @@ gst_tensor_converter_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
   switch (self->in_media_type) {
     case _NNS_VIDEO:
     {
+      GstVideoMeta *vmeta;
       guint color, width, height;
-      gsize type;
+      gsize type, row_size, stride, offset;
 
       color = config->info.info[0].dimension[0];
       width = config->info.info[0].dimension[1];
@@ -1054,16 +1097,55 @@ gst_tensor_converter_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
       type = gst_tensor_get_element_size (config->info.info[0].type);
 
       /** type * colorspace * width * height */
-      frame_size = type * color * width * height;
+      row_size = type * color * width;
+      frame_size = row_size * height;
+
+      /**
+       * If upstream has attached the video meta (see allocation query), it describes the actual layout.
+       * Otherwise, the frame follows the default stride in caps.
+       * Refer: https://gstreamer.freedesktop.org/documentation/design/mediatype-video-raw.html
+       */
+      vmeta = gst_buffer_get_video_meta (buf);
+      if (vmeta) {
+        stride = vmeta->stride[0];
+        offset = vmeta->offset[0];
+      } else {
+        stride = self->video_stride;
+        offset = 0;
 
-      /** supposed 1 frame in buffer */
-      g_assert ((buf_size / self->frame_size) == 1);
+        /** supposed 1 frame in buffer */
+        g_assert ((buf_size / self->frame_size) == 1);
+      }
+
+      if (stride == row_size) {
+        /* packed rows, share the memory without copying data. */
+        if (offset > 0 || buf_size != frame_size) {
+          if (offset + frame_size > buf_size) {
+            GST_ERROR_OBJECT (self,
+                "The incoming video frame is too small (%" G_GSIZE_FORMAT
+                " bytes), expected %" G_GSIZE_FORMAT " bytes from offset %"
+                G_GSIZE_FORMAT ".",
+                buf_size, frame_size, offset);
+            goto error;
+          }
 
-      if (self->remove_padding) {
+          inbuf = gst_buffer_copy_region (buf, GST_BUFFER_COPY_ALL, offset,
+              frame_size);
+        }
+      } else if (self->remove_padding || vmeta) {
         GstMapInfo src_info, dest_info;
-        guint d0, d1;
-        unsigned int src_idx = 0, dest_idx = 0;
-        size_t size, offset;
+        guint d1;
+        guint8 *src, *dest;
+
+        if (stride < row_size || offset + stride * (height - 1) + row_size >
+            buf_size) {
+          GST_ERROR_OBJECT (self,
+              "The incoming video frame has invalid layout (stride %"
+              G_GSIZE_FORMAT ", offset %" G_GSIZE_FORMAT ", size %"
+              G_GSIZE_FORMAT ").",
+              stride, offset, buf_size);
+          goto error;
+        }
 
         if (!gst_buffer_map (buf, &src_info, GST_MAP_READ)) {
           ml_logf
@@ -1071,8 +1153,8 @@ gst_tensor_converter_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
           goto error;
         }
 
-        inbuf = gst_buffer_new_and_alloc (frame_size);
-        gst_buffer_memset (inbuf, 0, 0, frame_size);
+        /* every byte is overwritten by the row copy below, no need to fill it. */
+        inbuf = _gst_tensor_converter_new_frame_buffer (self, frame_size);
         if (!gst_buffer_map (inbuf, &dest_info, GST_MAP_WRITE)) {
           ml_logf
               ("tensor_converter: Cannot map dest buffer at tensor_converter/video. The outgoing buffer (GstBuffer) for the srcpad of tensor_converter cannot be mapped for writing.\n");
@@ -1081,22 +1163,13 @@ gst_tensor_converter_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
           goto error;
         }
 
-        /**
-         * Refer: https://gstreamer.freedesktop.org/documentation/design/mediatype-video-raw.html
-         */
-        size = offset = type * color * width;
-
-        g_assert (offset % 4); /** Internal logic error! */
-        if (offset % 4) {
-          offset += 4 - (offset % 4);
-        }
+        src = src_info.data + offset;
+        dest = dest_info.data;
 
-        for (d0 = 0; d0 < frames_in; d0++) {
-          for (d1 = 0; d1 < height; d1++) {
-            memcpy (dest_info.data + dest_idx, src_info.data + src_idx, size);
-            dest_idx += size;
-            src_idx += offset;
-          }
+        for (d1 = 0; d1 < height; d1++) {
+          memcpy (dest, src, row_size);
+          dest += row_size;
+          src += stride;
         }
 
         gst_buffer_unmap (buf, &src_info);
@@ -1105,6 +1178,13 @@ gst_tensor_converter_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
         /** copy timestamps */
         gst_buffer_copy_into (inbuf, buf, GST_BUFFER_COPY_METADATA, 0, -1);
       }
+
+      /* the layout of converted tensor is packed, remove copied video meta. */
+      if (inbuf != buf && vmeta) {
+        vmeta = gst_buffer_get_video_meta (inbuf);
+        if (vmeta)
+          gst_buffer_remove_meta (inbuf, (GstMeta *) vmeta);
+      }
       break;
     }
     case _NNS_AUDIO:
@@ -1122,7 +1202,7 @@ gst_tensor_converter_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
           goto error;
         }
 
-        inbuf = gst_buffer_new_and_alloc (frame_size);
+        inbuf = _gst_tensor_converter_new_frame_buffer (self, frame_size);
         gst_buffer_memset (inbuf, 0, 0, frame_size);
         if (!gst_buffer_map (inbuf, &dest_info, GST_MAP_WRITE)) {
           ml_logf
@@ -1496,6 +1576,9 @@ gst_tensor_converter_parse_video (GstTensorConverter * self,
    * Emit Warning if RSTRIDE = RU4 (3BPP) && Width % 4 > 0
    * @todo Add more conditions!
    */
+  self->remove_padding = FALSE;
+  self->video_stride = GST_VIDEO_INFO_PLANE_STRIDE (&vinfo, 0);
+
   if (gst_tensor_converter_video_stride (format, width)) {
     self->remove_padding = TRUE;
     silent_debug (self, "Set flag to remove padding, width = %d", width);
@@ -1503,7 +1586,7 @@ gst_tensor_converter_parse_video (GstTensorConverter * self,
     /** @todo need rewrite. */
     GST_WARNING_OBJECT (self,
         "\nYOUR STREAM CONFIGURATION INCURS PERFORMANCE DETERIORATION!\n"
-        "Please use 4 x n as image width for inputs; the width of your input is %d.\n",
+        "Please use 4 x n as image width for inputs (or an upstream element supporting video meta); the width of your input is %d.\n",
         width);
   }
 
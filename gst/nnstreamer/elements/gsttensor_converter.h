@@ -92,6 +92,7 @@ struct _GstTensorConverter
 
   gsize frame_size; /**< size of one frame */
   gboolean remove_padding; /**< If true, zero-padding must be removed */
+  gsize video_stride; /**< row stride of the incoming video frame (from caps) */
   gboolean tensors_configured; /**< True if already successfully configured tensors metadata */
   GstTensorsConfig tensors_config; /**< output tensors info */
 
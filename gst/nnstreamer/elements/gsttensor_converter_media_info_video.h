@@ -21,6 +21,7 @@
 #endif
 
 #include <gst/video/video-info.h>
+#include <gst/video/gstvideometa.h>
 
 /**
  * @brief Caps string for supported video format
@@ -33,4 +34,10 @@
     gst_caps_append (caps, gst_caps_from_string (VIDEO_CAPS_STR))
 
 #define is_video_supported(...) TRUE
+
+/**
+ * @brief Let upstream describe the frame layout with GstVideoMeta, so that converter may skip the stride handling.
+ */
+#define add_video_meta_allocation(query) \
+    gst_query_add_allocation_meta (query, GST_VIDEO_META_API_TYPE, NULL)
 #endif /* __GST_TENSOR_CONVERTER_MEDIA_INFO_VIDEO_H__ */
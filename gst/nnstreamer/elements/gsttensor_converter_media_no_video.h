@@ -22,6 +22,7 @@
 
 #define append_video_caps_template(caps)
 #define is_video_supported(...) FALSE
+#define add_video_meta_allocation(query)
 
 #define GstVideoInfo gsize
 
@@ -41,6 +42,16 @@ typedef enum {
   GST_VIDEO_FORMAT_I420
 } GstVideoFormat;
 
+/**
+ * @brief Dummy video meta, only the fields used by tensor_converter.
+ */
+typedef struct {
+  gsize offset[4];
+  gint stride[4];
+} GstVideoMeta;
+
+#define gst_buffer_get_video_meta(...) NULL
+
 #define gst_video_info_init(i) memset (i, 0, sizeof (GstVideoInfo))
 #define gst_video_info_from_caps(...) FALSE
 #define gst_video_format_to_string(...) "Unknown"
@@ -49,6 +60,7 @@ typedef enum {
 #define GST_VIDEO_INFO_WIDTH(...) 0
 #define GST_VIDEO_INFO_HEIGHT(...) 0
 #define GST_VIDEO_INFO_SIZE(...) 0
+#define GST_VIDEO_INFO_PLANE_STRIDE(...) 0
 #define GST_VIDEO_INFO_FPS_N(...) 0
 #define GST_VIDEO_INFO_FPS_D(...) 1
 
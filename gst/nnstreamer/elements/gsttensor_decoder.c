@@ -74,7 +74,9 @@ enum
   PROP_MODE_OPTION7,
   PROP_MODE_OPTION8,
   PROP_MODE_OPTION9,
-  PROP_SUBPLUGINS
+  PROP_SUBPLUGINS,
+  PROP_STATS,
+  PROP_STATS_INTERVAL
 };
 
 /**
@@ -125,6 +127,11 @@ static gboolean gst_tensordec_set_caps (GstBaseTransform * trans,
 static gboolean gst_tensordec_transform_size (GstBaseTransform * trans,
     GstPadDirection direction, GstCaps * caps, gsize size,
     GstCaps * othercaps, gsize * othersize);
+static GstFlowReturn gst_tensordec_prepare_output_buffer (GstBaseTransform *
+    trans, GstBuffer * inbuf, GstBuffer ** outbuf);
+static gboolean gst_tensordec_start (GstBaseTransform * trans);
+static gboolean gst_tensordec_sink_event (GstBaseTransform * trans,
+    GstEvent * event);
 
 /**
  * @brief Validate decoder sub-plugin's data.
@@ -164,6 +171,7 @@ nnstreamer_decoder_probe (GstTensorDecoderDef * decoder)
 void
 nnstreamer_decoder_exit (const char *name)
 {
+  nnstreamer_decoder_set_decode_memory (name, NULL);
   unregister_subplugin (NNS_SUBPLUGIN_DECODER, name);
 }
 
@@ -178,6 +186,69 @@ nnstreamer_decoder_find (const char *name)
   return get_subplugin (NNS_SUBPLUGIN_DECODER, name);
 }
 
+/**
+ * @brief The functions decoding the input memory blocks, with the name of decoder sub-plugin.
+ */
+static GHashTable *decode_memory_table = NULL;
+G_LOCK_DEFINE_STATIC (decode_memory_lock);
+
+/**
+ * @brief Decoder's sub-plugin may call this after nnstreamer_decoder_probe() to register the function decoding the input memory blocks.
+ * @param[in] name The name of decoder sub-plugin.
+ * @param[in] func The function to decode the input memory blocks. NULL to unregister it.
+ * @return TRUE if registered. FALSE if the sub-plugin is not registered.
+ */
+int
+nnstreamer_decoder_set_decode_memory (const char *name,
+    GstTensorDecoderDecodeMemory func)
+{
+  g_return_val_if_fail (name != NULL, FALSE);
+
+  G_LOCK (decode_memory_lock);
+  if (func == NULL) {
+    if (decode_memory_table)
+      g_hash_table_remove (decode_memory_table, name);
+    G_UNLOCK (decode_memory_lock);
+    return TRUE;
+  }
+  G_UNLOCK (decode_memory_lock);
+
+  if (!nnstreamer_decoder_find (name)) {
+    ml_loge ("Cannot find the decoder sub-plugin %s.", name);
+    return FALSE;
+  }
+
+  G_LOCK (decode_memory_lock);
+  if (!decode_memory_table)
+    decode_memory_table =
+        g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+  g_hash_table_insert (decode_memory_table, g_strdup (name), (gpointer) func);
+  G_UNLOCK (decode_memory_lock);
+
+  return TRUE;
+}
+
+/**
+ * @brief Get the function decoding the input memory blocks of decoder sub-plugin.
+ * @param[in] name The name of decoder sub-plugin.
+ * @return NULL if not registered.
+ */
+GstTensorDecoderDecodeMemory
+nnstreamer_decoder_get_decode_memory (const char *name)
+{
+  GstTensorDecoderDecodeMemory func = NULL;
+
+  g_return_val_if_fail (name != NULL, NULL);
+
+  G_LOCK (decode_memory_lock);
+  if (decode_memory_table)
+    func = (GstTensorDecoderDecodeMemory)
+        g_hash_table_lookup (decode_memory_table, name);
+  G_UNLOCK (decode_memory_lock);
+
+  return func;
+}
+
 /**
  * @brief set custom property description for tensor decoder sub-plugin
  */
@@ -358,6 +429,18 @@ gst_tensordec_class_init (GstTensorDecoderClass * klass)
           "Registrable sub-plugins list", "",
           G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 
+  g_object_class_install_property (gobject_class, PROP_STATS,
+      g_param_spec_boxed ("stats", "Statistics",
+          "Latency statistics of the decoder, with the fields "
+          "count, p50, p95, p99 and max (latency in microseconds)",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_STATS_INTERVAL,
+      g_param_spec_uint ("stats-interval", "Statistics interval",
+          "Interval (ms) to post an element message with the latency "
+          "statistics (0: disabled)", 0, G_MAXUINT, 0,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_set_details_simple (gstelement_class,
       "TensorDecoder",
       "Converter/Tensor",
@@ -386,6 +469,11 @@ gst_tensordec_class_init (GstTensorDecoderClass * klass)
   /** Allocation units */
   trans_class->transform_size =
       GST_DEBUG_FUNCPTR (gst_tensordec_transform_size);
+  trans_class->prepare_output_buffer =
+      GST_DEBUG_FUNCPTR (gst_tensordec_prepare_output_buffer);
+
+  trans_class->start = GST_DEBUG_FUNCPTR (gst_tensordec_start);
+  trans_class->sink_event = GST_DEBUG_FUNCPTR (gst_tensordec_sink_event);
 }
 
 /**
@@ -403,6 +491,7 @@ gst_tensordec_init (GstTensorDecoder * self)
   self->configured = FALSE;
   self->negotiated = FALSE;
   self->decoder = NULL;
+  self->decode_memory = NULL;
   self->plugin_data = NULL;
   self->is_custom = FALSE;
   self->custom.func = NULL;
@@ -411,6 +500,7 @@ gst_tensordec_init (GstTensorDecoder * self)
     self->option[i] = NULL;
 
   gst_tensors_config_init (&self->tensor_config);
+  gst_tensor_latency_stats_init (&self->stats);
 }
 
 /**
@@ -488,6 +578,9 @@ gst_tensordec_set_property (GObject * object, guint prop_id,
           self->decoder = decoder;
         }
 
+        self->decode_memory =
+            nnstreamer_decoder_get_decode_memory (decoder->modename);
+
         if (0 == self->decoder->init (&self->plugin_data)) {
           ml_loge ("Failed to intialize a decode subplugin, \"%s\".\n",
               mode_string);
@@ -504,6 +597,7 @@ gst_tensordec_set_property (GObject * object, guint prop_id,
             mode_string);
         gst_tensor_decoder_clean_plugin (self);
         self->decoder = NULL;
+        self->decode_memory = NULL;
       }
       break;
     }
@@ -517,6 +611,10 @@ gst_tensordec_set_property (GObject * object, guint prop_id,
       PROP_MODE_OPTION (8);
       PROP_MODE_OPTION (9);
 
+    case PROP_STATS_INTERVAL:
+      gst_tensor_latency_stats_set_interval (&self->stats,
+          g_value_get_uint (value));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -576,6 +674,14 @@ gst_tensordec_get_property (GObject * object, guint prop_id,
       }
       break;
     }
+    case PROP_STATS:
+      g_value_take_boxed (value,
+          gst_tensor_latency_stats_to_structure (&self->stats));
+      break;
+    case PROP_STATS_INTERVAL:
+      g_value_set_uint (value,
+          gst_tensor_latency_stats_get_interval (&self->stats));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -604,6 +710,32 @@ gst_tensordec_class_finalize (GObject * object)
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
+/**
+ * @brief Called when the element starts processing. optional vmethod of BaseTransform
+ */
+static gboolean
+gst_tensordec_start (GstBaseTransform * trans)
+{
+  GstTensorDecoder *self = GST_TENSOR_DECODER_CAST (trans);
+
+  gst_tensor_latency_stats_reset (&self->stats);
+  return TRUE;
+}
+
+/**
+ * @brief Handle the event on sink pad. optional vmethod of BaseTransform
+ */
+static gboolean
+gst_tensordec_sink_event (GstBaseTransform * trans, GstEvent * event)
+{
+  GstTensorDecoder *self = GST_TENSOR_DECODER_CAST (trans);
+
+  if (GST_EVENT_TYPE (event) == GST_EVENT_FLUSH_STOP)
+    gst_tensor_latency_stats_reset (&self->stats);
+
+  return GST_BASE_TRANSFORM_CLASS (parent_class)->sink_event (trans, event);
+}
+
 /**
  * @brief Configure tensor metadata from sink caps
  */
@@ -659,6 +791,49 @@ gst_tensordec_configure (GstTensorDecoder * self, const GstCaps * in_caps,
   return TRUE;
 }
 
+/**
+ * @brief Map the input memory blocks and decode them with the sub-plugin.
+ */
+static GstFlowReturn
+gst_tensordec_decode_mapped (GstTensorDecoder * self, GstMemory ** in_mem,
+    guint num_tensors, GstBuffer * outbuf)
+{
+  GstMapInfo in_info[NNS_TENSOR_SIZE_LIMIT];
+  GstTensorMemory input[NNS_TENSOR_SIZE_LIMIT];
+  GstFlowReturn res;
+  guint i;
+
+  for (i = 0; i < num_tensors; i++) {
+    if (!gst_memory_map (in_mem[i], &in_info[i], GST_MAP_READ)) {
+      guint j;
+      ml_logf ("Failed to map in_mem[%u].\n", i);
+
+      for (j = 0; j < i; j++)
+        gst_memory_unmap (in_mem[j], &in_info[j]);
+      return GST_FLOW_ERROR;
+    }
+
+    input[i].data = in_info[i].data;
+    input[i].size = in_info[i].size;
+  }
+
+  if (!self->is_custom) {
+    res = self->decoder->decode (&self->plugin_data, &self->tensor_config,
+        input, outbuf);
+  } else if (self->custom.func != NULL) {
+    res = self->custom.func (input, &self->tensor_config, self->custom.data,
+        outbuf);
+  } else {
+    GST_ERROR_OBJECT (self, "Custom decoder callback is not registered.");
+    res = GST_FLOW_ERROR;
+  }
+
+  for (i = 0; i < num_tensors; i++)
+    gst_memory_unmap (in_mem[i], &in_info[i]);
+
+  return res;
+}
+
 /**
  * @brief non-ip transform. required vmethod for BaseTransform class.
  */
@@ -678,9 +853,8 @@ gst_tensordec_transform (GstBaseTransform * trans,
 
   if (self->decoder || self->is_custom) {
     GstMemory *in_mem[NNS_TENSOR_SIZE_LIMIT];
-    GstMapInfo in_info[NNS_TENSOR_SIZE_LIMIT];
-    GstTensorMemory input[NNS_TENSOR_SIZE_LIMIT];
     guint i, num_tensors;
+    gint64 start_time = g_get_monotonic_time ();
 
     if (gst_tensors_config_is_flexible (&self->tensor_config)) {
       self->tensor_config.info.num_tensors = gst_buffer_n_memory (inbuf);
@@ -689,33 +863,23 @@ gst_tensordec_transform (GstBaseTransform * trans,
     /** Internal logic error. Negotation process should prevent this! */
     g_assert (gst_buffer_n_memory (inbuf) == num_tensors);
 
-    for (i = 0; i < num_tensors; i++) {
+    for (i = 0; i < num_tensors; i++)
       in_mem[i] = gst_buffer_peek_memory (inbuf, i);
-      if (!gst_memory_map (in_mem[i], &in_info[i], GST_MAP_READ)) {
-        guint j;
-        ml_logf ("Failed to map in_mem[%u].\n", i);
 
-        for (j = 0; j < i; j++)
-          gst_memory_unmap (in_mem[j], &in_info[j]);
-        return GST_FLOW_ERROR;
-      }
+    /* decode without mapping the input if the sub-plugin supports it */
+    res = GST_TENSOR_DECODER_FALLBACK;
+    if (!self->is_custom && self->decode_memory)
+      res = self->decode_memory (&self->plugin_data,
+          &self->tensor_config, in_mem, outbuf);
 
-      input[i].data = in_info[i].data;
-      input[i].size = in_info[i].size;
-    }
-    if (!self->is_custom) {
-      res = self->decoder->decode (&self->plugin_data, &self->tensor_config,
-          input, outbuf);
-    } else if (self->custom.func != NULL) {
-      res = self->custom.func (input, &self->tensor_config, self->custom.data,
-          outbuf);
-    } else {
-      GST_ERROR_OBJECT (self, "Custom decoder callback is not registered.");
-      res = GST_FLOW_ERROR;
-    }
+    if (res == GST_TENSOR_DECODER_FALLBACK)
+      res = gst_tensordec_decode_mapped (self, in_mem, num_tensors, outbuf);
 
-    for (i = 0; i < num_tensors; i++)
-      gst_memory_unmap (in_mem[i], &in_info[i]);
+    if (res == GST_FLOW_OK) {
+      gst_tensor_latency_stats_record (&self->stats,
+          g_get_monotonic_time () - start_time);
+      gst_tensor_latency_stats_post (&self->stats, GST_ELEMENT_CAST (self));
+    }
   } else {
     GST_ERROR_OBJECT (self, "Decoder plugin not yet configured.");
     goto unknown_type;
@@ -919,7 +1083,10 @@ gst_tensordec_transform_size (GstBaseTransform * trans,
 
   g_assert (self->configured);
 
-  if (!self->is_custom && self->decoder->getTransformSize)
+  /* decode_memory appends the memory blocks to the empty buffer */
+  if (!self->is_custom && self->decode_memory)
+    *othersize = 0;
+  else if (!self->is_custom && self->decoder->getTransformSize)
     *othersize = self->decoder->getTransformSize (&self->plugin_data,
         &self->tensor_config, caps, size, othercaps, direction);
   else
@@ -928,6 +1095,37 @@ gst_tensordec_transform_size (GstBaseTransform * trans,
   return TRUE;
 }
 
+/**
+ * @brief Prepare the output buffer. optional vmethod of BaseTransform
+ *
+ * If the sub-plugin decodes the memory without copying, give an empty buffer instead of the one from downstream pool.
+ * decode_memory appends the memory blocks to the empty buffer.
+ */
+static GstFlowReturn
+gst_tensordec_prepare_output_buffer (GstBaseTransform * trans,
+    GstBuffer * inbuf, GstBuffer ** outbuf)
+{
+  GstTensorDecoder *self;
+  GstBaseTransformClass *bclass;
+
+  self = GST_TENSOR_DECODER_CAST (trans);
+  bclass = GST_BASE_TRANSFORM_GET_CLASS (trans);
+
+  if (!self->configured || self->is_custom || !self->decode_memory)
+    return GST_BASE_TRANSFORM_CLASS (parent_class)->prepare_output_buffer
+        (trans, inbuf, outbuf);
+
+  *outbuf = gst_buffer_new ();
+
+  /* copy the timestamps and metadata as the default implementation does */
+  if (bclass->copy_metadata && !bclass->copy_metadata (trans, inbuf, *outbuf)) {
+    GST_ELEMENT_WARNING (self, STREAM, NOT_IMPLEMENTED, (NULL),
+        ("could not copy metadata"));
+  }
+
+  return GST_FLOW_OK;
+}
+
 /**
  * @brief Registers a callback for tensor_decoder custom condition
  * @return 0 if success. -ERRNO if error.
@@ -82,7 +82,10 @@ struct _GstTensorDecoder
   decoder_custom_cb_s custom;
 
   const GstTensorDecoderDef *decoder; /**< Plugin object */
+  GstTensorDecoderDecodeMemory decode_memory; /**< Optional function of the plugin to decode the input memory blocks */
   void *plugin_data;
+
+  GstTensorLatencyStats stats; /**< latency statistics of the decoder */
 };
 
 /**
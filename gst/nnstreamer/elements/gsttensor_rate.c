@@ -28,6 +28,16 @@
  * to upstream elements by sending qos events, which prevents unnecessary
  * data from upstream elements.
  *
+ * When 'target-latency' property is set, it works as an admission controller.
+ * It queries the inference latency and the latest processed timestamp of the
+ * downstream tensor_filter elements, and estimates the end-to-end latency
+ * including the frames queued in between. If the estimated latency exceeds
+ * the target, frames are dropped so that the admission rate follows the
+ * processing rate of downstream filters, scaled down by the ratio of the
+ * estimated latency to the target. Thus, when the model latency spikes
+ * (e.g., thermal throttling), the pipeline degrades gracefully instead of
+ * queueing up frames.
+ *
  * <refsect2>
  * <title>Example launch line with tensor rate</title>
  * gst-launch-1.0 videotestsrc
@@ -72,6 +82,7 @@ GST_DEBUG_CATEGORY_STATIC (gst_tensor_rate_debug);
 /** @brief default parameters */
 #define DEFAULT_SILENT    TRUE
 #define DEFAULT_THROTTLE  TRUE
+#define DEFAULT_TARGET_LATENCY  0
 
 /**
  * @brief tensor_rate properties
@@ -86,6 +97,7 @@ enum
   PROP_SILENT,
   PROP_THROTTLE,
   PROP_FRAMERATE,
+  PROP_TARGET_LATENCY,
 };
 
 /**
@@ -133,6 +145,8 @@ static GstFlowReturn gst_tensor_rate_flush_prev (GstTensorRate * self,
 
 static void gst_tensor_rate_notify_drop (GstTensorRate * self);
 static void gst_tensor_rate_notify_duplicate (GstTensorRate * self);
+static gboolean gst_tensor_rate_admit (GstTensorRate * self,
+    GstClockTime timestamp);
 
 static gboolean gst_tensor_rate_start (GstBaseTransform * trans);
 static gboolean gst_tensor_rate_stop (GstBaseTransform * trans);
@@ -196,29 +210,14 @@ gst_tensor_rate_class_init (GstTensorRateClass * klass)
 }
 
 /**
- * @brief push the buffer to src pad
+ * @brief advance the timestamp of next output slot
+ * @note The slot is advanced even if the buffer is dropped, to keep the output frame rate.
  */
-static GstFlowReturn
-gst_tensor_rate_push_buffer (GstTensorRate * self, GstBuffer * outbuf,
-    gboolean duplicate, GstClockTime next_intime)
+static void
+gst_tensor_rate_advance_ts (GstTensorRate * self, GstBuffer * outbuf)
 {
-  GstFlowReturn res;
-  GstClockTime push_ts;
-  UNUSED (next_intime);
-
-  GST_BUFFER_OFFSET (outbuf) = self->out;
-  GST_BUFFER_OFFSET_END (outbuf) = self->out + 1;
-  GST_BUFFER_FLAG_UNSET (outbuf, GST_BUFFER_FLAG_DISCONT);
-
-  if (duplicate)
-    GST_BUFFER_FLAG_SET (outbuf, GST_BUFFER_FLAG_GAP);
-  else
-    GST_BUFFER_FLAG_UNSET (outbuf, GST_BUFFER_FLAG_GAP);
-
-  /* this is the timestamp we put on the buffer */
-  push_ts = self->next_ts;
+  GstClockTime push_ts = self->next_ts;
 
-  self->out++;
   self->out_frame_count++;
 
   if (self->to_rate_numerator) {
@@ -240,6 +239,48 @@ gst_tensor_rate_push_buffer (GstTensorRate * self, GstBuffer * outbuf,
 
     self->next_ts = GST_BUFFER_PTS (outbuf) + GST_BUFFER_DURATION (outbuf);
   }
+}
+
+/**
+ * @brief push the buffer to src pad
+ */
+static GstFlowReturn
+gst_tensor_rate_push_buffer (GstTensorRate * self, GstBuffer * outbuf,
+    gboolean duplicate, GstClockTime next_intime)
+{
+  GstFlowReturn res;
+  GstClockTime push_ts;
+  UNUSED (next_intime);
+
+  /* this is the timestamp we put on the buffer */
+  push_ts = self->next_ts;
+
+  /* check the latency before counting the outgoing buffer */
+  if (!gst_tensor_rate_admit (self, push_ts - self->segment.base)) {
+    silent_debug (self, "over target latency, dropping buffer outgoing ts %"
+        GST_TIME_FORMAT, GST_TIME_ARGS (push_ts));
+
+    gst_tensor_rate_advance_ts (self, outbuf);
+    gst_buffer_unref (outbuf);
+    self->drop++;
+
+    if (!self->silent)
+      gst_tensor_rate_notify_drop (self);
+
+    return GST_FLOW_OK;
+  }
+
+  GST_BUFFER_OFFSET (outbuf) = self->out;
+  GST_BUFFER_OFFSET_END (outbuf) = self->out + 1;
+  GST_BUFFER_FLAG_UNSET (outbuf, GST_BUFFER_FLAG_DISCONT);
+
+  if (duplicate)
+    GST_BUFFER_FLAG_SET (outbuf, GST_BUFFER_FLAG_GAP);
+  else
+    GST_BUFFER_FLAG_UNSET (outbuf, GST_BUFFER_FLAG_GAP);
+
+  self->out++;
+  gst_tensor_rate_advance_ts (self, outbuf);
 
   /* adapt for looping, bring back to time in current segment. */
   GST_BUFFER_TIMESTAMP (outbuf) = push_ts - self->segment.base;
@@ -304,6 +345,7 @@ gst_tensor_rate_reset (GstTensorRate * self)
   self->base_ts = 0;
   self->next_ts = GST_CLOCK_TIME_NONE;
   self->last_ts = GST_CLOCK_TIME_NONE;
+  self->last_admit_ts = GST_CLOCK_TIME_NONE;
 
   self->sent_qos_on_passthrough = FALSE;
 
@@ -320,6 +362,7 @@ gst_tensor_rate_init (GstTensorRate * self)
 
   self->silent = DEFAULT_SILENT;
   self->throttle = DEFAULT_THROTTLE;
+  self->target_latency = DEFAULT_TARGET_LATENCY;
 
   /* decided from caps negotiation */
   self->from_rate_numerator = 0;
@@ -361,6 +404,9 @@ gst_tensor_rate_set_property (GObject * object, guint prop_id,
     case PROP_THROTTLE:
       self->throttle = g_value_get_boolean (value);
       break;
+    case PROP_TARGET_LATENCY:
+      self->target_latency = g_value_get_uint (value);
+      break;
     case PROP_FRAMERATE:
     {
       const gchar *str = g_value_get_string (value);
@@ -430,6 +476,9 @@ gst_tensor_rate_get_property (GObject * object, guint prop_id,
     case PROP_THROTTLE:
       g_value_set_boolean (value, self->throttle);
       break;
+    case PROP_TARGET_LATENCY:
+      g_value_set_uint (value, self->target_latency);
+      break;
     case PROP_FRAMERATE:
       if (self->rate_n < 0 || self->rate_d <= 0) {
         g_value_set_string (value, "");
@@ -470,6 +519,66 @@ gst_tensor_rate_send_qos_throttle (GstTensorRate * self, GstClockTime timestamp)
   gst_pad_push_event (sinkpad, event);
 }
 
+/**
+ * @brief check whether a buffer can be pushed under the target latency
+ * @param[in] self "this" pointer
+ * @param[in] timestamp the timestamp of the outgoing buffer
+ * @return TRUE if the buffer is admitted, FALSE to drop it.
+ */
+static gboolean
+gst_tensor_rate_admit (GstTensorRate * self, GstClockTime timestamp)
+{
+  GstPad *srcpad = GST_BASE_TRANSFORM_SRC_PAD (&self->element);
+  GstClockTime target, latency = 0, pts = GST_CLOCK_TIME_NONE;
+  GstClockTime estimated, interval;
+  gdouble throughput = 0.0;
+  GstQuery *query;
+
+  GST_OBJECT_LOCK (self);
+  target = self->target_latency * GST_MSECOND;
+  GST_OBJECT_UNLOCK (self);
+
+  if (target == 0 || !GST_CLOCK_TIME_IS_VALID (timestamp))
+    return TRUE;
+
+  query = gst_tensor_latency_query_new ();
+  if (gst_pad_peer_query (srcpad, query))
+    gst_tensor_latency_query_parse (query, &latency, &throughput, &pts);
+  gst_query_unref (query);
+
+  /* no tensor_filter in downstream or not measured yet */
+  if (latency == 0)
+    goto admit;
+
+  /* inference latency and the frames queued before downstream filters */
+  estimated = latency;
+  if (GST_CLOCK_TIME_IS_VALID (pts) &&
+      GST_CLOCK_TIME_IS_VALID (self->last_admit_ts) &&
+      self->last_admit_ts > pts)
+    estimated += self->last_admit_ts - pts;
+
+  if (estimated > target && GST_CLOCK_TIME_IS_VALID (self->last_admit_ts)) {
+    /**
+     * Admit frames slower than the downstream filters can process,
+     * in proportion to how far the estimated latency is over the target.
+     */
+    interval = (throughput > 0.0) ?
+        (GstClockTime) (GST_SECOND / throughput) : latency;
+    interval = gst_util_uint64_scale (interval, estimated, target);
+
+    silent_debug (self, "estimated latency %" GST_TIME_FORMAT
+        " over target, admission interval %" GST_TIME_FORMAT,
+        GST_TIME_ARGS (estimated), GST_TIME_ARGS (interval));
+
+    if (timestamp < self->last_admit_ts + interval)
+      return FALSE;
+  }
+
+admit:
+  self->last_admit_ts = timestamp;
+  return TRUE;
+}
+
 /**
  * @brief in-place transform
  */
@@ -522,6 +631,17 @@ gst_tensor_rate_transform_ip (GstBaseTransform * trans, GstBuffer * buffer)
       gst_tensor_rate_send_qos_throttle (self, intime);
     }
 
+    if (!gst_tensor_rate_admit (self, in_ts)) {
+      silent_debug (self, "over target latency, dropping buffer %"
+          GST_TIME_FORMAT, GST_TIME_ARGS (in_ts));
+      self->drop++;
+
+      if (!self->silent)
+        gst_tensor_rate_notify_drop (self);
+
+      return GST_BASE_TRANSFORM_FLOW_DROPPED;
+    }
+
     self->out++;
     return GST_FLOW_OK;
   }
@@ -994,4 +1114,13 @@ gst_tensor_rate_install_properties (GObjectClass * object_class)
           "Specify a target framerate to adjust (e.g., framerate=10/1). "
           "Otherwise, the latest processing time will be a target interval.",
           "", G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /* PROP_TARGET_LATENCY */
+  g_object_class_install_property (object_class, PROP_TARGET_LATENCY,
+      g_param_spec_uint ("target-latency", "Target latency",
+          "Target end-to-end latency (ms) to downstream tensor_filter elements. "
+          "Frames are dropped when the latency reported by downstream filters "
+          "exceeds the target (0: disabled).",
+          0, G_MAXUINT, DEFAULT_TARGET_LATENCY,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 }
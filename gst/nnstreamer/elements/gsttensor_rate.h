@@ -56,12 +56,14 @@ struct _GstTensorRate
   guint64 prev_ts;              /**< Previous buffer timestamp */
   guint64 next_ts;              /**< Timestamp of next buffer to output */
   guint64 last_ts;              /**< Timestamp of last input buffer */
+  guint64 last_admit_ts;        /**< Timestamp of last buffer admitted under target latency */
 
   /** Properties */
   guint64 in, out, dup, drop;   /**< stat property */
   gint rate_n, rate_d;          /**< framerate property */
   gboolean silent;              /**< debug property */
   gboolean throttle;            /**< throttle property */
+  guint target_latency;         /**< target latency property (ms) */
 };
 
 /**
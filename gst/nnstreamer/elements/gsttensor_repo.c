@@ -42,6 +42,45 @@ static GstTensorRepo _repo = {.num_data = 0,.initialized = FALSE };
 #define GST_REPO_WAIT() (g_cond_wait(&_repo.repo_cond, &_repo.repo_lock))
 #define GST_REPO_BROADCAST() (g_cond_broadcast (&_repo.repo_cond))
 
+/**
+ * @brief Macro to get the number of buffers in the slot.
+ * Producer (reposink) updates head and consumer (reposrc) updates tail, so the ring is accessed without locking.
+ * Head and tail are kept in [0, 2 * depth), to distinguish the full ring from the empty one without overflow.
+ */
+#define GST_REPO_DATA_COUNT(d) \
+    ((guint) ((g_atomic_int_get (&(d)->head) - g_atomic_int_get (&(d)->tail) \
+        + 2 * (gint) (d)->depth) % (2 * (gint) (d)->depth)))
+
+/**
+ * @brief Macro to advance head or tail of the slot. Only one thread updates each of them.
+ */
+#define GST_REPO_DATA_ADVANCE(d,pos) \
+    g_atomic_int_set (&(d)->pos, (g_atomic_int_get (&(d)->pos) + 1) % (2 * (gint) (d)->depth))
+
+/**
+ * @brief Internal function to clear the buffers in the slot.
+ * @note Caller should hold the lock of slot.
+ */
+static void
+gst_tensor_repo_clear_buffers (GstTensorRepoData * data)
+{
+  guint i;
+
+  for (i = 0; i < data->depth; i++) {
+    if (data->buffers[i]) {
+      gst_buffer_unref (data->buffers[i]);
+      data->buffers[i] = NULL;
+    }
+    if (data->caps[i]) {
+      gst_caps_unref (data->caps[i]);
+      data->caps[i] = NULL;
+    }
+  }
+
+  g_atomic_int_set (&data->head, 0);
+  g_atomic_int_set (&data->tail, 0);
+}
+
 /**
  * @brief Getter to get nth GstTensorRepoData.
  */
@@ -135,8 +174,11 @@ gst_tensor_repo_add_repodata (guint nth, gboolean is_sink)
 
   g_mutex_lock (&data->lock);
   data->eos = FALSE;
-  data->buffer = NULL;
-  data->caps = NULL;
+  data->depth = GST_TENSOR_REPO_DEFAULT_DEPTH;
+  data->buffers = g_new0 (GstBuffer *, data->depth);
+  data->caps = g_new0 (GstCaps *, data->depth);
+  data->head = data->tail = 0;
+  data->wait_push = data->wait_pull = 0;
   data->sink_changed = FALSE;
   data->src_changed = FALSE;
   data->pushed = FALSE;
@@ -165,42 +207,89 @@ gboolean
 gst_tensor_repo_set_buffer (guint nth, GstBuffer * buffer, GstCaps * caps)
 {
   GstTensorRepoData *data;
+  guint idx;
 
   data = gst_tensor_repo_get_repodata (nth);
 
   g_return_val_if_fail (data != NULL, FALSE);
 
-  g_mutex_lock (&data->lock);
+  if (GST_REPO_DATA_COUNT (data) >= data->depth) {
+    g_mutex_lock (&data->lock);
+    g_atomic_int_set (&data->wait_pull, 1);
 
-  while (data->buffer != NULL && !data->eos) {
-    /* wait pull */
-    g_cond_wait (&data->cond_pull, &data->lock);
-  }
+    while (GST_REPO_DATA_COUNT (data) >= data->depth && !data->eos) {
+      /* wait pull */
+      g_cond_wait (&data->cond_pull, &data->lock);
+    }
 
-  if (data->eos) {
+    g_atomic_int_set (&data->wait_pull, 0);
     g_mutex_unlock (&data->lock);
-    return FALSE;
   }
 
-  data->buffer = gst_buffer_copy_deep (buffer);
-  if (!data->caps || !gst_caps_is_equal (data->caps, caps)) {
-    if (data->caps)
-      gst_caps_unref (data->caps);
-    data->caps = gst_caps_copy (caps);
-  }
+  if (g_atomic_int_get (&data->eos))
+    return FALSE;
+
+  idx = ((guint) g_atomic_int_get (&data->head)) % data->depth;
+
+  data->buffers[idx] = gst_buffer_copy_deep (buffer);
+  data->caps[idx] = gst_caps_ref (caps);
 
   if (DBG) {
-    unsigned long size = gst_buffer_get_size (data->buffer);
+    unsigned long size = gst_buffer_get_size (data->buffers[idx]);
     GST_DEBUG ("Pushed [%d] (size : %lu)\n", nth, size);
   }
 
-  /* signal push */
-  g_cond_signal (&data->cond_push);
+  /* publish the buffer, consumer may get it without locking. */
+  GST_REPO_DATA_ADVANCE (data, head);
+
+  if (g_atomic_int_get (&data->wait_push)) {
+    /* signal push */
+    g_mutex_lock (&data->lock);
+    g_cond_signal (&data->cond_push);
+    g_mutex_unlock (&data->lock);
+  }
 
-  g_mutex_unlock (&data->lock);
   return TRUE;
 }
 
+/**
+ * @brief Set the number of buffers in the slot.
+ * @note The buffers in the slot should be consumed before changing the depth.
+ */
+gboolean
+gst_tensor_repo_set_depth (guint nth, guint depth)
+{
+  GstTensorRepoData *data;
+  gboolean ret = FALSE;
+
+  data = gst_tensor_repo_get_repodata (nth);
+
+  g_return_val_if_fail (data != NULL, FALSE);
+  g_return_val_if_fail (depth > 0 && depth <= GST_TENSOR_REPO_MAX_DEPTH,
+      FALSE);
+
+  g_mutex_lock (&data->lock);
+
+  if (data->depth == depth) {
+    ret = TRUE;
+  } else if (GST_REPO_DATA_COUNT (data) == 0) {
+    gst_tensor_repo_clear_buffers (data);
+
+    g_free (data->buffers);
+    g_free (data->caps);
+
+    data->depth = depth;
+    data->buffers = g_new0 (GstBuffer *, depth);
+    data->caps = g_new0 (GstCaps *, depth);
+    ret = TRUE;
+  } else {
+    GST_ERROR ("Cannot change the depth of slot [%d], buffers in use.", nth);
+  }
+
+  g_mutex_unlock (&data->lock);
+  return ret;
+}
+
 /**
  * @brief Check EOS (End-of-Stream) of slot.
  */
@@ -266,7 +355,7 @@ gst_tensor_repo_set_eos (guint nth)
 
   g_mutex_lock (&data->lock);
 
-  data->eos = TRUE;
+  g_atomic_int_set (&data->eos, TRUE);
   g_cond_signal (&data->cond_push);
   g_cond_signal (&data->cond_pull);
 
@@ -283,42 +372,55 @@ gst_tensor_repo_get_buffer (guint nth, gboolean * eos, guint * newid,
 {
   GstTensorRepoData *data;
   GstBuffer *buf = NULL;
+  guint idx;
 
   data = gst_tensor_repo_get_repodata (nth);
 
   g_return_val_if_fail (data != NULL, NULL);
 
-  g_mutex_lock (&data->lock);
-
-  while (!data->buffer) {
-    if (gst_tensor_repo_check_changed (nth, newid, FALSE)) {
-      buf = NULL;
-      goto done;
-    }
-
-    if (gst_tensor_repo_check_eos (nth)) {
-      *eos = TRUE;
-      buf = NULL;
-      goto done;
+  if (GST_REPO_DATA_COUNT (data) == 0) {
+    g_mutex_lock (&data->lock);
+    g_atomic_int_set (&data->wait_push, 1);
+
+    while (GST_REPO_DATA_COUNT (data) == 0) {
+      if (gst_tensor_repo_check_changed (nth, newid, FALSE) ||
+          gst_tensor_repo_check_eos (nth)) {
+        *eos = data->eos;
+        g_atomic_int_set (&data->wait_push, 0);
+        g_mutex_unlock (&data->lock);
+        return NULL;
+      }
+
+      /* wait push */
+      g_cond_wait (&data->cond_push, &data->lock);
     }
 
-    /* wait push */
-    g_cond_wait (&data->cond_push, &data->lock);
+    g_atomic_int_set (&data->wait_push, 0);
+    g_mutex_unlock (&data->lock);
   }
 
-  /* Current buffer will be wasted. */
-  buf = data->buffer;
-  *caps = gst_caps_ref (data->caps);
+  idx = ((guint) g_atomic_int_get (&data->tail)) % data->depth;
+
+  buf = data->buffers[idx];
+  *caps = data->caps[idx];
+  data->buffers[idx] = NULL;
+  data->caps[idx] = NULL;
+
   if (DBG) {
     unsigned long size = gst_buffer_get_size (buf);
     GST_DEBUG ("Popped [ %d ] (size: %lu)\n", nth, size);
   }
 
-done:
-  data->buffer = NULL;
-  /* signal pull */
-  g_cond_signal (&data->cond_pull);
-  g_mutex_unlock (&data->lock);
+  /* release the entry to producer. */
+  GST_REPO_DATA_ADVANCE (data, tail);
+
+  if (g_atomic_int_get (&data->wait_pull)) {
+    /* signal pull */
+    g_mutex_lock (&data->lock);
+    g_cond_signal (&data->cond_pull);
+    g_mutex_unlock (&data->lock);
+  }
+
   return buf;
 }
 
@@ -338,10 +440,9 @@ gst_tensor_repo_remove_repodata (guint nth)
 
   if (data) {
     g_mutex_lock (&data->lock);
-    if (data->buffer)
-      gst_buffer_unref (data->buffer);
-    if (data->caps)
-      gst_caps_unref (data->caps);
+    gst_tensor_repo_clear_buffers (data);
+    g_free (data->buffers);
+    g_free (data->caps);
     g_mutex_unlock (&data->lock);
 
     g_mutex_clear (&data->lock);
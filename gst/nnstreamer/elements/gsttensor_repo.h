@@ -39,8 +39,13 @@ G_BEGIN_DECLS
  */
 typedef struct
 {
-  GstBuffer *buffer;
-  GstCaps *caps;
+  GstBuffer **buffers; /**< ring of buffers, single producer (reposink) and single consumer (reposrc) */
+  GstCaps **caps; /**< caps of each buffer in the ring */
+  guint depth; /**< the number of buffers in the ring */
+  gint head; /**< position to push, modulo 2 * depth (updated by producer) */
+  gint tail; /**< position to pull, modulo 2 * depth (updated by consumer) */
+  gint wait_push; /**< consumer is waiting for new buffer */
+  gint wait_pull; /**< producer is waiting for free entry */
   GCond cond_push;
   GCond cond_pull;
   GMutex lock;
@@ -52,6 +57,16 @@ typedef struct
   gboolean pushed;
 } GstTensorRepoData;
 
+/**
+ * @brief Default number of buffers in a slot.
+ */
+#define GST_TENSOR_REPO_DEFAULT_DEPTH (1)
+
+/**
+ * @brief Max number of buffers in a slot.
+ */
+#define GST_TENSOR_REPO_MAX_DEPTH (64)
+
 /**
  * @brief GstTensorRepo data structure.
  */
@@ -82,6 +97,12 @@ gst_tensor_repo_add_repodata (guint myid, gboolean is_sink);
 gboolean
 gst_tensor_repo_set_buffer (guint nth, GstBuffer * buffer, GstCaps * caps);
 
+/**
+ * @brief Set the number of buffers in the slot.
+ */
+gboolean
+gst_tensor_repo_set_depth (guint nth, guint depth);
+
 /**
  * @brief Check EOS (End-of-Stream) of slot.
  */
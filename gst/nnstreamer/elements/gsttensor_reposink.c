@@ -47,13 +47,15 @@ enum
   PROP_0,
   PROP_SIGNAL_RATE,
   PROP_SLOT,
-  PROP_SILENT
+  PROP_SILENT,
+  PROP_DEPTH
 };
 
 #define DEFAULT_SIGNAL_RATE 0
 #define DEFAULT_SILENT TRUE
 #define DEFAULT_QOS TRUE
 #define DEFAULT_INDEX 0
+#define DEFAULT_DEPTH GST_TENSOR_REPO_DEFAULT_DEPTH
 
 static void gst_tensor_reposink_set_property (GObject * object, guint prop_id,
     const GValue * value, GParamSpec * pspec);
@@ -116,6 +118,14 @@ gst_tensor_reposink_class_init (GstTensorRepoSinkClass * klass)
       g_param_spec_boolean ("silent", "Silent", "Produce verbose output",
           DEFAULT_SILENT, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  g_object_class_install_property (gobject_class, PROP_DEPTH,
+      g_param_spec_uint ("depth", "Depth",
+          "The number of buffers in the repository slot. "
+          "Set larger than 1 to let tensor_reposrc pull the buffers while tensor_reposink pushes new buffers.",
+          1, GST_TENSOR_REPO_MAX_DEPTH, DEFAULT_DEPTH,
+          G_PARAM_READWRITE | GST_PARAM_MUTABLE_READY |
+          G_PARAM_STATIC_STRINGS));
+
   gst_element_class_set_static_metadata (element_class,
       "TensorRepoSink",
       "Sink/Tensor/Repository",
@@ -157,6 +167,7 @@ gst_tensor_reposink_init (GstTensorRepoSink * self)
 
   self->silent = DEFAULT_SILENT;
   self->signal_rate = DEFAULT_SIGNAL_RATE;
+  self->depth = DEFAULT_DEPTH;
   self->last_render_time = GST_CLOCK_TIME_NONE;
   self->set_startid = FALSE;
   self->in_caps = NULL;
@@ -191,6 +202,7 @@ gst_tensor_reposink_set_property (GObject * object, guint prop_id,
       self->myid = g_value_get_uint (value);
 
       gst_tensor_repo_add_repodata (self->myid, TRUE);
+      gst_tensor_repo_set_depth (self->myid, self->depth);
 
       if (!self->set_startid) {
         self->o_myid = self->myid;
@@ -200,6 +212,15 @@ gst_tensor_reposink_set_property (GObject * object, guint prop_id,
       if (self->o_myid != self->myid)
         gst_tensor_repo_set_changed (self->o_myid, self->myid, TRUE);
       break;
+    case PROP_DEPTH:
+      self->depth = g_value_get_uint (value);
+
+      if (self->set_startid &&
+          !gst_tensor_repo_set_depth (self->myid, self->depth)) {
+        GST_WARNING_OBJECT (self, "Failed to set the depth of slot [%d].",
+            self->myid);
+      }
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -227,6 +248,9 @@ gst_tensor_reposink_get_property (GObject * object, guint prop_id,
     case PROP_SLOT:
       g_value_set_uint (value, self->myid);
       break;
+    case PROP_DEPTH:
+      g_value_set_uint (value, self->depth);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
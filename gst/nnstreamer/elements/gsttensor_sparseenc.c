@@ -24,7 +24,7 @@
  * <title>Example launch line</title>
  * |[
  * gst-launch-1.0 ... ! other/tensors,format=static ! \
- *    tensor_sparse_enc ! tensor_sink
+ *    tensor_sparse_enc encoding=bitmap ! tensor_sink
  * ]|
  * </refsect2>
  */
@@ -53,7 +53,8 @@ GST_DEBUG_CATEGORY_STATIC (gst_tensor_sparse_enc_debug);
 enum
 {
   PROP_0,
-  PROP_SILENT
+  PROP_SILENT,
+  PROP_ENCODING
 };
 
 /**
@@ -61,6 +62,11 @@ enum
  */
 #define DEFAULT_SILENT TRUE
 
+/**
+ * @brief Default encoding of sparse tensor.
+ */
+#define DEFAULT_ENCODING _NNS_SPARSE_ENCODING_COO
+
 /**
  * @brief Template for sink pad.
  */
@@ -122,6 +128,22 @@ gst_tensor_sparse_enc_class_init (GstTensorSparseEncClass * klass)
       g_param_spec_boolean ("silent", "Silent", "Produce verbose output",
           DEFAULT_SILENT, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstTensorSparseEnc::encoding:
+   *
+   * The encoding of indices in sparse tensor.
+   * coo: 32-bit index for each non-zero element (default)
+   * bitmap: 1 bit for each element
+   * delta: varint-coded distance between non-zero elements
+   * csr: compressed sparse row along the innermost dimension
+   * auto: the smallest one for each tensor
+   */
+  g_object_class_install_property (object_class, PROP_ENCODING,
+      g_param_spec_string ("encoding", "Encoding",
+          "The encoding of sparse tensor (coo, bitmap, delta, csr or auto)",
+          gst_tensor_sparse_get_encoding_string (DEFAULT_ENCODING),
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_add_pad_template (element_class,
       gst_static_pad_template_get (&src_template));
 
@@ -162,6 +184,7 @@ gst_tensor_sparse_enc_init (GstTensorSparseEnc * self)
 
   /* init properties */
   self->silent = DEFAULT_SILENT;
+  self->encoding = DEFAULT_ENCODING;
   gst_tensors_config_init (&self->in_config);
 }
 
@@ -194,6 +217,19 @@ gst_tensor_sparse_enc_set_property (GObject * object, guint prop_id,
     case PROP_SILENT:
       self->silent = g_value_get_boolean (value);
       break;
+    case PROP_ENCODING:
+    {
+      const gchar *str = g_value_get_string (value);
+      tensor_sparse_encoding encoding = gst_tensor_sparse_get_encoding (str);
+
+      if (encoding > GST_TENSOR_SPARSE_ENCODING_AUTO) {
+        GST_ERROR_OBJECT (self, "Invalid encoding %s.", GST_STR_NULL (str));
+        break;
+      }
+
+      self->encoding = encoding;
+      break;
+    }
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -215,6 +251,10 @@ gst_tensor_sparse_enc_get_property (GObject * object, guint prop_id,
     case PROP_SILENT:
       g_value_set_boolean (value, self->silent);
       break;
+    case PROP_ENCODING:
+      g_value_set_string (value,
+          gst_tensor_sparse_get_encoding_string (self->encoding));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -390,6 +430,7 @@ gst_tensor_sparse_enc_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
 
     meta.format = _NNS_TENSOR_FORMAT_SPARSE;
     meta.media_type = _NNS_TENSOR;
+    meta.sparse_info.encoding = self->encoding;
 
     /* do real encoding here */
     mem = gst_buffer_peek_memory (buf, i);
@@ -45,6 +45,7 @@ struct _GstTensorSparseEnc
   /* <private> */
   GstTensorsConfig in_config; /**< input tensors config */
   gboolean silent; /**< true to print minimized log */
+  tensor_sparse_encoding encoding; /**< encoding of sparse tensor */
 };
 
 /**
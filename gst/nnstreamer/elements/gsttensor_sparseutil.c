@@ -17,6 +17,305 @@
 #include <tensor_data.h>
 #include "gsttensor_sparseutil.h"
 
+/**
+ * @brief The max number of columns to use 16-bit column index in CSR encoding.
+ */
+#define SPARSE_CSR_SHORT_COLUMNS (65536U)
+
+/**
+ * @brief Internal data structure to encode non-zero elements.
+ * The encoder runs twice, first to count non-zero elements and index size (values and indices are null), then to write the sparse data.
+ */
+typedef struct
+{
+  tensor_sparse_encoding encoding; /**< encoding of indices */
+  guint nnz; /**< the number of non-zero elements */
+  gulong next; /**< next index of previous non-zero element (delta encoding) */
+  gsize delta_size; /**< the size of varint-coded indices */
+  guint32 columns; /**< the number of columns (CSR encoding) */
+  guint8 *values; /**< pointer to write the values */
+  guint8 *indices; /**< pointer to write the indices */
+  guint8 *columns_index; /**< pointer to write the column indices (CSR encoding) */
+} sparse_encoder_s;
+
+/**
+ * @brief Internal function to get the number of bytes for varint-coded value.
+ */
+static inline gsize
+_sparse_varint_size (gulong val)
+{
+  gsize size = 1;
+
+  while (val >= 0x80) {
+    val >>= 7;
+    size++;
+  }
+
+  return size;
+}
+
+/**
+ * @brief Internal function to write varint-coded value.
+ */
+static inline gsize
+_sparse_varint_write (guint8 * dest, gulong val)
+{
+  gsize size = 0;
+
+  while (val >= 0x80) {
+    dest[size++] = (guint8) (val | 0x80);
+    val >>= 7;
+  }
+
+  dest[size++] = (guint8) val;
+  return size;
+}
+
+/**
+ * @brief Internal function to read varint-coded value.
+ * @return The number of bytes read, 0 if the data is invalid.
+ */
+static inline gsize
+_sparse_varint_read (const guint8 * src, gsize limit, gulong * val)
+{
+  gsize size = 0;
+  guint shift = 0;
+
+  *val = 0;
+  while (size < limit && shift < sizeof (gulong) * 8) {
+    *val |= ((gulong) (src[size] & 0x7F)) << shift;
+
+    if ((src[size++] & 0x80) == 0)
+      return size;
+
+    shift += 7;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Internal function to read 32-bit index from unaligned memory.
+ */
+static inline guint32
+_sparse_read_u32 (const guint8 * src, gsize idx)
+{
+  guint32 val;
+
+  memcpy (&val, src + idx * sizeof (guint32), sizeof (guint32));
+  return val;
+}
+
+/**
+ * @brief Internal function to write 32-bit index into unaligned memory.
+ */
+static inline void
+_sparse_write_u32 (guint8 * dest, gsize idx, guint32 val)
+{
+  memcpy (dest + idx * sizeof (guint32), &val, sizeof (guint32));
+}
+
+/**
+ * @brief Internal function to add the index of non-zero element.
+ */
+static inline void
+_sparse_encoder_add (sparse_encoder_s * enc, gulong idx)
+{
+  switch (enc->encoding) {
+    case _NNS_SPARSE_ENCODING_COO:
+      if (enc->indices)
+        _sparse_write_u32 (enc->indices, enc->nnz, (guint32) idx);
+      break;
+    case _NNS_SPARSE_ENCODING_BITMAP:
+      if (enc->indices)
+        enc->indices[idx >> 3] |= (guint8) (1U << (idx & 7));
+      break;
+    case _NNS_SPARSE_ENCODING_CSR:
+      if (enc->indices) {
+        gulong row = idx / enc->columns;
+        guint32 col = (guint32) (idx % enc->columns);
+
+        _sparse_write_u32 (enc->indices, row + 1,
+            _sparse_read_u32 (enc->indices, row + 1) + 1);
+
+        if (enc->columns <= SPARSE_CSR_SHORT_COLUMNS) {
+          guint16 col16 = (guint16) col;
+          memcpy (enc->columns_index + enc->nnz * sizeof (guint16), &col16,
+              sizeof (guint16));
+        } else {
+          _sparse_write_u32 (enc->columns_index, enc->nnz, col);
+        }
+      }
+      break;
+    default:
+      break;
+  }
+
+  /* varint-coded size is always counted to select the encoding. */
+  if (enc->indices && enc->encoding == _NNS_SPARSE_ENCODING_DELTA)
+    enc->delta_size +=
+        _sparse_varint_write (enc->indices + enc->delta_size, idx - enc->next);
+  else
+    enc->delta_size += _sparse_varint_size (idx - enc->next);
+
+  enc->next = idx + 1;
+  enc->nnz++;
+}
+
+/**
+ * @brief Macro to find non-zero elements of given type.
+ * This skips the zero elements in 8-byte chunk, then compares each element in non-zero chunk.
+ */
+#define SPARSE_ENCODE_TYPE(ttype,dtype,enc,data,count) \
+  case ttype: \
+  { \
+    const dtype *_v = (const dtype *) (data); \
+    const gulong _step = sizeof (guint64) / sizeof (dtype); \
+    gulong _i = 0, _end; \
+    guint64 _chunk; \
+    while (_i < (count)) { \
+      if (_i + _step <= (count)) { \
+        memcpy (&_chunk, &_v[_i], sizeof (guint64)); \
+        if (_chunk == 0) { \
+          _i += _step; \
+          continue; \
+        } \
+        _end = _i + _step; \
+      } else { \
+        _end = (count); \
+      } \
+      for (; _i < _end; _i++) { \
+        if (_v[_i] != (dtype) 0) { \
+          if ((enc)->values) \
+            ((dtype *) (enc)->values)[(enc)->nnz] = _v[_i]; \
+          _sparse_encoder_add ((enc), _i); \
+        } \
+      } \
+    } \
+    break; \
+  }
+
+/**
+ * @brief Internal function to run the encoder with given dense data.
+ */
+static gboolean
+_sparse_encode (sparse_encoder_s * enc, tensor_type type, const guint8 * data,
+    gulong count)
+{
+  switch (type) {
+    SPARSE_ENCODE_TYPE (_NNS_INT32, int32_t, enc, data, count);
+    SPARSE_ENCODE_TYPE (_NNS_UINT32, uint32_t, enc, data, count);
+    SPARSE_ENCODE_TYPE (_NNS_INT16, int16_t, enc, data, count);
+    SPARSE_ENCODE_TYPE (_NNS_UINT16, uint16_t, enc, data, count);
+    SPARSE_ENCODE_TYPE (_NNS_INT8, int8_t, enc, data, count);
+    SPARSE_ENCODE_TYPE (_NNS_UINT8, uint8_t, enc, data, count);
+    SPARSE_ENCODE_TYPE (_NNS_FLOAT64, double, enc, data, count);
+    SPARSE_ENCODE_TYPE (_NNS_FLOAT32, float, enc, data, count);
+    SPARSE_ENCODE_TYPE (_NNS_INT64, int64_t, enc, data, count);
+    SPARSE_ENCODE_TYPE (_NNS_UINT64, uint64_t, enc, data, count);
+    default:
+      nns_loge ("Error occured during get tensor value");
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Internal function to get the size of indices for given encoding.
+ */
+static gsize
+_sparse_get_index_size (tensor_sparse_encoding encoding, guint nnz,
+    gulong count, guint32 columns, gsize delta_size)
+{
+  switch (encoding) {
+    case _NNS_SPARSE_ENCODING_COO:
+      return sizeof (guint32) * nnz;
+    case _NNS_SPARSE_ENCODING_BITMAP:
+      return (count + 7) / 8;
+    case _NNS_SPARSE_ENCODING_DELTA:
+      return delta_size;
+    case _NNS_SPARSE_ENCODING_CSR:
+      return sizeof (guint32) * (count / columns + 1) +
+          ((columns <= SPARSE_CSR_SHORT_COLUMNS) ?
+          sizeof (guint16) : sizeof (guint32)) * nnz;
+    default:
+      break;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Internal function to copy an element from sparse values into dense tensor.
+ */
+static inline void
+_sparse_set_element (guint8 * output, gulong idx, const guint8 * input,
+    guint i, gsize element_size)
+{
+  switch (element_size) {
+    case 1:
+      output[idx] = input[i];
+      break;
+    case 2:
+      ((guint16 *) output)[idx] = ((const guint16 *) input)[i];
+      break;
+    case 4:
+      ((guint32 *) output)[idx] = ((const guint32 *) input)[i];
+      break;
+    case 8:
+      ((guint64 *) output)[idx] = ((const guint64 *) input)[i];
+      break;
+    default:
+      memcpy (output + idx * element_size, input + i * element_size,
+          element_size);
+      break;
+  }
+}
+
+/**
+ * @brief Get the name of sparse encoding.
+ * @param[in] encoding the encoding of sparse tensor
+ * @return The name of encoding, NULL if given encoding is invalid.
+ */
+const gchar *
+gst_tensor_sparse_get_encoding_string (tensor_sparse_encoding encoding)
+{
+  static const gchar *encoding_names[] = {
+    [_NNS_SPARSE_ENCODING_COO] = "coo",
+    [_NNS_SPARSE_ENCODING_BITMAP] = "bitmap",
+    [_NNS_SPARSE_ENCODING_DELTA] = "delta",
+    [_NNS_SPARSE_ENCODING_CSR] = "csr",
+    [_NNS_SPARSE_ENCODING_END] = "auto",
+  };
+
+  if (encoding > _NNS_SPARSE_ENCODING_END)
+    return NULL;
+
+  return encoding_names[encoding];
+}
+
+/**
+ * @brief Get the sparse encoding from string.
+ * @param[in] str the name of encoding (coo, bitmap, delta, csr or auto)
+ * @return The sparse encoding, GST_TENSOR_SPARSE_ENCODING_AUTO for "auto" or _NNS_SPARSE_ENCODING_END + 1 if given string is invalid.
+ */
+tensor_sparse_encoding
+gst_tensor_sparse_get_encoding (const gchar * str)
+{
+  guint i;
+
+  if (str) {
+    for (i = 0; i <= _NNS_SPARSE_ENCODING_END; i++) {
+      if (g_ascii_strcasecmp (str,
+              gst_tensor_sparse_get_encoding_string (i)) == 0)
+        return (tensor_sparse_encoding) i;
+    }
+  }
+
+  return (tensor_sparse_encoding) (_NNS_SPARSE_ENCODING_END + 1);
+}
+
 /**
  * @brief Make dense tensor with input sparse tensor.
  * @param[in,out] meta tensor meta structure to be updated
@@ -29,9 +328,9 @@ gst_tensor_sparse_to_dense (GstTensorMetaInfo * meta, GstMemory * mem)
   GstMemory *dense = NULL;
   GstMapInfo map;
   guint i, nnz;
-  guint8 *output, *input;
-  guint *indices;
-  gsize output_size, element_size;
+  guint8 *output, *input, *indices;
+  gsize output_size, element_size, header_size, index_size;
+  gulong idx, element_count;
 
   if (!gst_memory_map (mem, &map, GST_MAP_READ)) {
     nns_loge ("Failed to map given memory");
@@ -43,9 +342,19 @@ gst_tensor_sparse_to_dense (GstTensorMetaInfo * meta, GstMemory * mem)
     goto done;
   }
 
+  header_size = gst_tensor_meta_info_get_header_size (meta);
+  if (map.size < header_size + gst_tensor_meta_info_get_data_size (meta)) {
+    nns_loge ("The size of given memory is smaller than the sparse tensor");
+    goto done;
+  }
+
+  nnz = meta->sparse_info.nnz;
+  index_size = gst_tensor_meta_info_get_data_size (meta);
+
   meta->format = _NNS_TENSOR_FORMAT_STATIC;
 
   element_size = gst_tensor_get_element_size (meta->type);
+  element_count = gst_tensor_get_element_count (meta->dimension);
   output_size = gst_tensor_meta_info_get_data_size (meta);
 
   if (element_size == 0 || output_size == 0) {
@@ -53,49 +362,101 @@ gst_tensor_sparse_to_dense (GstTensorMetaInfo * meta, GstMemory * mem)
     goto done;
   }
 
+  index_size -= element_size * nnz;
+  input = map.data + header_size;
+  indices = input + element_size * nnz;
+
   output = (guint8 *) g_malloc0 (output_size);
 
-  nnz = meta->sparse_info.nnz;
-  input = map.data + gst_tensor_meta_info_get_header_size (meta);
-  indices = (guint *) (input + element_size * nnz);
-
-  for (i = 0; i < nnz; ++i) {
-    switch (meta->type) {
-      case _NNS_INT32:
-        ((int32_t *) output)[indices[i]] = ((int32_t *) input)[i];
-        break;
-      case _NNS_UINT32:
-        ((uint32_t *) output)[indices[i]] = ((uint32_t *) input)[i];
-        break;
-      case _NNS_INT16:
-        ((int16_t *) output)[indices[i]] = ((int16_t *) input)[i];
-        break;
-      case _NNS_UINT16:
-        ((uint16_t *) output)[indices[i]] = ((uint16_t *) input)[i];
-        break;
-      case _NNS_INT8:
-        ((int8_t *) output)[indices[i]] = ((int8_t *) input)[i];
-        break;
-      case _NNS_UINT8:
-        ((uint8_t *) output)[indices[i]] = ((uint8_t *) input)[i];
-        break;
-      case _NNS_FLOAT64:
-        ((double *) output)[indices[i]] = ((double *) input)[i];
-        break;
-      case _NNS_FLOAT32:
-        ((float *) output)[indices[i]] = ((float *) input)[i];
-        break;
-      case _NNS_INT64:
-        ((int64_t *) output)[indices[i]] = ((int64_t *) input)[i];
-        break;
-      case _NNS_UINT64:
-        ((uint64_t *) output)[indices[i]] = ((uint64_t *) input)[i];
-        break;
-      default:
-        nns_loge ("Error occured during get tensor value");
-        g_free (output);
-        goto done;
+  switch (meta->sparse_info.encoding) {
+    case _NNS_SPARSE_ENCODING_COO:
+      for (i = 0; i < nnz; ++i) {
+        idx = _sparse_read_u32 (indices, i);
+        if (idx >= element_count)
+          goto invalid_index;
+
+        _sparse_set_element (output, idx, input, i, element_size);
+      }
+      break;
+    case _NNS_SPARSE_ENCODING_BITMAP:
+    {
+      gsize b;
+      guint8 bits;
+
+      if (index_size < (element_count + 7) / 8)
+        goto invalid_index;
+
+      for (b = 0, i = 0; b < (element_count + 7) / 8; b++) {
+        /* skip the zero block */
+        for (bits = indices[b]; bits; bits &= (guint8) (bits - 1)) {
+          idx = b * 8 + g_bit_nth_lsf (bits, -1);
+          if (idx >= element_count || i >= nnz)
+            goto invalid_index;
+
+          _sparse_set_element (output, idx, input, i++, element_size);
+        }
+      }
+      break;
     }
+    case _NNS_SPARSE_ENCODING_DELTA:
+    {
+      gsize pos = 0, len;
+      gulong gap;
+
+      for (i = 0, idx = 0; i < nnz; ++i, ++idx) {
+        len = _sparse_varint_read (indices + pos, index_size - pos, &gap);
+        if (len == 0)
+          goto invalid_index;
+
+        pos += len;
+
+        /* check the gap before adding it, not to wrap around the index */
+        if (idx >= element_count || gap >= element_count - idx)
+          goto invalid_index;
+
+        idx += gap;
+
+        _sparse_set_element (output, idx, input, i, element_size);
+      }
+      break;
+    }
+    case _NNS_SPARSE_ENCODING_CSR:
+    {
+      guint32 columns = meta->dimension[0];
+      gulong r, rows = element_count / columns;
+      guint32 k, k_end, col;
+      guint8 *col_index = indices + sizeof (guint32) * (rows + 1);
+
+      if (index_size != _sparse_get_index_size (_NNS_SPARSE_ENCODING_CSR,
+              nnz, element_count, columns, 0))
+        goto invalid_index;
+
+      for (r = 0; r < rows; r++) {
+        k = _sparse_read_u32 (indices, r);
+        k_end = _sparse_read_u32 (indices, r + 1);
+        if (k_end < k || k_end > nnz)
+          goto invalid_index;
+
+        for (; k < k_end; k++) {
+          if (columns <= SPARSE_CSR_SHORT_COLUMNS) {
+            guint16 col16;
+            memcpy (&col16, col_index + k * sizeof (guint16), sizeof (guint16));
+            col = col16;
+          } else {
+            col = _sparse_read_u32 (col_index, k);
+          }
+
+          if (col >= columns)
+            goto invalid_index;
+
+          _sparse_set_element (output, r * columns + col, input, k,
+              element_size);
+        }
+      }
+      break;
+    }
+    default:
+      goto invalid_index;
   }
 
   dense = gst_memory_new_wrapped (0, output, output_size, 0, output_size,
@@ -104,6 +465,13 @@ gst_tensor_sparse_to_dense (GstTensorMetaInfo * meta, GstMemory * mem)
 done:
   gst_memory_unmap (mem, &map);
   return dense;
+
+invalid_index:
+  nns_loge ("Given sparse tensor has invalid indices (encoding %s)",
+      _STR_NULL (gst_tensor_sparse_get_encoding_string (meta->
+              sparse_info.encoding)));
+  g_free (output);
+  goto done;
 }
 
 /**
@@ -111,19 +479,19 @@ done:
  * @param[in,out] meta tensor meta structure to be updated
  * @param[in] mem gst-memory of dense tensor data
  * @return pointer of GstMemory with sparse tensor data or NULL on error. Caller should handle this newly allocated memory.
+ * @note The indices are encoded with meta->sparse_info.encoding. Set GST_TENSOR_SPARSE_ENCODING_AUTO to select the smallest one.
  */
 GstMemory *
 gst_tensor_sparse_from_dense (GstTensorMetaInfo * meta, GstMemory * mem)
 {
   GstMemory *sparse = NULL;
   GstMapInfo map;
-  guint i, nnz = 0;
   guint8 *output;
-  tensor_type data_type;
-  void *values;
-  guint *indices;
-  gsize output_size, header_size, element_size;
+  tensor_sparse_encoding encoding;
+  sparse_encoder_s enc;
+  gsize output_size, header_size, element_size, index_size;
   gulong element_count;
+  guint32 columns;
 
   if (!gst_memory_map (mem, &map, GST_MAP_READ)) {
     nns_loge ("Failed to map given memory");
@@ -133,118 +501,93 @@ gst_tensor_sparse_from_dense (GstTensorMetaInfo * meta, GstMemory * mem)
   header_size = gst_tensor_meta_info_get_header_size (meta);
   element_size = gst_tensor_get_element_size (meta->type);
   element_count = gst_tensor_get_element_count (meta->dimension);
+  columns = meta->dimension[0];
+  encoding = meta->sparse_info.encoding;
 
-  if (element_size == 0 || element_count == 0) {
+  if (element_size == 0 || element_count == 0 || element_count > G_MAXUINT32) {
     nns_loge ("Got invalid meta info");
     goto done;
   }
 
-  /** alloc maximum possible size of memory */
-  values = g_malloc0 (element_size * element_count);
-  indices = g_malloc0 (sizeof (guint) * element_count);
+  if (encoding > GST_TENSOR_SPARSE_ENCODING_AUTO) {
+    nns_loge ("Got invalid sparse encoding %u", encoding);
+    goto done;
+  }
 
-  data_type = meta->type;
+  if (map.size < element_size * element_count) {
+    nns_loge ("The size of given memory is smaller than the dense tensor");
+    goto done;
+  }
 
-  /** Consider using macro to reduce loc and readability */
-  for (i = 0; i < element_count; ++i) {
-    switch (data_type) {
-      case _NNS_INT32:
-        if (((int32_t *) map.data)[i] != 0) {
-          ((int32_t *) values)[nnz] = ((int32_t *) map.data)[i];
-          indices[nnz] = i;
-          nnz += 1;
-        }
-        break;
-      case _NNS_UINT32:
-        if (((uint32_t *) map.data)[i] != 0) {
-          ((uint32_t *) values)[nnz] = ((uint32_t *) map.data)[i];
-          indices[nnz] = i;
-          nnz += 1;
-        }
-        break;
-      case _NNS_INT16:
-        if (((int16_t *) map.data)[i] != 0) {
-          ((int16_t *) values)[nnz] = ((int16_t *) map.data)[i];
-          indices[nnz] = i;
-          nnz += 1;
-        }
-        break;
-      case _NNS_UINT16:
-        if (((uint16_t *) map.data)[i] != 0) {
-          ((uint16_t *) values)[nnz] = ((uint16_t *) map.data)[i];
-          indices[nnz] = i;
-          nnz += 1;
-        }
-        break;
-      case _NNS_INT8:
-        if (((int8_t *) map.data)[i] != 0) {
-          ((int8_t *) values)[nnz] = ((int8_t *) map.data)[i];
-          indices[nnz] = i;
-          nnz += 1;
-        }
-        break;
-      case _NNS_UINT8:
-        if (((uint8_t *) map.data)[i] != 0) {
-          ((uint8_t *) values)[nnz] = ((uint8_t *) map.data)[i];
-          indices[nnz] = i;
-          nnz += 1;
-        }
-        break;
-      case _NNS_FLOAT64:
-        if (((double *) map.data)[i] != 0) {
-          ((double *) values)[nnz] = ((double *) map.data)[i];
-          indices[nnz] = i;
-          nnz += 1;
-        }
-        break;
-      case _NNS_FLOAT32:
-        if (((float *) map.data)[i] != 0) {
-          ((float *) values)[nnz] = ((float *) map.data)[i];
-          indices[nnz] = i;
-          nnz += 1;
-        }
-        break;
-      case _NNS_INT64:
-        if (((int64_t *) map.data)[i] != 0) {
-          ((int64_t *) values)[nnz] = ((int64_t *) map.data)[i];
-          indices[nnz] = i;
-          nnz += 1;
-        }
-        break;
-      case _NNS_UINT64:
-        if (((uint64_t *) map.data)[i] != 0) {
-          ((uint64_t *) values)[nnz] = ((uint64_t *) map.data)[i];
-          indices[nnz] = i;
-          nnz += 1;
-        }
-        break;
-      default:
-        nns_loge ("Error occured during get tensor value");
-        g_free (values);
-        g_free (indices);
-        goto done;
+  /** count non-zero elements first, to allocate exact size of memory */
+  memset (&enc, 0, sizeof (sparse_encoder_s));
+  enc.encoding = encoding;
+  enc.columns = columns;
+
+  if (!_sparse_encode (&enc, meta->type, map.data, element_count))
+    goto done;
+
+  if (encoding == GST_TENSOR_SPARSE_ENCODING_AUTO) {
+    guint e;
+    gsize size;
+
+    encoding = _NNS_SPARSE_ENCODING_COO;
+    index_size = _sparse_get_index_size (encoding, enc.nnz, element_count,
+        columns, enc.delta_size);
+
+    for (e = _NNS_SPARSE_ENCODING_COO + 1; e < _NNS_SPARSE_ENCODING_END; e++) {
+      size = _sparse_get_index_size (e, enc.nnz, element_count, columns,
+          enc.delta_size);
+
+      if (size < index_size) {
+        encoding = (tensor_sparse_encoding) e;
+        index_size = size;
+      }
     }
+  } else {
+    index_size = _sparse_get_index_size (encoding, enc.nnz, element_count,
+        columns, enc.delta_size);
   }
 
   /** update meta nnz info */
   meta->format = _NNS_TENSOR_FORMAT_SPARSE;
-  meta->sparse_info.nnz = nnz;
+  meta->sparse_info.nnz = enc.nnz;
+  meta->sparse_info.encoding = encoding;
+  meta->sparse_info.index_size = index_size;
 
   /** write to output buffer */
-  output_size = element_size * nnz + sizeof (guint) * nnz;
-
-  /** add meta info header */
-  output_size += header_size;
-  output = g_malloc0 (output_size);
+  output_size = header_size + element_size * enc.nnz + index_size;
+  output = g_malloc (output_size);
 
   gst_tensor_meta_info_update_header (meta, output);
 
-  memcpy (output + header_size, values, element_size * nnz);
-  memcpy (output + header_size + (element_size * nnz),
-      indices, sizeof (guint) * nnz);
+  memset (&enc, 0, sizeof (sparse_encoder_s));
+  enc.encoding = encoding;
+  enc.columns = columns;
+  enc.values = output + header_size;
+  enc.indices = enc.values + element_size * meta->sparse_info.nnz;
+
+  /* bitmap and row pointers are accumulated */
+  if (encoding == _NNS_SPARSE_ENCODING_BITMAP) {
+    memset (enc.indices, 0, index_size);
+  } else if (encoding == _NNS_SPARSE_ENCODING_CSR) {
+    memset (enc.indices, 0, sizeof (guint32) * (element_count / columns + 1));
+    enc.columns_index =
+        enc.indices + sizeof (guint32) * (element_count / columns + 1);
+  }
 
-  g_free (values);
-  g_free (indices);
+  _sparse_encode (&enc, meta->type, map.data, element_count);
+
+  if (encoding == _NNS_SPARSE_ENCODING_CSR) {
+    gulong r;
+
+    /* row pointers from the number of non-zero elements in each row */
+    for (r = 0; r < element_count / columns; r++) {
+      _sparse_write_u32 (enc.indices, r + 1,
+          _sparse_read_u32 (enc.indices, r) +
+          _sparse_read_u32 (enc.indices, r + 1));
+    }
+  }
 
   sparse = gst_memory_new_wrapped (0, output, output_size, 0, output_size,
       output, g_free);
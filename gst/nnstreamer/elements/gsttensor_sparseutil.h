@@ -20,6 +20,11 @@
 
 G_BEGIN_DECLS
 
+/**
+ * @brief Pseudo encoding to select the smallest sparse encoding for each tensor.
+ */
+#define GST_TENSOR_SPARSE_ENCODING_AUTO (_NNS_SPARSE_ENCODING_END)
+
 /**
  * @brief Make dense tensor with input sparse tensor.
  * @param[in,out] meta tensor meta structure to be updated
@@ -34,9 +39,26 @@ gst_tensor_sparse_to_dense (GstTensorMetaInfo * meta, GstMemory * mem);
  * @param[in,out] meta tensor meta structure to be updated
  * @param[in] mem gst-memory of dense tensor data
  * @return pointer of GstMemory with sparse tensor data or NULL on error. Caller should handle this newly allocated memory.
+ * @note The indices are encoded with meta->sparse_info.encoding. Set GST_TENSOR_SPARSE_ENCODING_AUTO to select the smallest one.
  */
 extern GstMemory *
 gst_tensor_sparse_from_dense (GstTensorMetaInfo * meta, GstMemory * mem);
 
+/**
+ * @brief Get the name of sparse encoding.
+ * @param[in] encoding the encoding of sparse tensor
+ * @return The name of encoding, NULL if given encoding is invalid.
+ */
+extern const gchar *
+gst_tensor_sparse_get_encoding_string (tensor_sparse_encoding encoding);
+
+/**
+ * @brief Get the sparse encoding from string.
+ * @param[in] str the name of encoding (coo, bitmap, delta, csr or auto)
+ * @return The sparse encoding, GST_TENSOR_SPARSE_ENCODING_AUTO for "auto" or _NNS_SPARSE_ENCODING_END + 1 if given string is invalid.
+ */
+extern tensor_sparse_encoding
+gst_tensor_sparse_get_encoding (const gchar * str);
+
 G_END_DECLS
 #endif /* __GST_TENSOR_SPARSE_UTIL_H__ */
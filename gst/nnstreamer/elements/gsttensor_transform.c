@@ -57,6 +57,16 @@
 #include "nnstreamer-orc.h"
 #endif
 
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#include <immintrin.h>
+
+#define X86_SIMD_ENABLED
+#endif
+
+#if defined(FLOAT16_SUPPORT) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 /**
  * @brief Macro for debug mode.
  */
@@ -78,6 +88,11 @@ GST_DEBUG_CATEGORY_STATIC (gst_tensor_transform_debug);
     "(((add|mul|div)(:([-+]?[0-9]*\\.?[0-9]+([eE][-+]?[0-9]+)?))+(@[0-9]+)?)(,|))+$"
 
 #define REGEX_ARITH_OPTION_TYPECAST "(typecast:([u]?int(8|16|32|64)|float(16|32|64)))"
+#define REGEX_QUANT_PARAMS "(per-channel:(false|true@[0-9]+),)?"\
+    "scale:[-+]?[0-9]*\\.?[0-9]+([eE][-+]?[0-9]+)?(:[-+]?[0-9]*\\.?[0-9]+([eE][-+]?[0-9]+)?)*"\
+    "(,zero-point:[-+]?[0-9]+(:[-+]?[0-9]+)*)?$"
+#define REGEX_QUANTIZE_OPTION "^[u]?int(8|16|32)," REGEX_QUANT_PARAMS
+#define REGEX_DEQUANTIZE_OPTION "^float(32|64)," REGEX_QUANT_PARAMS
 
 /**
  * @brief The transpose rank is fixed to 4.
@@ -96,7 +111,9 @@ enum
   PROP_OPTION,
   PROP_ACCELERATION,
   PROP_APPLY,
-  PROP_TRANSPOSE_RANK_LIMIT
+  PROP_TRANSPOSE_RANK_LIMIT,
+  PROP_STATS,
+  PROP_STATS_INTERVAL
 };
 
 /**
@@ -161,10 +178,14 @@ static gboolean gst_tensor_transform_set_caps (GstBaseTransform * trans,
 static gboolean gst_tensor_transform_transform_size (GstBaseTransform * trans,
     GstPadDirection direction, GstCaps * caps, gsize size,
     GstCaps * othercaps, gsize * othersize);
+static gboolean gst_tensor_transform_start (GstBaseTransform * trans);
+static gboolean gst_tensor_transform_sink_event (GstBaseTransform * trans,
+    GstEvent * event);
 
 static gboolean gst_tensor_transform_convert_dimension (GstTensorTransform *
     filter, GstPadDirection direction, guint idx, const GstTensorInfo * in_info,
     GstTensorInfo * out_info);
+static void gst_tensor_transform_select_kernels (void);
 
 #define GST_TYPE_TENSOR_TRANSFORM_MODE (gst_tensor_transform_mode_get_type ())
 /**
@@ -196,6 +217,12 @@ gst_tensor_transform_mode_get_type (void)
       {GTT_CLAMP, "Mode for clamping all elements of tensor into the range, "
             "option=CLAMP_MIN:CLAMP_MAX",
           "clamp"},
+      {GTT_QUANTIZE, "Mode for quantizing tensor with scale and zero-point, "
+            "option=TYPE,[per-channel:(false|true@DIM),]scale:SCALE[:SCALE...][,zero-point:ZP[:ZP...]]",
+          "quantize"},
+      {GTT_DEQUANTIZE, "Mode for dequantizing tensor with scale and zero-point, "
+            "option=TYPE,[per-channel:(false|true@DIM),]scale:SCALE[:SCALE...][,zero-point:ZP[:ZP...]]",
+          "dequantize"},
       {GTT_UNKNOWN, "Unknown or not-implemented-yet mode",
           "unknown"},
       {0, NULL, NULL},
@@ -250,6 +277,16 @@ gst_tensor_transform_class_init (GstTensorTransformClass * klass)
           "The rank limit of transpose, which varies per version of nnstreamer and may be lower than the global rank limit if it is over 4.",
           0, NNS_TENSOR_RANK_LIMIT, NNS_TENSOR_TRANSPOSE_RANK_LIMIT,
           G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_STATS,
+      g_param_spec_boxed ("stats", "Statistics",
+          "Latency statistics of the transform, with the fields "
+          "count, p50, p95, p99 and max (latency in microseconds)",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_STATS_INTERVAL,
+      g_param_spec_uint ("stats-interval", "Statistics interval",
+          "Interval (ms) to post an element message with the latency "
+          "statistics (0: disabled)", 0, G_MAXUINT, 0,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
   gst_element_class_set_details_simple (gstelement_class,
       "TensorTransform",
@@ -277,6 +314,12 @@ gst_tensor_transform_class_init (GstTensorTransformClass * klass)
   /* Allocation units */
   trans_class->transform_size =
       GST_DEBUG_FUNCPTR (gst_tensor_transform_transform_size);
+
+  trans_class->start = GST_DEBUG_FUNCPTR (gst_tensor_transform_start);
+  trans_class->sink_event =
+      GST_DEBUG_FUNCPTR (gst_tensor_transform_sink_event);
+
+  gst_tensor_transform_select_kernels ();
 }
 
 /**
@@ -293,11 +336,13 @@ gst_tensor_transform_init (GstTensorTransform * filter)
   filter->option = NULL;
   filter->loaded = FALSE;
   filter->operators = NULL;
+  filter->quant_params = NULL;
   filter->acceleration = DEFAULT_ACCELERATION;
   filter->apply = NULL;
 
   gst_tensors_config_init (&filter->in_config);
   gst_tensors_config_init (&filter->out_config);
+  gst_tensor_latency_stats_init (&filter->stats);
 }
 
 /**
@@ -346,7 +391,8 @@ float16_not_supported (void)
 #ifdef FLOAT16_SUPPORT
 /**
  * @brief Refrain from heavy operations on float16
- * @todo Remove this after applying SIMD or ORC
+ * @note The conversion kernels are applied if the other type is exactly represented in float32.
+ * Other types (e.g., int32, float64) are converted from/to float16 element by element.
  * */
 static void
 refrain_from_heavy_op_on_float16 (gulong n)
@@ -357,11 +403,245 @@ refrain_from_heavy_op_on_float16 (gulong n)
     if (warned)
       return;
     ml_logw
-        ("Tensor_transform implementation for float16 does not support SIMD. Heavy tensor-transform operations of float16 is not recommended. Try to apply heavy ops with other types (e.g., float32) and convert it to float16 at the time when it's really needed.\n");
+        ("Tensor_transform implementation for float16 does not support SIMD with 32/64-bit integer or float64. Heavy tensor-transform operations of float16 with these types is not recommended. Try to apply heavy ops with other types (e.g., float32) and convert it to float16 at the time when it's really needed.\n");
     warned = 1;
   }
 }
 
+/**
+ * @brief The number of elements converted at once from/to float16.
+ * The temporary buffers of a block fit in L1 cache.
+ */
+#define F16_BLOCK_SIZE (256)
+
+typedef void (*f16_to_f32_func) (const float16 * in, float *out, gsize num);
+typedef void (*f32_to_f16_func) (const float *in, float16 * out, gsize num);
+
+static f16_to_f32_func f16_to_f32_kernel = NULL;
+static f32_to_f16_func f32_to_f16_kernel = NULL;
+
+/**
+ * @brief Convert float16 values into float32 (scalar)
+ */
+static void
+f16_to_f32_scalar (const float16 * in, float *out, gsize num)
+{
+  gsize idx;
+
+  for (idx = 0; idx < num; idx++)
+    out[idx] = (float) in[idx];
+}
+
+/**
+ * @brief Convert float32 values into float16 (scalar), rounded to nearest even.
+ */
+static void
+f32_to_f16_scalar (const float *in, float16 * out, gsize num)
+{
+  gsize idx;
+
+  for (idx = 0; idx < num; idx++)
+    out[idx] = (float16) in[idx];
+}
+
+#if defined (X86_SIMD_ENABLED)
+/**
+ * @brief Convert float16 values into float32 (F16C)
+ */
+__attribute__ ((target ("avx,f16c")))
+static void
+f16_to_f32_f16c (const float16 * in, float *out, gsize num)
+{
+  gsize idx;
+
+  for (idx = 0; idx + 8 <= num; idx += 8) {
+    __m128i v_h = _mm_loadu_si128 ((const __m128i *) (in + idx));
+
+    _mm256_storeu_ps (out + idx, _mm256_cvtph_ps (v_h));
+  }
+
+  /* handle remaining data */
+  f16_to_f32_scalar (in + idx, out + idx, num - idx);
+}
+
+/**
+ * @brief Convert float32 values into float16 (F16C), rounded to nearest even.
+ */
+__attribute__ ((target ("avx,f16c")))
+static void
+f32_to_f16_f16c (const float *in, float16 * out, gsize num)
+{
+  gsize idx;
+
+  for (idx = 0; idx + 8 <= num; idx += 8) {
+    __m256 v_f = _mm256_loadu_ps (in + idx);
+
+    _mm_storeu_si128 ((__m128i *) (out + idx),
+        _mm256_cvtps_ph (v_f, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+  }
+
+  /* handle remaining data */
+  f32_to_f16_scalar (in + idx, out + idx, num - idx);
+}
+#elif defined (__aarch64__)
+/**
+ * @brief Convert float16 values into float32 (NEON)
+ */
+static void
+f16_to_f32_neon (const float16 * in, float *out, gsize num)
+{
+  gsize idx;
+
+  for (idx = 0; idx + 8 <= num; idx += 8) {
+    float16x8_t v_h = vld1q_f16 ((const float16_t *) (in + idx));
+
+    vst1q_f32 (out + idx, vcvt_f32_f16 (vget_low_f16 (v_h)));
+    vst1q_f32 (out + idx + 4, vcvt_high_f32_f16 (v_h));
+  }
+
+  /* handle remaining data */
+  f16_to_f32_scalar (in + idx, out + idx, num - idx);
+}
+
+/**
+ * @brief Convert float32 values into float16 (NEON), rounded to nearest even.
+ */
+static void
+f32_to_f16_neon (const float *in, float16 * out, gsize num)
+{
+  gsize idx;
+
+  for (idx = 0; idx + 8 <= num; idx += 8) {
+    float16x4_t v_lo = vcvt_f16_f32 (vld1q_f32 (in + idx));
+    float16x8_t v_h = vcvt_high_f16_f32 (v_lo, vld1q_f32 (in + idx + 4));
+
+    vst1q_f16 ((float16_t *) (out + idx), v_h);
+  }
+
+  /* handle remaining data */
+  f32_to_f16_scalar (in + idx, out + idx, num - idx);
+}
+#endif
+
+/**
+ * @brief Check the values of given type are exactly represented in float32.
+ */
+#define f32_exact_type(t) ((t) == _NNS_FLOAT16 || (t) == _NNS_FLOAT32 || \
+    (t) == _NNS_INT8 || (t) == _NNS_UINT8 || (t) == _NNS_INT16 || (t) == _NNS_UINT16)
+
+/**
+ * @brief Load the values into float32 array.
+ * @return FALSE if the values of given type cannot be exactly represented in float32.
+ */
+static gboolean
+gst_tensor_transform_load_f32 (const uint8_t * in, tensor_type type,
+    float *out, gsize num)
+{
+  gsize idx;
+
+#define _load_f32(itype) do { \
+    const itype *_in = (const itype *) in; \
+    for (idx = 0; idx < num; idx++) \
+      out[idx] = (float) _in[idx]; \
+  } while (0)
+
+  switch (type) {
+    case _NNS_FLOAT16:
+      f16_to_f32_kernel ((const float16 *) in, out, num);
+      break;
+    case _NNS_FLOAT32:
+      memcpy (out, in, num * sizeof (float));
+      break;
+    case _NNS_INT8:
+      _load_f32 (int8_t);
+      break;
+    case _NNS_UINT8:
+      _load_f32 (uint8_t);
+      break;
+    case _NNS_INT16:
+      _load_f32 (int16_t);
+      break;
+    case _NNS_UINT16:
+      _load_f32 (uint16_t);
+      break;
+    default:
+      return FALSE;
+  }
+#undef _load_f32
+
+  return TRUE;
+}
+
+/**
+ * @brief Store float32 values into the array of given type.
+ * @note Same as the cast in gst_tensor_data_typecast(), unsigned integer is cast via signed integer.
+ */
+static void
+gst_tensor_transform_store_f32 (const float *in, tensor_type type,
+    uint8_t * out, gsize num)
+{
+  gsize idx;
+
+#define _store_f32(otype,stype) do { \
+    otype *_out = (otype *) out; \
+    for (idx = 0; idx < num; idx++) \
+      _out[idx] = (otype) (stype) in[idx]; \
+  } while (0)
+
+  switch (type) {
+    case _NNS_FLOAT16:
+      f32_to_f16_kernel (in, (float16 *) out, num);
+      break;
+    case _NNS_FLOAT32:
+      memcpy (out, in, num * sizeof (float));
+      break;
+    case _NNS_FLOAT64:
+      _store_f32 (double, double);
+      break;
+    case _NNS_INT8:
+      _store_f32 (int8_t, int8_t);
+      break;
+    case _NNS_UINT8:
+      _store_f32 (uint8_t, int8_t);
+      break;
+    case _NNS_INT16:
+      _store_f32 (int16_t, int16_t);
+      break;
+    case _NNS_UINT16:
+      _store_f32 (uint16_t, int16_t);
+      break;
+    case _NNS_INT32:
+      _store_f32 (int32_t, int32_t);
+      break;
+    case _NNS_UINT32:
+      _store_f32 (uint32_t, int32_t);
+      break;
+    case _NNS_INT64:
+      _store_f32 (int64_t, int64_t);
+      break;
+    case _NNS_UINT64:
+      _store_f32 (uint64_t, int64_t);
+      break;
+    default:
+      g_assert_not_reached ();
+  }
+#undef _store_f32
+}
+
+/**
+ * @brief Round float32 values to the nearest float16 values.
+ */
+static void
+gst_tensor_transform_round_f16 (float *data, gsize num)
+{
+  float16 tmp[F16_BLOCK_SIZE];
+
+  g_assert (num <= F16_BLOCK_SIZE);
+
+  f32_to_f16_kernel (data, tmp, num);
+  f16_to_f32_kernel (tmp, data, num);
+}
+
 /** @todo Make this use SIMD or ORC */
 #define _conv_to_f16(intype, o, i, n) \
   do { \
@@ -630,6 +910,171 @@ gst_tensor_transform_do_operator (GstTensorTransform * filter,
   return TRUE;
 }
 
+/**
+ * @brief Get the range of the quantized type.
+ * @param[in] type The quantized type
+ * @param[out] qmin The min value of the type
+ * @param[out] qmax The max value of the type
+ * @return TRUE if the type can be a quantized type (8, 16 or 32-bit integer)
+ */
+static gboolean
+gst_tensor_transform_get_quant_range (tensor_type type, gint64 * qmin,
+    gint64 * qmax)
+{
+  switch (type) {
+    case _NNS_INT8:
+      *qmin = G_MININT8;
+      *qmax = G_MAXINT8;
+      break;
+    case _NNS_UINT8:
+      *qmin = 0;
+      *qmax = G_MAXUINT8;
+      break;
+    case _NNS_INT16:
+      *qmin = G_MININT16;
+      *qmax = G_MAXINT16;
+      break;
+    case _NNS_UINT16:
+      *qmin = 0;
+      *qmax = G_MAXUINT16;
+      break;
+    case _NNS_INT32:
+      *qmin = G_MININT32;
+      *qmax = G_MAXINT32;
+      break;
+    case _NNS_UINT32:
+      *qmin = 0;
+      *qmax = G_MAXUINT32;
+      break;
+    default:
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Parse the option of quantize and dequantize mode.
+ * @param[in/out] filter "this" pointer. mode & option MUST BE set already.
+ * @param[in] filter_name The name of the element for the error message
+ * @return TRUE if the option is valid. The parsed values are updated only if the option is valid.
+ */
+static gboolean
+gst_tensor_transform_parse_quant_option (GstTensorTransform * filter,
+    const gchar * filter_name)
+{
+  const gboolean quantize = (filter->mode == GTT_QUANTIZE);
+  const gchar *mode_name = quantize ? "quantize" : "dequantize";
+  tensor_transform_quant data;
+  tensor_transform_quant_param *params = NULL;
+  gchar **options, **scales = NULL, **zero_points = NULL;
+  guint i, num_options, num_scales, num_zero_points;
+  gint64 qmin, qmax, zp;
+  float scale;
+  gboolean ret = FALSE;
+
+  if (!g_regex_match_simple (quantize ? REGEX_QUANTIZE_OPTION :
+          REGEX_DEQUANTIZE_OPTION, filter->option, G_REGEX_CASELESS, 0)) {
+    ml_loge
+        ("%s: %s: \'%s\' is not valid option string: it should be in the form of TYPE,[per-channel:(false|true@DIM),]scale:SCALE[:SCALE...][,zero-point:ZP[:ZP...]], where TYPE is %s\n",
+        filter_name, mode_name, filter->option,
+        quantize ? "[u]int8, [u]int16 or [u]int32" : "float32 or float64");
+    return FALSE;
+  }
+
+  options = g_strsplit (filter->option, ",", -1);
+  num_options = g_strv_length (options);
+
+  memset (&data, 0, sizeof (tensor_transform_quant));
+  data.out_type = gst_tensor_get_type (options[0]);
+
+  for (i = 1; i < num_options; i++) {
+    if (g_ascii_strncasecmp (options[i], "per-channel:", 12) == 0) {
+      gchar *dim = strchr (options[i], '@');
+
+      if (dim) {
+        data.per_channel = TRUE;
+        data.ch_dim = (guint) g_ascii_strtoull (dim + 1, NULL, 10);
+      }
+    } else if (g_ascii_strncasecmp (options[i], "scale:", 6) == 0) {
+      scales = g_strsplit (options[i] + 6, ":", -1);
+    } else if (g_ascii_strncasecmp (options[i], "zero-point:", 11) == 0) {
+      zero_points = g_strsplit (options[i] + 11, ":", -1);
+    }
+  }
+
+  if (data.per_channel && data.ch_dim >= NNS_TENSOR_RANK_LIMIT) {
+    ml_loge ("%s: %s: the dimension of channel should be less than %d\n",
+        filter_name, mode_name, NNS_TENSOR_RANK_LIMIT);
+    goto done;
+  }
+
+  /* a single scale or zero-point is applied to all channels */
+  num_scales = g_strv_length (scales);
+  num_zero_points = zero_points ? g_strv_length (zero_points) : 0;
+  data.num_params = MAX (num_scales, num_zero_points);
+
+  if ((num_scales != 1 && num_scales != data.num_params) ||
+      (num_zero_points > 1 && num_zero_points != data.num_params)) {
+    ml_loge
+        ("%s: %s: the number of scale (%u) and zero-point (%u) should be the same\n",
+        filter_name, mode_name, num_scales, num_zero_points);
+    goto done;
+  }
+
+  if (data.num_params > 1 && !data.per_channel) {
+    ml_loge
+        ("%s: %s: multiple scales or zero-points are given, set per-channel:true@DIM\n",
+        filter_name, mode_name);
+    goto done;
+  }
+
+  /* the range of zero-point in dequantize mode is checked with the input type */
+  if (!quantize || !gst_tensor_transform_get_quant_range (data.out_type,
+          &qmin, &qmax)) {
+    qmin = G_MININT32;
+    qmax = G_MAXINT32;
+  }
+
+  params = g_new0 (tensor_transform_quant_param, data.num_params);
+
+  for (i = 0; i < data.num_params; i++) {
+    scale = (float) g_ascii_strtod (scales[(num_scales == 1) ? 0 : i], NULL);
+    if (!(scale > 0.0f) || isinf (scale)) {
+      ml_loge ("%s: %s: scale should be a positive finite number\n",
+          filter_name, mode_name);
+      goto done;
+    }
+
+    zp = 0;
+    if (zero_points)
+      zp = g_ascii_strtoll (zero_points[(num_zero_points == 1) ? 0 : i],
+          NULL, 10);
+    if (zp < qmin || zp > qmax) {
+      ml_loge ("%s: %s: zero-point %" G_GINT64_FORMAT
+          " is out of the range of %s\n", filter_name, mode_name, zp,
+          quantize ? gst_tensor_get_type_string (data.out_type) : "int32");
+      goto done;
+    }
+
+    params[i].scale = scale;
+    params[i].zero_point = (int32_t) zp;
+  }
+
+  g_free (filter->quant_params);
+  filter->quant_params = params;
+  filter->data_quant = data;
+  params = NULL;
+  ret = TRUE;
+
+done:
+  g_free (params);
+  g_strfreev (scales);
+  g_strfreev (zero_points);
+  g_strfreev (options);
+  return ret;
+}
+
 /**
  * @brief Setup internal data (data_* in GstTensorTransform)
  * @param[in/out] filter "this" pointer. mode & option MUST BE set already.
@@ -934,6 +1379,13 @@ gst_tensor_transform_set_option_data (GstTensorTransform * filter)
       ret = filter->loaded = TRUE;
       break;
     }
+    case GTT_QUANTIZE:
+    case GTT_DEQUANTIZE:
+    {
+      if (gst_tensor_transform_parse_quant_option (filter, filter_name))
+        ret = filter->loaded = TRUE;
+      break;
+    }
     default:
       GST_ERROR_OBJECT (filter, "Cannot identify mode\n");
       ret = FALSE;
@@ -1004,6 +1456,10 @@ gst_tensor_transform_set_property (GObject * object, guint prop_id,
       g_strfreev (strv);
       break;
     }
+    case PROP_STATS_INTERVAL:
+      gst_tensor_latency_stats_set_interval (&filter->stats,
+          g_value_get_uint (value));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1060,6 +1516,14 @@ gst_tensor_transform_get_property (GObject * object, guint prop_id,
     case PROP_TRANSPOSE_RANK_LIMIT:
       g_value_set_uint (value, NNS_TENSOR_TRANSPOSE_RANK_LIMIT);
       break;
+    case PROP_STATS:
+      g_value_take_boxed (value,
+          gst_tensor_latency_stats_to_structure (&filter->stats));
+      break;
+    case PROP_STATS_INTERVAL:
+      g_value_set_uint (value,
+          gst_tensor_latency_stats_get_interval (&filter->stats));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1086,6 +1550,9 @@ gst_tensor_transform_finalize (GObject * object)
     filter->operators = NULL;
   }
 
+  g_free (filter->quant_params);
+  filter->quant_params = NULL;
+
   if (filter->apply) {
     g_list_free (filter->apply);
     filter->apply = NULL;
@@ -1094,6 +1561,32 @@ gst_tensor_transform_finalize (GObject * object)
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
+/**
+ * @brief Called when the element starts processing (gst element vmethod)
+ */
+static gboolean
+gst_tensor_transform_start (GstBaseTransform * trans)
+{
+  GstTensorTransform *filter = GST_TENSOR_TRANSFORM_CAST (trans);
+
+  gst_tensor_latency_stats_reset (&filter->stats);
+  return TRUE;
+}
+
+/**
+ * @brief Handle the event on sink pad (gst element vmethod)
+ */
+static gboolean
+gst_tensor_transform_sink_event (GstBaseTransform * trans, GstEvent * event)
+{
+  GstTensorTransform *filter = GST_TENSOR_TRANSFORM_CAST (trans);
+
+  if (GST_EVENT_TYPE (event) == GST_EVENT_FLUSH_STOP)
+    gst_tensor_latency_stats_reset (&filter->stats);
+
+  return GST_BASE_TRANSFORM_CLASS (parent_class)->sink_event (trans, event);
+}
+
 /**
  * @brief subrouting for tensor-tranform, "dimchg" case.
  * @param[in/out] filter "this" pointer
@@ -1176,42 +1669,166 @@ gst_tensor_transform_dimchg (GstTensorTransform * filter,
   return GST_FLOW_OK;
 }
 
+#ifdef FLOAT16_SUPPORT
 /**
- * @brief subrouting for tensor-tranform, "typecast" case.
- * @param[in/out] filter "this" pointer
- * @param[in] in_info input tensor info
- * @param[in] out_info output tensor info
- * @param[in] inptr input tensor
- * @param[out] outptr output tensor
- * @return Gst flow status
+ * @brief Typecast from/to float16 with the conversion kernels, block by block.
+ * @return FALSE if the input type cannot be converted via float32.
  */
-static GstFlowReturn
-gst_tensor_transform_typecast (GstTensorTransform * filter,
-    GstTensorInfo * in_info, GstTensorInfo * out_info,
-    const uint8_t * inptr, uint8_t * outptr)
+static gboolean
+gst_tensor_transform_typecast_f16 (tensor_type in_type, tensor_type out_type,
+    const uint8_t * inptr, uint8_t * outptr, gulong num)
 {
-  gulong i, num;
+  float block[F16_BLOCK_SIZE];
   gsize in_element_size, out_element_size;
+  gulong i, n;
 
-  num = gst_tensor_get_element_count (in_info->dimension);
+  if (!f32_exact_type (in_type))
+    return FALSE;
 
-#ifdef HAVE_ORC
-  if (orc_supported (filter, in_info->type, out_info->type)) {
-    orc_typecast (inptr, outptr, num, in_info->type, out_info->type);
-    return GST_FLOW_OK;
-  }
-#endif
+  in_element_size = gst_tensor_get_element_size (in_type);
+  out_element_size = gst_tensor_get_element_size (out_type);
 
-  in_element_size = gst_tensor_get_element_size (in_info->type);
-  out_element_size = gst_tensor_get_element_size (out_info->type);
+  for (i = 0; i < num; i += n) {
+    n = MIN (F16_BLOCK_SIZE, num - i);
 
-  for (i = 0; i < num; ++i) {
-    gst_tensor_data_raw_typecast (
-        (gpointer) (inptr + in_element_size * i), in_info->type,
-        (gpointer) (outptr + out_element_size * i), out_info->type);
+    gst_tensor_transform_load_f32 (inptr + in_element_size * i, in_type,
+        block, n);
+    gst_tensor_transform_store_f32 (block, out_type,
+        outptr + out_element_size * i, n);
   }
 
-  return GST_FLOW_OK;
+  return TRUE;
+}
+
+/**
+ * @brief Arithmetic operations on float16, computed in float32 block by block.
+ * @note If the output type is float16, the value is rounded to float16 after each operator,
+ * as the operators on float16 type do.
+ * @return FALSE if the types are not supported.
+ */
+static gboolean
+gst_tensor_transform_arithmetic_f16 (GstTensorTransform * filter,
+    tensor_type in_type, tensor_type out_type, const uint8_t * inptr,
+    uint8_t * outptr, gulong num)
+{
+  float block[F16_BLOCK_SIZE];
+  gsize in_element_size, out_element_size;
+  gulong i, n, idx;
+  gboolean to_f16, need_round;
+  GSList *walk;
+  tensor_transform_operator_s *op_s;
+  tensor_data_s operand;
+  float v;
+
+  if (out_type != _NNS_FLOAT16 && out_type != _NNS_FLOAT32)
+    return FALSE;
+  if (!f32_exact_type (in_type))
+    return FALSE;
+
+  to_f16 = (out_type == _NNS_FLOAT16);
+  in_element_size = gst_tensor_get_element_size (in_type);
+  out_element_size = gst_tensor_get_element_size (out_type);
+
+  for (i = 0; i < num; i += n) {
+    n = MIN (F16_BLOCK_SIZE, num - i);
+
+    /* typecast is done at first */
+    gst_tensor_transform_load_f32 (inptr + in_element_size * i, in_type,
+        block, n);
+    need_round = (to_f16 && in_type != _NNS_FLOAT16);
+
+    walk = filter->operators;
+    while (walk) {
+      op_s = (tensor_transform_operator_s *) walk->data;
+      walk = g_slist_next (walk);
+
+      if (op_s->op == GTT_OP_TYPECAST)
+        continue;
+
+      operand = op_s->value;
+      gst_tensor_data_typecast (&operand, out_type);
+      v = to_f16 ? (float) operand.data._float16 : operand.data._float;
+
+      if (need_round)
+        gst_tensor_transform_round_f16 (block, n);
+
+      switch (op_s->op) {
+        case GTT_OP_ADD:
+          for (idx = 0; idx < n; idx++)
+            block[idx] += v;
+          break;
+        case GTT_OP_MUL:
+          for (idx = 0; idx < n; idx++)
+            block[idx] *= v;
+          break;
+        case GTT_OP_DIV:
+          if (v == 0) {
+            GST_ERROR_OBJECT (filter, "Invalid state, denominator is 0.");
+            continue;
+          }
+          for (idx = 0; idx < n; idx++)
+            block[idx] /= v;
+          break;
+        default:
+          g_assert_not_reached ();
+          return FALSE;
+      }
+
+      need_round = to_f16;
+    }
+
+    /* storing into float16 rounds the result of the last operator */
+    gst_tensor_transform_store_f32 (block, out_type,
+        outptr + out_element_size * i, n);
+  }
+
+  return TRUE;
+}
+#endif /* FLOAT16_SUPPORT */
+
+/**
+ * @brief subrouting for tensor-tranform, "typecast" case.
+ * @param[in/out] filter "this" pointer
+ * @param[in] in_info input tensor info
+ * @param[in] out_info output tensor info
+ * @param[in] inptr input tensor
+ * @param[out] outptr output tensor
+ * @return Gst flow status
+ */
+static GstFlowReturn
+gst_tensor_transform_typecast (GstTensorTransform * filter,
+    GstTensorInfo * in_info, GstTensorInfo * out_info,
+    const uint8_t * inptr, uint8_t * outptr)
+{
+  gulong i, num;
+  gsize in_element_size, out_element_size;
+
+  num = gst_tensor_get_element_count (in_info->dimension);
+
+#ifdef FLOAT16_SUPPORT
+  if ((in_info->type == _NNS_FLOAT16 || out_info->type == _NNS_FLOAT16)
+      && gst_tensor_transform_typecast_f16 (in_info->type, out_info->type,
+          inptr, outptr, num))
+    return GST_FLOW_OK;
+#endif
+
+#ifdef HAVE_ORC
+  if (orc_supported (filter, in_info->type, out_info->type)) {
+    orc_typecast (inptr, outptr, num, in_info->type, out_info->type);
+    return GST_FLOW_OK;
+  }
+#endif
+
+  in_element_size = gst_tensor_get_element_size (in_info->type);
+  out_element_size = gst_tensor_get_element_size (out_info->type);
+
+  for (i = 0; i < num; ++i) {
+    gst_tensor_data_raw_typecast (
+        (gpointer) (inptr + in_element_size * i), in_info->type,
+        (gpointer) (outptr + out_element_size * i), out_info->type);
+  }
+
+  return GST_FLOW_OK;
 }
 
 /**
@@ -1237,6 +1854,14 @@ gst_tensor_transform_arithmetic (GstTensorTransform * filter,
 
   num = gst_tensor_get_element_count (in_info->dimension);
 
+#ifdef FLOAT16_SUPPORT
+  if (!filter->data_arithmetic.per_channel_arith
+      && (in_info->type == _NNS_FLOAT16 || out_info->type == _NNS_FLOAT16)
+      && gst_tensor_transform_arithmetic_f16 (filter, in_info->type,
+          out_info->type, inptr, outptr, num))
+    return GST_FLOW_OK;
+#endif
+
 #ifdef HAVE_ORC
   /** per-channel is not supported by orc */
   if (!filter->data_arithmetic.per_channel_arith
@@ -1473,29 +2098,46 @@ gst_tensor_transform_stand (GstTensorTransform * filter,
   gsize in_element_size, out_element_size, data_size, ch_size;
   gulong i, num, data_idx, ch;
   gdouble tmp, *average, *std;
+  tensor_type in_type = in_info->type;
+  const uint8_t *in_data = inptr;
+  float *in_f32 = NULL;
 
-  in_element_size = gst_tensor_get_element_size (in_info->type);
-  out_element_size = gst_tensor_get_element_size (out_info->type);
   num = gst_tensor_get_element_count (in_info->dimension);
 
-  data_size = gst_tensor_info_get_size (in_info);
+#ifdef FLOAT16_SUPPORT
+  /**
+   * Widen float16 input into a float32 buffer (exact), not to convert float16 for each element.
+   * The float16 output is still rounded once from float64, not through float32.
+   */
+  if (in_type == _NNS_FLOAT16) {
+    in_f32 = g_new (float, num);
+    f16_to_f32_kernel ((const float16 *) inptr, in_f32, num);
+    in_data = (const uint8_t *) in_f32;
+    in_type = _NNS_FLOAT32;
+  }
+#endif
+
+  in_element_size = gst_tensor_get_element_size (in_type);
+  out_element_size = gst_tensor_get_element_size (out_info->type);
+
+  data_size = in_element_size * num;
   ch_size = in_info->dimension[0];
 
   /* calc average and std */
   average = std = NULL;
   if (filter->data_stand.per_channel) {
-    gst_tensor_data_raw_average_per_channel ((gpointer) inptr, data_size,
-        in_info->type, in_info->dimension, &average);
+    gst_tensor_data_raw_average_per_channel ((gpointer) in_data, data_size,
+        in_type, in_info->dimension, &average);
     /* calculate std only for default mode */
     if (filter->data_stand.mode == STAND_DEFAULT)
-      gst_tensor_data_raw_std_per_channel ((gpointer) inptr, data_size,
-          in_info->type, in_info->dimension, average, &std);
+      gst_tensor_data_raw_std_per_channel ((gpointer) in_data, data_size,
+          in_type, in_info->dimension, average, &std);
   } else {
-    gst_tensor_data_raw_average ((gpointer) inptr, data_size,
-        in_info->type, &average);
+    gst_tensor_data_raw_average ((gpointer) in_data, data_size,
+        in_type, &average);
     /* calculate std only for default mode */
     if (filter->data_stand.mode == STAND_DEFAULT)
-      gst_tensor_data_raw_std ((gpointer) inptr, data_size, in_info->type,
+      gst_tensor_data_raw_std ((gpointer) in_data, data_size, in_type,
           average, &std);
   }
 
@@ -1505,8 +2147,8 @@ gst_tensor_transform_stand (GstTensorTransform * filter,
       if (!filter->data_stand.per_channel) {
         for (i = 0; i < num; i++) {
           data_idx = in_element_size * i;
-          gst_tensor_data_raw_typecast ((gpointer) (inptr + data_idx),
-              in_info->type, &tmp, _NNS_FLOAT64);
+          gst_tensor_data_raw_typecast ((gpointer) (in_data + data_idx),
+              in_type, &tmp, _NNS_FLOAT64);
 
           tmp = fabs ((tmp - *average) / *std);
 
@@ -1518,8 +2160,8 @@ gst_tensor_transform_stand (GstTensorTransform * filter,
         for (ch = 0; ch < ch_size; ++ch) {
           for (i = 0; i < num / ch_size; i++) {
             data_idx = in_element_size * ((i * ch_size) + ch);
-            gst_tensor_data_raw_typecast ((gpointer) (inptr + data_idx),
-                in_info->type, &tmp, _NNS_FLOAT64);
+            gst_tensor_data_raw_typecast ((gpointer) (in_data + data_idx),
+                in_type, &tmp, _NNS_FLOAT64);
 
             tmp = fabs ((tmp - average[ch]) / std[ch]);
 
@@ -1536,8 +2178,8 @@ gst_tensor_transform_stand (GstTensorTransform * filter,
       if (!filter->data_stand.per_channel) {
         for (i = 0; i < num; i++) {
           data_idx = in_element_size * i;
-          gst_tensor_data_raw_typecast ((gpointer) (inptr + data_idx),
-              in_info->type, &tmp, _NNS_FLOAT64);
+          gst_tensor_data_raw_typecast ((gpointer) (in_data + data_idx),
+              in_type, &tmp, _NNS_FLOAT64);
 
           tmp -= *average;
 
@@ -1549,8 +2191,8 @@ gst_tensor_transform_stand (GstTensorTransform * filter,
         for (ch = 0; ch < ch_size; ++ch) {
           for (i = 0; i < num / ch_size; i++) {
             data_idx = in_element_size * ((i * ch_size) + ch);
-            gst_tensor_data_raw_typecast ((gpointer) (inptr + data_idx),
-                in_info->type, &tmp, _NNS_FLOAT64);
+            gst_tensor_data_raw_typecast ((gpointer) (in_data + data_idx),
+                in_type, &tmp, _NNS_FLOAT64);
 
             tmp -= average[ch];
 
@@ -1567,6 +2209,7 @@ gst_tensor_transform_stand (GstTensorTransform * filter,
       ret = GST_FLOW_ERROR;
   }
 
+  g_free (in_f32);
   g_free (average);
   g_free (std);
 
@@ -1597,6 +2240,31 @@ gst_tensor_transform_clamp (GstTensorTransform * filter,
   out_element_size = gst_tensor_get_element_size (out_info->type);
   num = gst_tensor_get_element_count (in_info->dimension);
 
+#ifdef FLOAT16_SUPPORT
+  if (in_info->type == _NNS_FLOAT16) {
+    float block[F16_BLOCK_SIZE];
+    float min, max;
+    gulong n, idx;
+
+    /* the bounds rounded to float16 give the same result as clamping in float64 */
+    min = (float) (float16) filter->data_clamp.min;
+    max = (float) (float16) filter->data_clamp.max;
+
+    for (i = 0; i < num; i += n) {
+      n = MIN (F16_BLOCK_SIZE, num - i);
+
+      f16_to_f32_kernel ((const float16 *) (inptr + in_element_size * i),
+          block, n);
+      for (idx = 0; idx < n; idx++)
+        block[idx] = CLAMP (block[idx], min, max);
+      gst_tensor_transform_store_f32 (block, out_info->type,
+          outptr + out_element_size * i, n);
+    }
+
+    return GST_FLOW_OK;
+  }
+#endif
+
   for (i = 0; i < num; ++i) {
     data_idx = in_element_size * i;
     gst_tensor_data_raw_typecast ((gpointer) (inptr + data_idx), in_info->type,
@@ -1612,6 +2280,813 @@ gst_tensor_transform_clamp (GstTensorTransform * filter,
   return GST_FLOW_OK;
 }
 
+/**
+ * @brief Quantize the values: out = saturate (round (in / scale) + zero_point)
+ * @note The value is clamped to the range of quantized type before rounding, and
+ * rounded half to even. Float32 input is computed in single precision, so that
+ * the scalar and SIMD kernels give the same result. NaN is quantized to the min value.
+ */
+#define quantize_loop(itype, ftype, otype, in, out, num, scale, zp, lo, hi) \
+  do { \
+    const itype *_in = (const itype *) (in); \
+    otype *_out = (otype *) (out); \
+    ftype _t; \
+    gsize _i; \
+    for (_i = 0; _i < (num); _i++) { \
+      _t = (ftype) _in[_i] / (ftype) (scale); \
+      _t = MIN (MAX (_t, (ftype) (lo)), (ftype) (hi)); \
+      _out[_i] = (otype) ((gint64) nearbyint (_t) + (zp)); \
+    } \
+  } while (0)
+
+/**
+ * @brief Quantize the values into the output type.
+ */
+#define quantize_loop_out(itype, ftype, otype, in, out, num, scale, zp, lo, hi) \
+  do { \
+    switch (otype) { \
+      case _NNS_INT8: \
+        quantize_loop (itype, ftype, int8_t, in, out, num, scale, zp, lo, hi); \
+        break; \
+      case _NNS_UINT8: \
+        quantize_loop (itype, ftype, uint8_t, in, out, num, scale, zp, lo, hi); \
+        break; \
+      case _NNS_INT16: \
+        quantize_loop (itype, ftype, int16_t, in, out, num, scale, zp, lo, hi); \
+        break; \
+      case _NNS_UINT16: \
+        quantize_loop (itype, ftype, uint16_t, in, out, num, scale, zp, lo, hi); \
+        break; \
+      case _NNS_INT32: \
+        quantize_loop (itype, ftype, int32_t, in, out, num, scale, zp, lo, hi); \
+        break; \
+      case _NNS_UINT32: \
+        quantize_loop (itype, ftype, uint32_t, in, out, num, scale, zp, lo, hi); \
+        break; \
+      default: \
+        g_assert_not_reached (); \
+    } \
+  } while (0)
+
+/**
+ * @brief Dequantize the values: out = (in - zero_point) * scale
+ */
+#define dequantize_loop(itype, otype, in, out, num, scale, zp) \
+  do { \
+    const itype *_in = (const itype *) (in); \
+    otype *_out = (otype *) (out); \
+    gsize _i; \
+    for (_i = 0; _i < (num); _i++) \
+      _out[_i] = (otype) ((gint64) _in[_i] - (zp)) * (otype) (scale); \
+  } while (0)
+
+/**
+ * @brief Dequantize the values of the input type.
+ */
+#define dequantize_loop_in(itype, otype, in, out, num, scale, zp) \
+  do { \
+    switch (itype) { \
+      case _NNS_INT8: \
+        dequantize_loop (int8_t, otype, in, out, num, scale, zp); \
+        break; \
+      case _NNS_UINT8: \
+        dequantize_loop (uint8_t, otype, in, out, num, scale, zp); \
+        break; \
+      case _NNS_INT16: \
+        dequantize_loop (int16_t, otype, in, out, num, scale, zp); \
+        break; \
+      case _NNS_UINT16: \
+        dequantize_loop (uint16_t, otype, in, out, num, scale, zp); \
+        break; \
+      case _NNS_INT32: \
+        dequantize_loop (int32_t, otype, in, out, num, scale, zp); \
+        break; \
+      case _NNS_UINT32: \
+        dequantize_loop (uint32_t, otype, in, out, num, scale, zp); \
+        break; \
+      default: \
+        g_assert_not_reached (); \
+    } \
+  } while (0)
+
+/**
+ * @brief Kernel to quantize float32 values into int8 or uint8.
+ */
+typedef void (*quantize_8bit_func) (const float *in, gpointer out, gsize num,
+    float scale, int32_t zp, gboolean is_signed);
+
+/**
+ * @brief Kernel to dequantize int8 or uint8 values into float32.
+ */
+typedef void (*dequantize_8bit_func) (gconstpointer in, float *out, gsize num,
+    float scale, int32_t zp, gboolean is_signed);
+
+/**
+ * @brief Kernel to quantize float32 values into int8 or uint8, with the scale and zero-point of each value.
+ */
+typedef void (*quantize_8bit_ch_func) (const float *in, gpointer out,
+    gsize num, const float *scale, const int32_t * zp, gboolean is_signed);
+
+/**
+ * @brief Kernel to dequantize int8 or uint8 values into float32, with the scale and zero-point of each value.
+ */
+typedef void (*dequantize_8bit_ch_func) (gconstpointer in, float *out,
+    gsize num, const float *scale, const int32_t * zp, gboolean is_signed);
+
+static quantize_8bit_func quantize_8bit_kernel = NULL;
+static dequantize_8bit_func dequantize_8bit_kernel = NULL;
+static quantize_8bit_ch_func quantize_8bit_ch_kernel = NULL;
+static dequantize_8bit_ch_func dequantize_8bit_ch_kernel = NULL;
+
+/** @brief Quantize float32 values into int8 or uint8 */
+static void
+quantize_8bit_scalar (const float *in, gpointer out, gsize num, float scale,
+    int32_t zp, gboolean is_signed)
+{
+  if (is_signed)
+    quantize_loop (float, float, int8_t, in, out, num, scale, zp,
+        G_MININT8 - zp, G_MAXINT8 - zp);
+  else
+    quantize_loop (float, float, uint8_t, in, out, num, scale, zp,
+        -zp, G_MAXUINT8 - zp);
+}
+
+/** @brief Dequantize int8 or uint8 values into float32 */
+static void
+dequantize_8bit_scalar (gconstpointer in, float *out, gsize num, float scale,
+    int32_t zp, gboolean is_signed)
+{
+  if (is_signed)
+    dequantize_loop (int8_t, float, in, out, num, scale, zp);
+  else
+    dequantize_loop (uint8_t, float, in, out, num, scale, zp);
+}
+
+/** @brief Quantize float32 values into int8 or uint8 with the scale and zero-point of each value */
+static void
+quantize_8bit_ch_scalar (const float *in, gpointer out, gsize num,
+    const float *scale, const int32_t * zp, gboolean is_signed)
+{
+  uint8_t *output = (uint8_t *) out;
+  gsize i;
+
+  for (i = 0; i < num; i++)
+    quantize_8bit_scalar (in + i, output + i, 1, scale[i], zp[i], is_signed);
+}
+
+/** @brief Dequantize int8 or uint8 values into float32 with the scale and zero-point of each value */
+static void
+dequantize_8bit_ch_scalar (gconstpointer in, float *out, gsize num,
+    const float *scale, const int32_t * zp, gboolean is_signed)
+{
+  const uint8_t *input = (const uint8_t *) in;
+  gsize i;
+
+  for (i = 0; i < num; i++)
+    dequantize_8bit_scalar (input + i, out + i, 1, scale[i], zp[i], is_signed);
+}
+
+#if defined (X86_SIMD_ENABLED)
+/**
+ * @brief Quantize float32 values into int8 or uint8 with SSE2
+ * @note The values are clamped before the conversion, which rounds half to even
+ * with the default rounding mode as nearbyint() does. Thus, the result is the same as the scalar path.
+ */
+__attribute__ ((target ("sse2")))
+static void
+quantize_8bit_sse2 (const float *in, gpointer out, gsize num, float scale,
+    int32_t zp, gboolean is_signed)
+{
+  const __m128 v_scale = _mm_set1_ps (scale);
+  const __m128 v_lo = _mm_set1_ps ((float) ((is_signed ? G_MININT8 : 0) - zp));
+  const __m128 v_hi =
+      _mm_set1_ps ((float) ((is_signed ? G_MAXINT8 : G_MAXUINT8) - zp));
+  const __m128i v_zp = _mm_set1_epi32 (zp);
+  __m128i v_q[4], v_lo16, v_hi16;
+  __m128 v_t;
+  uint8_t *output = (uint8_t *) out;
+  gsize idx;
+  guint k;
+
+  for (idx = 0; idx + 16 <= num; idx += 16) {
+    for (k = 0; k < 4; k++) {
+      v_t = _mm_div_ps (_mm_loadu_ps (in + idx + 4 * k), v_scale);
+      /* max returns the second operand (min value) for NaN */
+      v_t = _mm_min_ps (_mm_max_ps (v_t, v_lo), v_hi);
+      v_q[k] = _mm_add_epi32 (_mm_cvtps_epi32 (v_t), v_zp);
+    }
+
+    v_lo16 = _mm_packs_epi32 (v_q[0], v_q[1]);
+    v_hi16 = _mm_packs_epi32 (v_q[2], v_q[3]);
+
+    _mm_storeu_si128 ((__m128i *) (output + idx), is_signed ?
+        _mm_packs_epi16 (v_lo16, v_hi16) : _mm_packus_epi16 (v_lo16, v_hi16));
+  }
+
+  /* handle remaining data */
+  quantize_8bit_scalar (in + idx, output + idx, num - idx, scale, zp,
+      is_signed);
+}
+
+/** @brief Quantize float32 values into int8 or uint8 with AVX2 */
+__attribute__ ((target ("avx2")))
+static void
+quantize_8bit_avx2 (const float *in, gpointer out, gsize num, float scale,
+    int32_t zp, gboolean is_signed)
+{
+  const __m256 v_scale = _mm256_set1_ps (scale);
+  const __m256 v_lo =
+      _mm256_set1_ps ((float) ((is_signed ? G_MININT8 : 0) - zp));
+  const __m256 v_hi =
+      _mm256_set1_ps ((float) ((is_signed ? G_MAXINT8 : G_MAXUINT8) - zp));
+  const __m256i v_zp = _mm256_set1_epi32 (zp);
+  /* pack works in each 128-bit lane, reorder the 32-bit groups */
+  const __m256i v_order = _mm256_setr_epi32 (0, 4, 1, 5, 2, 6, 3, 7);
+  __m256i v_q[4], v_lo16, v_hi16, v_out;
+  __m256 v_t;
+  uint8_t *output = (uint8_t *) out;
+  gsize idx;
+  guint k;
+
+  for (idx = 0; idx + 32 <= num; idx += 32) {
+    for (k = 0; k < 4; k++) {
+      v_t = _mm256_div_ps (_mm256_loadu_ps (in + idx + 8 * k), v_scale);
+      v_t = _mm256_min_ps (_mm256_max_ps (v_t, v_lo), v_hi);
+      v_q[k] = _mm256_add_epi32 (_mm256_cvtps_epi32 (v_t), v_zp);
+    }
+
+    v_lo16 = _mm256_packs_epi32 (v_q[0], v_q[1]);
+    v_hi16 = _mm256_packs_epi32 (v_q[2], v_q[3]);
+    v_out = is_signed ? _mm256_packs_epi16 (v_lo16, v_hi16) :
+        _mm256_packus_epi16 (v_lo16, v_hi16);
+
+    _mm256_storeu_si256 ((__m256i *) (output + idx),
+        _mm256_permutevar8x32_epi32 (v_out, v_order));
+  }
+
+  /* handle remaining data */
+  quantize_8bit_scalar (in + idx, output + idx, num - idx, scale, zp,
+      is_signed);
+}
+
+/** @brief Dequantize int8 or uint8 values into float32 with SSE2 */
+__attribute__ ((target ("sse2")))
+static void
+dequantize_8bit_sse2 (gconstpointer in, float *out, gsize num, float scale,
+    int32_t zp, gboolean is_signed)
+{
+  const __m128 v_scale = _mm_set1_ps (scale);
+  const __m128i v_zp = _mm_set1_epi32 (zp);
+  const __m128i v_zero = _mm_setzero_si128 ();
+  const uint8_t *input = (const uint8_t *) in;
+  __m128i v_in, v_16[2], v_32[4];
+  gsize idx;
+  guint k;
+
+  for (idx = 0; idx + 16 <= num; idx += 16) {
+    v_in = _mm_loadu_si128 ((const __m128i *) (input + idx));
+
+    /* extend to 16-bit */
+    if (is_signed) {
+      v_16[0] = _mm_srai_epi16 (_mm_unpacklo_epi8 (v_in, v_in), 8);
+      v_16[1] = _mm_srai_epi16 (_mm_unpackhi_epi8 (v_in, v_in), 8);
+    } else {
+      v_16[0] = _mm_unpacklo_epi8 (v_in, v_zero);
+      v_16[1] = _mm_unpackhi_epi8 (v_in, v_zero);
+    }
+
+    /* extend to 32-bit */
+    for (k = 0; k < 2; k++) {
+      v_32[2 * k] =
+          _mm_srai_epi32 (_mm_unpacklo_epi16 (v_16[k], v_16[k]), 16);
+      v_32[2 * k + 1] =
+          _mm_srai_epi32 (_mm_unpackhi_epi16 (v_16[k], v_16[k]), 16);
+    }
+
+    for (k = 0; k < 4; k++) {
+      _mm_storeu_ps (out + idx + 4 * k,
+          _mm_mul_ps (_mm_cvtepi32_ps (_mm_sub_epi32 (v_32[k], v_zp)),
+              v_scale));
+    }
+  }
+
+  /* handle remaining data */
+  dequantize_8bit_scalar (input + idx, out + idx, num - idx, scale, zp,
+      is_signed);
+}
+
+/** @brief Dequantize int8 or uint8 values into float32 with AVX2 */
+__attribute__ ((target ("avx2")))
+static void
+dequantize_8bit_avx2 (gconstpointer in, float *out, gsize num, float scale,
+    int32_t zp, gboolean is_signed)
+{
+  const __m256 v_scale = _mm256_set1_ps (scale);
+  const __m256i v_zp = _mm256_set1_epi32 (zp);
+  const uint8_t *input = (const uint8_t *) in;
+  __m128i v_in;
+  __m256i v_32;
+  gsize idx;
+
+  for (idx = 0; idx + 8 <= num; idx += 8) {
+    v_in = _mm_loadl_epi64 ((const __m128i *) (input + idx));
+    v_32 = is_signed ? _mm256_cvtepi8_epi32 (v_in) :
+        _mm256_cvtepu8_epi32 (v_in);
+
+    _mm256_storeu_ps (out + idx,
+        _mm256_mul_ps (_mm256_cvtepi32_ps (_mm256_sub_epi32 (v_32, v_zp)),
+            v_scale));
+  }
+
+  /* handle remaining data */
+  dequantize_8bit_scalar (input + idx, out + idx, num - idx, scale, zp,
+      is_signed);
+}
+
+/** @brief Quantize float32 values into int8 or uint8 with SSE2, with the scale and zero-point of each value */
+__attribute__ ((target ("sse2")))
+static void
+quantize_8bit_ch_sse2 (const float *in, gpointer out, gsize num,
+    const float *scale, const int32_t * zp, gboolean is_signed)
+{
+  const __m128i v_qmin = _mm_set1_epi32 (is_signed ? G_MININT8 : 0);
+  const __m128i v_qmax = _mm_set1_epi32 (is_signed ? G_MAXINT8 : G_MAXUINT8);
+  __m128i v_q[4], v_zp, v_lo16, v_hi16;
+  __m128 v_t;
+  uint8_t *output = (uint8_t *) out;
+  gsize idx, i;
+  guint k;
+
+  for (idx = 0; idx + 16 <= num; idx += 16) {
+    for (k = 0; k < 4; k++) {
+      i = idx + 4 * k;
+      v_zp = _mm_loadu_si128 ((const __m128i *) (zp + i));
+      v_t = _mm_div_ps (_mm_loadu_ps (in + i), _mm_loadu_ps (scale + i));
+      v_t = _mm_max_ps (v_t, _mm_cvtepi32_ps (_mm_sub_epi32 (v_qmin, v_zp)));
+      v_t = _mm_min_ps (v_t, _mm_cvtepi32_ps (_mm_sub_epi32 (v_qmax, v_zp)));
+      v_q[k] = _mm_add_epi32 (_mm_cvtps_epi32 (v_t), v_zp);
+    }
+
+    v_lo16 = _mm_packs_epi32 (v_q[0], v_q[1]);
+    v_hi16 = _mm_packs_epi32 (v_q[2], v_q[3]);
+
+    _mm_storeu_si128 ((__m128i *) (output + idx), is_signed ?
+        _mm_packs_epi16 (v_lo16, v_hi16) : _mm_packus_epi16 (v_lo16, v_hi16));
+  }
+
+  /* handle remaining data */
+  quantize_8bit_ch_scalar (in + idx, output + idx, num - idx, scale + idx,
+      zp + idx, is_signed);
+}
+
+/** @brief Quantize float32 values into int8 or uint8 with AVX2, with the scale and zero-point of each value */
+__attribute__ ((target ("avx2")))
+static void
+quantize_8bit_ch_avx2 (const float *in, gpointer out, gsize num,
+    const float *scale, const int32_t * zp, gboolean is_signed)
+{
+  const __m256i v_qmin = _mm256_set1_epi32 (is_signed ? G_MININT8 : 0);
+  const __m256i v_qmax =
+      _mm256_set1_epi32 (is_signed ? G_MAXINT8 : G_MAXUINT8);
+  /* pack works in each 128-bit lane, reorder the 32-bit groups */
+  const __m256i v_order = _mm256_setr_epi32 (0, 4, 1, 5, 2, 6, 3, 7);
+  __m256i v_q[4], v_zp, v_lo16, v_hi16, v_out;
+  __m256 v_t;
+  uint8_t *output = (uint8_t *) out;
+  gsize idx, i;
+  guint k;
+
+  for (idx = 0; idx + 32 <= num; idx += 32) {
+    for (k = 0; k < 4; k++) {
+      i = idx + 8 * k;
+      v_zp = _mm256_loadu_si256 ((const __m256i *) (zp + i));
+      v_t = _mm256_div_ps (_mm256_loadu_ps (in + i),
+          _mm256_loadu_ps (scale + i));
+      v_t = _mm256_max_ps (v_t,
+          _mm256_cvtepi32_ps (_mm256_sub_epi32 (v_qmin, v_zp)));
+      v_t = _mm256_min_ps (v_t,
+          _mm256_cvtepi32_ps (_mm256_sub_epi32 (v_qmax, v_zp)));
+      v_q[k] = _mm256_add_epi32 (_mm256_cvtps_epi32 (v_t), v_zp);
+    }
+
+    v_lo16 = _mm256_packs_epi32 (v_q[0], v_q[1]);
+    v_hi16 = _mm256_packs_epi32 (v_q[2], v_q[3]);
+    v_out = is_signed ? _mm256_packs_epi16 (v_lo16, v_hi16) :
+        _mm256_packus_epi16 (v_lo16, v_hi16);
+
+    _mm256_storeu_si256 ((__m256i *) (output + idx),
+        _mm256_permutevar8x32_epi32 (v_out, v_order));
+  }
+
+  /* handle remaining data */
+  quantize_8bit_ch_scalar (in + idx, output + idx, num - idx, scale + idx,
+      zp + idx, is_signed);
+}
+
+/** @brief Dequantize int8 or uint8 values into float32 with SSE2, with the scale and zero-point of each value */
+__attribute__ ((target ("sse2")))
+static void
+dequantize_8bit_ch_sse2 (gconstpointer in, float *out, gsize num,
+    const float *scale, const int32_t * zp, gboolean is_signed)
+{
+  const __m128i v_zero = _mm_setzero_si128 ();
+  const uint8_t *input = (const uint8_t *) in;
+  __m128i v_in, v_16[2], v_32[4];
+  gsize idx, i;
+  guint k;
+
+  for (idx = 0; idx + 16 <= num; idx += 16) {
+    v_in = _mm_loadu_si128 ((const __m128i *) (input + idx));
+
+    /* extend to 16-bit */
+    if (is_signed) {
+      v_16[0] = _mm_srai_epi16 (_mm_unpacklo_epi8 (v_in, v_in), 8);
+      v_16[1] = _mm_srai_epi16 (_mm_unpackhi_epi8 (v_in, v_in), 8);
+    } else {
+      v_16[0] = _mm_unpacklo_epi8 (v_in, v_zero);
+      v_16[1] = _mm_unpackhi_epi8 (v_in, v_zero);
+    }
+
+    /* extend to 32-bit */
+    for (k = 0; k < 2; k++) {
+      v_32[2 * k] =
+          _mm_srai_epi32 (_mm_unpacklo_epi16 (v_16[k], v_16[k]), 16);
+      v_32[2 * k + 1] =
+          _mm_srai_epi32 (_mm_unpackhi_epi16 (v_16[k], v_16[k]), 16);
+    }
+
+    for (k = 0; k < 4; k++) {
+      i = idx + 4 * k;
+      _mm_storeu_ps (out + i,
+          _mm_mul_ps (_mm_cvtepi32_ps (_mm_sub_epi32 (v_32[k],
+                      _mm_loadu_si128 ((const __m128i *) (zp + i)))),
+              _mm_loadu_ps (scale + i)));
+    }
+  }
+
+  /* handle remaining data */
+  dequantize_8bit_ch_scalar (input + idx, out + idx, num - idx, scale + idx,
+      zp + idx, is_signed);
+}
+
+/** @brief Dequantize int8 or uint8 values into float32 with AVX2, with the scale and zero-point of each value */
+__attribute__ ((target ("avx2")))
+static void
+dequantize_8bit_ch_avx2 (gconstpointer in, float *out, gsize num,
+    const float *scale, const int32_t * zp, gboolean is_signed)
+{
+  const uint8_t *input = (const uint8_t *) in;
+  __m128i v_in;
+  __m256i v_32;
+  gsize idx;
+
+  for (idx = 0; idx + 8 <= num; idx += 8) {
+    v_in = _mm_loadl_epi64 ((const __m128i *) (input + idx));
+    v_32 = is_signed ? _mm256_cvtepi8_epi32 (v_in) :
+        _mm256_cvtepu8_epi32 (v_in);
+    v_32 = _mm256_sub_epi32 (v_32,
+        _mm256_loadu_si256 ((const __m256i *) (zp + idx)));
+
+    _mm256_storeu_ps (out + idx, _mm256_mul_ps (_mm256_cvtepi32_ps (v_32),
+            _mm256_loadu_ps (scale + idx)));
+  }
+
+  /* handle remaining data */
+  dequantize_8bit_ch_scalar (input + idx, out + idx, num - idx, scale + idx,
+      zp + idx, is_signed);
+}
+#endif
+
+/**
+ * @brief Select the SIMD kernels (quantize, dequantize and float16 conversion) according to the cpu features.
+ */
+static void
+gst_tensor_transform_select_kernels (void)
+{
+  quantize_8bit_kernel = quantize_8bit_scalar;
+  dequantize_8bit_kernel = dequantize_8bit_scalar;
+  quantize_8bit_ch_kernel = quantize_8bit_ch_scalar;
+  dequantize_8bit_ch_kernel = dequantize_8bit_ch_scalar;
+#ifdef FLOAT16_SUPPORT
+  f16_to_f32_kernel = f16_to_f32_scalar;
+  f32_to_f16_kernel = f32_to_f16_scalar;
+#endif
+
+#if defined (X86_SIMD_ENABLED)
+  __builtin_cpu_init ();
+
+  if (__builtin_cpu_supports ("avx2")) {
+    quantize_8bit_kernel = quantize_8bit_avx2;
+    dequantize_8bit_kernel = dequantize_8bit_avx2;
+    quantize_8bit_ch_kernel = quantize_8bit_ch_avx2;
+    dequantize_8bit_ch_kernel = dequantize_8bit_ch_avx2;
+  } else if (__builtin_cpu_supports ("sse2")) {
+    quantize_8bit_kernel = quantize_8bit_sse2;
+    dequantize_8bit_kernel = dequantize_8bit_sse2;
+    quantize_8bit_ch_kernel = quantize_8bit_ch_sse2;
+    dequantize_8bit_ch_kernel = dequantize_8bit_ch_sse2;
+  }
+#ifdef FLOAT16_SUPPORT
+  if (__builtin_cpu_supports ("avx") && __builtin_cpu_supports ("f16c")) {
+    f16_to_f32_kernel = f16_to_f32_f16c;
+    f32_to_f16_kernel = f32_to_f16_f16c;
+  }
+#endif
+#elif defined (FLOAT16_SUPPORT) && defined (__aarch64__)
+  /* fp16 conversion is a mandatory part of aarch64 NEON */
+  f16_to_f32_kernel = f16_to_f32_neon;
+  f32_to_f16_kernel = f32_to_f16_neon;
+#endif
+}
+
+/**
+ * @brief Get the layout of channels for quantize and dequantize mode.
+ * @param[in] filter "this" pointer
+ * @param[in] info tensor info
+ * @param[out] outer the number of blocks
+ * @param[out] channels the number of channels in a block
+ * @param[out] inner the number of elements of a channel in a block
+ * @return TRUE if the number of scale and zero-point is matched with the channels
+ */
+static gboolean
+gst_tensor_transform_get_quant_layout (GstTensorTransform * filter,
+    const GstTensorInfo * info, gsize * outer, guint * channels, gsize * inner)
+{
+  gsize num;
+  guint i, ch_dim;
+
+  num = gst_tensor_get_element_count (info->dimension);
+
+  *outer = 1;
+  *channels = 1;
+  *inner = num;
+
+  if (!filter->data_quant.per_channel)
+    return TRUE;
+
+  ch_dim = filter->data_quant.ch_dim;
+  *channels = info->dimension[ch_dim];
+
+  *inner = 1;
+  for (i = 0; i < ch_dim; i++)
+    *inner *= info->dimension[i];
+
+  if (*channels == 0 || *inner == 0)
+    return FALSE;
+
+  *outer = num / (*inner * *channels);
+
+  if (filter->data_quant.num_params != 1 &&
+      filter->data_quant.num_params != *channels) {
+    ml_loge
+        ("The number of scale and zero-point (%u) is not matched with the channels (%u) of %u-th dim.\n",
+        filter->data_quant.num_params, *channels, ch_dim);
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief The max number of values in a row of the repeated scale and zero-point.
+ */
+#define QUANT_ROW_LIMIT (4096)
+
+/**
+ * @brief Get the scale and zero-point of each value in a row, for the channels in the innermost dimension.
+ * @param[in] filter "this" pointer
+ * @param[in] channels the number of channels
+ * @param[out] scale the scale of each value (free with g_free)
+ * @param[out] zp the zero-point of each value (free with g_free)
+ * @return the number of values in a row, a multiple of the channels
+ * @note The row is also a multiple of 32 (the values in an iteration of the SIMD kernels) unless it is too long.
+ */
+static gsize
+gst_tensor_transform_get_quant_row (GstTensorTransform * filter,
+    guint channels, float **scale, int32_t ** zp)
+{
+  gsize row, i, a = channels, b = 32, t;
+
+  /* the least common multiple of the channels and 32 */
+  while (b != 0) {
+    t = a % b;
+    a = b;
+    b = t;
+  }
+
+  row = (gsize) channels * (32 / a);
+  if (row > QUANT_ROW_LIMIT)
+    row = channels;
+
+  *scale = g_new (float, row);
+  *zp = g_new (int32_t, row);
+
+  for (i = 0; i < row; i++) {
+    (*scale)[i] = filter->quant_params[i % channels].scale;
+    (*zp)[i] = filter->quant_params[i % channels].zero_point;
+  }
+
+  return row;
+}
+
+/**
+ * @brief subrouting for tensor-tranform, "quantize" case.
+ *        : out = saturate (round (in / scale) + zero_point)
+ * @param[in/out] filter "this" pointer
+ * @param[in] in_info input tensor info
+ * @param[in] out_info output tensor info
+ * @param[in] inptr input tensor
+ * @param[out] outptr output tensor
+ * @return Gst flow status
+ */
+static GstFlowReturn
+gst_tensor_transform_quantize (GstTensorTransform * filter,
+    GstTensorInfo * in_info, GstTensorInfo * out_info,
+    const uint8_t * inptr, uint8_t * outptr)
+{
+  const tensor_transform_quant_param *param;
+  gsize in_element_size, out_element_size;
+  gsize o, i, outer, inner, offset = 0;
+  guint c, channels;
+  gint64 qmin, qmax, lo, hi;
+  gdouble tmp;
+
+  if (!gst_tensor_transform_get_quant_range (out_info->type, &qmin, &qmax)) {
+    ml_loge ("tensor-transform/quantize does not support the output type %s.\n",
+        gst_tensor_get_type_string (out_info->type));
+    return GST_FLOW_ERROR;
+  }
+
+  if (!gst_tensor_transform_get_quant_layout (filter, in_info, &outer,
+          &channels, &inner))
+    return GST_FLOW_ERROR;
+
+  /* the channels in the innermost dimension, quantize the rows with the repeated scale and zero-point */
+  if (inner == 1 && channels > 1 && filter->data_quant.num_params == channels
+      && in_info->type == _NNS_FLOAT32 && (out_info->type == _NNS_INT8
+          || out_info->type == _NNS_UINT8)) {
+    gsize num = outer * channels, row;
+    float *scale;
+    int32_t *zp;
+
+    row = gst_tensor_transform_get_quant_row (filter, channels, &scale, &zp);
+
+    for (offset = 0; offset < num; offset += row)
+      quantize_8bit_ch_kernel ((const float *) inptr + offset, outptr + offset,
+          MIN (row, num - offset), scale, zp, out_info->type == _NNS_INT8);
+
+    g_free (scale);
+    g_free (zp);
+    return GST_FLOW_OK;
+  }
+
+  in_element_size = gst_tensor_get_element_size (in_info->type);
+  out_element_size = gst_tensor_get_element_size (out_info->type);
+
+  for (o = 0; o < outer; o++) {
+    for (c = 0; c < channels; c++) {
+      const uint8_t *in = inptr + in_element_size * offset;
+      uint8_t *out = outptr + out_element_size * offset;
+
+      param = &filter->quant_params[(filter->data_quant.num_params == 1) ? 0 : c];
+      lo = qmin - param->zero_point;
+      hi = qmax - param->zero_point;
+
+      switch (in_info->type) {
+        case _NNS_FLOAT32:
+          if (out_info->type == _NNS_INT8 || out_info->type == _NNS_UINT8) {
+            quantize_8bit_kernel ((const float *) in, out, inner,
+                param->scale, param->zero_point, out_info->type == _NNS_INT8);
+          } else if (out_info->type == _NNS_INT16 ||
+              out_info->type == _NNS_UINT16) {
+            quantize_loop_out (float, float, out_info->type, in, out, inner,
+                param->scale, param->zero_point, lo, hi);
+          } else {
+            /* the range of 32-bit integer cannot be represented in float32 */
+            quantize_loop_out (float, double, out_info->type, in, out, inner,
+                param->scale, param->zero_point, lo, hi);
+          }
+          break;
+        case _NNS_FLOAT64:
+          quantize_loop_out (double, double, out_info->type, in, out, inner,
+              param->scale, param->zero_point, lo, hi);
+          break;
+        default:
+          for (i = 0; i < inner; i++) {
+            gst_tensor_data_raw_typecast ((gpointer) (in + in_element_size * i),
+                in_info->type, &tmp, _NNS_FLOAT64);
+            quantize_loop_out (double, double, out_info->type, &tmp,
+                out + out_element_size * i, 1, param->scale,
+                param->zero_point, lo, hi);
+          }
+          break;
+      }
+
+      offset += inner;
+    }
+  }
+
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief subrouting for tensor-tranform, "dequantize" case.
+ *        : out = (in - zero_point) * scale
+ * @param[in/out] filter "this" pointer
+ * @param[in] in_info input tensor info
+ * @param[in] out_info output tensor info
+ * @param[in] inptr input tensor
+ * @param[out] outptr output tensor
+ * @return Gst flow status
+ */
+static GstFlowReturn
+gst_tensor_transform_dequantize (GstTensorTransform * filter,
+    GstTensorInfo * in_info, GstTensorInfo * out_info,
+    const uint8_t * inptr, uint8_t * outptr)
+{
+  const tensor_transform_quant_param *param;
+  gsize in_element_size, out_element_size;
+  gsize o, outer, inner, offset = 0;
+  guint c, channels;
+  gint64 qmin, qmax;
+
+  if (!gst_tensor_transform_get_quant_range (in_info->type, &qmin, &qmax)) {
+    ml_loge ("tensor-transform/dequantize does not support the input type %s.\n",
+        gst_tensor_get_type_string (in_info->type));
+    return GST_FLOW_ERROR;
+  }
+
+  if (!gst_tensor_transform_get_quant_layout (filter, in_info, &outer,
+          &channels, &inner))
+    return GST_FLOW_ERROR;
+
+  for (c = 0; c < filter->data_quant.num_params; c++) {
+    param = &filter->quant_params[c];
+    if (param->zero_point < qmin || param->zero_point > qmax) {
+      ml_loge
+          ("tensor-transform/dequantize: zero-point %d is out of the range of %s.\n",
+          param->zero_point, gst_tensor_get_type_string (in_info->type));
+      return GST_FLOW_ERROR;
+    }
+  }
+
+  /* the channels in the innermost dimension, dequantize the rows with the repeated scale and zero-point */
+  if (inner == 1 && channels > 1 && filter->data_quant.num_params == channels
+      && out_info->type == _NNS_FLOAT32 && (in_info->type == _NNS_INT8
+          || in_info->type == _NNS_UINT8)) {
+    gsize num = outer * channels, row;
+    float *scale;
+    int32_t *zp;
+
+    row = gst_tensor_transform_get_quant_row (filter, channels, &scale, &zp);
+
+    for (offset = 0; offset < num; offset += row)
+      dequantize_8bit_ch_kernel (inptr + offset, (float *) outptr + offset,
+          MIN (row, num - offset), scale, zp, in_info->type == _NNS_INT8);
+
+    g_free (scale);
+    g_free (zp);
+    return GST_FLOW_OK;
+  }
+
+  in_element_size = gst_tensor_get_element_size (in_info->type);
+  out_element_size = gst_tensor_get_element_size (out_info->type);
+
+  for (o = 0; o < outer; o++) {
+    for (c = 0; c < channels; c++) {
+      const uint8_t *in = inptr + in_element_size * offset;
+      uint8_t *out = outptr + out_element_size * offset;
+
+      param = &filter->quant_params[(filter->data_quant.num_params == 1) ? 0 : c];
+
+      switch (out_info->type) {
+        case _NNS_FLOAT32:
+          if (in_info->type == _NNS_INT8 || in_info->type == _NNS_UINT8) {
+            dequantize_8bit_kernel (in, (float *) out, inner, param->scale,
+                param->zero_point, in_info->type == _NNS_INT8);
+          } else {
+            dequantize_loop_in (in_info->type, float, in, out, inner,
+                param->scale, param->zero_point);
+          }
+          break;
+        case _NNS_FLOAT64:
+          dequantize_loop_in (in_info->type, double, in, out, inner,
+              param->scale, param->zero_point);
+          break;
+        default:
+          ml_loge
+              ("tensor-transform/dequantize does not support the output type %s.\n",
+              gst_tensor_get_type_string (out_info->type));
+          return GST_FLOW_ERROR;
+      }
+
+      offset += inner;
+    }
+  }
+
+  return GST_FLOW_OK;
+}
+
 /**
  * @brief non-ip transform. required vmethod for BaseTransform class.
  * @param[in/out] trans "super" pointer
@@ -1636,10 +3111,12 @@ gst_tensor_transform_transform (GstBaseTransform * trans,
   GstTensorMetaInfo meta;
   GstTensorInfo in_flex_info, out_flex_info;
   gboolean in_flexible, out_flexible;
+  gint64 start_time;
 
   filter = GST_TENSOR_TRANSFORM_CAST (trans);
 
   g_return_val_if_fail (filter->loaded, GST_FLOW_ERROR);
+  start_time = g_get_monotonic_time ();
   inbuf = gst_tensor_buffer_from_config (inbuf, &filter->in_config);
 
   in_flexible =
@@ -1710,7 +3187,13 @@ gst_tensor_transform_transform (GstBaseTransform * trans,
       buf_size += hsize;
     }
 
-    out_mem[i] = gst_allocator_alloc (NULL, buf_size, NULL);
+    /* write the header into the headroom, in case static tensor is converted to flexible */
+    if (out_flexible) {
+      out_mem[i] = gst_allocator_alloc (NULL, buf_size, NULL);
+    } else {
+      gst_tensor_info_convert_to_meta (out_info, &meta);
+      out_mem[i] = gst_tensor_alloc_with_headroom (&meta, buf_size);
+    }
     gst_buffer_append_memory (outbuf, out_mem[i]);
 
     if (!gst_memory_map (out_mem[i], &out_map[i], GST_MAP_WRITE)) {
@@ -1750,6 +3233,14 @@ gst_tensor_transform_transform (GstBaseTransform * trans,
         res = gst_tensor_transform_clamp (filter, in_info, out_info,
             inptr, outptr);
         break;
+      case GTT_QUANTIZE:
+        res = gst_tensor_transform_quantize (filter, in_info, out_info,
+            inptr, outptr);
+        break;
+      case GTT_DEQUANTIZE:
+        res = gst_tensor_transform_dequantize (filter, in_info, out_info,
+            inptr, outptr);
+        break;
       default:
         ml_loge ("Not supported tensor transform mode");
         res = GST_FLOW_NOT_SUPPORTED;
@@ -1765,6 +3256,12 @@ done:
       gst_memory_unmap (out_mem[i], &out_map[i]);
   }
 
+  if (res == GST_FLOW_OK) {
+    gst_tensor_latency_stats_record (&filter->stats,
+        g_get_monotonic_time () - start_time);
+    gst_tensor_latency_stats_post (&filter->stats, GST_ELEMENT_CAST (filter));
+  }
+
   return res;
 }
 
@@ -1906,6 +3403,17 @@ gst_tensor_transform_convert_dimension (GstTensorTransform * filter,
       /* same tensors info, do nothing. */
       break;
 
+    case GTT_QUANTIZE:
+    case GTT_DEQUANTIZE:
+      /** For both directions, dimension does not change */
+      if (direction == GST_PAD_SINK) {
+        out_info->type = filter->data_quant.out_type;
+      } else {
+        /* cannot get the incoming data type on sink pad */
+        out_info->type = _NNS_END;
+      }
+      break;
+
     default:
       return FALSE;
   }
@@ -62,6 +62,8 @@ typedef enum _tensor_transform_mode
   GTT_TRANSPOSE,      /* Transpose. "transpose" */
   GTT_STAND,          /* Standardization. "stand" */
   GTT_CLAMP,          /* Clamp, "clamp" */
+  GTT_QUANTIZE,       /* Quantize, "quantize" */
+  GTT_DEQUANTIZE,     /* Dequantize, "dequantize" */
 
   GTT_UNKNOWN = -1,   /* Unknown/Not-implemented-yet Mode. "unknown" */
 } tensor_transform_mode;
@@ -140,6 +142,24 @@ typedef struct _tensor_transform_clamp {
   double min, max;
 } tensor_transform_clamp;
 
+/**
+ * @brief Internal data structure for quantize and dequantize mode.
+ */
+typedef struct _tensor_transform_quant {
+  tensor_type out_type; /**< quantized type for quantize, float type for dequantize */
+  gboolean per_channel; /**< TRUE if scale and zero-point are given for each channel */
+  guint ch_dim; /**< the dimension of channel if per_channel is TRUE */
+  guint num_params; /**< the number of scale and zero-point pairs */
+} tensor_transform_quant;
+
+/**
+ * @brief Scale and zero-point of a channel for quantize and dequantize mode.
+ */
+typedef struct {
+  float scale;
+  int32_t zero_point;
+} tensor_transform_quant_param;
+
 /**
  * @brief Internal data structure for tensor_transform instances.
  */
@@ -157,14 +177,18 @@ struct _GstTensorTransform
     tensor_transform_transpose data_transpose; /**< Parsed option value for "transpose" mode. */
     tensor_transform_stand data_stand; /**< Parsed option value for "stand" mode. */
     tensor_transform_clamp data_clamp; /**< Parsed option value for "clamp" mode. */
+    tensor_transform_quant data_quant; /**< Parsed option value for "quantize" and "dequantize" mode. */
   };
   gboolean loaded; /**< TRUE if mode & option are loaded */
   gboolean acceleration; /**< TRUE to set orc acceleration */
   GSList *operators; /**< operators list */
+  tensor_transform_quant_param *quant_params; /**< scale and zero-point list of quantize and dequantize mode */
 
   GstTensorsConfig in_config; /**< input tensors config */
   GstTensorsConfig out_config; /**< output tensors config */
   GList *apply; /**< Select the tensors to apply transformation */
+
+  GstTensorLatencyStats stats; /**< latency statistics of the transform */
 };
 
 /**
@@ -79,6 +79,7 @@ class tensor_filter_subplugin {
     static int cpp_getFrameworkInfo (const GstTensorFilterFramework *tf, const GstTensorFilterProperties * prop, void *private_data, GstTensorFilterFrameworkInfo *fw_info); /**< C V1 wrapper func, getFrameworkInfo */
     static int cpp_getModelInfo (const GstTensorFilterFramework *tf, const GstTensorFilterProperties * prop, void *private_data, model_info_ops ops, GstTensorsInfo *in_info, GstTensorsInfo *out_info); /**< C V1 wrapper func, getModelInfo */
     static int cpp_eventHandler (const GstTensorFilterFramework *tf, const GstTensorFilterProperties * prop, void *private_data, event_ops ops, GstTensorFilterFrameworkEventData *data); /**< C V1 wrapper func, eventHandler */
+    static int cpp_invoke_async (const GstTensorFilterFramework *tf, const GstTensorFilterProperties *prop, void *private_data, const GstTensorMemory *input, GstTensorMemory *output, GstTensorFilterInvokeDoneCallback done_cb, void *user_data); /**< C V1 wrapper func, invoke_async */
 
     GstTensorFilterFramework fwdesc; /**< Represents C/V1 wrapper for the derived class and its objects. Derived should not access this anyway; the base class will handle this with the C wrapper functions, base static-functions, and base constructors/destructors. */
 
@@ -105,6 +106,12 @@ class tensor_filter_subplugin {
       memcpy (&emptyInstance->fwdesc, &fwdesc_template,
           sizeof (fwdesc_template));
       emptyInstance->fwdesc.subplugin_data = emptyInstance;
+#if __cplusplus >= 201103L
+      /** Let tensor_filter call invoke directly unless T overrides invoke_async */
+      if (!std::is_same<decltype (&T::invoke_async),
+              decltype (&tensor_filter_subplugin::invoke_async)>::value)
+        emptyInstance->fwdesc.invoke_async = cpp_invoke_async;
+#endif
       nnstreamer_filter_probe (&emptyInstance->fwdesc);
 
       return emptyInstance;
@@ -190,6 +197,14 @@ class tensor_filter_subplugin {
           *                 (e.g., let the framework do "free")
           *  Return -EINVAL if it is an invalid request.
           */
+
+    virtual int invoke_async (const GstTensorMemory *input, GstTensorMemory *output, GstTensorFilterInvokeDoneCallback done_cb, void *user_data);
+        /**< Optional. If not implemented, invoke is called instead.
+          *  It is registered only if the derived class overrides it.
+          *  Submit the input and call done_cb once the output is filled.
+          *  Return -ENOENT if this input should be run with invoke.
+          *  done_cb should not be called if it returns non-zero.
+          */
 };
 
 } /* namespace nnstreamer */
@@ -82,6 +82,22 @@ gst_tensors_caps_from_config (const GstTensorsConfig * config);
  */
 extern void gst_tensor_alloc_init (gsize alignment);
 
+/**
+ * @brief Memory flag for the memory which has the header of flexible tensor in the headroom.
+ * @see gst_tensor_alloc_with_headroom()
+ */
+#define GST_TENSOR_MEMORY_FLAG_HEADROOM (GST_MEMORY_FLAG_LAST << 0)
+
+/**
+ * @brief Allocate the memory of a tensor with the header of flexible tensor in the headroom.
+ * @param meta tensor meta structure to be written into the header
+ * @param size the size of tensor data
+ * @return Newly allocated GstMemory (Caller should free returned memory using gst_memory_unref())
+ * @note The header is written once at allocation. If it is same as the header to be appended, gst_tensor_meta_info_append_header() shares the memory without copying the data.
+ */
+extern GstMemory *
+gst_tensor_alloc_with_headroom (GstTensorMetaInfo * meta, gsize size);
+
 /**
  * @brief Parse memory and fill the tensor meta.
  * @param[out] meta tensor meta structure to be filled
@@ -96,6 +112,7 @@ gst_tensor_meta_info_parse_memory (GstTensorMetaInfo * meta, GstMemory * mem);
  * @param[in] meta tensor meta structure
  * @param[in] mem pointer to GstMemory
  * @return Newly allocated GstMemory (Caller should free returned memory using gst_memory_unref())
+ * @note If the memory is allocated with gst_tensor_alloc_with_headroom() and has the same header, the returned memory shares the data of given memory.
  */
 extern GstMemory *
 gst_tensor_meta_info_append_header (GstTensorMetaInfo * meta, GstMemory * mem);
@@ -31,6 +31,11 @@
 extern "C" {
 #endif
 
+/**
+ * @brief The return value of the decode-memory function to let tensor_decoder call decode with the mapped input.
+ */
+#define GST_TENSOR_DECODER_FALLBACK (GST_FLOW_CUSTOM_SUCCESS)
+
 /**
  * @brief Decoder definitions for different semantics of tensors
  *        This allows developers to create their own decoders.
@@ -126,6 +131,38 @@ nnstreamer_decoder_find (const char *name);
 extern void
 nnstreamer_decoder_set_custom_property_desc (const char *name, const char *prop, ...);
 
+/**
+ * @brief Optional function of the decoder sub-plugin to be called instead of decode, which gets the input memory blocks without mapping them.
+ * @details The sub-plugin may append the input memory blocks to outbuf with gst_memory_ref () or gst_memory_share () without copying the data.
+ *          If this is registered, tensor_decoder does not call getTransformSize and outbuf is always empty (gst_buffer_get_size (outbuf) == 0). Thus, decode should also append the memory blocks to outbuf.
+ *          If the sub-plugin cannot decode the input without copying, return GST_TENSOR_DECODER_FALLBACK and tensor_decoder calls decode with the mapped input.
+ *          This is not a member of GstTensorDecoderDef to keep the ABI of the sub-plugins built with the previous header.
+ * @param[in/out] private_data A sub-plugin may save its internal private data here. The sub-plugin is responsible for alloc/free of this pointer.
+ * @param[in] config The structure of input tensor info.
+ * @param[in] input The array of input memory blocks. The maximum array size of input data is NNS_TENSOR_SIZE_LIMIT. The sub-plugin should not unref these.
+ * @param[out] outbuf A sub-plugin should append proper memory for the negotiated media type.
+ * @return GST_FLOW_OK if OK. GST_TENSOR_DECODER_FALLBACK to call decode instead.
+ */
+typedef GstFlowReturn (*GstTensorDecoderDecodeMemory) (void **private_data,
+    const GstTensorsConfig *config, GstMemory **input, GstBuffer *outbuf);
+
+/**
+ * @brief Decoder's sub-plugin may call this after nnstreamer_decoder_probe() to register the function decoding the input memory blocks.
+ * @param[in] name The name of decoder sub-plugin.
+ * @param[in] func The function to decode the input memory blocks. NULL to unregister it.
+ * @return TRUE if registered. FALSE if the sub-plugin is not registered.
+ */
+extern int
+nnstreamer_decoder_set_decode_memory (const char *name, GstTensorDecoderDecodeMemory func);
+
+/**
+ * @brief Get the function decoding the input memory blocks of decoder sub-plugin.
+ * @param[in] name The name of decoder sub-plugin.
+ * @return NULL if not registered.
+ */
+extern GstTensorDecoderDecodeMemory
+nnstreamer_decoder_get_decode_memory (const char *name);
+
 #ifdef __cplusplus
 }
 #endif
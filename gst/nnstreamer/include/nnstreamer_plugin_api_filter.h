@@ -182,7 +182,7 @@ typedef struct _GstTensorFilterFrameworkStatistics
 typedef struct _GstTensorFilterFrameworkInfo
 {
   const char *name; /**< Name of the neural network framework, searchable by FRAMEWORK property. Subplugin is supposed to allocate/deallocate. */
-  int allow_in_place; /**< TRUE(nonzero) if InPlace transfer of input-to-output is allowed. Not supported in main, yet */
+  int allow_in_place; /**< TRUE(nonzero) if InPlace transfer of input-to-output is allowed. If the input and output tensors have the same info, tensor_filter may call invoke with output[i].data == input[i].data. */
   int allocate_in_invoke; /**< TRUE(nonzero) if invoke_NN is going to allocate outputptr by itself and return the address via outputptr. Do not change this value after cap negotiation is complete (or the stream has been started). */
   int run_without_model; /**< TRUE(nonzero) when the neural network framework does not need a model file. Tensor-filter will run invoke_NN without model. */
   int verify_model_path; /**< TRUE(nonzero) when the NNS framework, not the sub-plugin, should verify the path of model files. */
@@ -191,6 +191,7 @@ typedef struct _GstTensorFilterFrameworkInfo
   accl_hw accl_auto;  /**< accelerator to be used in auto mode (acceleration to be used but accelerator is not specified for the filter) - default -1 implies use first entry from hw_list */
   accl_hw accl_default;   /**< accelerator to be used by default (valid user input is not provided) - default -1 implies use first entry from hw_list*/
   const GstTensorFilterFrameworkStatistics *statistics;  /**< usage statistics by the framework. This is shared across all opened instances of this framework */
+  int accept_output_buffer; /**< TRUE(nonzero) if invoke may also fill the output buffers given by the caller when allocate_in_invoke is TRUE. If output[i].data is not NULL, the sub-plugin should write the result into it and should not allocate new memory. tensor_filter_single uses this to avoid memcpy when the caller has already allocated the output. */
 } GstTensorFilterFrameworkInfo;
 
 /**
@@ -263,6 +264,13 @@ typedef struct _GstTensorFilterFrameworkEventData
 
 typedef struct _GstTensorFilterFramework GstTensorFilterFramework;
 
+/**
+ * @brief Callback to notify that the asynchronous invoke is done.
+ * @param[in] status 0 if OK. non-zero if error. (same as the return value of invoke)
+ * @param[in] user_data The user data given to invoke_async
+ */
+typedef void (*GstTensorFilterInvokeDoneCallback) (int status, void *user_data);
+
 /**
  * @brief Tensor_Filter Subplugin definition
  *
@@ -306,7 +314,7 @@ struct _GstTensorFilterFramework
     struct /** _GstTensorFilterFramework_v0 */
     {
       char *name; /**< Name of the neural network framework, searchable by FRAMEWORK property */
-      int allow_in_place; /**< TRUE(nonzero) if InPlace transfer of input-to-output is allowed. Not supported in main, yet */
+      int allow_in_place; /**< TRUE(nonzero) if InPlace transfer of input-to-output is allowed. If the input and output tensors have the same info, tensor_filter may call invoke with output[i].data == input[i].data. */
       int allocate_in_invoke; /**< TRUE(nonzero) if invoke_NN is going to allocate outputptr by itself and return the address via outputptr. Do not change this value after cap negotiation is complete (or the stream has been started). */
       int run_without_model; /**< TRUE(nonzero) when the neural network framework does not need a model file. Tensor-filter will run invoke_NN without model. */
       int verify_model_path; /**< TRUE(nonzero) when the NNS framework, not the sub-plugin, should verify the path of model files. */
@@ -486,6 +494,24 @@ struct _GstTensorFilterFramework
        * @return 0 if OK. non-zero if error. -ENOENT if operation is not supported. -EINVAL if operation is supported but provided arguments are invalid.
        */
       void *subplugin_data; /**< This is used by tensor_filter infrastructure. Subplugin authors should NEVER update this. Only the files in /gst/nnstreamer/tensor_filter/ are allowed to access this. */
+
+      int (*invoke_async) (const GstTensorFilterFramework * self,
+          const GstTensorFilterProperties * prop, void *private_data,
+          const GstTensorMemory * input, GstTensorMemory * output,
+          GstTensorFilterInvokeDoneCallback done_cb, void *user_data);
+      /**< Optional. Set NULL if not supported. Submit the given input to the network model and return without waiting for the result.
+       * tensor_filter calls this instead of invoke if the element property 'max-inflight' is set, and keeps the number of submitted inputs under it. The outputs are pushed in the order of the inputs.
+       * The sub-plugin should call done_cb exactly once for each submitted input, after the output is filled. done_cb may be called in any thread, even before invoke_async returns.
+       * The input and output memory blocks are valid until done_cb is called. The rules of allocate_in_invoke are same as invoke.
+       *
+       * @param[in] prop read-only property values
+       * @param[in/out] private_data A subplugin may save its internal private data here. The subplugin is responsible for alloc/free of this pointer.
+       * @param[in] input The array of input tensors. Allocated and filled by tensor_filter/main
+       * @param[out] output The array of output tensors. Allocated by tensor_filter/main and to be filled before calling done_cb.
+       * @param[in] done_cb The callback to notify that the invoke is done, with the status of the invoke.
+       * @param[in] user_data The data to be passed to done_cb.
+       * @return 0 if the input is submitted. -ENOENT to run this input with invoke. Other non-zero values if error. done_cb should not be called if it returns non-zero.
+       */
     }
 #ifdef NO_ANONYMOUS_NESTED_STRUCT
         v1
@@ -257,12 +257,28 @@ typedef struct
   int rate_d; /**< framerate is in fraction, which is numerator/denominator */
 } GstTensorsConfig;
 
+/**
+ * @brief Encoding of the indices of sparse tensor.
+ * A sparse tensor has the values of non-zero elements, followed by the indices in given encoding.
+ */
+typedef enum _tensor_sparse_encoding
+{
+  _NNS_SPARSE_ENCODING_COO = 0, /**< 32-bit index of each non-zero element (default) */
+  _NNS_SPARSE_ENCODING_BITMAP, /**< bitmap of non-zero elements, 1 bit per element */
+  _NNS_SPARSE_ENCODING_DELTA, /**< varint-coded distance from the previous non-zero element */
+  _NNS_SPARSE_ENCODING_CSR, /**< compressed sparse row along the innermost dimension */
+
+  _NNS_SPARSE_ENCODING_END
+} tensor_sparse_encoding;
+
 /**
  * @brief Internal data structure for sparse tensor info
  */
 typedef struct
 {
   uint32_t nnz; /**< the number of "non-zero" elements */
+  uint32_t encoding; /**< the encoding of indices (see tensor_sparse_encoding) */
+  uint32_t index_size; /**< the size of indices in bytes (0 if default COO) */
 } GstSparseTensorInfo;
 
 /**
@@ -25,6 +25,7 @@
 
 #include <string.h>
 #include <glib.h>
+#include <glib/gstdio.h>
 
 #include "nnstreamer_log.h"
 #include "nnstreamer_conf.h"
@@ -42,6 +43,9 @@
 #define NNSTREAMER_PREFIX_CONVERTER	"libnnstreamer_converter_"
 /* Custom filter does not have prefix */
 
+/* Registry version, increase this when changing the format of registry */
+#define NNSTREAMER_REGISTRY_VERSION	(1)
+
 /* Env-var names */
 static const gchar *NNSTREAMER_ENVVAR[NNSCONF_PATH_END] = {
   [NNSCONF_PATH_FILTERS] = "NNSTREAMER_FILTERS",
@@ -95,15 +99,23 @@ typedef struct
   gboolean loaded;            /**< TRUE if loaded at least once */
   gboolean enable_envvar;     /**< TRUE to parse env variables */
   gboolean enable_symlink;    /**< TRUE to allow symbolic link file */
+  gboolean enable_registry;   /**< TRUE to cache the sub-plugin list and load status */
 
   gchar *conffile;            /**< Location of conf file. */
   gchar *extra_conffile;      /**< Location of extra configuration file. */
+  gchar *registry;            /**< Location of registry file. */
+
+  GKeyFile *registry_data;    /**< The cached sub-plugin list and load status */
+  gboolean registry_updated;  /**< TRUE if the registry should be saved */
 
   subplugin_conf conf[NNSCONF_PATH_END];
 } confdata;
 
 static confdata conf = { 0 };
 
+/** @brief Protects the registry data */
+G_LOCK_DEFINE_STATIC (registry_lock);
+
 /**
  * @brief Parse string to get boolean value.
  */
@@ -165,6 +177,217 @@ _validate_file (nnsconf_type_path type, const gchar * fullpath)
   return TRUE;
 }
 
+/**
+ * @brief Private function to load the registry file.
+ */
+static void
+_registry_load (void)
+{
+  GKeyFile *key_file;
+  gint version = 0;
+
+  if (!conf.enable_registry)
+    return;
+
+#ifndef __TIZEN__
+  conf.registry = _strdup_getenv (NNSTREAMER_ENVVAR_REGISTRY);
+#endif
+  if (conf.registry == NULL) {
+    conf.registry = g_build_filename (g_get_user_cache_dir (), "nnstreamer",
+        NNSTREAMER_REGISTRY_FILE, NULL);
+  }
+
+  key_file = g_key_file_new ();
+  if (g_key_file_load_from_file (key_file, conf.registry, G_KEY_FILE_NONE,
+          NULL)) {
+    version = g_key_file_get_integer (key_file, "registry", "version", NULL);
+  }
+
+  if (version != NNSTREAMER_REGISTRY_VERSION) {
+    /* The registry does not exist or is outdated, create new one. */
+    g_key_file_free (key_file);
+    key_file = g_key_file_new ();
+    g_key_file_set_integer (key_file, "registry", "version",
+        NNSTREAMER_REGISTRY_VERSION);
+  }
+
+  G_LOCK (registry_lock);
+  conf.registry_data = key_file;
+  conf.registry_updated = FALSE;
+  G_UNLOCK (registry_lock);
+}
+
+/**
+ * @brief Private function to save the registry file if it is updated.
+ * @note Caller should hold the registry lock.
+ */
+static void
+_registry_save_locked (void)
+{
+  GError *error = NULL;
+  gchar *dir;
+
+  if (!conf.registry_data || !conf.registry_updated)
+    return;
+
+  /* It's ok even if we cannot save the registry (e.g., read-only home). */
+  dir = g_path_get_dirname (conf.registry);
+  if (g_mkdir_with_parents (dir, 0700) != 0) {
+    ml_logd ("Cannot create the directory of registry, %s.", dir);
+  } else if (!g_key_file_save_to_file (conf.registry_data, conf.registry,
+          &error)) {
+    ml_logd ("Cannot save the registry %s: %s", conf.registry,
+        error ? error->message : "unknown error");
+    g_clear_error (&error);
+  }
+
+  /* Do not try again until the registry is updated. */
+  conf.registry_updated = FALSE;
+  g_free (dir);
+}
+
+/**
+ * @brief Private function to free the registry data.
+ */
+static void
+_registry_free (void)
+{
+  G_LOCK (registry_lock);
+  if (conf.registry_data) {
+    g_key_file_free (conf.registry_data);
+    conf.registry_data = NULL;
+  }
+  conf.registry_updated = FALSE;
+  G_UNLOCK (registry_lock);
+
+  g_free (conf.registry);
+  conf.registry = NULL;
+}
+
+/**
+ * @brief Private function to check the entry of registry is valid.
+ * @details The entry is valid if the mtime of the path is not changed and the path was not modified in the same second of recording (racy entry).
+ * @note Caller should hold the registry lock.
+ */
+static gboolean
+_registry_entry_is_valid (const gchar * group, const gchar * path,
+    GStatBuf * st)
+{
+  gint64 mtime, checked;
+
+  if (g_stat (path, st) != 0)
+    return FALSE;
+
+  if (!g_key_file_has_group (conf.registry_data, group))
+    return FALSE;
+
+  mtime = g_key_file_get_int64 (conf.registry_data, group, "mtime", NULL);
+  checked = g_key_file_get_int64 (conf.registry_data, group, "checked", NULL);
+
+  return (mtime == (gint64) st->st_mtime && mtime < checked);
+}
+
+/**
+ * @brief Private function to get the list of sub-plugins in a directory from the registry.
+ * @return TRUE if the registry has the valid list of the directory.
+ */
+static gboolean
+_registry_get_filenames (nnsconf_type_path type, const gchar * dir,
+    GSList ** listF, GSList ** listN, guint * counter)
+{
+  GStatBuf st;
+  gchar *group;
+  gchar **files = NULL, **names = NULL;
+  gsize i, nfiles = 0, nnames = 0;
+  gboolean valid = FALSE;
+
+  G_LOCK (registry_lock);
+  if (conf.registry_data == NULL)
+    goto done;
+
+  group = g_strdup_printf ("dir:%d:%s", type, dir);
+  if (_registry_entry_is_valid (group, dir, &st) &&
+      g_key_file_get_boolean (conf.registry_data, group, "symlink",
+          NULL) == conf.enable_symlink) {
+    files = g_key_file_get_string_list (conf.registry_data, group, "files",
+        &nfiles, NULL);
+    names = g_key_file_get_string_list (conf.registry_data, group, "names",
+        &nnames, NULL);
+    valid = (nfiles == nnames);
+  }
+  g_free (group);
+
+  if (valid) {
+    for (i = 0; i < nfiles; i++) {
+      *listF = g_slist_prepend (*listF, files[i]);
+      *listN = g_slist_prepend (*listN, names[i]);
+    }
+
+    *counter = *counter + nfiles;
+
+    /* Do not free elements. They are now in the lists. */
+    g_free (files);
+    g_free (names);
+  } else {
+    g_strfreev (files);
+    g_strfreev (names);
+  }
+
+done:
+  G_UNLOCK (registry_lock);
+  return valid;
+}
+
+/**
+ * @brief Private function to record the list of sub-plugins in a directory to the registry.
+ * @param[in] type conf type of the directory.
+ * @param[in] dir The directory scanned.
+ * @param[in] mtime The mtime of the directory before scanning.
+ * @param[in] checked The time (seconds) when scanning is started.
+ * @param[in] listF The fullpath list, the first n elements are found in the directory (in reverse order).
+ * @param[in] listN The name list, the first n elements are found in the directory (in reverse order).
+ * @param[in] n The number of sub-plugins found in the directory.
+ */
+static void
+_registry_set_filenames (nnsconf_type_path type, const gchar * dir,
+    gint64 mtime, gint64 checked, GSList * listF, GSList * listN, guint n)
+{
+  const gchar **files, **names;
+  gchar *group;
+  guint i;
+
+  G_LOCK (registry_lock);
+  if (conf.registry_data == NULL)
+    goto done;
+
+  files = g_new0 (const gchar *, n + 1);
+  names = g_new0 (const gchar *, n + 1);
+
+  for (i = n; i > 0 && listF && listN; i--) {
+    files[i - 1] = listF->data;
+    names[i - 1] = listN->data;
+
+    listF = listF->next;
+    listN = listN->next;
+  }
+
+  group = g_strdup_printf ("dir:%d:%s", type, dir);
+  g_key_file_set_int64 (conf.registry_data, group, "mtime", mtime);
+  g_key_file_set_int64 (conf.registry_data, group, "checked", checked);
+  g_key_file_set_boolean (conf.registry_data, group, "symlink",
+      conf.enable_symlink);
+  g_key_file_set_string_list (conf.registry_data, group, "files", files, n);
+  g_key_file_set_string_list (conf.registry_data, group, "names", names, n);
+  conf.registry_updated = TRUE;
+
+  g_free (group);
+  g_free (files);
+  g_free (names);
+
+done:
+  G_UNLOCK (registry_lock);
+}
+
 /**
  * @brief Private function to fill in ".so/.dylib list" with fullpath-filenames in a directory.
  * @param[in] type conf type to scan.
@@ -180,11 +403,21 @@ _get_filenames (nnsconf_type_path type, const gchar * dir, GSList ** listF,
     GSList ** listN, guint * counter)
 {
   GDir *gdir;
+  GStatBuf st;
   const gchar *entry;
   gchar *fullpath;
   gchar *basename;
   gchar *name;
   gsize prefix, extension, len;
+  gint64 mtime, checked;
+  guint found = 0;
+
+  /* Get the mtime before scanning, the registry entry is invalid if the directory is changed while scanning. */
+  if (g_stat (dir, &st) != 0)
+    return FALSE;
+
+  mtime = (gint64) st.st_mtime;
+  checked = g_get_real_time () / G_USEC_PER_SEC;
 
   if ((gdir = g_dir_open (dir, 0U, NULL)) == NULL)
     return FALSE;
@@ -206,6 +439,7 @@ _get_filenames (nnsconf_type_path type, const gchar * dir, GSList ** listF,
         *listF = g_slist_prepend (*listF, fullpath);
         *listN = g_slist_prepend (*listN, name);
         *counter = *counter + 1;
+        found++;
 
         g_free (basename);
       } else {
@@ -215,6 +449,8 @@ _get_filenames (nnsconf_type_path type, const gchar * dir, GSList ** listF,
   }
 
   g_dir_close (gdir);
+
+  _registry_set_filenames (type, dir, mtime, checked, *listF, *listN, found);
   return TRUE;
 }
 
@@ -289,7 +525,9 @@ _fill_in_vstr (gchar *** fullpath_vstr, gchar *** name_vstr,
           break;
         }
       }
-      if (j == CONF_SOURCE_END)
+      if (j == CONF_SOURCE_END &&
+          !_registry_get_filenames (type, searchpath[i], &lstF, &lstN,
+              &counter))
         _get_filenames (type, searchpath[i], &lstF, &lstN, &counter);
     }
   }
@@ -359,6 +597,8 @@ nnsconf_loadconf (gboolean force_reload)
       g_strfreev (conf.conf[t].names);
     }
 
+    _registry_free ();
+
     /* init with 0 */
     memset (&conf, 0, sizeof (confdata));
   }
@@ -399,6 +639,9 @@ nnsconf_loadconf (gboolean force_reload)
     }
   }
 
+  /* The registry is disabled by default, it writes to the user cache dir. */
+  conf.enable_registry = FALSE;
+
   if (conf.conffile) {
     key_file = g_key_file_new ();
     g_assert (key_file != NULL); /** Internal lib error? out-of-memory? */
@@ -417,6 +660,11 @@ nnsconf_loadconf (gboolean force_reload)
       conf.enable_symlink = _parse_bool_string (value, FALSE);
       g_free (value);
 
+      value =
+          g_key_file_get_string (key_file, "common", "enable_registry", NULL);
+      conf.enable_registry = _parse_bool_string (value, FALSE);
+      g_free (value);
+
       conf.extra_conffile =
           g_key_file_get_string (key_file, "common", "extra_config_path", NULL);
 
@@ -451,6 +699,8 @@ nnsconf_loadconf (gboolean force_reload)
     ml_logw ("Failed to load the configuration, no config file found.");
   }
 
+  _registry_load ();
+
   for (t = 0; t < NNSCONF_PATH_END; t++) {
     if (t == NNSCONF_PATH_EASY_CUSTOM_FILTERS)
       continue;                 /* It does not have its own configuration */
@@ -468,6 +718,10 @@ nnsconf_loadconf (gboolean force_reload)
         conf.conf[t].path, t);
   }
 
+  G_LOCK (registry_lock);
+  _registry_save_locked ();
+  G_UNLOCK (registry_lock);
+
   conf.loaded = TRUE;
   return TRUE;
 }
@@ -537,6 +791,97 @@ nnsconf_get_subplugin_info (nnsconf_type_path type, subplugin_info_s * info)
   return g_strv_length (vstr);
 }
 
+/** @brief Public function defined in the header */
+nnsconf_registry_status
+nnsconf_registry_get_status (const gchar * fullpath)
+{
+  nnsconf_registry_status status = NNSCONF_REGISTRY_UNKNOWN;
+  GStatBuf st;
+  gchar *group;
+
+  g_return_val_if_fail (fullpath != NULL, NNSCONF_REGISTRY_UNKNOWN);
+
+  nnsconf_loadconf (FALSE);
+
+  G_LOCK (registry_lock);
+  if (conf.registry_data) {
+    group = g_strdup_printf ("file:%s", fullpath);
+
+    if (_registry_entry_is_valid (group, fullpath, &st) &&
+        g_key_file_get_int64 (conf.registry_data, group, "size",
+            NULL) == (gint64) st.st_size) {
+      status = g_key_file_get_boolean (conf.registry_data, group, "loadable",
+          NULL) ? NNSCONF_REGISTRY_LOADABLE : NNSCONF_REGISTRY_BROKEN;
+    }
+
+    g_free (group);
+  }
+  G_UNLOCK (registry_lock);
+
+  return status;
+}
+
+/** @brief Public function defined in the header */
+void
+nnsconf_registry_set_status (const gchar * fullpath, gboolean loadable)
+{
+  nnsconf_registry_status status;
+  GStatBuf st;
+  gchar *group;
+
+  g_return_if_fail (fullpath != NULL);
+
+  /* Do nothing if the status is not changed. */
+  status = nnsconf_registry_get_status (fullpath);
+  if (status == (loadable ? NNSCONF_REGISTRY_LOADABLE : NNSCONF_REGISTRY_BROKEN))
+    return;
+
+  if (g_stat (fullpath, &st) != 0)
+    return;
+
+  G_LOCK (registry_lock);
+  if (conf.registry_data) {
+    group = g_strdup_printf ("file:%s", fullpath);
+
+    g_key_file_set_int64 (conf.registry_data, group, "mtime",
+        (gint64) st.st_mtime);
+    g_key_file_set_int64 (conf.registry_data, group, "checked",
+        g_get_real_time () / G_USEC_PER_SEC);
+    g_key_file_set_int64 (conf.registry_data, group, "size",
+        (gint64) st.st_size);
+    g_key_file_set_boolean (conf.registry_data, group, "loadable", loadable);
+    conf.registry_updated = TRUE;
+
+    _registry_save_locked ();
+    g_free (group);
+  }
+  G_UNLOCK (registry_lock);
+}
+
+/** @brief Public function defined in the header */
+void
+nnsconf_registry_clear_status (const gchar * fullpath)
+{
+  gchar *group;
+
+  g_return_if_fail (fullpath != NULL);
+
+  nnsconf_loadconf (FALSE);
+
+  G_LOCK (registry_lock);
+  if (conf.registry_data) {
+    group = g_strdup_printf ("file:%s", fullpath);
+
+    if (g_key_file_remove_group (conf.registry_data, group, NULL)) {
+      conf.registry_updated = TRUE;
+      _registry_save_locked ();
+    }
+
+    g_free (group);
+  }
+  G_UNLOCK (registry_lock);
+}
+
 /**
  * @brief Internal cache for the custom key-values
  */
@@ -637,6 +982,7 @@ nnsconf_dump (gchar * str, gulong size)
       "[Common]\n"
       "  Enable envvar: %s\n"
       "  Enable sym-linked subplugins: %s\n"
+      "  Registry: %s\n"
       "[Filter]\n"
       "  Filter paths from .ini: %s\n"
       "             from envvar: %s\n"
@@ -651,6 +997,7 @@ nnsconf_dump (gchar * str, gulong size)
       NNSTREAMER_CONF_FILE, NNSTREAMER_DEFAULT_CONF_FILE,
       /* 2. [Common] */
       STR_BOOL (conf.enable_envvar), STR_BOOL (conf.enable_symlink),
+      (conf.registry ? conf.registry : "<disabled>"),
       /* 3. [Filter] */
       conf.conf[NNSCONF_PATH_FILTERS].path[CONF_SOURCE_INI],
       (conf.enable_envvar) ?
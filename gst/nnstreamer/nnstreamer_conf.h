@@ -28,6 +28,17 @@
  * - The configuration file (default: /etc/nnstreamer.ini)
  * - (Lowest) Internal hardcoded values.
  *
+ * The list of sub-plugin files in each directory and the load status of
+ * each sub-plugin are cached in the registry file (like the registry of
+ * GStreamer), $XDG_CACHE_HOME/nnstreamer/registry.ini by default.
+ * The registry is disabled by default. Set enable_registry to True in
+ * [common] of the configuration file to enable it, and set
+ * NNSTREAMER_REGISTRY to change the location.
+ * An entry of the registry is valid until the mtime of the directory or
+ * the file is changed. A sub-plugin file which cannot be opened is not
+ * recorded, because the failure may come from the environment (e.g., a
+ * missing dependency), so it is probed again next time.
+ *
  * Do not export this to devel package. This is an internal header.
  */
 #ifndef __GST_NNSTREAMER_CONF_H__
@@ -59,6 +70,8 @@ G_BEGIN_DECLS
 #define NNSTREAMER_CONF_FILE NNSTREAMER_DEFAULT_CONF_FILE
 #endif
 #define NNSTREAMER_ENVVAR_CONF_FILE     "NNSTREAMER_CONF"
+#define NNSTREAMER_ENVVAR_REGISTRY      "NNSTREAMER_REGISTRY"
+#define NNSTREAMER_REGISTRY_FILE        "registry.ini"
 
 typedef enum {
   NNSCONF_PATH_FILTERS = 0,
@@ -77,6 +90,15 @@ typedef struct
   gchar **paths;
 } subplugin_info_s;
 
+/**
+ * @brief The load status of a sub-plugin file in the registry.
+ */
+typedef enum {
+  NNSCONF_REGISTRY_UNKNOWN = 0, /**< Not in the registry, or the file is changed */
+  NNSCONF_REGISTRY_LOADABLE, /**< The sub-plugin was loaded and registered */
+  NNSCONF_REGISTRY_BROKEN, /**< The sub-plugin could not be loaded */
+} nnsconf_registry_status;
+
 /**
  * @brief Load the .ini file
  * @param[in] force_reload TRUE if you want to clean up and load conf again.
@@ -124,6 +146,29 @@ nnsconf_get_subplugin_name_prefix (nnsconf_type_path type);
 extern guint
 nnsconf_get_subplugin_info (nnsconf_type_path type, subplugin_info_s * info);
 
+/**
+ * @brief Get the load status of the sub-plugin file from the registry.
+ * @param[in] fullpath The full path to the sub-plugin file.
+ * @return The load status. NNSCONF_REGISTRY_UNKNOWN if the registry is disabled or the file is changed since the status is recorded.
+ */
+extern nnsconf_registry_status
+nnsconf_registry_get_status (const gchar * fullpath);
+
+/**
+ * @brief Record the load status of the sub-plugin file to the registry.
+ * @param[in] fullpath The full path to the sub-plugin file.
+ * @param[in] loadable TRUE if the sub-plugin is loaded and registered.
+ */
+extern void
+nnsconf_registry_set_status (const gchar * fullpath, gboolean loadable);
+
+/**
+ * @brief Remove the load status of the sub-plugin file from the registry, so that the file is probed again.
+ * @param[in] fullpath The full path to the sub-plugin file.
+ */
+extern void
+nnsconf_registry_clear_status (const gchar * fullpath);
+
 /**
  * @brief Get the custom configuration value from .ini and envvar.
  * @detail For predefined configurations defined in this header,
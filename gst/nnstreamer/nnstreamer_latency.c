@@ -0,0 +1,197 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * @file	nnstreamer_latency.c
+ * @date	19 Oct 2026
+ * @brief	Lock-free latency histogram of NNStreamer elements.
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	agent <agent@local>
+ * @bug		No known bugs except for NYI items
+ */
+
+#include <string.h>
+
+#include "nnstreamer_latency.h"
+
+/**
+ * @brief Atomic operations on 64-bit counters (glib supports atomic operations on int and pointer only).
+ */
+#define _count_get(p) __atomic_load_n ((p), __ATOMIC_RELAXED)
+#define _count_set(p,v) __atomic_store_n ((p), (v), __ATOMIC_RELAXED)
+#define _count_inc(p) __atomic_fetch_add ((p), 1, __ATOMIC_RELAXED)
+
+#define SUB_COUNT (1 << NNS_LATENCY_SUB_BITS)
+#define HALF_COUNT (1 << (NNS_LATENCY_SUB_BITS - 1))
+
+/**
+ * @brief Get the bucket index of the value.
+ * @details The values less than SUB_COUNT have their own buckets.
+ * Larger values are split by the power of two, and each range is divided into HALF_COUNT buckets.
+ */
+static inline guint
+_get_bucket_index (guint value)
+{
+  guint msb, shift;
+
+  if (value < SUB_COUNT)
+    return value;
+
+  msb = (guint) g_bit_nth_msf (value, -1);
+  shift = msb - NNS_LATENCY_SUB_BITS + 1;
+
+  return SUB_COUNT + (shift - 1) * HALF_COUNT + ((value >> shift) - HALF_COUNT);
+}
+
+/**
+ * @brief Get the highest value of the bucket.
+ */
+static inline gint64
+_get_bucket_value (guint index)
+{
+  guint shift, sub;
+
+  if (index < SUB_COUNT)
+    return index;
+
+  shift = (index - SUB_COUNT) / HALF_COUNT + 1;
+  sub = (index - SUB_COUNT) % HALF_COUNT + HALF_COUNT;
+
+  return ((gint64) (sub + 1) << shift) - 1;
+}
+
+/**
+ * @brief Initialize the latency statistics. This clears the recorded values.
+ */
+void
+gst_tensor_latency_stats_init (GstTensorLatencyStats * stats)
+{
+  g_return_if_fail (stats != NULL);
+
+  gst_tensor_latency_stats_reset (stats);
+}
+
+/**
+ * @brief Clear the recorded values (e.g., when the element starts or the stream is flushed).
+ */
+void
+gst_tensor_latency_stats_reset (GstTensorLatencyStats * stats)
+{
+  guint i;
+
+  g_return_if_fail (stats != NULL);
+
+  for (i = 0; i < NNS_LATENCY_NUM_BUCKETS; i++)
+    _count_set (&stats->counts[i], 0);
+
+  g_atomic_int_set (&stats->max, 0);
+  stats->last_report = g_get_monotonic_time ();
+}
+
+/**
+ * @brief Record a latency value. This does not allocate memory and does not take a lock.
+ */
+void
+gst_tensor_latency_stats_record (GstTensorLatencyStats * stats, gint64 latency)
+{
+  gint value, max;
+
+  g_return_if_fail (stats != NULL);
+
+  value = (gint) CLAMP (latency, 0, G_MAXINT);
+
+  _count_inc (&stats->counts[_get_bucket_index ((guint) value)]);
+
+  do {
+    max = g_atomic_int_get (&stats->max);
+  } while (value > max &&
+      !g_atomic_int_compare_and_exchange (&stats->max, max, value));
+}
+
+/**
+ * @brief Get the summary (count, percentiles and max) of the recorded values.
+ */
+void
+gst_tensor_latency_stats_summarize (GstTensorLatencyStats * stats,
+    GstTensorLatencySummary * summary)
+{
+  const gdouble percentiles[] = { 0.50, 0.95, 0.99 };
+  gint64 *values[] = { &summary->p50, &summary->p95, &summary->p99 };
+  guint64 counts[NNS_LATENCY_NUM_BUCKETS];
+  guint64 total = 0, accum = 0, rank;
+  guint i, p = 0;
+
+  g_return_if_fail (stats != NULL);
+  g_return_if_fail (summary != NULL);
+
+  memset (summary, 0, sizeof (GstTensorLatencySummary));
+
+  /* take a snapshot, the buckets may be updated while walking */
+  for (i = 0; i < NNS_LATENCY_NUM_BUCKETS; i++) {
+    counts[i] = _count_get (&stats->counts[i]);
+    total += counts[i];
+  }
+
+  summary->count = total;
+  summary->max = g_atomic_int_get (&stats->max);
+  if (total == 0)
+    return;
+
+  for (i = 0; i < NNS_LATENCY_NUM_BUCKETS && p < G_N_ELEMENTS (values); i++) {
+    accum += counts[i];
+
+    while (p < G_N_ELEMENTS (values)) {
+      rank = (guint64) (percentiles[p] * total + 0.5);
+      if (rank == 0)
+        rank = 1;
+      if (accum < rank)
+        break;
+
+      *values[p] = MIN (_get_bucket_value (i), summary->max);
+      p++;
+    }
+  }
+}
+
+/**
+ * @brief Set the interval to report the statistics.
+ */
+void
+gst_tensor_latency_stats_set_interval (GstTensorLatencyStats * stats,
+    guint interval)
+{
+  g_return_if_fail (stats != NULL);
+
+  g_atomic_int_set (&stats->interval, (gint) MIN (interval, G_MAXINT));
+}
+
+/**
+ * @brief Get the interval to report the statistics.
+ */
+guint
+gst_tensor_latency_stats_get_interval (GstTensorLatencyStats * stats)
+{
+  g_return_val_if_fail (stats != NULL, 0);
+
+  return (guint) g_atomic_int_get (&stats->interval);
+}
+
+/**
+ * @brief Check whether the statistics should be reported now, and update the time of the last report.
+ */
+gboolean
+gst_tensor_latency_stats_report_due (GstTensorLatencyStats * stats)
+{
+  gint64 now, interval;
+
+  g_return_val_if_fail (stats != NULL, FALSE);
+
+  interval = g_atomic_int_get (&stats->interval);
+  if (interval <= 0)
+    return FALSE;
+
+  now = g_get_monotonic_time ();
+  if (now - stats->last_report < interval * 1000)
+    return FALSE;
+
+  stats->last_report = now;
+  return TRUE;
+}
@@ -0,0 +1,119 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * @file	nnstreamer_latency.h
+ * @date	19 Oct 2026
+ * @brief	Internal header for lock-free latency histogram of NNStreamer elements.
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	agent <agent@local>
+ * @bug		No known bugs except for NYI items
+ *
+ * The histogram has log-linear buckets (like HDR histogram), so that the
+ * relative error of a recorded value is bounded (about 3%) for the whole
+ * range of latencies, from microseconds to minutes.
+ * Recording a value does not allocate memory and does not take a lock,
+ * so it can be called in the streaming thread of any element.
+ *
+ * Do not export this to devel package. This is an internal header.
+ */
+#ifndef __NNSTREAMER_LATENCY_H__
+#define __NNSTREAMER_LATENCY_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * @brief The number of bits of the linear sub-buckets.
+ */
+#define NNS_LATENCY_SUB_BITS (6)
+
+/**
+ * @brief The number of buckets to cover the values in [0, G_MAXINT].
+ */
+#define NNS_LATENCY_NUM_BUCKETS \
+  ((1 << NNS_LATENCY_SUB_BITS) + (31 - NNS_LATENCY_SUB_BITS) * (1 << (NNS_LATENCY_SUB_BITS - 1)))
+
+/**
+ * @brief Data structure for the latency statistics of an element.
+ * @note Do not access the fields directly, use the functions below.
+ */
+typedef struct
+{
+  guint64 counts[NNS_LATENCY_NUM_BUCKETS]; /**< the number of recorded values in each bucket */
+  gint max; /**< the max latency (usec) */
+  gint interval; /**< the interval (ms) to report the statistics, 0 to disable */
+  gint64 last_report; /**< the monotonic time (usec) of the last report */
+} GstTensorLatencyStats;
+
+/**
+ * @brief Data structure for the summary of the latency statistics.
+ */
+typedef struct
+{
+  guint64 count; /**< the number of recorded values */
+  gint64 p50; /**< the median latency (usec) */
+  gint64 p95; /**< the 95th percentile latency (usec) */
+  gint64 p99; /**< the 99th percentile latency (usec) */
+  gint64 max; /**< the max latency (usec) */
+} GstTensorLatencySummary;
+
+/**
+ * @brief Initialize the latency statistics. This clears the recorded values.
+ * @param stats The latency statistics
+ */
+extern void
+gst_tensor_latency_stats_init (GstTensorLatencyStats * stats);
+
+/**
+ * @brief Clear the recorded values (e.g., when the element starts or the stream is flushed).
+ * @param stats The latency statistics
+ * @note This keeps the interval to report the statistics.
+ */
+extern void
+gst_tensor_latency_stats_reset (GstTensorLatencyStats * stats);
+
+/**
+ * @brief Record a latency value. This does not allocate memory and does not take a lock.
+ * @param stats The latency statistics
+ * @param latency The latency (usec) to be recorded. The value is clamped to [0, G_MAXINT].
+ */
+extern void
+gst_tensor_latency_stats_record (GstTensorLatencyStats * stats, gint64 latency);
+
+/**
+ * @brief Get the summary (count, percentiles and max) of the recorded values.
+ * @param stats The latency statistics
+ * @param[out] summary The summary of the latency statistics
+ */
+extern void
+gst_tensor_latency_stats_summarize (GstTensorLatencyStats * stats,
+    GstTensorLatencySummary * summary);
+
+/**
+ * @brief Set the interval to report the statistics.
+ * @param stats The latency statistics
+ * @param interval The interval (ms), 0 to disable the report
+ */
+extern void
+gst_tensor_latency_stats_set_interval (GstTensorLatencyStats * stats,
+    guint interval);
+
+/**
+ * @brief Get the interval to report the statistics.
+ * @param stats The latency statistics
+ * @return The interval (ms), 0 if the report is disabled
+ */
+extern guint
+gst_tensor_latency_stats_get_interval (GstTensorLatencyStats * stats);
+
+/**
+ * @brief Check whether the statistics should be reported now, and update the time of the last report.
+ * @param stats The latency statistics
+ * @return TRUE if the interval has passed since the last report.
+ * @note This should be called in one thread (e.g., the streaming thread of the element).
+ */
+extern gboolean
+gst_tensor_latency_stats_report_due (GstTensorLatencyStats * stats);
+
+G_END_DECLS
+#endif /* __NNSTREAMER_LATENCY_H__ */
@@ -706,6 +706,118 @@ gst_tensor_aggregation_get_adapter (GHashTable * table, const guint32 key)
   return aggr->adapter;
 }
 
+/**
+ * @brief Creates a custom query to get the inference latency of downstream elements.
+ */
+GstQuery *
+gst_tensor_latency_query_new (void)
+{
+  GstStructure *s;
+
+  s = gst_structure_new (GST_TENSOR_LATENCY_QUERY_NAME,
+      "latency", G_TYPE_UINT64, (guint64) 0,
+      "throughput", G_TYPE_DOUBLE, 0.0,
+      "pts", G_TYPE_UINT64, (guint64) GST_CLOCK_TIME_NONE, NULL);
+
+  return gst_query_new_custom (GST_QUERY_CUSTOM, s);
+}
+
+/**
+ * @brief Parses the latency query.
+ */
+gboolean
+gst_tensor_latency_query_parse (GstQuery * query, GstClockTime * latency,
+    gdouble * throughput, GstClockTime * pts)
+{
+  const GstStructure *s;
+
+  g_return_val_if_fail (query != NULL, FALSE);
+
+  if (GST_QUERY_TYPE (query) != GST_QUERY_CUSTOM)
+    return FALSE;
+
+  s = gst_query_get_structure (query);
+  if (!s || !gst_structure_has_name (s, GST_TENSOR_LATENCY_QUERY_NAME))
+    return FALSE;
+
+  if (latency)
+    gst_structure_get_uint64 (s, "latency", latency);
+  if (throughput)
+    gst_structure_get_double (s, "throughput", throughput);
+  if (pts)
+    gst_structure_get_uint64 (s, "pts", pts);
+
+  return TRUE;
+}
+
+/**
+ * @brief Updates the latency query with the statistics of an element.
+ */
+gboolean
+gst_tensor_latency_query_update (GstQuery * query, GstClockTime latency,
+    gdouble throughput, GstClockTime pts)
+{
+  GstStructure *s;
+  GstClockTime q_latency, q_pts;
+  gdouble q_throughput;
+
+  if (!gst_tensor_latency_query_parse (query, &q_latency, &q_throughput,
+          &q_pts))
+    return FALSE;
+
+  s = gst_query_writable_structure (query);
+
+  q_latency += latency;
+  if (throughput > 0.0 && (q_throughput <= 0.0 || throughput < q_throughput))
+    q_throughput = throughput;
+  if (!GST_CLOCK_TIME_IS_VALID (q_pts))
+    q_pts = pts;
+
+  gst_structure_set (s, "latency", G_TYPE_UINT64, (guint64) q_latency,
+      "throughput", G_TYPE_DOUBLE, q_throughput,
+      "pts", G_TYPE_UINT64, (guint64) q_pts, NULL);
+
+  return TRUE;
+}
+
+/**
+ * @brief Gets the latency statistics as a structure.
+ */
+GstStructure *
+gst_tensor_latency_stats_to_structure (GstTensorLatencyStats * stats)
+{
+  GstTensorLatencySummary summary;
+
+  g_return_val_if_fail (stats != NULL, NULL);
+
+  gst_tensor_latency_stats_summarize (stats, &summary);
+
+  return gst_structure_new (GST_TENSOR_LATENCY_STATS_NAME,
+      "count", G_TYPE_UINT64, summary.count,
+      "p50", G_TYPE_UINT64, (guint64) summary.p50,
+      "p95", G_TYPE_UINT64, (guint64) summary.p95,
+      "p99", G_TYPE_UINT64, (guint64) summary.p99,
+      "max", G_TYPE_UINT64, (guint64) summary.max, NULL);
+}
+
+/**
+ * @brief Posts an element message with the latency statistics if the report interval has passed.
+ */
+void
+gst_tensor_latency_stats_post (GstTensorLatencyStats * stats,
+    GstElement * element)
+{
+  g_return_if_fail (stats != NULL);
+  g_return_if_fail (GST_IS_ELEMENT (element));
+
+  if (!gst_tensor_latency_stats_report_due (stats))
+    return;
+
+  gst_element_post_message (element,
+      gst_message_new_element (GST_OBJECT_CAST (element),
+          gst_tensor_latency_stats_to_structure (stats)));
+}
+
 /**
  * @brief Internal function to get caps for single tensor from config.
  */
@@ -1225,6 +1337,55 @@ gst_tensor_meta_info_parse_memory (GstTensorMetaInfo * meta, GstMemory * mem)
   return ret;
 }
 
+/**
+ * @brief Share the memory including the header in the headroom, if the header is same as given meta.
+ * @return Newly allocated GstMemory, NULL if the memory does not have the same header in the headroom.
+ */
+static GstMemory *
+_gst_tensor_meta_info_share_with_header (GstTensorMetaInfo * meta,
+    GstMemory * mem, gsize hsize)
+{
+  GstMemory *new_mem;
+  GstMapInfo map;
+  gpointer header;
+  gboolean same;
+
+  /**
+   * The header is written only in the memory allocated with gst_tensor_alloc_with_headroom().
+   * Note that the shared memory (e.g., the data without the header) has the flag of its parent.
+   */
+  if (!GST_MEMORY_FLAG_IS_SET (mem, GST_TENSOR_MEMORY_FLAG_HEADROOM) ||
+      mem->parent != NULL || mem->offset != hsize)
+    return NULL;
+
+  new_mem = gst_memory_share (mem, -((gssize) hsize), -1);
+  if (!new_mem)
+    return NULL;
+
+  /**
+   * The memory may be shared with other elements (e.g., after tee), never write the header here.
+   * Compare it with given meta, and copy the data if it is different.
+   */
+  if (!gst_memory_map (new_mem, &map, GST_MAP_READ)) {
+    gst_memory_unref (new_mem);
+    return NULL;
+  }
+
+  header = g_malloc (hsize);
+  gst_tensor_meta_info_update_header (meta, header);
+  same = (memcmp (map.data, header, hsize) == 0);
+  g_free (header);
+
+  gst_memory_unmap (new_mem, &map);
+
+  if (!same) {
+    gst_memory_unref (new_mem);
+    return NULL;
+  }
+
+  return new_mem;
+}
+
 /**
  * @brief Append header to memory.
  * @param[in] meta tensor meta structure
@@ -1241,13 +1402,19 @@ gst_tensor_meta_info_append_header (GstTensorMetaInfo * meta, GstMemory * mem)
   g_return_val_if_fail (mem != NULL, NULL);
   g_return_val_if_fail (gst_tensor_meta_info_validate (meta), NULL);
 
+  hsize = gst_tensor_meta_info_get_header_size (meta);
+
+  /* zero-copy, if the memory already has the same header in the headroom */
+  new_mem = _gst_tensor_meta_info_share_with_header (meta, mem, hsize);
+  if (new_mem)
+    return new_mem;
+
   if (!gst_memory_map (mem, &old_map, GST_MAP_READ)) {
     nns_loge ("Failed to append header, cannot map the old memory.");
     return NULL;
   }
 
   /* memory size (header + old memory) */
-  hsize = gst_tensor_meta_info_get_header_size (meta);
   msize = hsize + old_map.size;
 
   new_mem = gst_allocator_alloc (NULL, msize, NULL);
@@ -1139,6 +1139,17 @@ gst_tensor_get_format_string (tensor_format format)
  */
 #define GST_TENSOR_META_VERSION GST_TENSOR_META_MAKE_VERSION(1,0)
 
+/**
+ * @brief The version of tensor meta, which has the encoding and the size of sparse indices.
+ * The header of sparse tensor with other than COO encoding is written with this version, old peers cannot parse it as COO.
+ */
+#define GST_TENSOR_META_VERSION_SPARSE_ENCODING GST_TENSOR_META_MAKE_VERSION(1,1)
+
+/**
+ * @brief Macro to check the version of tensor meta is supported (newer minor version may have unknown fields).
+ */
+#define GST_TENSOR_META_IS_SUPPORTED(v) (GST_TENSOR_META_VERSION_VALID(v) && ((v) & 0x00FFFFFF) <= (GST_TENSOR_META_VERSION_SPARSE_ENCODING & 0x00FFFFFF))
+
 /**
  * @brief Macro to check the version of tensor meta.
  */
@@ -1226,6 +1237,13 @@ gst_tensor_meta_info_validate (GstTensorMetaInfo * meta)
     return FALSE;
   }
 
+  if (meta->format == _NNS_TENSOR_FORMAT_SPARSE &&
+      meta->sparse_info.encoding >= _NNS_SPARSE_ENCODING_END) {
+    nns_logd ("Failed to validate tensor meta info. invalid sparse encoding: %u.",
+        meta->sparse_info.encoding);
+    return FALSE;
+  }
+
   return TRUE;
 }
 
@@ -1265,7 +1283,11 @@ gst_tensor_meta_info_get_data_size (GstTensorMetaInfo * meta)
   dsize = gst_tensor_get_element_size (meta->type);
 
   if (meta->format == _NNS_TENSOR_FORMAT_SPARSE) {
-    return meta->sparse_info.nnz * (dsize + sizeof (guint));
+    if (meta->sparse_info.encoding == _NNS_SPARSE_ENCODING_COO &&
+        meta->sparse_info.index_size == 0)
+      return meta->sparse_info.nnz * (dsize + sizeof (guint));
+
+    return meta->sparse_info.nnz * dsize + meta->sparse_info.index_size;
   }
 
   for (i = 0; i < NNS_TENSOR_META_RANK_LIMIT; i++) {
@@ -1298,6 +1320,14 @@ gst_tensor_meta_info_update_header (GstTensorMetaInfo * meta, gpointer header)
   memset (header, 0, hsize);
 
   memcpy (header, meta, sizeof (GstTensorMetaInfo));
+
+  /* the encoding of sparse indices is given since version 1.1, others are compatible with 1.0. */
+  if (meta->format == _NNS_TENSOR_FORMAT_SPARSE &&
+      meta->sparse_info.encoding != _NNS_SPARSE_ENCODING_COO)
+    *((uint32_t *) header) = GST_TENSOR_META_VERSION_SPARSE_ENCODING;
+  else
+    *((uint32_t *) header) = GST_TENSOR_META_VERSION;
+
   return TRUE;
 }
 
@@ -1324,9 +1354,22 @@ gst_tensor_meta_info_parse_header (GstTensorMetaInfo * meta, gpointer header)
   meta->format = val[18];
   meta->media_type = val[19];
 
+  if (GST_TENSOR_META_VERSION_VALID (meta->version) &&
+      !GST_TENSOR_META_IS_SUPPORTED (meta->version)) {
+    nns_logd ("Failed to parse header, unsupported meta version 0x%x.",
+        meta->version);
+    return FALSE;
+  }
+
   switch ((tensor_format) meta->format) {
     case _NNS_TENSOR_FORMAT_SPARSE:
       meta->sparse_info.nnz = val[20];
+
+      /* version 1.0 has COO indices only */
+      if (meta->version == GST_TENSOR_META_VERSION_SPARSE_ENCODING) {
+        meta->sparse_info.encoding = val[21];
+        meta->sparse_info.index_size = val[22];
+      }
       break;
     default:
       break;
@@ -117,6 +117,8 @@ _search_subplugin (subpluginType type, const gchar * name, const gchar * path)
   if (module == NULL) {
     ml_loge ("Cannot open %s(%s) with error %s.", name, path,
         g_module_error ());
+    /* the failure may be transient (e.g., missing library), do not persist it */
+    nnsconf_registry_clear_status (path);
     return NULL;
   }
 
@@ -130,6 +132,8 @@ _search_subplugin (subpluginType type, const gchar * name, const gchar * path)
     g_module_close (module);
   }
 
+  nnsconf_registry_set_status (path, spdata != NULL);
+
   return spdata;
 }
 
@@ -168,6 +172,36 @@ get_subplugin (subpluginType type, const char *name)
   return (spdata != NULL) ? spdata->data : NULL;
 }
 
+/** @brief Public function defined in the header */
+gboolean
+subplugin_is_available (subpluginType type, const char *name)
+{
+  g_return_val_if_fail (name, FALSE);
+
+  if (_get_subplugin_data (type, name))
+    return TRUE;
+
+  if (searchAlgorithm[type] == NNS_SEARCH_FILENAME) {
+    nnsconf_type_path conf_type = (nnsconf_type_path) type;
+    const gchar *fullpath = nnsconf_get_fullpath (name, conf_type);
+
+    if (!nnsconf_validate_file (conf_type, fullpath))
+      return FALSE;
+
+    switch (nnsconf_registry_get_status (fullpath)) {
+      case NNSCONF_REGISTRY_LOADABLE:
+        return TRUE;
+      case NNSCONF_REGISTRY_BROKEN:
+        return FALSE;
+      default:
+        break;
+    }
+  }
+
+  /* The load status is unknown, load the subplugin to check it. */
+  return (get_subplugin (type, name) != NULL);
+}
+
 /** @brief Public function defined in the header */
 gchar **
 get_all_subplugins (subpluginType type)
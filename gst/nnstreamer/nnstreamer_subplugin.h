@@ -60,6 +60,16 @@ typedef enum {
 extern const void *
 get_subplugin (subpluginType type, const char *name);
 
+/**
+ * @brief Check whether the subplugin is available, without loading it if the registry has its load status.
+ * @param[in] type Subplugin Type
+ * @param[in] name Subplugin Name. The filename should be libnnstreamer_${type}_${name}.so
+ * @return TRUE if the subplugin is registered or the registry says it can be loaded.
+ * @note If the registry does not have the load status of the subplugin, this loads the subplugin to check it.
+ */
+extern gboolean
+subplugin_is_available (subpluginType type, const char *name);
+
 /**
  * @brief Get the list of registered subplugins.
  * @param[in] type Subplugin Type
@@ -126,3 +126,43 @@ gst_tensor_alloc_init (gsize alignment)
   }
   gst_allocator_set_default (allocator);
 }
+
+/**
+ * @brief Allocate the memory of a tensor with the header of flexible tensor in the headroom.
+ * @param meta tensor meta structure to be written into the header
+ * @param size the size of tensor data
+ * @return Newly allocated GstMemory (Caller should free returned memory using gst_memory_unref())
+ */
+GstMemory *
+gst_tensor_alloc_with_headroom (GstTensorMetaInfo * meta, gsize size)
+{
+  GstMemory *mem;
+  GstMapInfo map;
+  gsize hsize;
+
+  g_return_val_if_fail (gst_tensor_meta_info_validate (meta), NULL);
+
+  hsize = gst_tensor_meta_info_get_header_size (meta);
+
+  mem = gst_allocator_alloc (NULL, hsize + size, NULL);
+  if (!mem)
+    return NULL;
+
+  /* the header is written only here, nobody else holds the memory yet. */
+  if (!gst_memory_map (mem, &map, GST_MAP_WRITE)) {
+    gst_memory_unref (mem);
+    return NULL;
+  }
+
+  gst_tensor_meta_info_update_header (meta, map.data);
+  gst_memory_unmap (mem, &map);
+
+  /* hide the header, the data of tensor starts after the headroom. */
+  gst_memory_resize (mem, hsize, size);
+
+  /* only the system memory can be shared including the headroom */
+  if (gst_memory_is_type (mem, GST_ALLOCATOR_SYSMEM))
+    GST_MINI_OBJECT_FLAG_SET (mem, GST_TENSOR_MEMORY_FLAG_HEADROOM);
+
+  return mem;
+}
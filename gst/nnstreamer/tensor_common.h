@@ -38,6 +38,7 @@
 #include "tensor_typedef.h"
 #include "nnstreamer_log.h"
 #include "nnstreamer_plugin_api.h"
+#include "nnstreamer_latency.h"
 
 #ifdef HAVE_ORC
 #include <orc/orcfunctions.h>
@@ -235,6 +236,67 @@ gst_tensor_aggregation_clear_all (GHashTable * table);
 extern GstAdapter *
 gst_tensor_aggregation_get_adapter (GHashTable * table, const guint32 key);
 
+/**
+ * @brief Name of the custom query to get the inference latency of downstream tensor_filter elements.
+ */
+#define GST_TENSOR_LATENCY_QUERY_NAME "nnstreamer-tensor-latency"
+
+/**
+ * @brief Creates a custom query to get the inference latency of downstream elements.
+ * @return Newly allocated query, caller should release this using gst_query_unref().
+ */
+extern GstQuery *
+gst_tensor_latency_query_new (void);
+
+/**
+ * @brief Parses the latency query.
+ * @param query The query created with gst_tensor_latency_query_new()
+ * @param[out] latency The accumulated inference latency (ns) of downstream elements
+ * @param[out] throughput The lowest throughput (fps) of downstream elements, 0 if unknown
+ * @param[out] pts The timestamp of the latest buffer processed in downstream elements
+ * @return TRUE if the query is the latency query.
+ */
+extern gboolean
+gst_tensor_latency_query_parse (GstQuery * query, GstClockTime * latency,
+    gdouble * throughput, GstClockTime * pts);
+
+/**
+ * @brief Updates the latency query with the statistics of an element.
+ * @details The latency is accumulated and the lowest throughput is kept. The timestamp is updated only if it is not set yet, so the element should forward the query downstream first.
+ * @param query The query created with gst_tensor_latency_query_new()
+ * @param latency The inference latency (ns) of the element
+ * @param throughput The throughput (fps) of the element, 0 if unknown
+ * @param pts The timestamp of the latest buffer processed in the element
+ * @return TRUE if the query is updated.
+ */
+extern gboolean
+gst_tensor_latency_query_update (GstQuery * query, GstClockTime latency,
+    gdouble throughput, GstClockTime pts);
+
+/**
+ * @brief Name of the structure and the element message for the latency statistics.
+ */
+#define GST_TENSOR_LATENCY_STATS_NAME "nnstreamer-latency-stats"
+
+/**
+ * @brief Gets the latency statistics as a structure.
+ * @details The structure has the fields "count" (guint64), "p50", "p95", "p99" and "max" (guint64, usec).
+ * @param stats The latency statistics
+ * @return Newly allocated structure, caller should release this using gst_structure_free().
+ */
+extern GstStructure *
+gst_tensor_latency_stats_to_structure (GstTensorLatencyStats * stats);
+
+/**
+ * @brief Posts an element message with the latency statistics if the report interval has passed.
+ * @param stats The latency statistics
+ * @param element The element to post the message
+ * @note This should be called in the streaming thread of the element.
+ */
+extern void
+gst_tensor_latency_stats_post (GstTensorLatencyStats * stats,
+    GstElement * element);
+
 /******************************************************
  ************ Commonly used debugging macros **********
  ******************************************************
@@ -61,12 +61,34 @@
  * with more tight QoS requirement. Lastly, 'tensor_filter' also sends QoS events to
  * upstream elements (e.g., tensor_converter, tensor_src) to possibly reduce incoming
  * framerates, which is a better solution than dropping framerates.
+ *
+ * The invoke latency of every inference is recorded in a histogram.
+ * 'stats' property gives the percentiles (p50, p95, p99) and the max latency
+ * as a GstStructure, and the same structure is posted as an element message
+ * on the bus every 'stats-interval' milliseconds if the interval is set.
+ *
+ * If 'reload-async' is set, changing the 'model' property while streaming
+ * does not block the stream. The new model is opened and warmed up (with
+ * 'warmup-data' or zero-filled input tensors) in a background thread, then
+ * swapped between invokes, and the old model is closed in the background.
+ * The new model should have the same input and output tensors.
+ * If the model is changed again while loading, only the latest model is
+ * loaded after the running reload is done.
+ * The result is posted as an element message "nnstreamer-model-reloaded"
+ * with the fields 'model', 'success' and 'load-time' (usec).
+ *
+ * If 'max-inflight' is set and the sub-plugin supports asynchronous invoke,
+ * tensor_filter submits up to 'max-inflight' inputs to the sub-plugin without
+ * waiting for the results, and a separate thread pushes the outputs in the
+ * order of the inputs. Serialized events (e.g., EOS) are forwarded after
+ * all submitted outputs are pushed. Other sub-plugins are invoked synchronously.
  */
 
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
 
+#include <errno.h>
 #include <string.h>
 #include <nnstreamer_util.h>
 
@@ -102,6 +124,55 @@ static GstStaticPadTemplate src_factory = GST_STATIC_PAD_TEMPLATE ("src",
     GST_PAD_ALWAYS,
     GST_STATIC_CAPS (CAPS_STRING));
 
+/**
+ * @brief tensor_filter properties, not shared with single-shot.
+ */
+enum
+{
+  PROP_STATS = GST_TENSOR_FILTER_PROP_ELEMENT_START,
+  PROP_STATS_INTERVAL,
+  PROP_RELOAD_ASYNC,
+  PROP_WARMUP_DATA,
+  PROP_MAX_INFLIGHT,
+};
+
+/**
+ * @brief Default value to reload the model in background thread.
+ */
+#define DEFAULT_RELOAD_ASYNC FALSE
+
+/**
+ * @brief Default value of max in-flight inputs, invoke synchronously.
+ */
+#define DEFAULT_MAX_INFLIGHT 0
+
+/**
+ * @brief Data to invoke the sub-plugin with an input buffer.
+ */
+typedef struct
+{
+  GstTensorFilter *filter; /**< the tensor_filter instance */
+  GstBuffer *inbuf; /**< input buffer, mapped until the invoke is done */
+  GstBuffer *outbuf; /**< output buffer to be pushed (asynchronous invoke) */
+  guint num_mems; /**< number of memory blocks in the input buffer */
+  GstMemory *in_mem[NNS_TENSOR_SIZE_LIMIT]; /**< memory blocks of the input buffer */
+  GstMapInfo in_info[NNS_TENSOR_SIZE_LIMIT]; /**< map info of the input memory */
+  GstMemory *out_mem[NNS_TENSOR_SIZE_LIMIT]; /**< output memory allocated by tensor_filter */
+  GstMapInfo out_info[NNS_TENSOR_SIZE_LIMIT]; /**< map info of the output memory */
+  GstTensorMemory in_tensors[NNS_TENSOR_SIZE_LIMIT]; /**< input tensors in the buffer */
+  GstTensorMemory invoke_tensors[NNS_TENSOR_SIZE_LIMIT]; /**< input tensors to invoke (input-combination) */
+  GstTensorMemory out_tensors[NNS_TENSOR_SIZE_LIMIT]; /**< output tensors */
+  GstTensorMetaInfo in_meta[NNS_TENSOR_SIZE_LIMIT]; /**< meta of flexible input tensors */
+  GstTensorMetaInfo out_meta[NNS_TENSOR_SIZE_LIMIT]; /**< meta of output tensors */
+  gboolean allocate_in_invoke; /**< TRUE if the sub-plugin allocates the output */
+  gboolean in_flexible; /**< TRUE if the input is flexible tensor */
+  gboolean out_flexible; /**< TRUE if the output is flexible tensor */
+  gint64 invoke_time; /**< time (usec) when the input is submitted */
+  gint64 latency; /**< invoke latency (usec) */
+  gint status; /**< return value of the invoke */
+  gboolean done; /**< TRUE when the invoke is done */
+} GstTensorFilterInvokeData;
+
 #define gst_tensor_filter_parent_class parent_class
 G_DEFINE_TYPE (GstTensorFilter, gst_tensor_filter, GST_TYPE_BASE_TRANSFORM);
 
@@ -111,10 +182,16 @@ static void gst_tensor_filter_set_property (GObject * object, guint prop_id,
 static void gst_tensor_filter_get_property (GObject * object, guint prop_id,
     GValue * value, GParamSpec * pspec);
 static void gst_tensor_filter_finalize (GObject * object);
+static gboolean gst_tensor_filter_reload_start (GstTensorFilter * self,
+    const gchar * model_files);
+static void gst_tensor_filter_reload_stop (GstTensorFilter * self);
+static void gst_tensor_filter_async_stop (GstTensorFilter * self);
 
 /* GstBaseTransform vmethod implementations */
 static GstFlowReturn gst_tensor_filter_transform (GstBaseTransform * trans,
     GstBuffer * inbuf, GstBuffer * outbuf);
+static GstFlowReturn gst_tensor_filter_transform_ip (GstBaseTransform * trans,
+    GstBuffer * buf);
 static GstCaps *gst_tensor_filter_transform_caps (GstBaseTransform * trans,
     GstPadDirection direction, GstCaps * caps, GstCaps * filter);
 static GstCaps *gst_tensor_filter_fixate_caps (GstBaseTransform * trans,
@@ -130,6 +207,8 @@ static gboolean gst_tensor_filter_sink_event (GstBaseTransform * trans,
     GstEvent * event);
 static gboolean gst_tensor_filter_src_event (GstBaseTransform * trans,
     GstEvent * event);
+static gboolean gst_tensor_filter_query (GstBaseTransform * trans,
+    GstPadDirection direction, GstQuery * query);
 
 /**
  * @brief initialize the tensor_filter's class
@@ -154,6 +233,39 @@ gst_tensor_filter_class_init (GstTensorFilterClass * klass)
 
   gst_tensor_filter_install_properties (gobject_class);
 
+  g_object_class_install_property (gobject_class, PROP_STATS,
+      g_param_spec_boxed ("stats", "Statistics",
+          "Latency statistics of the inferences, with the fields "
+          "count, p50, p95, p99 and max (latency in microseconds)",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_STATS_INTERVAL,
+      g_param_spec_uint ("stats-interval", "Statistics interval",
+          "Interval (ms) to post an element message with the latency "
+          "statistics (0: disabled)", 0, G_MAXUINT, 0,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_RELOAD_ASYNC,
+      g_param_spec_boolean ("reload-async", "Reload model asynchronously",
+          "Load and warm up the new model in background thread when the model "
+          "property is changed while streaming, and swap the model between "
+          "invokes. The result is posted as an element message "
+          "(" GST_TENSOR_FILTER_RELOAD_MSG_NAME ").",
+          DEFAULT_RELOAD_ASYNC, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_WARMUP_DATA,
+      g_param_spec_string ("warmup-data", "Warmup data",
+          "File path of the raw input tensors to warm up the new model "
+          "with reload-async (zero-filled tensors if not given)", "",
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_MAX_INFLIGHT,
+      g_param_spec_uint ("max-inflight", "Max in-flight inputs",
+          "Max number of inputs submitted at once if the sub-plugin supports "
+          "asynchronous invoke. The outputs are pushed in the order of the "
+          "inputs (0: invoke synchronously)", 0, G_MAXUINT,
+          DEFAULT_MAX_INFLIGHT, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_set_details_simple (gstelement_class,
       "TensorFilter",
       "Filter/Tensor",
@@ -170,6 +282,8 @@ gst_tensor_filter_class_init (GstTensorFilterClass * klass)
 
   /* Processing units */
   trans_class->transform = GST_DEBUG_FUNCPTR (gst_tensor_filter_transform);
+  trans_class->transform_ip =
+      GST_DEBUG_FUNCPTR (gst_tensor_filter_transform_ip);
 
   /* Negotiation units */
   trans_class->transform_caps =
@@ -185,6 +299,9 @@ gst_tensor_filter_class_init (GstTensorFilterClass * klass)
   trans_class->sink_event = GST_DEBUG_FUNCPTR (gst_tensor_filter_sink_event);
   trans_class->src_event = GST_DEBUG_FUNCPTR (gst_tensor_filter_src_event);
 
+  /* setup queries */
+  trans_class->query = GST_DEBUG_FUNCPTR (gst_tensor_filter_query);
+
   /* start/stop to call open/close */
   trans_class->start = GST_DEBUG_FUNCPTR (gst_tensor_filter_start);
   trans_class->stop = GST_DEBUG_FUNCPTR (gst_tensor_filter_stop);
@@ -206,6 +323,28 @@ gst_tensor_filter_init (GstTensorFilter * self)
   self->prev_ts = GST_CLOCK_TIME_NONE;
   self->throttling_delay = 0;
   self->throttling_accum = 0;
+  self->latest_pts = GST_CLOCK_TIME_NONE;
+
+  /* init model reload */
+  self->reload_async = DEFAULT_RELOAD_ASYNC;
+  self->warmup_data = NULL;
+  self->reload_thread = NULL;
+  g_mutex_init (&self->reload_lock);
+  g_cond_init (&self->reload_cond);
+  self->reload_busy = FALSE;
+  self->reload_cancel = FALSE;
+  self->reload_pending = NULL;
+  self->reload_next = NULL;
+
+  /* init asynchronous invoke */
+  self->max_inflight = DEFAULT_MAX_INFLIGHT;
+  self->async_thread = NULL;
+  g_mutex_init (&self->async_lock);
+  g_cond_init (&self->async_cond);
+  g_queue_init (&self->async_queue);
+  self->async_stop = FALSE;
+  self->async_flushing = FALSE;
+  self->async_flow = GST_FLOW_OK;
 }
 
 /**
@@ -220,6 +359,15 @@ gst_tensor_filter_finalize (GObject * object)
   self = GST_TENSOR_FILTER (object);
   priv = &self->priv;
 
+  gst_tensor_filter_reload_stop (self);
+  g_mutex_clear (&self->reload_lock);
+  g_cond_clear (&self->reload_cond);
+  g_free (self->warmup_data);
+
+  gst_tensor_filter_async_stop (self);
+  g_mutex_clear (&self->async_lock);
+  g_cond_clear (&self->async_cond);
+
   gst_tensor_filter_common_close_fw (priv);
   gst_tensor_filter_common_free_property (priv);
 
@@ -271,8 +419,33 @@ gst_tensor_filter_set_property (GObject * object, guint prop_id,
 
   silent_debug (self, "Setting property for prop %d.\n", prop_id);
 
-  if (!gst_tensor_filter_common_set_property (priv, prop_id, value, pspec))
-    G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+  switch (prop_id) {
+    case PROP_STATS_INTERVAL:
+      gst_tensor_latency_stats_set_interval (&priv->stat.latency_stats,
+          g_value_get_uint (value));
+      break;
+    case PROP_RELOAD_ASYNC:
+      self->reload_async = g_value_get_boolean (value);
+      break;
+    case PROP_MAX_INFLIGHT:
+      self->max_inflight = g_value_get_uint (value);
+      break;
+    case PROP_WARMUP_DATA:
+      g_free (self->warmup_data);
+      self->warmup_data = g_value_dup_string (value);
+      if (self->warmup_data && self->warmup_data[0] == '\0')
+        g_clear_pointer (&self->warmup_data, g_free);
+      break;
+    default:
+      /* load the new model in background thread, or reload it synchronously */
+      if (self->reload_async && g_str_equal (pspec->name, "model") &&
+          gst_tensor_filter_reload_start (self, g_value_get_string (value)))
+        break;
+
+      if (!gst_tensor_filter_common_set_property (priv, prop_id, value, pspec))
+        G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
 }
 
 /**
@@ -290,8 +463,32 @@ gst_tensor_filter_get_property (GObject * object, guint prop_id,
 
   silent_debug (self, "Getting property for prop %d.\n", prop_id);
 
-  if (!gst_tensor_filter_common_get_property (priv, prop_id, value, pspec))
-    G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+  switch (prop_id) {
+    case PROP_STATS:
+      g_value_take_boxed (value,
+          gst_tensor_latency_stats_to_structure (&priv->stat.latency_stats));
+      break;
+    case PROP_STATS_INTERVAL:
+      g_value_set_uint (value,
+          gst_tensor_latency_stats_get_interval (&priv->stat.latency_stats));
+      break;
+    case PROP_RELOAD_ASYNC:
+      g_value_set_boolean (value, self->reload_async);
+      break;
+    case PROP_MAX_INFLIGHT:
+      g_value_set_uint (value, self->max_inflight);
+      break;
+    case PROP_WARMUP_DATA:
+      g_value_set_string (value, self->warmup_data ? self->warmup_data : "");
+      break;
+    default:
+      /* the model files may be swapped and freed by background model reload */
+      g_mutex_lock (&self->reload_lock);
+      if (!gst_tensor_filter_common_get_property (priv, prop_id, value, pspec))
+        G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      g_mutex_unlock (&self->reload_lock);
+      break;
+  }
 }
 
 /**
@@ -334,50 +531,40 @@ gst_tensor_filter_get_wrapped_mem (GstTensorFilter * self, gpointer data,
 static void
 prepare_statistics (GstTensorFilterPrivate * priv)
 {
-  priv->stat.latest_invoke_time = g_get_real_time ();
-}
-
-/**
- * @brief Helper function to accumulate latencies
- */
-static void
-accumulate_latency (void *data, void *user_data)
-{
-  gint64 *latency = data;
-  gint64 *total_latency = user_data;
-
-  *total_latency += *latency;
+  priv->stat.latest_invoke_time = g_get_monotonic_time ();
 }
 
 #define THRESHOLD_DROP_OLD  (2000)
 #define THRESHOLD_CACHE_OLD (1000)
 
 /**
- * @brief Record statistics for performance profiling (e.g, latency, throughput)
+ * @brief Record statistics for performance profiling (e.g, latency, throughput) with the given invoke latency
  */
 static void
-record_statistics (GstTensorFilterPrivate * priv)
+record_statistics_latency (GstTensorFilterPrivate * priv, gint64 latency)
 {
-  gint64 end_time = g_get_real_time ();
-  gint64 *latency = g_new (gint64, 1);
-  GQueue *recent_latencies = priv->stat.recent_latencies;
+  GstTensorFilterStatistics *stat = &priv->stat;
 
-  *latency = end_time - priv->stat.latest_invoke_time;
-  priv->stat.total_invoke_latency += *latency;
-  priv->stat.total_invoke_num += 1;
+  gst_tensor_latency_stats_record (&stat->latency_stats, latency);
 
-  if (g_queue_get_length (recent_latencies) == GST_TF_STAT_MAX_RECENT)
-    g_free (g_queue_pop_head (recent_latencies));
-  g_queue_push_tail (recent_latencies, latency);
+  if (priv->latency_mode == 0 && priv->throughput_mode == 0)
+    return;
 
-  /* the queue should have at least one element */
-  g_assert (g_queue_get_length (recent_latencies) != 0);
+  stat->total_invoke_latency += latency;
+  stat->total_invoke_num += 1;
 
-  if (priv->latency_mode > 0) {
-    gint64 avg_latency = 0;
+  /* replace the oldest latency in the ring buffer */
+  if (stat->recent_num == GST_TF_STAT_MAX_RECENT)
+    stat->recent_total_latency -= stat->recent_latencies[stat->recent_index];
+  else
+    stat->recent_num++;
 
-    g_queue_foreach (recent_latencies, accumulate_latency, &avg_latency);
-    avg_latency /= g_queue_get_length (recent_latencies);
+  stat->recent_latencies[stat->recent_index] = latency;
+  stat->recent_total_latency += latency;
+  stat->recent_index = (stat->recent_index + 1) % GST_TF_STAT_MAX_RECENT;
+
+  if (priv->latency_mode > 0) {
+    gint64 avg_latency = stat->recent_total_latency / stat->recent_num;
 
     /* check integer overflow */
     if (avg_latency <= INT32_MAX)
@@ -386,7 +573,7 @@ record_statistics (GstTensorFilterPrivate * priv)
       priv->prop.latency = -1;
 
     ml_logi ("[%s] Invoke took %.3f ms", TF_MODELNAME (&(priv->prop)),
-        (*latency) / 1000.0);
+        latency / 1000.0);
   }
 
   if (priv->throughput_mode > 0) {
@@ -429,6 +616,404 @@ record_statistics (GstTensorFilterPrivate * priv)
   }
 }
 
+/**
+ * @brief Record statistics for performance profiling (e.g, latency, throughput)
+ */
+static void
+record_statistics (GstTensorFilterPrivate * priv)
+{
+  record_statistics_latency (priv,
+      g_get_monotonic_time () - priv->stat.latest_invoke_time);
+}
+
+/**
+ * @brief Post an element message for the result of background model reload.
+ */
+static void
+gst_tensor_filter_reload_post (GstTensorFilter * self,
+    const gchar ** model_files, gint64 load_time, gboolean success)
+{
+  GstStructure *structure;
+  gchar *model;
+
+  model = g_strjoinv (",", (gchar **) model_files);
+  structure = gst_structure_new (GST_TENSOR_FILTER_RELOAD_MSG_NAME,
+      "model", G_TYPE_STRING, model,
+      "success", G_TYPE_BOOLEAN, success,
+      "load-time", G_TYPE_UINT64, (guint64) load_time, NULL);
+  g_free (model);
+
+  gst_element_post_message (GST_ELEMENT_CAST (self),
+      gst_message_new_element (GST_OBJECT_CAST (self), structure));
+}
+
+/**
+ * @brief Close the model and free the reload data.
+ */
+static void
+gst_tensor_filter_reload_free (GstTensorFilterReload * reload)
+{
+  if (reload->opened && reload->fw->close)
+    reload->fw->close (&reload->prop, &reload->privateData);
+
+  g_strfreev_const (reload->prop.model_files);
+  g_free (reload->warmup_data);
+  g_free (reload);
+}
+
+/**
+ * @brief Open the new model and check its tensor info, which should be same as the negotiated info.
+ */
+static gboolean
+gst_tensor_filter_reload_open (GstTensorFilterReload * reload)
+{
+  GstTensorFilterPrivate *priv = &reload->filter->priv;
+  const GstTensorFilterFramework *fw = reload->fw;
+  GstTensorsInfo in_info, out_info;
+  gboolean ret = FALSE;
+  int status = -1;
+
+  if (fw->open && fw->open (&reload->prop, &reload->privateData) < 0) {
+    ml_loge ("Failed to open the new model %s to reload.",
+        TF_MODELNAME (&reload->prop));
+    return FALSE;
+  }
+
+  reload->opened = TRUE;
+
+  if (GST_TF_FW_V1 (fw) &&
+      fw->getFrameworkInfo (fw, &reload->prop, reload->privateData,
+          &reload->info) != 0) {
+    ml_loge ("Failed to get the framework info of the new model %s.",
+        TF_MODELNAME (&reload->prop));
+    return FALSE;
+  }
+
+  gst_tensors_info_init (&in_info);
+  gst_tensors_info_init (&out_info);
+
+  if (GST_TF_FW_V0 (fw)) {
+    if (fw->getInputDimension && fw->getOutputDimension) {
+      status = fw->getInputDimension (&reload->prop, &reload->privateData,
+          &in_info);
+      if (status == 0)
+        status = fw->getOutputDimension (&reload->prop, &reload->privateData,
+            &out_info);
+    } else if (fw->setInputDimension) {
+      gst_tensors_info_copy (&in_info, &priv->prop.input_meta);
+      status = fw->setInputDimension (&reload->prop, &reload->privateData,
+          &in_info, &out_info);
+    }
+  } else if (GST_TF_FW_V1 (fw)) {
+    status = fw->getModelInfo (fw, &reload->prop, reload->privateData,
+        GET_IN_OUT_INFO, &in_info, &out_info);
+    if (status == -ENOENT) {
+      gst_tensors_info_free (&in_info);
+      gst_tensors_info_copy (&in_info, &priv->prop.input_meta);
+      status = fw->getModelInfo (fw, &reload->prop, reload->privateData,
+          SET_INPUT_INFO, &in_info, &out_info);
+    }
+  }
+
+  /* the pad caps cannot be changed while streaming */
+  if (status != 0) {
+    ml_loge ("Failed to get the tensor info of the new model %s.",
+        TF_MODELNAME (&reload->prop));
+  } else if (!gst_tensors_info_is_equal (&in_info, &priv->prop.input_meta) ||
+      !gst_tensors_info_is_equal (&out_info, &priv->prop.output_meta)) {
+    ml_loge ("The tensor info of the new model %s is different from the "
+        "negotiated info. Cannot swap the model while streaming.",
+        TF_MODELNAME (&reload->prop));
+  } else {
+    ret = TRUE;
+  }
+
+  gst_tensors_info_free (&in_info);
+  gst_tensors_info_free (&out_info);
+  return ret;
+}
+
+/**
+ * @brief Invoke the new model once, to warm up the model before swapping.
+ * @details The input tensors are filled with the data in warmup_data file, or zero if the file is not given.
+ */
+static gboolean
+gst_tensor_filter_reload_warmup (GstTensorFilterReload * reload)
+{
+  GstTensorFilterProperties *prop = &reload->prop;
+  const GstTensorFilterFramework *fw = reload->fw;
+  GstTensorMemory input[NNS_TENSOR_SIZE_LIMIT];
+  GstTensorMemory output[NNS_TENSOR_SIZE_LIMIT];
+  gchar *contents = NULL;
+  gsize length = 0, offset = 0;
+  gboolean ret = FALSE;
+  guint i;
+  int status = -1;
+
+  memset (input, 0, sizeof (input));
+  memset (output, 0, sizeof (output));
+
+  for (i = 0; i < prop->input_meta.num_tensors; i++)
+    input[i].size = gst_tensor_info_get_size (&prop->input_meta.info[i]);
+  for (i = 0; i < prop->output_meta.num_tensors; i++)
+    output[i].size = gst_tensor_info_get_size (&prop->output_meta.info[i]);
+
+  if (reload->warmup_data) {
+    if (!g_file_get_contents (reload->warmup_data, &contents, &length, NULL)) {
+      ml_loge ("Failed to read the warmup data %s.", reload->warmup_data);
+      return FALSE;
+    }
+
+    if (length != gst_tensors_info_get_size (&prop->input_meta, -1)) {
+      ml_loge ("The size of warmup data %s (%zu) is different from the size "
+          "of input tensors (%zu).", reload->warmup_data, length,
+          gst_tensors_info_get_size (&prop->input_meta, -1));
+      goto done;
+    }
+  }
+
+  for (i = 0; i < prop->input_meta.num_tensors; i++) {
+    input[i].data = g_malloc0 (input[i].size);
+    if (contents)
+      memcpy (input[i].data, contents + offset, input[i].size);
+    offset += input[i].size;
+  }
+
+  for (i = 0; i < prop->output_meta.num_tensors; i++)
+    output[i].data = g_malloc0 (output[i].size);
+
+  if (GST_TF_FW_V0 (fw))
+    status = fw->invoke_NN (prop, &reload->privateData, input, output);
+  else if (GST_TF_FW_V1 (fw))
+    status = fw->invoke (fw, prop, reload->privateData, input, output);
+
+  if (status < 0) {
+    ml_loge ("Failed to warm up the new model %s (error code %d).",
+        TF_MODELNAME (prop), status);
+  } else {
+    ret = TRUE;
+  }
+
+done:
+  for (i = 0; i < NNS_TENSOR_SIZE_LIMIT; i++) {
+    g_free (input[i].data);
+    g_free (output[i].data);
+  }
+  g_free (contents);
+  return ret;
+}
+
+/**
+ * @brief Load and warm up the new model, and wait until it is swapped.
+ * @details The loaded model is swapped in the streaming thread (see gst_tensor_filter_reload_swap), then this closes the old model.
+ */
+static void
+gst_tensor_filter_reload_run (GstTensorFilterReload * reload)
+{
+  GstTensorFilter *self = reload->filter;
+  gint64 start_time = g_get_monotonic_time ();
+
+  if (!gst_tensor_filter_reload_open (reload) ||
+      !gst_tensor_filter_reload_warmup (reload)) {
+    reload->load_time = g_get_monotonic_time () - start_time;
+    gst_tensor_filter_reload_post (self, reload->prop.model_files,
+        reload->load_time, FALSE);
+    goto done;
+  }
+
+  reload->load_time = g_get_monotonic_time () - start_time;
+  ml_logi ("The new model %s is loaded in background. It took %"
+      G_GINT64_FORMAT " us", TF_MODELNAME (&reload->prop), reload->load_time);
+
+  /* wait for the swap, the reload data has the old model after swapping. */
+  g_mutex_lock (&self->reload_lock);
+  g_atomic_pointer_set (&self->reload_pending, reload);
+  while (self->reload_pending == reload && !self->reload_cancel)
+    g_cond_wait (&self->reload_cond, &self->reload_lock);
+  g_atomic_pointer_set (&self->reload_pending, NULL);
+  g_mutex_unlock (&self->reload_lock);
+
+done:
+  gst_tensor_filter_reload_free (reload);
+}
+
+/**
+ * @brief Thread to load the new model, and then the latest model requested while loading.
+ */
+static gpointer
+gst_tensor_filter_reload_thread (gpointer data)
+{
+  GstTensorFilterReload *reload = (GstTensorFilterReload *) data;
+  GstTensorFilter *self = reload->filter;
+
+  while (reload) {
+    gst_tensor_filter_reload_run (reload);
+
+    g_mutex_lock (&self->reload_lock);
+    reload = self->reload_next;
+    self->reload_next = NULL;
+
+    if (reload && self->reload_cancel) {
+      gst_tensor_filter_reload_free (reload);
+      reload = NULL;
+    }
+
+    if (!reload)
+      self->reload_busy = FALSE;
+    g_mutex_unlock (&self->reload_lock);
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Start to load the new model in background thread.
+ * @return TRUE if the model property is handled, FALSE to reload the model synchronously.
+ */
+static gboolean
+gst_tensor_filter_reload_start (GstTensorFilter * self,
+    const gchar * model_files)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterProperties *prop = &priv->prop;
+  GstTensorFilterReload *reload;
+  GError *error = NULL;
+
+  if (!model_files || !priv->fw || !prop->fw_opened || !priv->configured)
+    return FALSE;
+
+  /**
+   * The model instance is shared with other filters, or the output memory
+   * blocks refer to the model instance. Reload the model synchronously.
+   */
+  if (prop->shared_tensor_filter_key ||
+      gst_tensor_filter_allocate_in_invoke (priv))
+    return FALSE;
+
+  reload = g_new0 (GstTensorFilterReload, 1);
+  reload->filter = self;
+  reload->fw = priv->fw;
+  memcpy (&reload->prop, prop, sizeof (GstTensorFilterProperties));
+  reload->prop.model_files =
+      (const gchar **) g_strsplit_set (model_files, ",", -1);
+  reload->prop.num_models = g_strv_length ((gchar **) reload->prop.model_files);
+  reload->info = priv->info;
+  reload->warmup_data = g_strdup (self->warmup_data);
+
+  g_mutex_lock (&self->reload_lock);
+  if (self->reload_busy) {
+    /* load the latest model when the running reload is done */
+    if (self->reload_next) {
+      ml_logw ("The model %s is replaced by the new model %s before loading.",
+          TF_MODELNAME (&self->reload_next->prop), model_files);
+      gst_tensor_filter_reload_free (self->reload_next);
+    }
+
+    self->reload_next = reload;
+    reload = NULL;
+  } else {
+    self->reload_busy = TRUE;
+  }
+  g_mutex_unlock (&self->reload_lock);
+
+  if (!reload)
+    return TRUE;
+
+  /* the previous thread is already done */
+  if (self->reload_thread) {
+    g_thread_join (self->reload_thread);
+    self->reload_thread = NULL;
+  }
+
+  self->reload_thread = g_thread_try_new ("tensor_filter_reload",
+      gst_tensor_filter_reload_thread, reload, &error);
+  if (!self->reload_thread) {
+    ml_loge ("Failed to create the thread to reload the model: %s",
+        error ? error->message : "unknown error");
+    g_clear_error (&error);
+    gst_tensor_filter_reload_free (reload);
+
+    g_mutex_lock (&self->reload_lock);
+    if (self->reload_next) {
+      gst_tensor_filter_reload_free (self->reload_next);
+      self->reload_next = NULL;
+    }
+    self->reload_busy = FALSE;
+    g_mutex_unlock (&self->reload_lock);
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Swap the model if the new model is loaded in background. Called in the streaming thread before invoke.
+ */
+static void
+gst_tensor_filter_reload_swap (GstTensorFilter * self)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterReload *reload;
+  const gchar **model_files;
+  gint num_models;
+  gint64 load_time = 0;
+  void *data;
+
+  /* fast path, no model to be swapped */
+  if (G_LIKELY (g_atomic_pointer_get (&self->reload_pending) == NULL))
+    return;
+
+  g_mutex_lock (&self->reload_lock);
+  reload = self->reload_pending;
+  if (reload) {
+    GstTensorFilterFrameworkInfo info = priv->info;
+
+    data = priv->privateData;
+    priv->privateData = reload->privateData;
+    reload->privateData = data;
+
+    model_files = priv->prop.model_files;
+    num_models = priv->prop.num_models;
+    priv->prop.model_files = reload->prop.model_files;
+    priv->prop.num_models = reload->prop.num_models;
+    reload->prop.model_files = model_files;
+    reload->prop.num_models = num_models;
+
+    if (GST_TF_FW_V1 (priv->fw)) {
+      priv->info = reload->info;
+      reload->info = info;
+    }
+
+    load_time = reload->load_time;
+    g_atomic_pointer_set (&self->reload_pending, NULL);
+    g_cond_signal (&self->reload_cond);
+  }
+  g_mutex_unlock (&self->reload_lock);
+
+  if (reload) {
+    gst_tensor_filter_reload_post (self, priv->prop.model_files, load_time,
+        TRUE);
+  }
+}
+
+/**
+ * @brief Cancel the background model reload and wait for the thread.
+ */
+static void
+gst_tensor_filter_reload_stop (GstTensorFilter * self)
+{
+  if (!self->reload_thread)
+    return;
+
+  g_mutex_lock (&self->reload_lock);
+  self->reload_cancel = TRUE;
+  g_cond_broadcast (&self->reload_cond);
+  g_mutex_unlock (&self->reload_lock);
+
+  g_thread_join (self->reload_thread);
+  self->reload_thread = NULL;
+  self->reload_cancel = FALSE;
+}
+
 /**
  * @brief Check throttling delay and send qos overflow event to upstream elements
  */
@@ -550,7 +1135,7 @@ _gst_tensor_filter_transform_validate (GstBaseTransform * trans,
             prop->fwname, TF_MODELNAME (prop)));
     return GST_FLOW_ERROR;
   }
-  if (gst_buffer_get_size (outbuf) != 0) {
+  if (outbuf != inbuf && gst_buffer_get_size (outbuf) != 0) {
     GST_ELEMENT_ERROR_BTRACE (self, STREAM, FAILED,
         ("The output buffer for the isntance of tensor-filter subplugin (%s / %s) already has a content (buffer size = %zu). It should be 0.",
             prop->fwname, TF_MODELNAME (prop), gst_buffer_get_size (outbuf)));
@@ -561,53 +1146,62 @@ _gst_tensor_filter_transform_validate (GstBaseTransform * trans,
 }
 
 /**
- * @brief non-ip transform. required vmethod of GstBaseTransform.
+ * @brief Unmap the input buffer and release the output memory when failed to prepare the invoke.
+ */
+static void
+gst_tensor_filter_invoke_clear (GstTensorFilter * self,
+    GstTensorFilterInvokeData * data)
+{
+  GstTensorFilterProperties *prop = &self->priv.prop;
+  guint i;
+
+  for (i = 0; i < data->num_mems; i++) {
+    if (data->in_mem[i])
+      gst_memory_unmap (data->in_mem[i], &data->in_info[i]);
+  }
+
+  if (!data->allocate_in_invoke) {
+    for (i = 0; i < prop->output_meta.num_tensors; i++) {
+      if (data->out_mem[i]) {
+        gst_memory_unmap (data->out_mem[i], &data->out_info[i]);
+        gst_allocator_free (data->out_mem[i]->allocator, data->out_mem[i]);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Map the input buffer and prepare the output tensors to invoke the sub-plugin.
  */
 static GstFlowReturn
-gst_tensor_filter_transform (GstBaseTransform * trans,
-    GstBuffer * inbuf, GstBuffer * outbuf)
+gst_tensor_filter_invoke_prepare (GstTensorFilter * self,
+    GstTensorFilterInvokeData * data)
 {
-  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (trans);
+  GstBaseTransform *trans = GST_BASE_TRANSFORM_CAST (self);
   GstTensorFilterPrivate *priv = &self->priv;
   GstTensorFilterProperties *prop = &priv->prop;
-  GstMemory *in_mem[NNS_TENSOR_SIZE_LIMIT] = { 0, };
-  GstMapInfo in_info[NNS_TENSOR_SIZE_LIMIT];
-  GstMemory *out_mem[NNS_TENSOR_SIZE_LIMIT] = { 0, };
-  GstMapInfo out_info[NNS_TENSOR_SIZE_LIMIT];
-  GstTensorMemory in_tensors[NNS_TENSOR_SIZE_LIMIT];
-  GstTensorMemory invoke_tensors[NNS_TENSOR_SIZE_LIMIT];
-  GstTensorMemory out_tensors[NNS_TENSOR_SIZE_LIMIT];
+  GstBuffer *inbuf = data->inbuf;
   GList *list;
   guint i, num_mems;
-  gint ret;
-  gboolean allocate_in_invoke, in_flexible, out_flexible;
-  gboolean need_profiling;
   gsize expected, hsize;
 
-  GstTensorMetaInfo in_meta[NNS_TENSOR_SIZE_LIMIT];
-  GstTensorMetaInfo out_meta[NNS_TENSOR_SIZE_LIMIT];
-  GstMemory *mem;
+  memset (data->in_mem, 0, sizeof (data->in_mem));
+  memset (data->out_mem, 0, sizeof (data->out_mem));
 
-  /* 0. Check all properties. */
-  GstFlowReturn retval = _gst_tensor_filter_transform_validate (trans, inbuf,
-      outbuf);
-  if (retval != GST_FLOW_OK)
-    return retval;
-
-  allocate_in_invoke = gst_tensor_filter_allocate_in_invoke (priv);
+  data->allocate_in_invoke = gst_tensor_filter_allocate_in_invoke (priv);
 
-  in_flexible =
+  data->in_flexible =
       gst_tensor_pad_caps_is_flexible (GST_BASE_TRANSFORM_SINK_PAD (trans));
-  out_flexible =
+  data->out_flexible =
       gst_tensor_pad_caps_is_flexible (GST_BASE_TRANSFORM_SRC_PAD (trans));
 
   /* 1. Get all input tensors from inbuf. */
   /* Internal Logic Error or GST Bug (sinkcap changed!) */
-  num_mems = gst_buffer_n_memory (inbuf);
+  num_mems = data->num_mems = gst_buffer_n_memory (inbuf);
 
   for (i = 0; i < num_mems; i++) {
-    in_mem[i] = gst_buffer_peek_memory (inbuf, i);
-    if (!gst_memory_map (in_mem[i], &in_info[i], GST_MAP_READ)) {
+    data->in_mem[i] = gst_buffer_peek_memory (inbuf, i);
+    if (!gst_memory_map (data->in_mem[i], &data->in_info[i], GST_MAP_READ)) {
       ml_logf_stacktrace
           ("gst_tensor_filter_transform: For the given input buffer, tensor-filter (%s : %s) cannot map input memory from the buffer for reading. The %u-th memory chunk (%u-th tensor) has failed for memory map.\n",
           prop->fwname, TF_MODELNAME (prop), i, i);
@@ -615,13 +1209,14 @@ gst_tensor_filter_transform (GstBaseTransform * trans,
     }
 
     hsize = 0;
-    if (in_flexible) {
-      gst_tensor_meta_info_parse_header (&in_meta[i], in_info[i].data);
-      hsize = gst_tensor_meta_info_get_header_size (&in_meta[i]);
+    if (data->in_flexible) {
+      gst_tensor_meta_info_parse_header (&data->in_meta[i],
+          data->in_info[i].data);
+      hsize = gst_tensor_meta_info_get_header_size (&data->in_meta[i]);
     }
 
-    in_tensors[i].data = in_info[i].data + hsize;
-    in_tensors[i].size = in_info[i].size - hsize;
+    data->in_tensors[i].data = data->in_info[i].data + hsize;
+    data->in_tensors[i].size = data->in_info[i].size - hsize;
   }
 
   /* 1.1 Prepare tensors to invoke. */
@@ -639,14 +1234,14 @@ gst_tensor_filter_transform (GstBaseTransform * trans,
       }
 
       expected = gst_tensor_filter_get_tensor_size (self, info_idx, TRUE);
-      if (expected != in_tensors[i].size) {
+      if (expected != data->in_tensors[i].size) {
         ml_loge_stacktrace
             ("gst_tensor_filter_transform: With the given input combination ('input-combination' property) of the tensor-filter, the incoming buffer size of combination index %u (%u'th combination) is %zd, which is invalid and is expected to be %zd. Because of buffer size inconsistency, it cannot continue (cannot map the memory for the input buffer).\n",
-            i, info_idx, in_tensors[i].size, expected);
+            i, info_idx, data->in_tensors[i].size, expected);
         goto mem_map_error;
       }
 
-      invoke_tensors[info_idx++] = in_tensors[i];
+      data->invoke_tensors[info_idx++] = data->in_tensors[i];
     }
   } else {
     if (num_mems != prop->input_meta.num_tensors) {
@@ -658,52 +1253,59 @@ gst_tensor_filter_transform (GstBaseTransform * trans,
 
     for (i = 0; i < prop->input_meta.num_tensors; i++) {
       expected = gst_tensor_filter_get_tensor_size (self, i, TRUE);
-      if (expected != in_tensors[i].size) {
+      if (expected != data->in_tensors[i].size) {
         ml_loge_stacktrace
             ("gst_tensor_filter_transform: Input buffer size (%u'th memory chunk: %zd) is invalid, which is expected to be %zd, which is the frame size of the corresponding tensor. Maybe, the pad capability is not consistent with the actual input stream; if the size is supposed to change dynamically and the given neural network, framework, and the subpluigins can handle it, please consider using format=flexible.\n",
-            i, in_tensors[i].size, expected);
+            i, data->in_tensors[i].size, expected);
         goto mem_map_error;
       }
 
-      invoke_tensors[i] = in_tensors[i];
+      data->invoke_tensors[i] = data->in_tensors[i];
     }
   }
 
   /* 2. Prepare output tensors. */
   for (i = 0; i < prop->output_meta.num_tensors; i++) {
-    out_tensors[i].data = NULL;
-    out_tensors[i].size = gst_tensor_filter_get_tensor_size (self, i, FALSE);
+    data->out_tensors[i].data = NULL;
+    data->out_tensors[i].size =
+        gst_tensor_filter_get_tensor_size (self, i, FALSE);
+
+    gst_tensor_info_convert_to_meta (&prop->output_meta.info[i],
+        &data->out_meta[i]);
 
     hsize = 0;
-    if (out_flexible) {
-      gst_tensor_info_convert_to_meta (&prop->output_meta.info[i],
-          &out_meta[i]);
-      hsize = gst_tensor_meta_info_get_header_size (&out_meta[i]);
-    }
+    if (data->out_flexible)
+      hsize = gst_tensor_meta_info_get_header_size (&data->out_meta[i]);
 
     /* allocate memory if allocate_in_invoke is FALSE */
-    if (!allocate_in_invoke) {
-      out_mem[i] =
-          gst_allocator_alloc (NULL, out_tensors[i].size + hsize, NULL);
-      if (!out_mem[i]) {
+    if (!data->allocate_in_invoke) {
+      /* static tensor may be converted to flexible in the pipeline, write the header into the headroom. */
+      if (data->out_flexible)
+        data->out_mem[i] = gst_allocator_alloc (NULL,
+            data->out_tensors[i].size + hsize, NULL);
+      else
+        data->out_mem[i] = gst_tensor_alloc_with_headroom (&data->out_meta[i],
+            data->out_tensors[i].size);
+      if (!data->out_mem[i]) {
         ml_loge_stacktrace
             ("gst_tensor_filter_transform: cannot allocate memory for the output buffer (%u'th memory chunk for %u'th tensor), which requires %zd bytes. gst_allocate_alloc has returned Null. Out of memory?",
-            i, i, out_tensors[i].size + hsize);
+            i, i, data->out_tensors[i].size + hsize);
         goto mem_map_error;
       }
-      if (!gst_memory_map (out_mem[i], &out_info[i], GST_MAP_WRITE)) {
+      if (!gst_memory_map (data->out_mem[i], &data->out_info[i],
+              GST_MAP_WRITE)) {
         ml_loge_stacktrace
             ("gst_tensor_filter_transform: For the given output buffer, allocated by gst_tensor_filter_transform, it cannot map output memory buffer for the %u'th memory chunk (%u'th output tensor) for write.\n",
             i, i);
         goto mem_map_error;
       }
 
-      out_tensors[i].data = out_info[i].data + hsize;
+      data->out_tensors[i].data = data->out_info[i].data + hsize;
 
       /* append header */
-      if (out_flexible) {
+      if (data->out_flexible) {
         if (FALSE == gst_tensor_meta_info_update_header
-            (&out_meta[i], out_info[i].data)) {
+            (&data->out_meta[i], data->out_info[i].data)) {
           ml_loge_stacktrace
               ("gst_tensor_meta_info_update_header() has failed to update header for flexible format: invalid metadata or buffer for header is not available. This looks like an internal error of nnstreamer/tensor_filter. Please report to github.com/nnstreamer/nnstreamer/issues. %u'th output buffer has failed to update its header.\n",
               i);
@@ -713,24 +1315,37 @@ gst_tensor_filter_transform (GstBaseTransform * trans,
     }
   }
 
-  need_profiling = (priv->latency_mode > 0 || priv->throughput_mode > 0);
-  if (need_profiling)
-    prepare_statistics (priv);
+  return GST_FLOW_OK;
 
-  /* 3. Call the filter-subplugin callback, "invoke" */
-  GST_TF_FW_INVOKE_COMPAT (priv, ret, invoke_tensors, out_tensors);
-  if (need_profiling)
-    record_statistics (priv);
+mem_map_error:
+  data->num_mems = gst_buffer_n_memory (inbuf);
+  gst_tensor_filter_invoke_clear (self, data);
+  return GST_FLOW_ERROR;
+}
+
+/**
+ * @brief Unmap the buffers and append the output tensors to the output buffer after invoking the sub-plugin.
+ */
+static GstFlowReturn
+gst_tensor_filter_invoke_finish (GstTensorFilter * self,
+    GstTensorFilterInvokeData * data, gint ret, GstBuffer * outbuf)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterProperties *prop = &priv->prop;
+  GstMemory *mem;
+  GList *list;
+  guint i;
+  gsize hsize;
 
   /* 4. Free map info and handle error case */
-  for (i = 0; i < num_mems; i++)
-    gst_memory_unmap (in_mem[i], &in_info[i]);
+  for (i = 0; i < data->num_mems; i++)
+    gst_memory_unmap (data->in_mem[i], &data->in_info[i]);
 
-  if (!allocate_in_invoke) {
+  if (!data->allocate_in_invoke) {
     for (i = 0; i < prop->output_meta.num_tensors; i++) {
-      gst_memory_unmap (out_mem[i], &out_info[i]);
+      gst_memory_unmap (data->out_mem[i], &data->out_info[i]);
       if (ret != 0)
-        gst_allocator_free (out_mem[i]->allocator, out_mem[i]);
+        gst_allocator_free (data->out_mem[i]->allocator, data->out_mem[i]);
     }
   }
 
@@ -751,17 +1366,18 @@ gst_tensor_filter_transform (GstBaseTransform * trans,
     for (list = priv->combi.out_combi_i; list != NULL; list = list->next) {
       i = GPOINTER_TO_UINT (list->data);
 
-      if (!in_flexible && out_flexible) {
+      if (!data->in_flexible && data->out_flexible) {
         /* append header */
         gst_tensor_info_convert_to_meta (&priv->in_config.info.info[i],
-            &in_meta[i]);
-        mem = gst_tensor_meta_info_append_header (&in_meta[i], in_mem[i]);
-      } else if (in_flexible && !out_flexible) {
+            &data->in_meta[i]);
+        mem = gst_tensor_meta_info_append_header (&data->in_meta[i],
+            data->in_mem[i]);
+      } else if (data->in_flexible && !data->out_flexible) {
         /* remove header */
-        hsize = gst_tensor_meta_info_get_header_size (&in_meta[i]);
-        mem = gst_memory_share (in_mem[i], hsize, -1);
+        hsize = gst_tensor_meta_info_get_header_size (&data->in_meta[i]);
+        mem = gst_memory_share (data->in_mem[i], hsize, -1);
       } else {
-        mem = gst_memory_ref (in_mem[i]);
+        mem = gst_memory_ref (data->in_mem[i]);
       }
 
       gst_buffer_append_memory (outbuf, mem);
@@ -780,51 +1396,450 @@ gst_tensor_filter_transform (GstBaseTransform * trans,
       }
       if (!out_combi) {
         /* release memory block if output tensor is not in the combi list */
-        if (allocate_in_invoke) {
-          gst_tensor_filter_destroy_notify_util (priv, out_tensors[i].data);
+        if (data->allocate_in_invoke) {
+          gst_tensor_filter_destroy_notify_util (priv,
+              data->out_tensors[i].data);
         } else {
-          gst_allocator_free (out_mem[i]->allocator, out_mem[i]);
+          gst_allocator_free (data->out_mem[i]->allocator, data->out_mem[i]);
         }
 
         continue;
       }
     }
 
-    if (allocate_in_invoke) {
+    if (data->allocate_in_invoke) {
       /* prepare memory block if successfully done */
-      out_mem[i] = mem = gst_tensor_filter_get_wrapped_mem (self,
-          out_tensors[i].data, out_tensors[i].size);
+      data->out_mem[i] = mem = gst_tensor_filter_get_wrapped_mem (self,
+          data->out_tensors[i].data, data->out_tensors[i].size);
 
-      if (out_flexible) {
+      if (data->out_flexible) {
         /* prepare new memory block with meta */
-        out_mem[i] = gst_tensor_meta_info_append_header (&out_meta[i], mem);
+        data->out_mem[i] =
+            gst_tensor_meta_info_append_header (&data->out_meta[i], mem);
         gst_memory_unref (mem);
       }
     }
 
     /* append the memory block to outbuf */
-    gst_buffer_append_memory (outbuf, out_mem[i]);
+    gst_buffer_append_memory (outbuf, data->out_mem[i]);
   }
 
   return GST_FLOW_OK;
-mem_map_error:
-  num_mems = gst_buffer_n_memory (inbuf);
-  for (i = 0; i < num_mems; i++) {
-    if (in_mem[i])
-      gst_memory_unmap (in_mem[i], &in_info[i]);
+}
+
+/**
+ * @brief Record the statistics of the invoke and update the timestamp for the latency query.
+ */
+static void
+gst_tensor_filter_invoke_record (GstTensorFilter * self, GstBuffer * inbuf,
+    gint64 latency)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+
+  record_statistics_latency (priv, latency);
+  gst_tensor_latency_stats_post (&priv->stat.latency_stats,
+      GST_ELEMENT_CAST (self));
+
+  if (priv->latency_mode > 0 || priv->throughput_mode > 0) {
+    GST_OBJECT_LOCK (self);
+    self->latest_pts = GST_BUFFER_PTS (inbuf);
+    GST_OBJECT_UNLOCK (self);
   }
+}
 
-  if (!allocate_in_invoke) {
-    for (i = 0; i < prop->output_meta.num_tensors; i++) {
-      if (out_mem[i]) {
-        gst_memory_unmap (out_mem[i], &out_info[i]);
-        gst_allocator_free (out_mem[i]->allocator, out_mem[i]);
-      }
+/**
+ * @brief Free the data of the asynchronous invoke.
+ */
+static void
+gst_tensor_filter_invoke_data_free (GstTensorFilterInvokeData * data)
+{
+  gst_buffer_unref (data->inbuf);
+  if (data->outbuf)
+    gst_buffer_unref (data->outbuf);
+  g_free (data);
+}
+
+/**
+ * @brief Callback for the sub-plugin to notify that the asynchronous invoke is done.
+ */
+static void
+gst_tensor_filter_async_done (int status, void *user_data)
+{
+  GstTensorFilterInvokeData *data = (GstTensorFilterInvokeData *) user_data;
+  GstTensorFilter *self = data->filter;
+  gint64 latency = g_get_monotonic_time () - data->invoke_time;
+
+  g_mutex_lock (&self->async_lock);
+  data->status = status;
+  data->latency = latency;
+  data->done = TRUE;
+  g_cond_broadcast (&self->async_cond);
+  g_mutex_unlock (&self->async_lock);
+}
+
+/**
+ * @brief Thread to push the outputs of asynchronous invoke in the order of the input buffers.
+ */
+static gpointer
+gst_tensor_filter_async_thread (gpointer user_data)
+{
+  GstTensorFilter *self = GST_TENSOR_FILTER (user_data);
+  GstTensorFilterInvokeData *data;
+  GstFlowReturn ret;
+  gboolean flushing;
+
+  g_mutex_lock (&self->async_lock);
+  while (TRUE) {
+    data = (GstTensorFilterInvokeData *) g_queue_peek_head (&self->async_queue);
+    if (data == NULL && self->async_stop)
+      break;
+
+    if (data == NULL || !data->done) {
+      g_cond_wait (&self->async_cond, &self->async_lock);
+      continue;
+    }
+
+    flushing = self->async_flushing;
+    g_mutex_unlock (&self->async_lock);
+
+    gst_tensor_filter_invoke_record (self, data->inbuf, data->latency);
+
+    ret = gst_tensor_filter_invoke_finish (self, data, data->status,
+        data->outbuf);
+    if (ret == GST_FLOW_OK && !flushing) {
+      ret = gst_pad_push (GST_BASE_TRANSFORM_SRC_PAD (self), data->outbuf);
+      data->outbuf = NULL;
+    } else if (ret == GST_BASE_TRANSFORM_FLOW_DROPPED || flushing) {
+      ret = GST_FLOW_OK;
+    }
+
+    if (ret == GST_FLOW_NOT_LINKED || ret < GST_FLOW_EOS) {
+      GST_ELEMENT_ERROR (self, STREAM, FAILED,
+          ("Failed to push the output of asynchronous invoke."),
+          ("streaming stopped, reason %s", gst_flow_get_name (ret)));
+    }
+
+    g_mutex_lock (&self->async_lock);
+    g_queue_pop_head (&self->async_queue);
+    if (ret != GST_FLOW_OK && self->async_flow == GST_FLOW_OK)
+      self->async_flow = ret;
+    g_cond_broadcast (&self->async_cond);
+    g_mutex_unlock (&self->async_lock);
+
+    gst_tensor_filter_invoke_data_free (data);
+    g_mutex_lock (&self->async_lock);
+  }
+  g_mutex_unlock (&self->async_lock);
+
+  return NULL;
+}
+
+/**
+ * @brief Wait until all submitted invokes are done and the outputs are pushed.
+ */
+static void
+gst_tensor_filter_async_drain (GstTensorFilter * self)
+{
+  if (!self->async_thread)
+    return;
+
+  g_mutex_lock (&self->async_lock);
+  while (!g_queue_is_empty (&self->async_queue))
+    g_cond_wait (&self->async_cond, &self->async_lock);
+  g_mutex_unlock (&self->async_lock);
+}
+
+/**
+ * @brief Push all outputs and stop the thread of asynchronous invoke.
+ */
+static void
+gst_tensor_filter_async_stop (GstTensorFilter * self)
+{
+  if (!self->async_thread)
+    return;
+
+  g_mutex_lock (&self->async_lock);
+  self->async_stop = TRUE;
+  g_cond_broadcast (&self->async_cond);
+  g_mutex_unlock (&self->async_lock);
+
+  g_thread_join (self->async_thread);
+  self->async_thread = NULL;
+  self->async_stop = FALSE;
+  self->async_flushing = FALSE;
+  self->async_flow = GST_FLOW_OK;
+}
+
+/**
+ * @brief Check whether the sub-plugin is invoked asynchronously.
+ */
+static inline gboolean
+gst_tensor_filter_async_enabled (GstTensorFilter * self)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+
+  return (self->max_inflight > 0 && GST_TF_FW_V1 (priv->fw) &&
+      priv->fw->invoke_async != NULL);
+}
+
+/**
+ * @brief Submit the input buffer to the sub-plugin. The output is pushed by the thread of asynchronous invoke.
+ */
+static GstFlowReturn
+gst_tensor_filter_transform_async (GstTensorFilter * self, GstBuffer * inbuf)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterInvokeData *data;
+  GstFlowReturn retval;
+  gint ret;
+
+  /* wait until the number of submitted invokes is less than max-inflight */
+  g_mutex_lock (&self->async_lock);
+  while (self->async_flow == GST_FLOW_OK &&
+      g_queue_get_length (&self->async_queue) >= self->max_inflight)
+    g_cond_wait (&self->async_cond, &self->async_lock);
+  retval = self->async_flow;
+  g_mutex_unlock (&self->async_lock);
+
+  if (retval != GST_FLOW_OK)
+    return retval;
+
+  if (!self->async_thread) {
+    self->async_thread = g_thread_try_new ("tensor_filter_async",
+        gst_tensor_filter_async_thread, self, NULL);
+    if (!self->async_thread) {
+      ml_loge ("Failed to create the thread for asynchronous invoke.");
+      return GST_FLOW_ERROR;
     }
   }
+
+  data = g_new (GstTensorFilterInvokeData, 1);
+  data->filter = self;
+  data->inbuf = gst_buffer_ref (inbuf);
+  data->outbuf = NULL;
+
+  retval = gst_tensor_filter_invoke_prepare (self, data);
+  if (retval != GST_FLOW_OK) {
+    gst_tensor_filter_invoke_data_free (data);
+    return retval;
+  }
+
+  /* the output buffer of base-transform cannot be held after returning */
+  data->outbuf = gst_buffer_new ();
+  gst_buffer_copy_into (data->outbuf, inbuf, GST_BUFFER_COPY_METADATA, 0, -1);
+  data->status = 0;
+  data->latency = 0;
+  data->done = FALSE;
+  data->invoke_time = g_get_monotonic_time ();
+
+  g_mutex_lock (&self->async_lock);
+  g_queue_push_tail (&self->async_queue, data);
+  g_mutex_unlock (&self->async_lock);
+
+  ret = priv->fw->invoke_async (priv->fw, &priv->prop, priv->privateData,
+      data->invoke_tensors, data->out_tensors, gst_tensor_filter_async_done,
+      data);
+  if (ret == -ENOENT) {
+    /* the sub-plugin cannot run this input asynchronously */
+    GST_TF_FW_INVOKE_COMPAT (priv, ret, data->invoke_tensors,
+        data->out_tensors);
+    gst_tensor_filter_async_done (ret, data);
+  } else if (ret != 0) {
+    gst_tensor_filter_async_done (ret, data);
+  }
+
+  return GST_BASE_TRANSFORM_FLOW_DROPPED;
+}
+
+/**
+ * @brief non-ip transform. required vmethod of GstBaseTransform.
+ */
+static GstFlowReturn
+gst_tensor_filter_transform (GstBaseTransform * trans,
+    GstBuffer * inbuf, GstBuffer * outbuf)
+{
+  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (trans);
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterInvokeData data;
+  GstFlowReturn retval;
+  gboolean async;
+  gint ret;
+
+  async = gst_tensor_filter_async_enabled (self);
+
+  /**
+   * Keep the order of the outputs and the model of submitted inputs.
+   * Wait for the asynchronous invokes before swapping the model or invoking synchronously.
+   */
+  if (!async || g_atomic_pointer_get (&self->reload_pending) != NULL)
+    gst_tensor_filter_async_drain (self);
+
+  /* 0. Swap the model loaded in background, and check all properties. */
+  gst_tensor_filter_reload_swap (self);
+
+  retval = _gst_tensor_filter_transform_validate (trans, inbuf, outbuf);
+  if (retval != GST_FLOW_OK)
+    return retval;
+
+  if (async)
+    return gst_tensor_filter_transform_async (self, inbuf);
+
+  /* 1. Map the input buffer and 2. prepare output tensors. */
+  data.filter = self;
+  data.inbuf = inbuf;
+  retval = gst_tensor_filter_invoke_prepare (self, &data);
+  if (retval != GST_FLOW_OK)
+    return retval;
+
+  prepare_statistics (priv);
+
+  /* 3. Call the filter-subplugin callback, "invoke" */
+  GST_TF_FW_INVOKE_COMPAT (priv, ret, data.invoke_tensors, data.out_tensors);
+  gst_tensor_filter_invoke_record (self, inbuf,
+      g_get_monotonic_time () - priv->stat.latest_invoke_time);
+
+  /* 4. Free map info and 5. update result */
+  return gst_tensor_filter_invoke_finish (self, &data, ret, outbuf);
+}
+
+/**
+ * @brief in-place transform. optional vmethod of GstBaseTransform.
+ * @details This is called only if the subplugin allows in-place invoke and the input and output tensors have the same info (see gst_tensor_filter_set_caps). The output tensors are written in the memory blocks of the input buffer.
+ */
+static GstFlowReturn
+gst_tensor_filter_transform_ip (GstBaseTransform * trans, GstBuffer * buf)
+{
+  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (trans);
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterProperties *prop = &priv->prop;
+  GstMemory *mem[NNS_TENSOR_SIZE_LIMIT] = { 0, };
+  GstMapInfo info[NNS_TENSOR_SIZE_LIMIT];
+  GstTensorMemory in_tensors[NNS_TENSOR_SIZE_LIMIT];
+  GstTensorMemory out_tensors[NNS_TENSOR_SIZE_LIMIT];
+  guint i, num_mems;
+  gint ret;
+  gboolean need_profiling;
+  gsize expected;
+  GstFlowReturn retval;
+
+  /* 0. Swap the model loaded in background, and check all properties. */
+  gst_tensor_filter_reload_swap (self);
+
+  retval = _gst_tensor_filter_transform_validate (trans, buf, buf);
+  if (retval != GST_FLOW_OK)
+    return retval;
+
+  num_mems = gst_buffer_n_memory (buf);
+  if (num_mems != prop->input_meta.num_tensors) {
+    ml_loge_stacktrace
+        ("gst_tensor_filter_transform_ip: Input buffer has invalid number of memory blocks (%u), which is expected to be %u (the number of tensors). Maybe, the pad capability is not consistent with the actual input stream.\n",
+        num_mems, prop->input_meta.num_tensors);
+    return GST_FLOW_ERROR;
+  }
+
+  /* 1. Get all tensors from buf, the memory blocks are read and written. */
+  for (i = 0; i < num_mems; i++) {
+    mem[i] = gst_buffer_peek_memory (buf, i);
+
+    /* the memory block is shared with other buffers, do not overwrite it. */
+    if (!gst_memory_is_writable (mem[i])) {
+      mem[i] = gst_memory_copy (mem[i], 0, -1);
+      gst_buffer_replace_memory (buf, i, mem[i]);
+    }
+
+    if (!gst_memory_map (mem[i], &info[i], GST_MAP_READWRITE)) {
+      ml_loge_stacktrace
+          ("gst_tensor_filter_transform_ip: For the given input buffer, tensor-filter (%s : %s) cannot map the %u-th memory chunk for in-place invoke.\n",
+          prop->fwname, TF_MODELNAME (prop), i);
+      mem[i] = NULL;
+      goto mem_map_error;
+    }
+
+    expected = gst_tensor_filter_get_tensor_size (self, i, TRUE);
+    if (expected != info[i].size) {
+      ml_loge_stacktrace
+          ("gst_tensor_filter_transform_ip: Input buffer size (%u'th memory chunk: %zd) is invalid, which is expected to be %zd, which is the frame size of the corresponding tensor. Maybe, the pad capability is not consistent with the actual input stream.\n",
+          i, info[i].size, expected);
+      goto mem_map_error;
+    }
+
+    in_tensors[i].data = info[i].data;
+    in_tensors[i].size = info[i].size;
+    out_tensors[i] = in_tensors[i];
+  }
+
+  need_profiling = (priv->latency_mode > 0 || priv->throughput_mode > 0);
+  prepare_statistics (priv);
+
+  /* 2. Call the filter-subplugin callback, "invoke" */
+  GST_TF_FW_INVOKE_COMPAT (priv, ret, in_tensors, out_tensors);
+  record_statistics (priv);
+  gst_tensor_latency_stats_post (&priv->stat.latency_stats,
+      GST_ELEMENT_CAST (self));
+
+  if (need_profiling) {
+    GST_OBJECT_LOCK (self);
+    self->latest_pts = GST_BUFFER_PTS (buf);
+    GST_OBJECT_UNLOCK (self);
+  }
+
+  /* 3. Free map info and handle error case */
+  for (i = 0; i < num_mems; i++)
+    gst_memory_unmap (mem[i], &info[i]);
+
+  /** @todo define enum to indicate status code */
+  if (ret < 0) {
+    ml_loge_stacktrace
+        ("Calling invoke function (inference instance) of the tensor-filter subplugin (%s for %s) has failed with error code (%d).\n",
+        prop->fwname, TF_MODELNAME (prop), ret);
+    return GST_FLOW_ERROR;
+  } else if (ret > 0) {
+    /* drop this buffer */
+    return GST_BASE_TRANSFORM_FLOW_DROPPED;
+  }
+
+  return GST_FLOW_OK;
+mem_map_error:
+  for (i = 0; i < num_mems; i++) {
+    if (mem[i])
+      gst_memory_unmap (mem[i], &info[i]);
+  }
   return GST_FLOW_ERROR;
 }
 
+/**
+ * @brief Check whether tensor_filter can invoke in-place with negotiated caps.
+ * @param self "this" pointer
+ * @param out_config the tensors config of the output caps
+ * @return TRUE if the subplugin allows in-place invoke and the input and output have the same layout
+ */
+static gboolean
+gst_tensor_filter_check_in_place (GstTensorFilter * self,
+    const GstTensorsConfig * out_config)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterProperties *prop = &priv->prop;
+
+  if (!priv->fw || !gst_tensor_filter_allow_in_place (priv))
+    return FALSE;
+
+  /* the subplugin gives its own output memory */
+  if (gst_tensor_filter_allocate_in_invoke (priv))
+    return FALSE;
+
+  /* the buffer layout is changed with the combination options */
+  if (priv->combi.in_combi_defined || priv->combi.out_combi_i_defined ||
+      priv->combi.out_combi_o_defined)
+    return FALSE;
+
+  /* flexible tensor has the header in each memory block */
+  if (gst_tensors_config_is_flexible (&priv->in_config) ||
+      gst_tensors_config_is_flexible (out_config))
+    return FALSE;
+
+  return gst_tensors_info_is_equal (&prop->input_meta, &prop->output_meta);
+}
+
 /**
  * @brief Configure input and output tensor info from incaps.
  * @param self "this" pointer
@@ -1184,6 +2199,7 @@ gst_tensor_filter_set_caps (GstBaseTransform * trans,
   GstTensorFilterPrivate *priv;
   GstStructure *structure;
   GstTensorsConfig config;
+  gboolean in_place;
 
   self = GST_TENSOR_FILTER_CAST (trans);
   priv = &self->priv;
@@ -1227,6 +2243,12 @@ gst_tensor_filter_set_caps (GstBaseTransform * trans,
     return FALSE;
   }
 
+  /* invoke in-place to avoid the allocation of output buffer */
+  in_place = gst_tensor_filter_check_in_place (self, &config);
+  GST_INFO_OBJECT (self, "In-place invoke is %s.",
+      in_place ? "enabled" : "disabled");
+  gst_base_transform_set_in_place (trans, in_place);
+
   return TRUE;
 }
 
@@ -1234,7 +2256,7 @@ gst_tensor_filter_set_caps (GstBaseTransform * trans,
  * @brief Tell the framework the required size of buffer based on the info of the other side pad. optional vmethod of BaseTransform
  *
  * We cannot directly get the value from size value, we need to review the pad-caps.
- * This is called when non-ip mode is used.
+ * This is called when non-ip mode is used (in-place invoke is disabled).
  */
 static gboolean
 gst_tensor_filter_transform_size (GstBaseTransform * trans,
@@ -1272,7 +2294,24 @@ gst_tensor_filter_sink_event (GstBaseTransform * trans, GstEvent * event)
   GstTensorFilterPrivate *priv;
   self = GST_TENSOR_FILTER_CAST (trans);
   priv = &self->priv;
+
+  /* push the outputs of the submitted inputs before the serialized events */
+  if (GST_EVENT_IS_SERIALIZED (event))
+    gst_tensor_filter_async_drain (self);
+
   switch (GST_EVENT_TYPE (event)) {
+    case GST_EVENT_FLUSH_START:
+      g_mutex_lock (&self->async_lock);
+      self->async_flushing = TRUE;
+      g_mutex_unlock (&self->async_lock);
+      break;
+    case GST_EVENT_FLUSH_STOP:
+      g_mutex_lock (&self->async_lock);
+      self->async_flushing = FALSE;
+      self->async_flow = GST_FLOW_OK;
+      g_mutex_unlock (&self->async_lock);
+      gst_tensor_latency_stats_reset (&priv->stat.latency_stats);
+      break;
     case GST_EVENT_CUSTOM_DOWNSTREAM:
     {
       const GstStructure *structure = gst_event_get_structure (event);
@@ -1339,6 +2378,53 @@ gst_tensor_filter_src_event (GstBaseTransform * trans, GstEvent * event)
   return GST_BASE_TRANSFORM_CLASS (parent_class)->src_event (trans, event);
 }
 
+/**
+ * @brief Query handler of tensor filter.
+ * @param trans "this" pointer
+ * @param direction the direction of the pad which received the query
+ * @param query a passed query object
+ * @return TRUE if the query is handled.
+ */
+static gboolean
+gst_tensor_filter_query (GstBaseTransform * trans,
+    GstPadDirection direction, GstQuery * query)
+{
+  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (trans);
+  GstTensorFilterPrivate *priv = &self->priv;
+
+  if (direction == GST_PAD_SINK &&
+      gst_tensor_latency_query_parse (query, NULL, NULL, NULL)) {
+    GstClockTime latency = 0, pts;
+    gdouble throughput = 0.0;
+
+    /**
+     * Let the downstream filters update the query first,
+     * then accumulate the latency of this filter.
+     */
+    gst_pad_peer_query (GST_BASE_TRANSFORM_SRC_PAD (trans), query);
+
+    /* enable the profiling to get the latency and throughput */
+    if (priv->latency_mode == 0)
+      g_object_set (self, "latency", 1, NULL);
+    if (priv->throughput_mode == 0)
+      g_object_set (self, "throughput", 1, NULL);
+
+    if (priv->prop.latency > 0)
+      latency = (GstClockTime) priv->prop.latency * GST_USECOND;
+    if (priv->prop.throughput > 0)
+      throughput = priv->prop.throughput / 1000.0;
+
+    GST_OBJECT_LOCK (self);
+    pts = self->latest_pts;
+    GST_OBJECT_UNLOCK (self);
+
+    return gst_tensor_latency_query_update (query, latency, throughput, pts);
+  }
+
+  return GST_BASE_TRANSFORM_CLASS (parent_class)->query (trans, direction,
+      query);
+}
+
 /**
  * @brief Called when the element starts processing. optional vmethod of BaseTransform
  * @param trans "this" pointer
@@ -1354,6 +2440,7 @@ gst_tensor_filter_start (GstBaseTransform * trans)
   /* If it is not configured properly, don't allow to start! */
   if (priv->fw == NULL)
     return FALSE;
+  gst_tensor_latency_stats_reset (&priv->stat.latency_stats);
   gst_tensor_filter_common_open_fw (priv);
   return priv->prop.fw_opened;
 }
@@ -1370,6 +2457,8 @@ gst_tensor_filter_stop (GstBaseTransform * trans)
   GstTensorFilterPrivate *priv;
   self = GST_TENSOR_FILTER_CAST (trans);
   priv = &self->priv;
+  gst_tensor_filter_async_stop (self);
+  gst_tensor_filter_reload_stop (self);
   gst_tensor_filter_common_close_fw (priv);
   return TRUE;
 }
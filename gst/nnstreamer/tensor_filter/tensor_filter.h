@@ -55,6 +55,26 @@ G_BEGIN_DECLS
 typedef struct _GstTensorFilter GstTensorFilter;
 typedef struct _GstTensorFilterClass GstTensorFilterClass;
 
+/**
+ * @brief The name of the element message posted when the model is reloaded in background.
+ */
+#define GST_TENSOR_FILTER_RELOAD_MSG_NAME "nnstreamer-model-reloaded"
+
+/**
+ * @brief Data structure for the model loaded in background thread (reload-async).
+ */
+typedef struct
+{
+  GstTensorFilter *filter; /**< the tensor_filter instance to reload the model */
+  const GstTensorFilterFramework *fw; /**< the framework of the model */
+  GstTensorFilterProperties prop; /**< copy of the filter properties with the model files of this instance */
+  GstTensorFilterFrameworkInfo info; /**< framework info of the model */
+  void *privateData; /**< subplugin private data of the model */
+  gboolean opened; /**< TRUE if the model is opened */
+  gchar *warmup_data; /**< file path of the raw input tensors to warm up the model */
+  gint64 load_time; /**< time (usec) to load and warm up the model */
+} GstTensorFilterReload;
+
 /**
  * @brief Internal data structure for tensor_filter instances.
  */
@@ -67,6 +87,26 @@ struct _GstTensorFilter
   GstClockTime prev_ts;  /**< previous timestamp */
   GstClockTimeDiff throttling_delay;  /**< throttling delay from tensor rate */
   GstClockTimeDiff throttling_accum;  /**< accumulated frame durations for throttling */
+  GstClockTime latest_pts;  /**< timestamp of the latest invoked buffer (latency query) */
+
+  gboolean reload_async; /**< load the new model in background thread and swap it between invokes */
+  gchar *warmup_data; /**< file path of the raw input tensors to warm up the new model */
+  GThread *reload_thread; /**< background thread to load the new model */
+  GMutex reload_lock; /**< lock for the model swap, the model files of the filter and the reload state */
+  GCond reload_cond; /**< signaled when the loaded model is swapped or the reload is cancelled */
+  gboolean reload_busy; /**< TRUE while the reload thread is running */
+  gboolean reload_cancel; /**< TRUE to cancel the reload (stop the element) */
+  GstTensorFilterReload *reload_pending; /**< loaded model to be swapped in the streaming thread */
+  GstTensorFilterReload *reload_next; /**< latest model requested while reloading, loaded when the running reload is done */
+
+  guint max_inflight; /**< max number of inputs submitted with asynchronous invoke, 0 to invoke synchronously */
+  GThread *async_thread; /**< thread to push the outputs of asynchronous invoke in order */
+  GMutex async_lock; /**< lock for the queue of asynchronous invoke */
+  GCond async_cond; /**< signaled when an invoke is done or an output is pushed */
+  GQueue async_queue; /**< submitted invokes, in the order of the input buffers */
+  gboolean async_stop; /**< TRUE to stop the thread after pushing all outputs */
+  gboolean async_flushing; /**< TRUE to drop the outputs while flushing */
+  GstFlowReturn async_flow; /**< the last flow return of the thread */
 };
 
 /**
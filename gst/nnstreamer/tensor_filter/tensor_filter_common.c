@@ -23,7 +23,9 @@
  *
  */
 
+#include <stdlib.h>
 #include <string.h>
+#include <glib/gstdio.h>
 
 #include <hw_accel.h>
 #include <nnstreamer_log.h>
@@ -81,7 +83,6 @@ static const gchar *regex_accl_elem_utils[] = {
  * @brief Free memory
  */
 #define g_free_const(x) g_free((void*)(long)(x))
-#define g_strfreev_const(x) g_strfreev((void*)(long)(x))
 
 static GType accl_hw_get_type (void);
 static GList *parse_accl_hw_all (const gchar * accelerators,
@@ -97,6 +98,16 @@ static gint _gtfc_setprop_ACCELERATOR (GstTensorFilterPrivate * priv,
 G_LOCK_DEFINE_STATIC (shared_model_table);
 static GHashTable *shared_model_table = NULL;
 
+/**
+ * @brief The prefix of the shared key generated for the model cache.
+ */
+#define MODEL_CACHE_KEY_PREFIX "model-cache:"
+
+/**
+ * @brief The default time (seconds) to keep the idle model in the model cache.
+ */
+#define DEFAULT_MODEL_CACHE_TIMEOUT (10)
+
 /**
  * @brief GstTensorFilter properties.
  */
@@ -125,6 +136,7 @@ enum
   PROP_INPUTCOMBINATION,
   PROP_OUTPUTCOMBINATION,
   PROP_SHARED_TENSOR_FILTER_KEY,
+  PROP_MODEL_CACHE,
 };
 
 /**
@@ -561,6 +573,7 @@ gst_tensor_filter_framework_info_init (GstTensorFilterFrameworkInfo * info)
   info->accl_auto = -1;
   info->accl_default = -1;
   info->statistics = NULL;
+  info->accept_output_buffer = 0;
 }
 
 /**
@@ -574,7 +587,10 @@ gst_tensor_filter_statistics_init (GstTensorFilterStatistics * stat)
   stat->old_total_invoke_num = 0;
   stat->old_total_invoke_latency = 0;
   stat->latest_invoke_time = 0;
-  stat->recent_latencies = g_queue_new ();
+  stat->recent_index = 0;
+  stat->recent_num = 0;
+  stat->recent_total_latency = 0;
+  gst_tensor_latency_stats_init (&stat->latency_stats);
 }
 
 /**
@@ -701,6 +717,10 @@ nnstreamer_filter_find_best_fit (const char *names)
     if (strlen (g_strstrip (subplugins[i])) == 0)
       continue;
 
+    /* skip the sub-plugin which cannot be loaded, without opening it */
+    if (!subplugin_is_available (NNS_SUBPLUGIN_FILTER, subplugins[i]))
+      continue;
+
     fw = get_subplugin (NNS_SUBPLUGIN_FILTER, subplugins[i]);
     if (fw) {
       nns_logi ("Found %s", subplugins[i]);
@@ -743,6 +763,66 @@ nnstreamer_filter_find (const char *name)
   return fw;
 }
 
+/**
+ * @brief Check the sub-plugin in the name list is available.
+ * @param[in] names comma, whitespace separated list of the sub-plugin name
+ * @return TRUE if one of the sub-plugins is available.
+ */
+static gboolean
+nnstreamer_filter_is_available_any (const char *names)
+{
+  gboolean available = FALSE;
+  gchar **subplugins;
+  guint i, len;
+
+  if (names == NULL || names[0] == '\0')
+    return FALSE;
+
+  subplugins = g_strsplit_set (names, " ,;", -1);
+  len = g_strv_length (subplugins);
+
+  for (i = 0; i < len && !available; i++) {
+    if (strlen (g_strstrip (subplugins[i])) == 0)
+      continue;
+
+    available = subplugin_is_available (NNS_SUBPLUGIN_FILTER, subplugins[i]);
+  }
+  g_strfreev (subplugins);
+
+  return available;
+}
+
+/**
+ * @brief Check filter sub-plugin with the name is available. Same as nnstreamer_filter_find(), but this does not load the sub-plugin if the registry has its load status.
+ * @param[in] name The name of filter sub-plugin.
+ * @return TRUE if the sub-plugin is available.
+ */
+static gboolean
+nnstreamer_filter_is_available (const char *name)
+{
+  gboolean available;
+  gchar *_str;
+
+  g_return_val_if_fail (name != NULL, FALSE);
+
+  available = subplugin_is_available (NNS_SUBPLUGIN_FILTER, name);
+
+  if (!available) {
+    /* get sub-plugin priority from ini file */
+    _str = nnsconf_get_custom_value_string (name, "subplugin_priority");
+    available = nnstreamer_filter_is_available_any (_str);
+    g_free (_str);
+  }
+
+  if (!available) {
+    /* Check the filter-alias from ini file */
+    _str = nnsconf_get_custom_value_string ("filter-aliases", name);
+    available = nnstreamer_filter_is_available_any (_str);
+    g_free (_str);
+  }
+  return available;
+}
+
 /**
  * @brief Parse the string of model
  * @param[out] prop Struct containing the properties of the object
@@ -792,6 +872,39 @@ gst_tensor_filter_allocate_in_invoke (GstTensorFilterPrivate * priv)
   return allocate_in_invoke;
 }
 
+/**
+ * @brief check if the framework fills the output buffers given by the caller, even if it allocates the output in invoke
+ * @param[in] priv Struct containing the properties of the object
+ * @return TRUE if the framework accepts the output buffers
+ */
+gboolean
+gst_tensor_filter_accept_output_buffer (GstTensorFilterPrivate * priv)
+{
+  if (GST_TF_FW_V1 (priv->fw))
+    return (priv->info.allocate_in_invoke && priv->info.accept_output_buffer);
+
+  return FALSE;
+}
+
+/**
+ * @brief check if the framework allows in-place invoke (output == input)
+ * @param[in] priv Struct containing the properties of the object
+ * @return TRUE if in-place invoke is allowed, FALSE otherwise
+ */
+gboolean
+gst_tensor_filter_allow_in_place (GstTensorFilterPrivate * priv)
+{
+  int allow_in_place = 0;
+
+  if (GST_TF_FW_V0 (priv->fw)) {
+    allow_in_place = priv->fw->allow_in_place;
+  } else if (GST_TF_FW_V1 (priv->fw)) {
+    allow_in_place = priv->info.allow_in_place;
+  }
+
+  return allow_in_place ? TRUE : FALSE;
+}
+
 /**
  * @brief Free the data allocated for tensor filter output
  * @param[in] priv Struct containing the properties of the object
@@ -1004,6 +1117,14 @@ gst_tensor_filter_install_properties (GObjectClass * gobject_class)
           "to declare and share such instances. "
           "If it is NULL, it means the model representations is not shared.",
           NULL, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_MODEL_CACHE,
+      g_param_spec_boolean ("model-cache", "Model cache",
+          "Share the model representation automatically with the filters "
+          "in the process opening the same model file with the same framework, "
+          "accelerator and custom properties. This is ignored if "
+          "\"shared-tensor-filter-key\" is given or the model is updatable. "
+          "The default value is given by model_cache in [filter] of the configuration.",
+          FALSE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 }
 
 /**
@@ -1025,10 +1146,150 @@ gst_tensor_filter_common_init_property (GstTensorFilterPrivate * priv)
 
   /* init internal properties */
   priv->silent = TRUE;
+  priv->model_cache =
+      nnsconf_get_custom_value_bool ("filter", "model_cache", FALSE);
   gst_tensors_config_init (&priv->in_config);
   gst_tensors_config_init (&priv->out_config);
 }
 
+/**
+ * @brief Get the time (seconds) to keep the idle model in the model cache.
+ * @note Caller should hold the lock of shared model table.
+ */
+static gint64
+_model_cache_get_timeout (void)
+{
+  static gint64 timeout = -1;
+
+  if (timeout < 0) {
+    gchar *str = nnsconf_get_custom_value_string ("filter",
+        "model_cache_timeout");
+
+    timeout = str ? g_ascii_strtoll (str, NULL, 10) :
+        DEFAULT_MODEL_CACHE_TIMEOUT;
+    timeout = MAX (timeout, 0);
+    g_free (str);
+  }
+
+  return timeout;
+}
+
+/**
+ * @brief Destroy the idle models in the model cache.
+ * @param[in] all TRUE to destroy all idle models regardless of the idle time.
+ * @note Caller should hold the lock of shared model table.
+ */
+static void
+_shared_model_evict_locked (gboolean all)
+{
+  GstTensorFilterSharedModelRepresenatation *rep;
+  GHashTableIter iter;
+  gpointer key, value;
+  gint64 now, timeout;
+
+  if (!shared_model_table)
+    return;
+
+  now = g_get_monotonic_time ();
+  timeout = _model_cache_get_timeout () * G_USEC_PER_SEC;
+
+  g_hash_table_iter_init (&iter, shared_model_table);
+  while (g_hash_table_iter_next (&iter, &key, &value)) {
+    rep = (GstTensorFilterSharedModelRepresenatation *) value;
+
+    if (rep->idle_since == 0 || (!all && now - rep->idle_since < timeout))
+      continue;
+
+    ml_logd ("The idle model is evicted from the model cache, key: %s",
+        (const gchar *) key);
+    if (rep->free_callback)
+      rep->free_callback (rep->shared_interpreter);
+    g_hash_table_iter_remove (&iter);
+  }
+}
+
+/**
+ * @brief Generate the shared key of the model cache and set it to the properties.
+ * @details The key consists of the framework, the canonical path, device, inode, mtime and size of each model file, the accelerator, custom properties and input tensors info.
+ */
+static void
+_model_cache_set_key (GstTensorFilterPrivate * priv)
+{
+  GstTensorFilterProperties *prop = &priv->prop;
+  GString *key;
+  GStatBuf st;
+  gchar *path, *str;
+  gint i;
+
+  if (!priv->model_cache || priv->is_updatable || prop->shared_tensor_filter_key)
+    return;
+
+  if (!prop->fwname || !prop->model_files || prop->num_models <= 0)
+    return;
+
+  key = g_string_new (MODEL_CACHE_KEY_PREFIX);
+  g_string_append (key, prop->fwname);
+
+  for (i = 0; i < prop->num_models; i++) {
+    path = realpath (prop->model_files[i], NULL);
+
+    if (!path || g_stat (path, &st) != 0) {
+      /* not a model file, do not cache it */
+      free (path);
+      g_string_free (key, TRUE);
+      return;
+    }
+
+    g_string_append_printf (key, ":%s:%" G_GUINT64_FORMAT ":%" G_GUINT64_FORMAT
+        ":%" G_GINT64_FORMAT ":%" G_GINT64_FORMAT, path, (guint64) st.st_dev,
+        (guint64) st.st_ino, (gint64) st.st_mtime, (gint64) st.st_size);
+    free (path);
+  }
+
+  g_string_append_printf (key, ":%s:%s", prop->accl_str ? prop->accl_str : "",
+      prop->custom_properties ? prop->custom_properties : "");
+
+  if (prop->input_meta.num_tensors > 0) {
+    str = gst_tensors_info_to_string (&prop->input_meta);
+    g_string_append_printf (key, ":%s", str);
+    g_free (str);
+  }
+
+  priv->model_cache_key = g_string_free (key, FALSE);
+  prop->shared_tensor_filter_key = g_strdup (priv->model_cache_key);
+
+  G_LOCK (shared_model_table);
+  if (!shared_model_table) {
+    shared_model_table =
+        g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+  }
+  G_UNLOCK (shared_model_table);
+
+  ml_logd ("The model is opened with the model cache, key: %s",
+      priv->model_cache_key);
+}
+
+/**
+ * @brief Clear the shared key of the model cache.
+ */
+static void
+_model_cache_clear_key (GstTensorFilterPrivate * priv)
+{
+  GstTensorFilterProperties *prop = &priv->prop;
+
+  if (!priv->model_cache_key)
+    return;
+
+  /* the key may be updated by the user */
+  if (g_strcmp0 (prop->shared_tensor_filter_key, priv->model_cache_key) == 0) {
+    g_free (prop->shared_tensor_filter_key);
+    prop->shared_tensor_filter_key = NULL;
+  }
+
+  g_free (priv->model_cache_key);
+  priv->model_cache_key = NULL;
+}
+
 /**
  * @brief Free the properties for tensor-filter.
  */
@@ -1057,27 +1318,21 @@ gst_tensor_filter_common_free_property (GstTensorFilterPrivate * priv)
   g_list_free (priv->combi.out_combi_i);
   g_list_free (priv->combi.out_combi_o);
 
-  if (priv->stat.recent_latencies != NULL) {
-    GQueue *queue = priv->stat.recent_latencies;
-    gint64 *latency;
-    while ((latency = g_queue_pop_tail (queue)) != NULL)
-      g_free (latency);
-    g_queue_free (queue);
-  }
+  g_free (priv->model_cache_key);
+  priv->model_cache_key = NULL;
 
+  /**
+   * Other filters may still share the models in the table.
+   * Destroy the table only when no model is shared or cached.
+   */
   G_LOCK (shared_model_table);
   if (shared_model_table) {
-    GstTensorFilterSharedModelRepresenatation *rep;
-    GList *value = g_hash_table_get_values (shared_model_table);
+    _shared_model_evict_locked (FALSE);
 
-    while (value) {
-      rep = (GstTensorFilterSharedModelRepresenatation *) value->data;
-      g_list_free (rep->referred_list);
-      value = g_list_next (value);
+    if (g_hash_table_size (shared_model_table) == 0) {
+      g_hash_table_destroy (shared_model_table);
+      shared_model_table = NULL;
     }
-
-    g_hash_table_destroy (shared_model_table);
-    shared_model_table = NULL;
   }
   G_UNLOCK (shared_model_table);
 }
@@ -1173,7 +1428,8 @@ _detect_framework_from_config (const gchar * extension)
     len = g_strv_length (priority_arr);
 
     for (i = 0; i < len; i++) {
-      if (nnstreamer_filter_find (priority_arr[i])) {
+      /* Do not load the sub-plugins to check it, only the detected one will be loaded. */
+      if (nnstreamer_filter_is_available (priority_arr[i])) {
         detected = g_strdup (priority_arr[i]);
         nns_logi ("Detected framework is %s.", detected);
         nns_logd
@@ -1426,7 +1682,11 @@ _gtfc_setprop_MODEL (GstTensorFilterPrivate * priv,
    * has responsibility for the verification of the path regardless of priv->fw->verify_model_path.
    */
   if (prop->fw_opened) {
-    if (GST_TF_FW_V0 (priv->fw) && priv->is_updatable) {
+    if (priv->model_cache_key && priv->is_updatable) {
+      /* The model may be shared with other filters, do not replace it. */
+      ml_loge ("Cannot reload the model opened with the model cache.");
+      status = -1;
+    } else if (GST_TF_FW_V0 (priv->fw) && priv->is_updatable) {
       if (priv->fw->reloadModel &&
           priv->fw->reloadModel (prop, &priv->privateData) != 0) {
         status = -1;
@@ -1976,6 +2236,9 @@ gst_tensor_filter_common_set_property (GstTensorFilterPrivate * priv,
     case PROP_SHARED_TENSOR_FILTER_KEY:
       status = _gtfc_setprop_SHARED_TENSOR_FILTER_KEY (prop, value);
       break;
+    case PROP_MODEL_CACHE:
+      priv->model_cache = g_value_get_boolean (value);
+      break;
     default:
       return FALSE;
   }
@@ -2178,6 +2441,9 @@ gst_tensor_filter_common_get_property (GstTensorFilterPrivate * priv,
       else
         g_value_set_string (value, "");
       break;
+    case PROP_MODEL_CACHE:
+      g_value_set_boolean (value, priv->model_cache);
+      break;
     default:
       /* unknown property */
       return FALSE;
@@ -2426,6 +2692,8 @@ gst_tensor_filter_common_open_fw (GstTensorFilterPrivate * priv)
       }
       /* 0 if successfully loaded. 1 if skipped (already loaded). */
       if (verify_model_path (priv)) {
+        _model_cache_set_key (priv);
+
         if (priv->fw->open (&priv->prop, &priv->privateData) >= 0)
           priv->prop.fw_opened = TRUE;
       }
@@ -2443,6 +2711,9 @@ gst_tensor_filter_common_open_fw (GstTensorFilterPrivate * priv)
       }
     }
 
+    if (!priv->prop.fw_opened)
+      _model_cache_clear_key (priv);
+
     end_time = g_get_monotonic_time ();
     if (priv->prop.fw_opened == TRUE &&
         priv->prop.fwname && priv->prop.model_files) {
@@ -2463,6 +2734,7 @@ gst_tensor_filter_common_close_fw (GstTensorFilterPrivate * priv)
     if (priv->fw && priv->fw->close) {
       priv->fw->close (&priv->prop, &priv->privateData);
     }
+    _model_cache_clear_key (priv);
     priv->prop.input_configured = priv->prop.output_configured = FALSE;
     priv->prop.fw_opened = FALSE;
     g_free_const (priv->prop.fwname);
@@ -2905,6 +3177,8 @@ nnstreamer_filter_shared_model_get (void *instance, const char *key)
     goto done;
   }
 
+  _shared_model_evict_locked (FALSE);
+
   model_rep = g_hash_table_lookup (shared_model_table, key);
   if (!model_rep) {
     ml_logi ("There is no value of the key: %s", key);
@@ -2914,6 +3188,9 @@ nnstreamer_filter_shared_model_get (void *instance, const char *key)
     model_rep->referred_list =
         g_list_append (model_rep->referred_list, instance);
 
+  /* the idle model in the model cache is used again */
+  model_rep->idle_since = 0;
+
 done:
   G_UNLOCK (shared_model_table);
   return model_rep ? model_rep->shared_interpreter : NULL;
@@ -3009,11 +3286,20 @@ nnstreamer_filter_shared_model_remove (void *instance, const char *key,
 
   /* remove key from table if list is empty */
   if (g_list_length (model_rep->referred_list) == 0) {
-    if (free_callback)
-      free_callback (model_rep->shared_interpreter);
-    g_hash_table_remove (shared_model_table, key);
+    if (free_callback && _model_cache_get_timeout () > 0 &&
+        g_str_has_prefix (key, MODEL_CACHE_KEY_PREFIX)) {
+      /* keep the model in the model cache, it is destroyed after the idle timeout */
+      model_rep->free_callback = free_callback;
+      model_rep->idle_since = g_get_monotonic_time ();
+    } else {
+      if (free_callback)
+        free_callback (model_rep->shared_interpreter);
+      g_hash_table_remove (shared_model_table, key);
+    }
   }
 
+  _shared_model_evict_locked (FALSE);
+
 done:
   G_UNLOCK (shared_model_table);
   return ret;
@@ -30,6 +30,7 @@
 #include <nnstreamer_subplugin.h>
 #include <nnstreamer_plugin_api_util.h>
 #include <nnstreamer_plugin_api_filter.h>
+#include <nnstreamer_latency.h>
 
 G_BEGIN_DECLS
 
@@ -46,6 +47,11 @@ G_BEGIN_DECLS
 #define GST_TF_FW_V0(fw) GST_TF_FW_VN (fw, 0)
 #define GST_TF_FW_V1(fw) GST_TF_FW_VN (fw, 1)
 
+/**
+ * @brief Free the const string array (e.g., model files)
+ */
+#define g_strfreev_const(x) g_strfreev((void*)(long)(x))
+
 /**
  * @brief Invoke callbacks of nn framework. Guarantees calling open for the first call.
  */
@@ -76,6 +82,11 @@ G_BEGIN_DECLS
 
 #define GST_TF_STAT_MAX_RECENT (10)
 
+/**
+ * @brief The first property ID of tensor_filter element, which is not shared with single-shot.
+ */
+#define GST_TENSOR_FILTER_PROP_ELEMENT_START (0x1000)
+
 /**
  * @brief Structure definition for tensor-filter statistics
  */
@@ -85,8 +96,12 @@ typedef struct _GstTensorFilterStatistics
   gint64 total_invoke_latency;  /**< accumulated invoke latency (usec) */
   gint64 old_total_invoke_num;      /**< cached value. number of total invokes */
   gint64 old_total_invoke_latency;  /**< cached value. accumulated invoke latency (usec) */
-  gint64 latest_invoke_time;    /**< the latest invoke time (usec) */
-  void *recent_latencies;       /**< data structure (e.g., queue) to hold recent latencies */
+  gint64 latest_invoke_time;    /**< the latest invoke time (monotonic, usec) */
+  gint64 recent_latencies[GST_TF_STAT_MAX_RECENT]; /**< ring buffer of recent latencies (usec) */
+  guint recent_index;           /**< index of the ring buffer to store the next latency */
+  guint recent_num;             /**< number of latencies in the ring buffer */
+  gint64 recent_total_latency;  /**< sum of latencies in the ring buffer (usec) */
+  GstTensorLatencyStats latency_stats; /**< histogram of invoke latencies */
 } GstTensorFilterStatistics;
 
 /**
@@ -108,6 +123,8 @@ typedef struct _GstTensorFilterCombination
 typedef struct {
   void *shared_interpreter; /**< the model representation for each sub-plugins */
   GList *referred_list; /**< the referred list about the instances sharing the same key */
+  void (*free_callback) (void *); /**< the callback to destroy the idle model representation (model cache) */
+  gint64 idle_since; /**< the monotonic time when the referred list becomes empty (model cache), 0 if referred */
 } GstTensorFilterSharedModelRepresenatation;
 
 /**
@@ -132,6 +149,9 @@ typedef struct _GstTensorFilterPrivate
   gint throughput_mode;  /**< throughput profiling mode (0: off, 1: on, ...) */
 
   GstTensorFilterCombination combi;
+
+  gboolean model_cache; /**< TRUE to share the model representation automatically with the filters opening the same model */
+  gchar *model_cache_key; /**< the key of model cache while the framework is opened, NULL if the model is not cached */
 } GstTensorFilterPrivate;
 
 /**
@@ -161,6 +181,22 @@ gst_tensorsinfo_compare_print (const GstTensorsInfo * info1,
 extern gboolean
 gst_tensor_filter_allocate_in_invoke (GstTensorFilterPrivate * priv);
 
+/**
+ * @brief check if the framework fills the output buffers given by the caller, even if it allocates the output in invoke
+ * @param[in] priv Struct containing the properties of the object
+ * @return TRUE if the framework accepts the output buffers
+ */
+extern gboolean
+gst_tensor_filter_accept_output_buffer (GstTensorFilterPrivate * priv);
+
+/**
+ * @brief check if the framework allows in-place invoke (output == input)
+ * @param[in] priv Struct containing the properties of the object
+ * @return TRUE if in-place invoke is allowed, FALSE otherwise
+ */
+extern gboolean
+gst_tensor_filter_allow_in_place (GstTensorFilterPrivate * priv);
+
 /**
  * @brief Installs all the properties for tensor_filter
  * @param[in] gobject_class Glib object class whose properties will be set
@@ -54,6 +54,7 @@ typedef struct _GTensorFilterSinglePrivate
 {
   GstTensorFilterPrivate filter_priv; /**< Internal properties for tensor-filter */
   gboolean allocate_in_invoke;  /**< cached value after first invoke */
+  gboolean accept_output_buffer;  /**< cached value after first invoke, the framework fills the output buffers given by the caller */
 } GTensorFilterSinglePrivate;
 
 #define G_TENSOR_FILTER_SINGLE_PRIV(obj) ((GTensorFilterSinglePrivate *) (obj)->priv)
@@ -72,6 +73,10 @@ static void g_tensor_filter_single_get_property (GObject * object,
 /* GTensorFilterSingle method implementations */
 static gboolean g_tensor_filter_single_invoke (GTensorFilterSingle * self,
     const GstTensorMemory * input, GstTensorMemory * output, gboolean allocate);
+static gboolean g_tensor_filter_single_invoke_no_copy (GTensorFilterSingle *
+    self, const GstTensorMemory * input, GstTensorMemory * output);
+static void g_tensor_filter_release_output (GTensorFilterSingle * self,
+    GstTensorMemory * output);
 static gboolean g_tensor_filter_input_configured (GTensorFilterSingle * self);
 static gboolean g_tensor_filter_output_configured (GTensorFilterSingle * self);
 static gint g_tensor_filter_set_input_info (GTensorFilterSingle * self,
@@ -99,6 +104,8 @@ g_tensor_filter_single_class_init (GTensorFilterSingleClass * klass)
   gst_tensor_filter_install_properties (gobject_class);
 
   klass->invoke = g_tensor_filter_single_invoke;
+  klass->invoke_no_copy = g_tensor_filter_single_invoke_no_copy;
+  klass->release_output = g_tensor_filter_release_output;
   klass->start = g_tensor_filter_single_start;
   klass->stop = g_tensor_filter_single_stop;
   klass->input_configured = g_tensor_filter_input_configured;
@@ -124,6 +131,7 @@ g_tensor_filter_single_init (GTensorFilterSingle * self)
 
   gst_tensor_filter_common_init_property (priv);
   spriv->allocate_in_invoke = FALSE;
+  spriv->accept_output_buffer = FALSE;
 }
 
 /**
@@ -262,6 +270,7 @@ g_tensor_filter_single_start (GTensorFilterSingle * self)
 
   gst_tensor_filter_load_tensor_info (priv);
   spriv->allocate_in_invoke = gst_tensor_filter_allocate_in_invoke (priv);
+  spriv->accept_output_buffer = gst_tensor_filter_accept_output_buffer (priv);
 
   priv->configured = TRUE;
 
@@ -342,10 +351,14 @@ g_tensor_filter_single_invoke (GTensorFilterSingle * self,
   _out = output;
 
   if (spriv->allocate_in_invoke) {
-    if (!allocate) {
+    if (allocate) {
+      /* sub-plugin allocates new memory, clear the output to be filled. */
+      for (i = 0; i < priv->prop.output_meta.num_tensors; i++)
+        output[i].data = NULL;
+    } else if (!spriv->accept_output_buffer) {
       /**
-       * @todo how can we remove memcpy if output data is already allocated
        * single-shot should fill the output data, but sub-plugin allocates new memory.
+       * Copy the output only if sub-plugin cannot fill the given output buffers.
        */
       _out = out_tensors;
 
@@ -389,6 +402,47 @@ error:
   return FALSE;
 }
 
+/**
+ * @brief Called when an input supposed to be invoked, the output is passed without memcpy
+ * @param self "this" pointer
+ * @param input memory containing input data to run processing on
+ * @param output memory to get the output data, allocated by the filter or sub-plugin
+ * @return TRUE if there is no error.
+ * @note Caller should call release_output() to free the output data.
+ */
+static gboolean
+g_tensor_filter_single_invoke_no_copy (GTensorFilterSingle * self,
+    const GstTensorMemory * input, GstTensorMemory * output)
+{
+  return g_tensor_filter_single_invoke (self, input, output, TRUE);
+}
+
+/**
+ * @brief Called to free the output data from invoke_no_copy()
+ * @param self "this" pointer
+ * @param output memory containing output data
+ */
+static void
+g_tensor_filter_release_output (GTensorFilterSingle * self,
+    GstTensorMemory * output)
+{
+  guint i;
+  GTensorFilterSinglePrivate *spriv;
+  GstTensorFilterPrivate *priv;
+
+  spriv = G_TENSOR_FILTER_SINGLE_PRIV (self);
+  priv = &spriv->filter_priv;
+
+  if (spriv->allocate_in_invoke) {
+    g_tensor_filter_destroy_notify (self, output);
+  } else {
+    for (i = 0; i < priv->prop.output_meta.num_tensors; i++) {
+      g_free (output[i].data);
+      output[i].data = NULL;
+    }
+  }
+}
+
 /**
  * @brief Set input tensor information in the framework
  * @param self "this" pointer
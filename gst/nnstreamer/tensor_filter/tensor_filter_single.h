@@ -81,6 +81,11 @@ struct _GTensorFilterSingleClass
   gboolean (*allocate_in_invoke) (GTensorFilterSingle * self);
   /** Free the data allocated by the tensor filter in invoke */
   void (*destroy_notify) (GTensorFilterSingle * self, GstTensorMemory * mem);
+  /** Invoke the filter and get the output allocated by the filter or sub-plugin without memcpy. */
+  gboolean (*invoke_no_copy) (GTensorFilterSingle * self,
+      const GstTensorMemory * input, GstTensorMemory * output);
+  /** Free the output data from invoke_no_copy, regardless of which allocated it */
+  void (*release_output) (GTensorFilterSingle * self, GstTensorMemory * output);
 };
 
 /**
@@ -247,6 +247,37 @@ tensor_filter_subplugin::cpp_eventHandler (const GstTensorFilterFramework *tf,
   return obj->eventHandler (ops, *data);
 }
 
+/**
+ * @brief C V1 tensor-filter wrapper callback function, "invoke_async"
+ */
+int
+tensor_filter_subplugin::cpp_invoke_async (const GstTensorFilterFramework *tf,
+    const GstTensorFilterProperties *prop, void *private_data,
+    const GstTensorMemory *input, GstTensorMemory *output,
+    GstTensorFilterInvokeDoneCallback done_cb, void *user_data)
+{
+  tensor_filter_subplugin *obj;
+  int ret;
+
+  GET_TFSP_WITH_CHECKS (obj, private_data);
+  UNUSED (tf);
+  UNUSED (prop);
+
+  try {
+    ret = obj->invoke_async (input, output, done_cb, user_data);
+  } catch (const std::invalid_argument &e) {
+    _RETURN_ERR_WITH_MSG (-EINVAL, e.what ());
+  } catch (const std::system_error &e) {
+    _RETURN_ERR_WITH_MSG (e.code ().value () * -1, e.what ());
+  } catch (const std::runtime_error &e) {
+    _RETURN_ERR_WITH_MSG (-EINVAL, e.what ());
+  } catch (const std::exception &e) {
+    _RETURN_ERR_WITH_MSG (-EINVAL, e.what ());
+  }
+
+  return ret;
+}
+
 /**
  * @brief The template for fwdesc, the C wrapper (V1) struct.
  */
@@ -260,6 +291,7 @@ const GstTensorFilterFramework tensor_filter_subplugin::fwdesc_template
              .getModelInfo = cpp_getModelInfo,
              .eventHandler = cpp_eventHandler,
              .subplugin_data = nullptr,
+             .invoke_async = nullptr, /* set by register_subplugin () if overridden */
          } } };
 
 /**
@@ -289,4 +321,18 @@ tensor_filter_subplugin::eventHandler (event_ops ops, GstTensorFilterFrameworkEv
   return -ENOENT;
 }
 
+/**
+ * @brief Base invoke_async, which lets tensor_filter call invoke.
+ */
+int
+tensor_filter_subplugin::invoke_async (const GstTensorMemory *input,
+    GstTensorMemory *output, GstTensorFilterInvokeDoneCallback done_cb, void *user_data)
+{
+  UNUSED (input);
+  UNUSED (output);
+  UNUSED (done_cb);
+  UNUSED (user_data);
+  return -ENOENT;
+}
+
 } /* namespace nnstreamer */
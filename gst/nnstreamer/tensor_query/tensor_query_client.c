@@ -46,6 +46,8 @@ enum
   PROP_TOPIC,
   PROP_TIMEOUT,
   PROP_SILENT,
+  PROP_STATS,
+  PROP_STATS_INTERVAL,
 };
 
 #define TCP_HIGHEST_PORT        65535
@@ -145,6 +147,16 @@ gst_tensor_query_client_class_init (GstTensorQueryClientClass * klass)
           "A timeout value (in ms) to wait message from query server after sending buffer to server. 0 means no wait.",
           0, G_MAXUINT, DEFAULT_CLIENT_TIMEOUT,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_STATS,
+      g_param_spec_boxed ("stats", "Statistics",
+          "Latency statistics of the round trip to query server, with the "
+          "fields count, p50, p95, p99 and max (latency in microseconds)",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_STATS_INTERVAL,
+      g_param_spec_uint ("stats-interval", "Statistics interval",
+          "Interval (ms) to post an element message with the latency "
+          "statistics (0: disabled)", 0, G_MAXUINT, 0,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
   gst_element_class_add_pad_template (gstelement_class,
       gst_static_pad_template_get (&sinktemplate));
@@ -192,6 +204,7 @@ gst_tensor_query_client_init (GstTensorQueryClient * self)
   self->timeout = DEFAULT_CLIENT_TIMEOUT;
   self->edge_h = NULL;
   self->msg_queue = g_async_queue_new ();
+  gst_tensor_latency_stats_init (&self->stats);
 }
 
 /**
@@ -279,6 +292,10 @@ gst_tensor_query_client_set_property (GObject * object, guint prop_id,
     case PROP_SILENT:
       self->silent = g_value_get_boolean (value);
       break;
+    case PROP_STATS_INTERVAL:
+      gst_tensor_latency_stats_set_interval (&self->stats,
+          g_value_get_uint (value));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -319,6 +336,14 @@ gst_tensor_query_client_get_property (GObject * object, guint prop_id,
     case PROP_SILENT:
       g_value_set_boolean (value, self->silent);
       break;
+    case PROP_STATS:
+      g_value_take_boxed (value,
+          gst_tensor_latency_stats_to_structure (&self->stats));
+      break;
+    case PROP_STATS_INTERVAL:
+      g_value_set_uint (value,
+          gst_tensor_latency_stats_get_interval (&self->stats));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -588,10 +613,15 @@ gst_tensor_query_client_sink_event (GstPad * pad,
       ret = gst_tensor_query_client_create_edge_handle (self);
       if (!ret)
         nns_loge ("Failed to create edge handle, cannot start query client.");
+      else
+        gst_tensor_latency_stats_reset (&self->stats);
 
       gst_event_unref (event);
       return ret;
     }
+    case GST_EVENT_FLUSH_STOP:
+      gst_tensor_latency_stats_reset (&self->stats);
+      break;
     default:
       break;
   }
@@ -666,6 +696,7 @@ gst_tensor_query_client_chain (GstPad * pad,
   GstMemory *mem[NNS_TENSOR_SIZE_LIMIT];
   GstMapInfo map[NNS_TENSOR_SIZE_LIMIT];
   gchar *val;
+  gint64 start_time;
   UNUSED (pad);
 
   ret = nns_edge_data_create (&data_h);
@@ -689,6 +720,7 @@ gst_tensor_query_client_chain (GstPad * pad,
   nns_edge_data_set_info (data_h, "client_id", val);
   g_free (val);
 
+  start_time = g_get_monotonic_time ();
   if (NNS_EDGE_ERROR_NONE != nns_edge_send (self->edge_h, data_h)) {
     nns_logw ("Failed to publish to server node, retry connection.");
     goto retry;
@@ -699,6 +731,10 @@ gst_tensor_query_client_chain (GstPad * pad,
   data_h = g_async_queue_timeout_pop (self->msg_queue,
       self->timeout * G_TIME_SPAN_MILLISECOND);
   if (data_h) {
+    gst_tensor_latency_stats_record (&self->stats,
+        g_get_monotonic_time () - start_time);
+    gst_tensor_latency_stats_post (&self->stats, GST_ELEMENT_CAST (self));
+
     ret = nns_edge_data_get_count (data_h, &num_data);
     if (ret != NNS_EDGE_ERROR_NONE || num_data == 0) {
       nns_loge ("Failed to get the number of memories of the edge data.");
@@ -59,6 +59,8 @@ struct _GstTensorQueryClient
   nns_edge_connect_type_e connect_type;
   nns_edge_h edge_h;
   GAsyncQueue *msg_queue;
+
+  GstTensorLatencyStats stats; /**< latency statistics of the round trip to the server */
 };
 
 /**
@@ -17,6 +17,7 @@
 #include <glib.h>
 #include <glib/gstdio.h>
 #include <nnstreamer_conf.h>
+#include <nnstreamer_subplugin.h>
 #include <nnstreamer_plugin_api.h>
 #include <tensor_common.h>
 #include <unistd.h>
@@ -1342,6 +1343,111 @@ TEST (commonMetaInfo, appendHeader)
   gst_memory_unref (result);
 }
 
+/**
+ * @brief Test for tensor meta info (append header to memory with the headroom).
+ */
+TEST (commonMetaInfo, appendHeaderHeadroom)
+{
+  GstTensorMetaInfo meta1, meta2, meta3;
+  GstMemory *result, *data, *sub;
+  GstMapInfo data_map, result_map;
+  gsize hsize, msize, i;
+  gboolean ret;
+
+  gst_tensor_meta_info_init (&meta1);
+  meta1.type = _NNS_UINT8;
+  meta1.format = _NNS_TENSOR_FORMAT_FLEXIBLE;
+  meta1.dimension[0] = 300U;
+
+  hsize = gst_tensor_meta_info_get_header_size (&meta1);
+  data = gst_tensor_alloc_with_headroom (&meta1, 300);
+  ASSERT_TRUE (data != NULL);
+  EXPECT_TRUE (GST_MEMORY_FLAG_IS_SET (data, GST_TENSOR_MEMORY_FLAG_HEADROOM));
+
+  ASSERT_TRUE (gst_memory_map (data, &data_map, GST_MAP_WRITE));
+  EXPECT_EQ (data_map.size, 300U);
+  for (i = 0; i < data_map.size; i++)
+    data_map.data[i] = (guint8) i;
+  gst_memory_unmap (data, &data_map);
+
+  result = gst_tensor_meta_info_append_header (&meta1, data);
+  ASSERT_TRUE (result != NULL);
+
+  msize = gst_memory_get_sizes (result, NULL, NULL);
+  EXPECT_EQ (msize, hsize + 300U);
+
+  ret = gst_tensor_meta_info_parse_memory (&meta2, result);
+  EXPECT_TRUE (ret);
+  EXPECT_EQ (meta2.type, _NNS_UINT8);
+  EXPECT_EQ (meta2.format, _NNS_TENSOR_FORMAT_FLEXIBLE);
+  EXPECT_EQ (meta2.dimension[0], 300U);
+
+  /* the header in the headroom is shared, without copying the data */
+  ASSERT_TRUE (gst_memory_map (data, &data_map, GST_MAP_READ));
+  ASSERT_TRUE (gst_memory_map (result, &result_map, GST_MAP_READ));
+  EXPECT_EQ (result_map.data + hsize, data_map.data);
+  EXPECT_EQ (data_map.size, 300U);
+  for (i = 0; i < data_map.size; i++)
+    EXPECT_EQ (data_map.data[i], (guint8) i);
+  gst_memory_unmap (result, &result_map);
+  gst_memory_unmap (data, &data_map);
+
+  gst_memory_unref (result);
+
+  /* the header in the headroom is different, the data should be copied */
+  meta3 = meta1;
+  meta3.media_type = _NNS_OCTET;
+  result = gst_tensor_meta_info_append_header (&meta3, data);
+  ASSERT_TRUE (result != NULL);
+
+  ret = gst_tensor_meta_info_parse_memory (&meta2, result);
+  EXPECT_TRUE (ret);
+  EXPECT_EQ ((media_type) meta2.media_type, _NNS_OCTET);
+
+  ASSERT_TRUE (gst_memory_map (data, &data_map, GST_MAP_READ));
+  ASSERT_TRUE (gst_memory_map (result, &result_map, GST_MAP_READ));
+  EXPECT_NE (result_map.data + hsize, data_map.data);
+  for (i = 0; i < data_map.size; i++)
+    EXPECT_EQ (result_map.data[hsize + i], (guint8) i);
+  gst_memory_unmap (result, &result_map);
+  gst_memory_unmap (data, &data_map);
+
+  gst_memory_unref (result);
+
+  /* the header in the headroom is not overwritten */
+  result = gst_tensor_meta_info_append_header (&meta1, data);
+  ASSERT_TRUE (result != NULL);
+
+  ret = gst_tensor_meta_info_parse_memory (&meta2, result);
+  EXPECT_TRUE (ret);
+  EXPECT_EQ ((media_type) meta2.media_type, _NNS_TENSOR);
+
+  ASSERT_TRUE (gst_memory_map (data, &data_map, GST_MAP_READ));
+  ASSERT_TRUE (gst_memory_map (result, &result_map, GST_MAP_READ));
+  EXPECT_EQ (result_map.data + hsize, data_map.data);
+  gst_memory_unmap (result, &result_map);
+  gst_memory_unmap (data, &data_map);
+
+  gst_memory_unref (result);
+
+  /* shared memory does not own the headroom, the data should be copied */
+  sub = gst_memory_share (data, 0, -1);
+  result = gst_tensor_meta_info_append_header (&meta1, sub);
+  ASSERT_TRUE (result != NULL);
+
+  ASSERT_TRUE (gst_memory_map (sub, &data_map, GST_MAP_READ));
+  ASSERT_TRUE (gst_memory_map (result, &result_map, GST_MAP_READ));
+  EXPECT_NE (result_map.data + hsize, data_map.data);
+  for (i = 0; i < data_map.size; i++)
+    EXPECT_EQ (result_map.data[hsize + i], (guint8) i);
+  gst_memory_unmap (result, &result_map);
+  gst_memory_unmap (sub, &data_map);
+
+  gst_memory_unref (result);
+  gst_memory_unref (sub);
+  gst_memory_unref (data);
+}
+
 /**
  * @brief Test for tensor meta info (append header to memory with invalid param).
  */
@@ -1697,6 +1803,100 @@ TEST (confCustom, checkExtraConfPath_p)
   }
 }
 
+/**
+ * @brief Test the registry of sub-plugins.
+ */
+TEST (confCustom, registry_p)
+{
+  gchar *fullpath = g_build_path ("/", g_get_tmp_dir (), "nns-tizen-XXXXXX", NULL);
+  gchar *dir = g_mkdtemp (fullpath);
+  gchar *filename = g_build_path ("/", dir, "nnstreamer.ini", NULL);
+  gchar *registry = g_build_path ("/", dir, "registry.ini", NULL);
+  gchar *dirf = g_build_path ("/", dir, "filters", NULL);
+  gchar *confenv = g_strdup (g_getenv ("NNSTREAMER_CONF"));
+  gchar *regenv = g_strdup (g_getenv ("NNSTREAMER_REGISTRY"));
+  const gchar *fn;
+
+  EXPECT_EQ (g_mkdir (dirf, 0755), 0);
+
+  FILE *fp = g_fopen (filename, "w");
+  ASSERT_TRUE (fp != NULL);
+  g_fprintf (fp, "[common]\n");
+  g_fprintf (fp, "enable_registry=True\n");
+  g_fprintf (fp, "[filter]\n");
+  g_fprintf (fp, "filters=%s\n", dirf);
+  fclose (fp);
+
+  gchar *f1 = create_null_file (dirf, "libnnstreamer_filter_cached" NNSTREAMER_SO_FILE_EXTENSION);
+
+  EXPECT_TRUE (g_setenv ("NNSTREAMER_CONF", filename, TRUE));
+  EXPECT_TRUE (g_setenv ("NNSTREAMER_REGISTRY", registry, TRUE));
+  EXPECT_TRUE (nnsconf_loadconf (TRUE));
+  EXPECT_TRUE (g_file_test (registry, G_FILE_TEST_IS_REGULAR));
+
+  /* the list from the registry should be same */
+  EXPECT_TRUE (nnsconf_loadconf (TRUE));
+  fn = nnsconf_get_fullpath ("cached", NNSCONF_PATH_FILTERS);
+  EXPECT_STREQ (fn, f1);
+
+  /* the status of the file is unknown before loading it */
+  EXPECT_EQ (nnsconf_registry_get_status (f1), NNSCONF_REGISTRY_UNKNOWN);
+
+  nnsconf_registry_set_status (f1, FALSE);
+  /* the status may be unknown if the file is modified in the same second */
+  if (nnsconf_registry_get_status (f1) != NNSCONF_REGISTRY_UNKNOWN) {
+    EXPECT_EQ (nnsconf_registry_get_status (f1), NNSCONF_REGISTRY_BROKEN);
+
+    /* reload the registry from the file */
+    EXPECT_TRUE (nnsconf_loadconf (TRUE));
+    EXPECT_EQ (nnsconf_registry_get_status (f1), NNSCONF_REGISTRY_BROKEN);
+  }
+
+  /* the status is invalid if the file is changed */
+  fp = g_fopen (f1, "w");
+  ASSERT_TRUE (fp != NULL);
+  g_fprintf (fp, "changed");
+  fclose (fp);
+  EXPECT_EQ (nnsconf_registry_get_status (f1), NNSCONF_REGISTRY_UNKNOWN);
+
+  nnsconf_registry_set_status (f1, FALSE);
+  nnsconf_registry_clear_status (f1);
+  EXPECT_EQ (nnsconf_registry_get_status (f1), NNSCONF_REGISTRY_UNKNOWN);
+
+  /* the file cannot be opened, the failure should not be recorded */
+  EXPECT_TRUE (get_subplugin (NNS_SUBPLUGIN_FILTER, "cached") == NULL);
+  EXPECT_EQ (nnsconf_registry_get_status (f1), NNSCONF_REGISTRY_UNKNOWN);
+  EXPECT_FALSE (subplugin_is_available (NNS_SUBPLUGIN_FILTER, "cached"));
+
+  g_remove (f1);
+  g_remove (registry);
+  g_remove (filename);
+  g_rmdir (dirf);
+  g_rmdir (dir);
+
+  g_free (f1);
+  g_free (fullpath);
+  g_free (filename);
+  g_free (registry);
+  g_free (dirf);
+
+  if (regenv) {
+    EXPECT_TRUE (g_setenv ("NNSTREAMER_REGISTRY", regenv, TRUE));
+    g_free (regenv);
+  } else {
+    g_unsetenv ("NNSTREAMER_REGISTRY");
+  }
+
+  if (confenv) {
+    EXPECT_TRUE (g_setenv ("NNSTREAMER_CONF", confenv, TRUE));
+    g_free (confenv);
+  } else {
+    g_unsetenv ("NNSTREAMER_CONF");
+  }
+
+  EXPECT_TRUE (nnsconf_loadconf (TRUE));
+}
+
 /**
  * @brief Test nnstreamer conf util (name prefix with invalid param).
  */
@@ -1911,6 +2111,142 @@ TEST (commonUtil, createTensorBufferInvalidSize_n)
   EXPECT_FALSE (out != NULL);
 }
 
+/**
+ * @brief Test latency statistics with uniform values
+ */
+TEST (commonLatencyStats, summarize)
+{
+  GstTensorLatencyStats stats;
+  GstTensorLatencySummary summary;
+  gint64 i;
+
+  gst_tensor_latency_stats_init (&stats);
+
+  /* 1 ~ 1000 usec */
+  for (i = 1; i <= 1000; i++)
+    gst_tensor_latency_stats_record (&stats, i);
+
+  gst_tensor_latency_stats_summarize (&stats, &summary);
+  EXPECT_EQ (summary.count, 1000U);
+  EXPECT_EQ (summary.max, 1000);
+
+  /* relative error of the histogram is less than 1/32 */
+  EXPECT_GE (summary.p50, 500);
+  EXPECT_LE (summary.p50, 500 + 500 / 32);
+  EXPECT_GE (summary.p95, 950);
+  EXPECT_LE (summary.p95, 950 + 950 / 32);
+  EXPECT_GE (summary.p99, 990);
+  EXPECT_LE (summary.p99, 1000);
+}
+
+/**
+ * @brief Test latency statistics with small and large values
+ */
+TEST (commonLatencyStats, summarizeRange)
+{
+  GstTensorLatencyStats stats;
+  GstTensorLatencySummary summary;
+
+  gst_tensor_latency_stats_init (&stats);
+
+  /* exact values in the linear buckets */
+  gst_tensor_latency_stats_record (&stats, 7);
+  gst_tensor_latency_stats_summarize (&stats, &summary);
+  EXPECT_EQ (summary.count, 1U);
+  EXPECT_EQ (summary.p50, 7);
+  EXPECT_EQ (summary.p99, 7);
+  EXPECT_EQ (summary.max, 7);
+
+  /* negative and overflowed values are clamped */
+  gst_tensor_latency_stats_record (&stats, -10);
+  gst_tensor_latency_stats_record (&stats, G_MAXINT64);
+  gst_tensor_latency_stats_summarize (&stats, &summary);
+  EXPECT_EQ (summary.count, 3U);
+  EXPECT_EQ (summary.p50, 7);
+  EXPECT_EQ (summary.max, G_MAXINT);
+  EXPECT_EQ (summary.p99, G_MAXINT);
+
+  /* init clears the recorded values */
+  gst_tensor_latency_stats_init (&stats);
+  gst_tensor_latency_stats_summarize (&stats, &summary);
+  EXPECT_EQ (summary.count, 0U);
+  EXPECT_EQ (summary.p50, 0);
+  EXPECT_EQ (summary.max, 0);
+}
+
+/**
+ * @brief Test latency statistics reset (keeps the report interval)
+ */
+TEST (commonLatencyStats, reset)
+{
+  GstTensorLatencyStats stats;
+  GstTensorLatencySummary summary;
+
+  gst_tensor_latency_stats_init (&stats);
+  gst_tensor_latency_stats_set_interval (&stats, 500U);
+  gst_tensor_latency_stats_record (&stats, 100);
+  gst_tensor_latency_stats_record (&stats, 200);
+
+  gst_tensor_latency_stats_reset (&stats);
+  gst_tensor_latency_stats_summarize (&stats, &summary);
+  EXPECT_EQ (summary.count, 0U);
+  EXPECT_EQ (summary.max, 0);
+  EXPECT_EQ (gst_tensor_latency_stats_get_interval (&stats), 500U);
+
+  gst_tensor_latency_stats_record (&stats, 50);
+  gst_tensor_latency_stats_summarize (&stats, &summary);
+  EXPECT_EQ (summary.count, 1U);
+  EXPECT_EQ (summary.max, 50);
+}
+
+/**
+ * @brief Test latency statistics structure and report interval
+ */
+TEST (commonLatencyStats, structure)
+{
+  GstTensorLatencyStats stats;
+  GstStructure *s;
+  guint64 count, p50, max;
+
+  gst_tensor_latency_stats_init (&stats);
+  gst_tensor_latency_stats_record (&stats, 100);
+  gst_tensor_latency_stats_record (&stats, 200);
+
+  s = gst_tensor_latency_stats_to_structure (&stats);
+  ASSERT_TRUE (s != NULL);
+  EXPECT_TRUE (gst_structure_has_name (s, GST_TENSOR_LATENCY_STATS_NAME));
+  EXPECT_TRUE (gst_structure_get_uint64 (s, "count", &count));
+  EXPECT_TRUE (gst_structure_get_uint64 (s, "p50", &p50));
+  EXPECT_TRUE (gst_structure_get_uint64 (s, "max", &max));
+  EXPECT_EQ (count, 2U);
+  EXPECT_GE (p50, 100U);
+  EXPECT_LE (p50, 100U + 100U / 32);
+  EXPECT_EQ (max, 200U);
+  gst_structure_free (s);
+
+  /* report is disabled by default */
+  EXPECT_EQ (gst_tensor_latency_stats_get_interval (&stats), 0U);
+  EXPECT_FALSE (gst_tensor_latency_stats_report_due (&stats));
+
+  gst_tensor_latency_stats_set_interval (&stats, 1U);
+  EXPECT_EQ (gst_tensor_latency_stats_get_interval (&stats), 1U);
+  g_usleep (2000);
+  EXPECT_TRUE (gst_tensor_latency_stats_report_due (&stats));
+}
+
+/**
+ * @brief Test latency statistics with invalid param
+ */
+TEST (commonLatencyStats, invalidParam_n)
+{
+  GstTensorLatencySummary summary;
+
+  gst_tensor_latency_stats_summarize (NULL, &summary);
+  EXPECT_EQ (gst_tensor_latency_stats_get_interval (NULL), 0U);
+  EXPECT_FALSE (gst_tensor_latency_stats_report_due (NULL));
+  EXPECT_TRUE (gst_tensor_latency_stats_to_structure (NULL) == NULL);
+}
+
 /**
  * @brief Main function for unit test.
  */
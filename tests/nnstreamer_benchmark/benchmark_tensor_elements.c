@@ -0,0 +1,871 @@
+/**
+ * SPDX-License-Identifier: LGPL-2.1-only
+ *
+ * @file        benchmark_tensor_elements.c
+ * @date        19 Oct 2026
+ * @brief       Microbenchmarks of the core tensor elements.
+ * @see         https://github.com/nnstreamer/nnstreamer
+ * @author      agent <agent@local>
+ * @bug         No known bugs
+ *
+ * Each case runs a pipeline (appsrc ! element under test ! fakesink) and
+ * measures the time per output buffer in the streaming thread, after a few
+ * warm-up buffers. The inputs are filled with random values of a fixed seed
+ * for each case, so that the results are comparable between runs, whichever
+ * cases are selected.
+ *
+ * The options and the JSON output follow Google Benchmark, so its tools
+ * (e.g., compare.py) can be used to find regressions.
+ *   benchmark_tensor_elements --benchmark_filter=transform/arithmetic
+ *   benchmark_tensor_elements --benchmark_format=json --benchmark_out=result.json
+ */
+
+#include <gst/gst.h>
+#include <gst/app/gstappsrc.h>
+#include <glib/gstdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <nnstreamer_plugin_api.h>
+
+/**
+ * @brief The seed of the random input values, mixed with the hash of the case name.
+ */
+#define BENCH_SEED (20201019)
+
+/**
+ * @brief Default number of iterations (output buffers) and repetitions.
+ */
+#define BENCH_DEFAULT_ITERATIONS (100)
+#define BENCH_DEFAULT_REPETITIONS (3)
+
+/**
+ * @brief The number of output buffers before the measurement.
+ */
+#define BENCH_WARMUP (10)
+
+/**
+ * @brief The max number of input elements (appsrc) in a case.
+ */
+#define BENCH_MAX_INPUTS (2)
+
+/**
+ * @brief The timeout to wait for the end of stream.
+ */
+#define BENCH_TIMEOUT (120 * GST_SECOND)
+
+/**
+ * @brief The duration of an input buffer (30 fps).
+ */
+#define BENCH_DURATION (GST_SECOND / 30)
+
+/**
+ * @brief The sink element to measure the time. Other sinks in a case should not be named 'sink'.
+ */
+#define BENCH_SINK "fakesink name=sink sync=false"
+
+/**
+ * @brief Data structure for a memory of the input buffer.
+ */
+typedef struct
+{
+  tensor_type type; /**< the type of random values */
+  gsize size; /**< the size of memory */
+  gdouble min; /**< the min of random values */
+  gdouble max; /**< the max of random values */
+} bench_memory;
+
+/**
+ * @brief Data structure for an input element (appsrc named src_%u).
+ */
+typedef struct
+{
+  GstCaps *caps; /**< the caps of appsrc */
+  guint num_mems; /**< the number of memories in a buffer */
+  bench_memory mems[NNS_TENSOR_SIZE_LIMIT]; /**< the memories in a buffer */
+  GstBuffer *buffer; /**< the input buffer */
+} bench_input;
+
+/**
+ * @brief Data structure for a benchmark case.
+ */
+typedef struct
+{
+  gchar *name; /**< the name of case, element/mode/type/dimension */
+  gchar *launch; /**< the pipeline description */
+  guint num_inputs; /**< the number of input elements */
+  bench_input inputs[BENCH_MAX_INPUTS]; /**< the input elements */
+} bench_case;
+
+/**
+ * @brief Data structure for the measurement in the streaming thread.
+ */
+typedef struct
+{
+  guint count; /**< the number of output buffers */
+  gint64 start_real; /**< the monotonic time (usec) at the end of warm-up */
+  gint64 end_real; /**< the monotonic time (usec) of the last buffer */
+  gint64 start_cpu; /**< the cpu time (usec) at the end of warm-up */
+  gint64 end_cpu; /**< the cpu time (usec) of the last buffer */
+} bench_counter;
+
+/**
+ * @brief Data structure for the result of a run.
+ */
+typedef struct
+{
+  guint iterations; /**< the number of measured output buffers */
+  gdouble real_time; /**< the real time (nsec) per iteration */
+  gdouble cpu_time; /**< the cpu time (nsec) of the process per iteration */
+} bench_run;
+
+/**
+ * @brief Output formats.
+ */
+typedef enum
+{
+  BENCH_FORMAT_CONSOLE = 0,
+  BENCH_FORMAT_JSON,
+  BENCH_FORMAT_CSV
+} bench_format;
+
+static gchar *opt_filter = NULL;
+static gchar *opt_format = NULL;
+static gchar *opt_out = NULL;
+static gint opt_iterations = BENCH_DEFAULT_ITERATIONS;
+static gint opt_repetitions = BENCH_DEFAULT_REPETITIONS;
+static gboolean opt_list = FALSE;
+
+/**
+ * @brief Command line options, named after Google Benchmark.
+ */
+static GOptionEntry opt_entries[] = {
+  {"benchmark_filter", 0, 0, G_OPTION_ARG_STRING, &opt_filter,
+      "Run the cases whose name matches the regular expression", "REGEX"},
+  {"benchmark_format", 0, 0, G_OPTION_ARG_STRING, &opt_format,
+      "Output format of stdout (console, json, csv)", "FORMAT"},
+  {"benchmark_out", 0, 0, G_OPTION_ARG_FILENAME, &opt_out,
+      "Write the results in json to the file", "FILE"},
+  {"benchmark_min_iters", 0, 0, G_OPTION_ARG_INT, &opt_iterations,
+      "The number of output buffers to be measured", "N"},
+  {"benchmark_repetitions", 0, 0, G_OPTION_ARG_INT, &opt_repetitions,
+      "The number of runs of each case, the median is reported", "N"},
+  {"benchmark_list_tests", 0, 0, G_OPTION_ARG_NONE, &opt_list,
+      "List the cases and exit", NULL},
+  {NULL}
+};
+
+/**
+ * @brief Get the cpu time (usec) of the process.
+ */
+static gint64
+_get_cpu_time (void)
+{
+  struct rusage usage;
+
+  if (getrusage (RUSAGE_SELF, &usage) != 0)
+    return 0;
+
+  return (gint64) (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * G_USEC_PER_SEC
+      + usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+}
+
+/**
+ * @brief Fill the data with random values of the type.
+ */
+#define fill_random(type, rand, data, size, min, max) do { \
+    type *_d = (type *) (data); \
+    gsize _i, _n = (size) / sizeof (type); \
+    for (_i = 0; _i < _n; _i++) \
+      _d[_i] = (type) g_rand_double_range ((rand), (min), (max)); \
+  } while (0)
+
+/**
+ * @brief Create the input buffer filled with random values.
+ */
+static GstBuffer *
+_create_input_buffer (GRand * rand, const bench_input * input)
+{
+  GstBuffer *buffer = gst_buffer_new ();
+  GstMemory *mem;
+  GstMapInfo map;
+  const bench_memory *m;
+  guint i;
+
+  for (i = 0; i < input->num_mems; i++) {
+    m = &input->mems[i];
+    mem = gst_allocator_alloc (NULL, m->size, NULL);
+
+    if (!gst_memory_map (mem, &map, GST_MAP_WRITE))
+      g_error ("Failed to map the memory of input buffer.");
+
+    switch (m->type) {
+      case _NNS_INT32:
+        fill_random (gint32, rand, map.data, m->size, m->min, m->max);
+        break;
+      case _NNS_UINT32:
+        fill_random (guint32, rand, map.data, m->size, m->min, m->max);
+        break;
+      case _NNS_INT16:
+        fill_random (gint16, rand, map.data, m->size, m->min, m->max);
+        break;
+      case _NNS_UINT16:
+        fill_random (guint16, rand, map.data, m->size, m->min, m->max);
+        break;
+      case _NNS_INT8:
+        fill_random (gint8, rand, map.data, m->size, m->min, m->max);
+        break;
+      case _NNS_UINT8:
+        fill_random (guint8, rand, map.data, m->size, m->min, m->max);
+        break;
+      case _NNS_FLOAT64:
+        fill_random (gdouble, rand, map.data, m->size, m->min, m->max);
+        break;
+      case _NNS_FLOAT32:
+        fill_random (gfloat, rand, map.data, m->size, m->min, m->max);
+        break;
+      case _NNS_INT64:
+        fill_random (gint64, rand, map.data, m->size, m->min, m->max);
+        break;
+      case _NNS_UINT64:
+        fill_random (guint64, rand, map.data, m->size, m->min, m->max);
+        break;
+#ifdef FLOAT16_SUPPORT
+      case _NNS_FLOAT16:
+        fill_random (float16, rand, map.data, m->size, m->min, m->max);
+        break;
+#endif
+      default:
+        memset (map.data, 0, m->size);
+        break;
+    }
+
+    gst_memory_unmap (mem, &map);
+    gst_buffer_append_memory (buffer, mem);
+  }
+
+  return buffer;
+}
+
+/**
+ * @brief Create a case. The launch line should have the input elements (appsrc named src_%u) and the sink.
+ */
+static bench_case *
+_case_new (GPtrArray * cases, const gchar * name, const gchar * launch)
+{
+  bench_case *bc = g_new0 (bench_case, 1);
+
+  bc->name = g_strdup (name);
+  bc->launch = g_strdup (launch);
+  g_ptr_array_add (cases, bc);
+
+  return bc;
+}
+
+/**
+ * @brief Free the case.
+ */
+static void
+_case_free (gpointer data)
+{
+  bench_case *bc = (bench_case *) data;
+  guint i;
+
+  for (i = 0; i < bc->num_inputs; i++) {
+    gst_caps_unref (bc->inputs[i].caps);
+    if (bc->inputs[i].buffer)
+      gst_buffer_unref (bc->inputs[i].buffer);
+  }
+
+  g_free (bc->name);
+  g_free (bc->launch);
+  g_free (bc);
+}
+
+/**
+ * @brief Add the input of raw data (e.g., video) to the case.
+ */
+static void
+_case_add_raw_input (bench_case * bc, const gchar * caps, gsize size)
+{
+  bench_input *input;
+
+  g_assert (bc->num_inputs < BENCH_MAX_INPUTS);
+  input = &bc->inputs[bc->num_inputs++];
+
+  input->caps = gst_caps_from_string (caps);
+  input->num_mems = 1;
+  input->mems[0].type = _NNS_UINT8;
+  input->mems[0].size = size;
+  input->mems[0].min = 0;
+  input->mems[0].max = 255;
+}
+
+/**
+ * @brief Add the input of tensors to the case. The types and dimensions are separated by '.'.
+ */
+static void
+_case_add_tensors_input (bench_case * bc, const gchar * types,
+    const gchar * dims, gdouble min, gdouble max)
+{
+  GstTensorsConfig config;
+  bench_input *input;
+  guint i;
+
+  g_assert (bc->num_inputs < BENCH_MAX_INPUTS);
+  input = &bc->inputs[bc->num_inputs++];
+
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = gst_tensors_info_parse_types_string (&config.info, types);
+  gst_tensors_info_parse_dimensions_string (&config.info, dims);
+  config.rate_n = 30;
+  config.rate_d = 1;
+
+  input->caps = gst_tensors_caps_from_config (&config);
+  input->num_mems = config.info.num_tensors;
+
+  for (i = 0; i < config.info.num_tensors; i++) {
+    input->mems[i].type = config.info.info[i].type;
+    input->mems[i].size = gst_tensors_info_get_size (&config.info, i);
+    input->mems[i].min = min;
+    input->mems[i].max = max;
+  }
+
+  gst_tensors_info_free (&config.info);
+}
+
+/**
+ * @brief Set the value range of the memory in the input.
+ */
+static void
+_case_set_range (bench_case * bc, guint input, guint mem, gdouble min,
+    gdouble max)
+{
+  bc->inputs[input].mems[mem].min = min;
+  bc->inputs[input].mems[mem].max = max;
+}
+
+/**
+ * @brief Add the cases of tensor_converter.
+ */
+static void
+_add_converter_cases (GPtrArray * cases)
+{
+  const guint sizes[][2] = { {224, 224}, {640, 480} };
+  bench_case *bc;
+  gchar *name, *caps;
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (sizes); i++) {
+    name = g_strdup_printf ("converter/video/RGB/%ux%u", sizes[i][0], sizes[i][1]);
+    caps = g_strdup_printf ("video/x-raw,format=RGB,width=%u,height=%u,framerate=30/1",
+        sizes[i][0], sizes[i][1]);
+
+    bc = _case_new (cases, name,
+        "appsrc name=src_0 ! tensor_converter ! " BENCH_SINK);
+    _case_add_raw_input (bc, caps, sizes[i][0] * sizes[i][1] * 3);
+
+    g_free (name);
+    g_free (caps);
+  }
+}
+
+/**
+ * @brief Add the cases of tensor_transform.
+ */
+static void
+_add_transform_cases (GPtrArray * cases)
+{
+  const gchar *types[] = { "uint8", "int16", "int32", "float32", "float64" };
+  const gchar *dims[] = { "3:224:224:1", "3:640:480:1" };
+  const gchar *accel[] = { "false", "true" };
+  const struct
+  {
+    const gchar *name;
+    const gchar *option;
+    const gchar *type;
+  } modes[] = {
+    {"typecast", "mode=typecast option=float32", "uint8"},
+    {"transpose", "mode=transpose option=1:2:0:3", "uint8"},
+    {"transpose", "mode=transpose option=1:2:0:3", "float32"},
+    {"dimchg", "mode=dimchg option=0:2", "uint8"},
+    {"stand", "mode=stand option=default", "float32"},
+    {"clamp", "mode=clamp option=32:224", "float32"},
+    {"quantize", "mode=quantize option=uint8,scale:0.5,zero-point:0", "float32"},
+    {"dequantize", "mode=dequantize option=float32,scale:0.5,zero-point:128",
+        "uint8"},
+#ifdef FLOAT16_SUPPORT
+    {"typecast", "mode=typecast option=float16", "float32"},
+    {"typecast", "mode=typecast option=float32", "float16"},
+    {"arithmetic", "mode=arithmetic option=add:-127.5,div:127.5", "float16"},
+    {"stand", "mode=stand option=default", "float16"},
+    {"clamp", "mode=clamp option=32:224", "float16"},
+#endif
+  };
+  bench_case *bc;
+  gchar *name, *launch;
+  guint i, j, k;
+
+  /* the normalization, a hot path of pre-processing */
+  for (k = 0; k < G_N_ELEMENTS (accel); k++) {
+    for (i = 0; i < G_N_ELEMENTS (types); i++) {
+      for (j = 0; j < G_N_ELEMENTS (dims); j++) {
+        name = g_strdup_printf ("transform/arithmetic%s/%s/%s",
+            (k == 0) ? "" : "-accel", types[i], dims[j]);
+        launch = g_strdup_printf ("appsrc name=src_0 ! tensor_transform "
+            "mode=arithmetic option=typecast:float32,add:-127.5,div:127.5 "
+            "acceleration=%s ! " BENCH_SINK, accel[k]);
+
+        bc = _case_new (cases, name, launch);
+        _case_add_tensors_input (bc, types[i], dims[j], 0, 255);
+
+        g_free (name);
+        g_free (launch);
+      }
+    }
+  }
+
+  for (i = 0; i < G_N_ELEMENTS (modes); i++) {
+    name = g_strdup_printf ("transform/%s/%s/%s", modes[i].name,
+        modes[i].type, dims[0]);
+    launch = g_strdup_printf ("appsrc name=src_0 ! tensor_transform %s "
+        "acceleration=false ! " BENCH_SINK, modes[i].option);
+
+    bc = _case_new (cases, name, launch);
+    _case_add_tensors_input (bc, modes[i].type, dims[0], 0, 255);
+
+    g_free (name);
+    g_free (launch);
+  }
+}
+
+/**
+ * @brief Add the cases of tensor_merge, tensor_split and tensor_aggregator.
+ */
+static void
+_add_stream_cases (GPtrArray * cases)
+{
+  bench_case *bc;
+
+  bc = _case_new (cases, "merge/linear/uint8/3:224:224:1",
+      "tensor_merge name=merge mode=linear option=2 ! " BENCH_SINK " "
+      "appsrc name=src_0 ! merge.sink_0 appsrc name=src_1 ! merge.sink_1");
+  _case_add_tensors_input (bc, "uint8", "3:224:224:1", 0, 255);
+  _case_add_tensors_input (bc, "uint8", "3:224:224:1", 0, 255);
+
+  bc = _case_new (cases, "split/uint8/3:224:224:1",
+      "appsrc name=src_0 ! tensor_split name=split "
+      "tensorseg=1:224:224:1,2:224:224:1 "
+      "split.src_0 ! " BENCH_SINK " split.src_1 ! fakesink sync=false");
+  _case_add_tensors_input (bc, "uint8", "3:224:224:1", 0, 255);
+
+  bc = _case_new (cases, "aggregator/uint8/3:224:224:1",
+      "appsrc name=src_0 ! tensor_aggregator frames-in=1 frames-out=4 "
+      "frames-flush=1 frames-dim=3 ! " BENCH_SINK);
+  _case_add_tensors_input (bc, "uint8", "3:224:224:1", 0, 255);
+}
+
+/**
+ * @brief Add the cases of tensor_decoder.
+ */
+static void
+_add_decoder_cases (GPtrArray * cases, const gchar * root_path)
+{
+  bench_case *bc;
+  gchar *labels, *priors, *launch;
+
+  bc = _case_new (cases, "decoder/direct_video/uint8/3:640:480:1",
+      "appsrc name=src_0 ! tensor_decoder mode=direct_video ! " BENCH_SINK);
+  _case_add_tensors_input (bc, "uint8", "3:640:480:1", 0, 255);
+
+  bc = _case_new (cases, "decoder/image_segment/float32/21:257:257:1",
+      "appsrc name=src_0 ! tensor_decoder mode=image_segment "
+      "option1=tflite-deeplab ! " BENCH_SINK);
+  _case_add_tensors_input (bc, "float32", "21:257:257:1", -5.0, 5.0);
+
+  /* bounding boxes with nms, requires the labels and box priors */
+  labels = g_build_filename (root_path, "tests", "nnstreamer_decoder_boundingbox",
+      "coco_labels_list.txt", NULL);
+  priors = g_build_filename (root_path, "tests", "nnstreamer_decoder_boundingbox",
+      "box_priors.txt", NULL);
+
+  if (g_file_test (labels, G_FILE_TEST_IS_REGULAR) &&
+      g_file_test (priors, G_FILE_TEST_IS_REGULAR)) {
+    launch = g_strdup_printf ("appsrc name=src_0 ! tensor_decoder "
+        "mode=bounding_boxes option1=mobilenet-ssd option2=%s option3=%s "
+        "option4=640:480 option5=300:300 ! " BENCH_SINK, labels, priors);
+
+    bc = _case_new (cases,
+        "decoder/bounding_boxes/mobilenet-ssd/float32/4:1:1917:1.91:1917:1",
+        launch);
+    _case_add_tensors_input (bc, "float32.float32", "4:1:1917:1.91:1917:1",
+        -1.0, 1.0);
+    /* about 2% of the scores exceed the threshold, to be filtered by nms */
+    _case_set_range (bc, 0, 1, -24.0, 0.5);
+
+    g_free (launch);
+  } else {
+    g_printerr ("Cannot find the test data of bounding_boxes, "
+        "set NNSTREAMER_SOURCE_ROOT_PATH to run the case.\n");
+  }
+
+  g_free (labels);
+  g_free (priors);
+}
+
+/**
+ * @brief Handoff callback of the sink, called in the streaming thread.
+ */
+static void
+_handoff_cb (GstElement * sink, GstBuffer * buffer, GstPad * pad,
+    gpointer user_data)
+{
+  bench_counter *counter = (bench_counter *) user_data;
+  gint64 now = g_get_monotonic_time ();
+  gint64 cpu = _get_cpu_time ();
+
+  counter->count++;
+
+  if (counter->count == BENCH_WARMUP) {
+    counter->start_real = now;
+    counter->start_cpu = cpu;
+  }
+
+  counter->end_real = now;
+  counter->end_cpu = cpu;
+}
+
+/**
+ * @brief Run the case once.
+ * @return TRUE if the case is done without error.
+ */
+static gboolean
+_run_case (bench_case * bc, guint iterations, bench_run * run)
+{
+  GstElement *pipeline, *sink;
+  GstElement *src[BENCH_MAX_INPUTS] = { NULL, };
+  GstBuffer *buffer;
+  GstBus *bus;
+  GstMessage *msg;
+  GError *err = NULL;
+  bench_counter counter = { 0, };
+  gboolean ret = FALSE;
+  gchar *name;
+  guint i, n;
+
+  pipeline = gst_parse_launch (bc->launch, &err);
+  if (!pipeline || err) {
+    g_printerr ("%s: failed to launch the pipeline (%s)\n", bc->name,
+        err ? err->message : "unknown reason");
+    g_clear_error (&err);
+    if (pipeline)
+      gst_object_unref (pipeline);
+    return FALSE;
+  }
+
+  sink = gst_bin_get_by_name (GST_BIN (pipeline), "sink");
+  g_assert (sink != NULL);
+  g_object_set (sink, "signal-handoffs", TRUE, NULL);
+  g_signal_connect (sink, "handoff", G_CALLBACK (_handoff_cb), &counter);
+
+  for (i = 0; i < bc->num_inputs; i++) {
+    name = g_strdup_printf ("src_%u", i);
+    src[i] = gst_bin_get_by_name (GST_BIN (pipeline), name);
+    g_free (name);
+    g_assert (src[i] != NULL);
+
+    /* do not queue too many buffers, to measure the element in a steady state */
+    g_object_set (src[i], "caps", bc->inputs[i].caps, "format", GST_FORMAT_TIME,
+        "block", TRUE, "max-bytes",
+        (guint64) gst_buffer_get_size (bc->inputs[i].buffer) * 4, NULL);
+  }
+
+  if (gst_element_set_state (pipeline, GST_STATE_PLAYING) ==
+      GST_STATE_CHANGE_FAILURE) {
+    g_printerr ("%s: failed to start the pipeline\n", bc->name);
+    goto done;
+  }
+
+  for (n = 0; n < BENCH_WARMUP + iterations; n++) {
+    for (i = 0; i < bc->num_inputs; i++) {
+      /* share the memories of the input buffer */
+      buffer = gst_buffer_copy (bc->inputs[i].buffer);
+      GST_BUFFER_PTS (buffer) = n * BENCH_DURATION;
+      GST_BUFFER_DURATION (buffer) = BENCH_DURATION;
+
+      if (gst_app_src_push_buffer (GST_APP_SRC (src[i]), buffer) != GST_FLOW_OK) {
+        g_printerr ("%s: failed to push the buffer\n", bc->name);
+        goto done;
+      }
+    }
+  }
+
+  for (i = 0; i < bc->num_inputs; i++)
+    gst_app_src_end_of_stream (GST_APP_SRC (src[i]));
+
+  bus = gst_element_get_bus (pipeline);
+  msg = gst_bus_timed_pop_filtered (bus, BENCH_TIMEOUT,
+      GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+  gst_object_unref (bus);
+
+  if (!msg || GST_MESSAGE_TYPE (msg) != GST_MESSAGE_EOS) {
+    if (msg && GST_MESSAGE_TYPE (msg) == GST_MESSAGE_ERROR) {
+      gst_message_parse_error (msg, &err, NULL);
+      g_printerr ("%s: %s\n", bc->name, err->message);
+      g_clear_error (&err);
+    } else {
+      g_printerr ("%s: timeout\n", bc->name);
+    }
+  } else if (counter.count <= BENCH_WARMUP) {
+    g_printerr ("%s: not enough output buffers (%u)\n", bc->name, counter.count);
+  } else {
+    run->iterations = counter.count - BENCH_WARMUP;
+    run->real_time = (gdouble) (counter.end_real - counter.start_real) * 1000.0
+        / run->iterations;
+    run->cpu_time = (gdouble) (counter.end_cpu - counter.start_cpu) * 1000.0
+        / run->iterations;
+    ret = TRUE;
+  }
+
+  if (msg)
+    gst_message_unref (msg);
+
+done:
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+
+  for (i = 0; i < bc->num_inputs; i++)
+    gst_object_unref (src[i]);
+  gst_object_unref (sink);
+  gst_object_unref (pipeline);
+
+  return ret;
+}
+
+/**
+ * @brief Compare the runs with the real time.
+ */
+static gint
+_compare_run (gconstpointer a, gconstpointer b)
+{
+  const bench_run *ra = (const bench_run *) a;
+  const bench_run *rb = (const bench_run *) b;
+
+  if (ra->real_time < rb->real_time)
+    return -1;
+  return (ra->real_time > rb->real_time) ? 1 : 0;
+}
+
+/**
+ * @brief Get the size of input buffers per iteration.
+ */
+static gsize
+_get_input_size (const bench_case * bc)
+{
+  gsize size = 0;
+  guint i;
+
+  for (i = 0; i < bc->num_inputs; i++)
+    size += gst_buffer_get_size (bc->inputs[i].buffer);
+
+  return size;
+}
+
+/**
+ * @brief Append the result in json.
+ */
+static void
+_append_json (GString * json, const bench_case * bc, const bench_run * run,
+    guint repetitions, gboolean first)
+{
+  gdouble sec = run->real_time / 1e9;
+
+  g_string_append_printf (json, "%s    {\n"
+      "      \"name\": \"%s\",\n"
+      "      \"run_name\": \"%s\",\n"
+      "      \"run_type\": \"iteration\",\n"
+      "      \"repetitions\": %u,\n"
+      "      \"iterations\": %u,\n"
+      "      \"real_time\": %.2f,\n"
+      "      \"cpu_time\": %.2f,\n"
+      "      \"time_unit\": \"ns\",\n"
+      "      \"bytes_per_second\": %.2f,\n"
+      "      \"items_per_second\": %.2f\n"
+      "    }", first ? "" : ",\n", bc->name, bc->name, repetitions,
+      run->iterations, run->real_time, run->cpu_time,
+      (sec > 0) ? _get_input_size (bc) / sec : 0, (sec > 0) ? 1.0 / sec : 0);
+}
+
+/**
+ * @brief Get the context of the benchmark in json.
+ */
+static void
+_append_json_context (GString * json, const gchar * prog, guint iterations,
+    guint repetitions)
+{
+  GDateTime *now = g_date_time_new_now_local ();
+  gchar *date = g_date_time_format (now, "%Y-%m-%dT%H:%M:%S%z");
+
+  g_string_append_printf (json, "{\n"
+      "  \"context\": {\n"
+      "    \"date\": \"%s\",\n"
+      "    \"host_name\": \"%s\",\n"
+      "    \"executable\": \"%s\",\n"
+      "    \"num_cpus\": %u,\n"
+      "    \"library_version\": \"%s\",\n"
+      "    \"seed\": %u,\n"
+      "    \"warmup\": %u,\n"
+      "    \"iterations\": %u,\n"
+      "    \"repetitions\": %u\n"
+      "  },\n"
+      "  \"benchmarks\": [\n", date, g_get_host_name (), prog,
+      g_get_num_processors (), gst_version_string (), BENCH_SEED,
+      BENCH_WARMUP, iterations, repetitions);
+
+  g_free (date);
+  g_date_time_unref (now);
+}
+
+/**
+ * @brief Main routine of the benchmark.
+ */
+int
+main (int argc, char **argv)
+{
+  GOptionContext *ctx;
+  GError *err = NULL;
+  GPtrArray *cases;
+  GRegex *filter = NULL;
+  GRand *rand;
+  GString *json;
+  bench_format format = BENCH_FORMAT_CONSOLE;
+  bench_run *runs, result;
+  const gchar *root_path;
+  guint c, i, r, iterations, repetitions, done = 0;
+  gint status = 0;
+
+  ctx = g_option_context_new ("- microbenchmarks of the core tensor elements");
+  g_option_context_add_main_entries (ctx, opt_entries, NULL);
+  g_option_context_add_group (ctx, gst_init_get_option_group ());
+
+  if (!g_option_context_parse (ctx, &argc, &argv, &err)) {
+    g_printerr ("Failed to parse the options: %s\n", err->message);
+    g_clear_error (&err);
+    g_option_context_free (ctx);
+    return 1;
+  }
+  g_option_context_free (ctx);
+
+  if (opt_format) {
+    if (g_ascii_strcasecmp (opt_format, "json") == 0)
+      format = BENCH_FORMAT_JSON;
+    else if (g_ascii_strcasecmp (opt_format, "csv") == 0)
+      format = BENCH_FORMAT_CSV;
+    else if (g_ascii_strcasecmp (opt_format, "console") != 0) {
+      g_printerr ("Invalid format: %s\n", opt_format);
+      return 1;
+    }
+  }
+
+  if (opt_filter) {
+    filter = g_regex_new (opt_filter, 0, 0, &err);
+    if (!filter) {
+      g_printerr ("Invalid filter: %s\n", err->message);
+      g_clear_error (&err);
+      return 1;
+    }
+  }
+
+  iterations = (guint) MAX (opt_iterations, 1);
+  repetitions = (guint) MAX (opt_repetitions, 1);
+
+  root_path = g_getenv ("NNSTREAMER_SOURCE_ROOT_PATH");
+  if (!root_path)
+    root_path = ".";
+
+  cases = g_ptr_array_new_with_free_func (_case_free);
+  _add_converter_cases (cases);
+  _add_transform_cases (cases);
+  _add_stream_cases (cases);
+  _add_decoder_cases (cases, root_path);
+
+  json = g_string_new (NULL);
+  _append_json_context (json, argv[0], iterations, repetitions);
+
+  if (format == BENCH_FORMAT_CSV)
+    g_print ("name,iterations,real_time,cpu_time,time_unit,"
+        "bytes_per_second,items_per_second\n");
+
+  runs = g_new0 (bench_run, repetitions);
+
+  for (c = 0; c < cases->len; c++) {
+    bench_case *bc = (bench_case *) g_ptr_array_index (cases, c);
+    gboolean failed = FALSE;
+
+    if (filter && !g_regex_match (filter, bc->name, 0, NULL))
+      continue;
+
+    if (opt_list) {
+      g_print ("%s\n", bc->name);
+      continue;
+    }
+
+    /* the inputs of a case do not depend on the other cases selected */
+    rand = g_rand_new_with_seed (BENCH_SEED ^ g_str_hash (bc->name));
+    for (i = 0; i < bc->num_inputs; i++)
+      bc->inputs[i].buffer = _create_input_buffer (rand, &bc->inputs[i]);
+    g_rand_free (rand);
+
+    for (r = 0; r < repetitions && !failed; r++)
+      failed = !_run_case (bc, iterations, &runs[r]);
+
+    if (failed) {
+      status = 1;
+      continue;
+    }
+
+    /* report the median of the repetitions */
+    qsort (runs, repetitions, sizeof (bench_run), _compare_run);
+    result = runs[repetitions / 2];
+
+    switch (format) {
+      case BENCH_FORMAT_JSON:
+        /* printed at the end */
+        break;
+      case BENCH_FORMAT_CSV:
+        g_print ("\"%s\",%u,%.2f,%.2f,ns,%.2f,%.2f\n", bc->name,
+            result.iterations, result.real_time, result.cpu_time,
+            _get_input_size (bc) / (result.real_time / 1e9),
+            1e9 / result.real_time);
+        break;
+      default:
+        g_print ("%-64s %12.0f ns %12.0f ns %6u %10.2f MB/s\n", bc->name,
+            result.real_time, result.cpu_time, result.iterations,
+            _get_input_size (bc) / (result.real_time / 1e9) / (1024 * 1024));
+        break;
+    }
+
+    _append_json (json, bc, &result, repetitions, done == 0);
+    done++;
+  }
+
+  g_string_append (json, "\n  ]\n}\n");
+
+  if (!opt_list) {
+    if (format == BENCH_FORMAT_JSON)
+      g_print ("%s", json->str);
+
+    if (opt_out && !g_file_set_contents (opt_out, json->str, -1, &err)) {
+      g_printerr ("Failed to write %s: %s\n", opt_out, err->message);
+      g_clear_error (&err);
+      status = 1;
+    }
+  }
+
+  g_free (runs);
+  g_string_free (json, TRUE);
+  g_ptr_array_free (cases, TRUE);
+  if (filter)
+    g_regex_unref (filter);
+
+  return status;
+}
@@ -346,6 +346,412 @@ TEST (tensorDecoder, subpluginNullDesc_n)
   free_default_decoder (sub);
 }
 
+/**
+ * @brief Dummy function decoding the input memory blocks.
+ */
+static GstFlowReturn
+test_decode_memory (void **private_data, const GstTensorsConfig *config,
+    GstMemory **input, GstBuffer *outbuf)
+{
+  return GST_TENSOR_DECODER_FALLBACK;
+}
+
+/**
+ * @brief Test for registering the function decoding the input memory blocks
+ */
+TEST (tensorDecoder, setDecodeMemory)
+{
+  GstTensorDecoderDef *sub = get_default_decoder ("mode");
+
+  /* the sub-plugin is not registered */
+  EXPECT_FALSE (nnstreamer_decoder_set_decode_memory ("mode", test_decode_memory));
+  EXPECT_TRUE (nnstreamer_decoder_get_decode_memory ("mode") == NULL);
+
+  EXPECT_TRUE (nnstreamer_decoder_probe (sub));
+  EXPECT_TRUE (nnstreamer_decoder_get_decode_memory ("mode") == NULL);
+  EXPECT_TRUE (nnstreamer_decoder_set_decode_memory ("mode", test_decode_memory));
+  EXPECT_TRUE (nnstreamer_decoder_get_decode_memory ("mode") == test_decode_memory);
+
+  /* unregistered with the sub-plugin */
+  nnstreamer_decoder_exit ("mode");
+  EXPECT_TRUE (nnstreamer_decoder_get_decode_memory ("mode") == NULL);
+  free_default_decoder (sub);
+}
+
+/**
+ * @brief Test for direct_video decoding the input memory without copying
+ */
+TEST (tensorDecoder, decodeMemoryDirectVideo)
+{
+  const GstTensorDecoderDef *dv = nnstreamer_decoder_find ("direct_video");
+  GstTensorDecoderDecodeMemory decode_memory;
+  GstTensorsConfig config;
+  GstMemory *in_mem, *out_mem;
+  GstMapInfo in_map, out_map;
+  GstBuffer *outbuf;
+  void *pdata = NULL;
+
+  ASSERT_TRUE (dv != NULL);
+  decode_memory = nnstreamer_decoder_get_decode_memory ("direct_video");
+  ASSERT_TRUE (decode_memory != NULL);
+  ASSERT_TRUE (dv->init (&pdata));
+
+  gst_tensors_config_init (&config);
+  config.rate_n = 0;
+  config.rate_d = 1;
+  config.info.num_tensors = 1;
+  config.info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("3:320:240:1", config.info.info[0].dimension);
+
+  in_mem = gst_allocator_alloc (NULL, 3 * 320 * 240, NULL);
+  outbuf = gst_buffer_new ();
+
+  /* no padding, the output has the same memory */
+  EXPECT_EQ (GST_FLOW_OK, decode_memory (&pdata, &config, &in_mem, outbuf));
+  ASSERT_EQ (gst_buffer_n_memory (outbuf), 1U);
+  out_mem = gst_buffer_peek_memory (outbuf, 0);
+
+  ASSERT_TRUE (gst_memory_map (in_mem, &in_map, GST_MAP_READ));
+  ASSERT_TRUE (gst_memory_map (out_mem, &out_map, GST_MAP_READ));
+  EXPECT_EQ (in_map.data, out_map.data);
+  EXPECT_EQ (in_map.size, out_map.size);
+  gst_memory_unmap (out_mem, &out_map);
+  gst_memory_unmap (in_mem, &in_map);
+
+  gst_buffer_unref (outbuf);
+
+  /* the output buffer is already allocated (e.g., from downstream pool), fall back to decode */
+  outbuf = gst_buffer_new_allocate (NULL, 3 * 320 * 240, NULL);
+
+  EXPECT_EQ (GST_TENSOR_DECODER_FALLBACK,
+      decode_memory (&pdata, &config, &in_mem, outbuf));
+  EXPECT_EQ (gst_buffer_n_memory (outbuf), 1U);
+  EXPECT_EQ (gst_buffer_get_size (outbuf), 3U * 320 * 240);
+
+  gst_buffer_unref (outbuf);
+  gst_memory_unref (in_mem);
+
+  /* the rows need padding, fall back to decode */
+  gst_tensor_parse_dimension ("3:321:240:1", config.info.info[0].dimension);
+  in_mem = gst_allocator_alloc (NULL, 3 * 321 * 240, NULL);
+  outbuf = gst_buffer_new ();
+
+  EXPECT_EQ (GST_TENSOR_DECODER_FALLBACK,
+      decode_memory (&pdata, &config, &in_mem, outbuf));
+  EXPECT_EQ (gst_buffer_n_memory (outbuf), 0U);
+
+  gst_buffer_unref (outbuf);
+  gst_memory_unref (in_mem);
+  dv->exit (&pdata);
+}
+
+/**
+ * @brief Test for direct_video decoding without copying, when downstream proposes the buffer pool.
+ */
+TEST (tensorDecoder, decodeMemoryDirectVideoPool)
+{
+  gchar *content1 = NULL;
+  gchar *content2 = NULL;
+  gsize len1, len2;
+  char *tmp_video = getTempFilename ();
+  char *tmp_decoded = getTempFilename ();
+  const gsize frame_size = 320 * 240 * 4;
+
+  EXPECT_NE (tmp_video, nullptr);
+  EXPECT_NE (tmp_decoded, nullptr);
+
+  /* videoconvert converts RGB to BGRx, with the buffer pool proposed to tensor_decoder */
+  gchar *str_pipeline = g_strdup_printf (
+      "videotestsrc num-buffers=1 pattern=12 ! videoconvert ! videoscale ! "
+      "video/x-raw,format=RGB,width=320,height=240 ! tee name=t "
+      "t. ! queue ! videoconvert ! video/x-raw,format=BGRx ! filesink location=%s buffer-mode=unbuffered sync=false async=false "
+      "t. ! queue ! tensor_converter ! tensor_decoder mode=direct_video ! videoconvert ! video/x-raw,format=BGRx ! "
+      "filesink location=%s buffer-mode=unbuffered sync=false async=false ",
+      tmp_video, tmp_decoded);
+
+  GstElement *pipeline = gst_parse_launch (str_pipeline, NULL);
+  EXPECT_NE (pipeline, nullptr);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  g_usleep (1000000);
+
+  _wait_pipeline_save_files (tmp_video, content1, len1, frame_size, TEST_TIMEOUT_MS);
+  _wait_pipeline_save_files (tmp_decoded, content2, len2, frame_size, TEST_TIMEOUT_MS);
+  EXPECT_EQ (len1, frame_size);
+  EXPECT_EQ (len2, frame_size);
+  if (len1 == len2)
+    EXPECT_EQ (memcmp (content1, content2, len1), 0);
+  g_free (content1);
+  g_free (content2);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  g_usleep (100000);
+
+  gst_object_unref (pipeline);
+  g_free (str_pipeline);
+  g_remove (tmp_video);
+  g_remove (tmp_decoded);
+  g_free (tmp_video);
+  g_free (tmp_decoded);
+}
+
+/**
+ * @brief Test for octet_stream decoding the input memory without copying
+ */
+TEST (tensorDecoder, decodeMemoryOctetStream)
+{
+  const GstTensorDecoderDef *os = nnstreamer_decoder_find ("octet_stream");
+  GstTensorDecoderDecodeMemory decode_memory;
+  GstTensorsConfig config;
+  GstMemory *in_mem[2];
+  GstMapInfo in_map, out_map;
+  GstBuffer *outbuf;
+  void *pdata = NULL;
+  guint i;
+
+  ASSERT_TRUE (os != NULL);
+  decode_memory = nnstreamer_decoder_get_decode_memory ("octet_stream");
+  ASSERT_TRUE (decode_memory != NULL);
+  ASSERT_TRUE (os->init (&pdata));
+
+  gst_tensors_config_init (&config);
+  config.rate_n = 0;
+  config.rate_d = 1;
+  config.info.num_tensors = 2;
+  config.info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("10:1:1:1", config.info.info[0].dimension);
+  config.info.info[1].type = _NNS_FLOAT32;
+  gst_tensor_parse_dimension ("5:1:1:1", config.info.info[1].dimension);
+
+  in_mem[0] = gst_allocator_alloc (NULL, 10, NULL);
+  in_mem[1] = gst_allocator_alloc (NULL, 5 * sizeof (float), NULL);
+  outbuf = gst_buffer_new ();
+
+  EXPECT_EQ (GST_FLOW_OK, decode_memory (&pdata, &config, in_mem, outbuf));
+  ASSERT_EQ (gst_buffer_n_memory (outbuf), 2U);
+
+  for (i = 0; i < 2; i++) {
+    GstMemory *out_mem = gst_buffer_peek_memory (outbuf, i);
+
+    ASSERT_TRUE (gst_memory_map (in_mem[i], &in_map, GST_MAP_READ));
+    ASSERT_TRUE (gst_memory_map (out_mem, &out_map, GST_MAP_READ));
+    EXPECT_EQ (in_map.data, out_map.data);
+    EXPECT_EQ (in_map.size, out_map.size);
+    gst_memory_unmap (out_mem, &out_map);
+    gst_memory_unmap (in_mem[i], &in_map);
+  }
+
+  gst_buffer_unref (outbuf);
+
+  /* invalid size of the input memory */
+  gst_tensor_parse_dimension ("20:1:1:1", config.info.info[0].dimension);
+  outbuf = gst_buffer_new ();
+
+  EXPECT_EQ (GST_FLOW_ERROR, decode_memory (&pdata, &config, in_mem, outbuf));
+  EXPECT_EQ (gst_buffer_n_memory (outbuf), 0U);
+
+  gst_buffer_unref (outbuf);
+  for (i = 0; i < 2; i++)
+    gst_memory_unref (in_mem[i]);
+  os->exit (&pdata);
+}
+
+/**
+ * @brief Reference of image_segment (tflite-deeplab), the scalar argmax and palette lookup.
+ */
+static void
+_image_segment_reference (const float *prob, guint labels, guint num_pixels, uint32_t *out)
+{
+  const guint modifier = 0xFFFFFF / labels;
+  guint i, l, max_idx;
+  float max_prob;
+
+  for (i = 0; i < num_pixels; i++) {
+    max_idx = 0;
+    max_prob = prob[i * labels];
+    for (l = 1; l < labels; l++) {
+      if (prob[i * labels + l] > max_prob) {
+        max_prob = prob[i * labels + l];
+        max_idx = l;
+      }
+    }
+
+    if (max_prob <= 0.5f || max_idx == 0)
+      out[i] = 0;
+    else
+      out[i] = (modifier * max_idx) | 0xFF000000;
+  }
+}
+
+/**
+ * @brief Test for image_segment, the output of each kernel should be the same with the scalar path.
+ * @note The kernels are forced by NNSTREAMER_IMAGE_SEGMENT_KERNEL, which the decoder reads in the test build only.
+ */
+TEST (tensorDecoder, imageSegmentBitExact)
+{
+  const GstTensorDecoderDef *is = nnstreamer_decoder_find ("image_segment");
+  const guint labels = 21, width = 67, height = 70;
+  const guint num_pixels = width * height;
+  const gchar *threads[] = { "1", "4" };
+  const gchar *kernels[] = { NULL, "scalar", "sse2", "avx2", "neon" };
+  gchar *kernel_env = g_strdup (g_getenv ("NNSTREAMER_IMAGE_SEGMENT_KERNEL"));
+  GstTensorsConfig config;
+  GstTensorMemory input;
+  GstMapInfo map;
+  GstBuffer *outbuf;
+  GstCaps *caps;
+  GRand *rand;
+  uint32_t *expected;
+  float *prob;
+  void *pdata = NULL;
+  guint i, k, t;
+
+  ASSERT_TRUE (is != NULL);
+
+  gst_tensors_config_init (&config);
+  config.rate_n = 0;
+  config.rate_d = 1;
+  config.info.num_tensors = 1;
+  config.info.info[0].type = _NNS_FLOAT32;
+  config.info.info[0].dimension[0] = labels;
+  config.info.info[0].dimension[1] = width;
+  config.info.info[0].dimension[2] = height;
+  config.info.info[0].dimension[3] = 1;
+
+  /* probabilities with ties, to check the first label is selected */
+  prob = g_new (float, num_pixels * labels);
+  rand = g_rand_new_with_seed (20261019U);
+  for (i = 0; i < num_pixels * labels; i++)
+    prob[i] = (float) (g_rand_int_range (rand, 0, 9)) / 8.0f;
+  g_rand_free (rand);
+
+  expected = g_new (uint32_t, num_pixels);
+  _image_segment_reference (prob, labels, num_pixels, expected);
+
+  input.data = prob;
+  input.size = num_pixels * labels * sizeof (float);
+
+  for (k = 0; k < G_N_ELEMENTS (kernels); k++) {
+#if defined(__x86_64__) || defined(__i386__)
+    if (g_strcmp0 (kernels[k], "neon") == 0)
+      continue;
+    __builtin_cpu_init ();
+    if (g_strcmp0 (kernels[k], "sse2") == 0 && !__builtin_cpu_supports ("sse2"))
+      continue;
+    if (g_strcmp0 (kernels[k], "avx2") == 0 && !__builtin_cpu_supports ("avx2"))
+      continue;
+#elif defined(__aarch64__)
+    if (g_strcmp0 (kernels[k], "sse2") == 0 || g_strcmp0 (kernels[k], "avx2") == 0)
+      continue;
+#else
+    if (kernels[k] != NULL && g_strcmp0 (kernels[k], "scalar") != 0)
+      continue;
+#endif
+
+    /* the kernels are selected when initializing the decoder */
+    if (kernels[k])
+      g_setenv ("NNSTREAMER_IMAGE_SEGMENT_KERNEL", kernels[k], TRUE);
+    else
+      g_unsetenv ("NNSTREAMER_IMAGE_SEGMENT_KERNEL");
+
+    for (t = 0; t < G_N_ELEMENTS (threads); t++) {
+      ASSERT_TRUE (is->init (&pdata));
+      EXPECT_TRUE (is->setOption (&pdata, 0, "tflite-deeplab"));
+      EXPECT_TRUE (is->setOption (&pdata, 2, threads[t]));
+
+      caps = is->getOutCaps (&pdata, &config);
+      ASSERT_TRUE (caps != NULL);
+      gst_caps_unref (caps);
+
+      outbuf = gst_buffer_new ();
+      EXPECT_EQ (GST_FLOW_OK, is->decode (&pdata, &config, &input, outbuf));
+
+      ASSERT_TRUE (gst_buffer_map (outbuf, &map, GST_MAP_READ));
+      ASSERT_EQ (map.size, num_pixels * sizeof (uint32_t));
+      EXPECT_EQ (0, memcmp (map.data, expected, map.size))
+          << "kernel " << (kernels[k] ? kernels[k] : "auto") << ", threads " << threads[t];
+      gst_buffer_unmap (outbuf, &map);
+
+      gst_buffer_unref (outbuf);
+      is->exit (&pdata);
+    }
+  }
+
+  if (kernel_env)
+    g_setenv ("NNSTREAMER_IMAGE_SEGMENT_KERNEL", kernel_env, TRUE);
+  else
+    g_unsetenv ("NNSTREAMER_IMAGE_SEGMENT_KERNEL");
+
+  g_free (kernel_env);
+  g_free (expected);
+  g_free (prob);
+}
+
+/**
+ * @brief Test for pose_estimation, the recycled output memory should be cleared.
+ */
+TEST (tensorDecoder, poseRecycledOutput)
+{
+  const GstTensorDecoderDef *pose = nnstreamer_decoder_find ("pose_estimation");
+  const guint labels = 14, grid = 8, width = 64, height = 64;
+  GstTensorsConfig config;
+  GstTensorMemory input;
+  GstMapInfo map;
+  GstBuffer *outbuf;
+  float *heatmap;
+  void *pdata = NULL;
+  gsize i, nonzero;
+
+  ASSERT_TRUE (pose != NULL);
+  ASSERT_TRUE (pose->init (&pdata));
+  EXPECT_TRUE (pose->setOption (&pdata, 0, "64:64"));
+  EXPECT_TRUE (pose->setOption (&pdata, 1, "8:8"));
+
+  gst_tensors_config_init (&config);
+  config.rate_n = 0;
+  config.rate_d = 1;
+  config.info.num_tensors = 1;
+  config.info.info[0].type = _NNS_FLOAT32;
+  config.info.info[0].dimension[0] = labels;
+  config.info.info[0].dimension[1] = grid;
+  config.info.info[0].dimension[2] = grid;
+  config.info.info[0].dimension[3] = 1;
+
+  heatmap = g_new0 (float, labels * grid * grid);
+  input.data = heatmap;
+  input.size = labels * grid * grid * sizeof (float);
+
+  /* all keypoints are valid, at the cell (label / 2, label / 2) */
+  for (i = 0; i < labels; i++)
+    heatmap[((i / 2) * grid + (i / 2)) * labels + i] = 1.0f;
+
+  outbuf = gst_buffer_new ();
+  EXPECT_EQ (GST_FLOW_OK, pose->decode (&pdata, &config, &input, outbuf));
+  ASSERT_TRUE (gst_buffer_map (outbuf, &map, GST_MAP_READ));
+  ASSERT_EQ (map.size, width * height * 4U);
+  for (i = 0, nonzero = 0; i < width * height; i++)
+    nonzero += (((uint32_t *) map.data)[i] != 0);
+  EXPECT_GT (nonzero, 0U);
+  gst_buffer_unmap (outbuf, &map);
+  gst_buffer_unref (outbuf);
+
+  /* no valid keypoint, the output should be cleared */
+  memset (heatmap, 0, input.size);
+
+  outbuf = gst_buffer_new ();
+  EXPECT_EQ (GST_FLOW_OK, pose->decode (&pdata, &config, &input, outbuf));
+  ASSERT_TRUE (gst_buffer_map (outbuf, &map, GST_MAP_READ));
+  ASSERT_EQ (map.size, width * height * 4U);
+  for (i = 0, nonzero = 0; i < width * height; i++)
+    nonzero += (((uint32_t *) map.data)[i] != 0);
+  EXPECT_EQ (nonzero, 0U);
+  gst_buffer_unmap (outbuf, &map);
+  gst_buffer_unref (outbuf);
+
+  g_free (heatmap);
+  pose->exit (&pdata);
+}
+
 /**
  * @brief Main GTest
  */
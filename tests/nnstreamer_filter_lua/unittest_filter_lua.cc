@@ -699,6 +699,136 @@ end
   sp->close (&prop, &data);
 }
 
+/**
+ * @brief Positive case with invoke for lua model using built-in functions
+ */
+TEST (nnstreamerFilterLua, invoke06)
+{
+  int ret;
+  void *data = NULL;
+  GstTensorMemory input, output[3];
+  GstTensorFilterProperties prop;
+  const char *lua_script = R""""(
+inputTensorsInfo = {
+  num = 1,
+  dim = {{4, 1, 1, 1}, },
+  type = {'float32', }
+}
+outputTensorsInfo = {
+  num = 3,
+  dim = {{4, 1, 1, 1}, {4, 1, 1, 1}, {3, 1, 1, 1}, },
+  type = {'uint8', 'float32', 'float32', }
+}
+function nnstreamer_invoke()
+  input = input_tensor(1)
+  output1 = output_tensor(1)
+  output2 = output_tensor(2)
+  output3 = output_tensor(3)
+
+  tensor_copy(output1, input)
+  tensor_map(output1, output1, function(x) return x * 2 end)
+
+  tensor_fill(output2, 1.5)
+  tensor_axpy(2, input, output2)
+
+  idx, val = tensor_argmax(input)
+  output3[1] = idx
+  output3[2] = val
+  output3[3] = tensor_sum(input) + #input
+end
+)"""";
+  const gchar *model_files[] = {
+    lua_script,
+    NULL,
+  };
+  const float in_data[] = { 1.0f, 5.0f, 3.0f, 2.0f };
+  const uint8_t expected1[] = { 2U, 10U, 6U, 4U };
+  const float expected2[] = { 3.5f, 11.5f, 7.5f, 5.5f };
+  const float expected3[] = { 2.0f, 5.0f, 15.0f };
+  guint i;
+
+  input.size = sizeof (in_data);
+  input.data = _g_memdup (in_data, sizeof (in_data));
+  output[0].size = sizeof (expected1);
+  output[1].size = sizeof (expected2);
+  output[2].size = sizeof (expected3);
+  for (i = 0; i < 3; i++)
+    output[i].data = g_malloc0 (output[i].size);
+
+  const GstTensorFilterFramework *sp = nnstreamer_filter_find ("lua");
+  EXPECT_NE (sp, nullptr);
+  _SetFilterProp (&prop, "lua", model_files);
+
+  ret = sp->open (&prop, &data);
+  EXPECT_EQ (ret, 0);
+  EXPECT_NE (data, (void *) NULL);
+  ret = sp->invoke (NULL, NULL, data, &input, output);
+  EXPECT_EQ (ret, 0);
+
+  for (i = 0; i < 4; i++) {
+    EXPECT_EQ (static_cast<uint8_t *> (output[0].data)[i], expected1[i]);
+    EXPECT_FLOAT_EQ (static_cast<float *> (output[1].data)[i], expected2[i]);
+  }
+  for (i = 0; i < 3; i++)
+    EXPECT_FLOAT_EQ (static_cast<float *> (output[2].data)[i], expected3[i]);
+
+  g_free (input.data);
+  for (i = 0; i < 3; i++)
+    g_free (output[i].data);
+  sp->close (&prop, &data);
+}
+
+/**
+ * @brief Negative case with invoke for lua model: the number of elements does not match in the built-in function
+ */
+TEST (nnstreamerFilterLua, invoke07_n)
+{
+  int ret;
+  void *data = NULL;
+  GstTensorMemory input, output;
+  GstTensorFilterProperties prop;
+  const char *invalid_lua_script = R""""(
+inputTensorsInfo = {
+  num = 1,
+  dim = {{3, 100, 100, 1}, },
+  type = {'uint8', }
+}
+outputTensorsInfo = {
+  num = 1,
+  dim = {{3, 100, 50, 1}, },
+  type = {'uint8', }
+}
+function nnstreamer_invoke()
+  tensor_copy(output_tensor(1), input_tensor(1))
+end
+)"""";
+  const gchar *model_files[] = {
+    invalid_lua_script,
+    NULL,
+  };
+
+  input.size = sizeof (uint8_t) * 3 * 100 * 100 * 1;
+  output.size = sizeof (uint8_t) * 3 * 100 * 50 * 1;
+
+  input.data = g_malloc0 (input.size);
+  output.data = g_malloc0 (output.size);
+
+  const GstTensorFilterFramework *sp = nnstreamer_filter_find ("lua");
+  EXPECT_NE (sp, nullptr);
+  _SetFilterProp (&prop, "lua", model_files);
+
+  ret = sp->open (&prop, &data);
+  EXPECT_EQ (ret, 0);
+  EXPECT_NE (data, (void *) NULL);
+  ret = sp->invoke (NULL, NULL, data, &input, &output);
+
+  EXPECT_NE (ret, 0);
+
+  g_free (input.data);
+  g_free (output.data);
+  sp->close (&prop, &data);
+}
+
 /**
  * @brief Positive case with reload lua model file
  */
@@ -602,6 +602,7 @@ TEST (tensorFilterOpenvino, getTensorDim0)
   const GstTensorFilterFramework *fw = nnstreamer_filter_find (fw_name);
   GstTensorFilterProperties *prop = NULL;
   GstTensorsInfo nns_tensors_info;
+  GstTensorsInfo nns_other_info;
   gpointer private_data = NULL;
   std::string str_test_model;
   gchar *test_model;
@@ -638,9 +639,10 @@ TEST (tensorFilterOpenvino, getTensorDim0)
 #endif
   }
 
-  /* Test getInputDimension () */
-  ASSERT_TRUE (fw->getInputDimension);
-  ret = fw->getInputDimension (prop, &private_data, &nns_tensors_info);
+  /* Test getModelInfo () for the input tensors */
+  ASSERT_TRUE (fw->getModelInfo);
+  ret = fw->getModelInfo (fw, prop, private_data, GET_IN_OUT_INFO,
+      &nns_tensors_info, &nns_other_info);
   EXPECT_EQ (ret, 0);
   EXPECT_EQ (nns_tensors_info.num_tensors, MOBINET_V2_IN_NUM_TENSOR);
   for (uint32_t i = 0; i < MOBINET_V2_IN_NUM_TENSOR; ++i) {
@@ -649,9 +651,10 @@ TEST (tensorFilterOpenvino, getTensorDim0)
     }
   }
 
-  /* Test getOutputDimension () */
-  ASSERT_TRUE (fw->getOutputDimension);
-  ret = fw->getOutputDimension (prop, &private_data, &nns_tensors_info);
+  /* Test getModelInfo () for the output tensors */
+  ASSERT_TRUE (fw->getModelInfo);
+  ret = fw->getModelInfo (fw, prop, private_data, GET_IN_OUT_INFO,
+      &nns_other_info, &nns_tensors_info);
   EXPECT_EQ (ret, 0);
   EXPECT_EQ (nns_tensors_info.num_tensors, MOBINET_V2_OUT_NUM_TENSOR);
   for (uint32_t i = 0; i < MOBINET_V2_OUT_NUM_TENSOR; ++i) {
@@ -679,6 +682,7 @@ TEST (tensorFilterOpenvino, getTensorDim0_n)
   GstTensorFilterProperties *prop = NULL;
   gpointer private_data = NULL;
   GstTensorsInfo nns_tensors_info;
+  GstTensorsInfo nns_other_info;
   gchar *test_model_xml;
   gchar *test_model_bin;
   gint ret;
@@ -734,9 +738,10 @@ TEST (tensorFilterOpenvino, getTensorDim0_n)
     ASSERT_TRUE (prop != NULL);
     prop->fwname = fw_name;
 
-    /* Test getInputDimension () */
-    ASSERT_TRUE (fw->getInputDimension);
-    ret = fw->getInputDimension (prop, &private_data, &nns_tensors_info);
+    /* Test getModelInfo () for the input tensors */
+    ASSERT_TRUE (fw->getModelInfo);
+    ret = fw->getModelInfo (fw, prop, private_data, GET_IN_OUT_INFO,
+        &nns_tensors_info, &nns_other_info);
     EXPECT_NE (ret, 0);
     g_free (prop);
   }
@@ -757,6 +762,7 @@ TEST (tensorFilterOpenvino, getTensorDim1_n)
   GstTensorFilterProperties *prop = NULL;
   gpointer private_data = NULL;
   GstTensorsInfo nns_tensors_info;
+  GstTensorsInfo nns_other_info;
   gchar *test_model_xml;
   gchar *test_model_bin;
   gint ret;
@@ -810,9 +816,10 @@ TEST (tensorFilterOpenvino, getTensorDim1_n)
     ASSERT_TRUE (prop != NULL);
     prop->fwname = fw_name;
 
-    /* Test getInputDimension () */
-    ASSERT_TRUE (fw->getInputDimension);
-    ret = fw->getInputDimension (prop, &private_data, &nns_tensors_info);
+    /* Test getModelInfo () for the input tensors */
+    ASSERT_TRUE (fw->getModelInfo);
+    ret = fw->getModelInfo (fw, prop, private_data, GET_IN_OUT_INFO,
+        &nns_tensors_info, &nns_other_info);
     EXPECT_NE (ret, 0);
     g_free (prop);
   }
@@ -833,6 +840,7 @@ TEST (tensorFilterOpenvino, getTensorDim2_n)
   GstTensorFilterProperties *prop = NULL;
   gpointer private_data = NULL;
   GstTensorsInfo nns_tensors_info;
+  GstTensorsInfo nns_other_info;
   gchar *test_model_xml;
   gchar *test_model_bin;
   gint ret;
@@ -885,9 +893,10 @@ TEST (tensorFilterOpenvino, getTensorDim2_n)
     ASSERT_TRUE (prop != NULL);
     prop->fwname = fw_name;
 
-    /* Test getOutputDimension () */
-    ASSERT_TRUE (fw->getOutputDimension);
-    ret = fw->getOutputDimension (prop, &private_data, &nns_tensors_info);
+    /* Test getModelInfo () for the output tensors */
+    ASSERT_TRUE (fw->getModelInfo);
+    ret = fw->getModelInfo (fw, prop, private_data, GET_IN_OUT_INFO,
+        &nns_other_info, &nns_tensors_info);
     EXPECT_NE (ret, 0);
     g_free (prop);
   }
@@ -908,6 +917,7 @@ TEST (tensorFilterOpenvino, getTensorDim3_n)
   GstTensorFilterProperties *prop = NULL;
   gpointer private_data = NULL;
   GstTensorsInfo nns_tensors_info;
+  GstTensorsInfo nns_other_info;
   gchar *test_model_xml;
   gchar *test_model_bin;
   gint ret;
@@ -958,9 +968,10 @@ TEST (tensorFilterOpenvino, getTensorDim3_n)
     ASSERT_TRUE (prop != NULL);
     prop->fwname = fw_name;
 
-    /* Test getOutputDimension () */
-    ASSERT_TRUE (fw->getOutputDimension);
-    ret = fw->getOutputDimension (prop, &private_data, &nns_tensors_info);
+    /* Test getModelInfo () for the output tensors */
+    ASSERT_TRUE (fw->getModelInfo);
+    ret = fw->getModelInfo (fw, prop, private_data, GET_IN_OUT_INFO,
+        &nns_other_info, &nns_tensors_info);
     EXPECT_NE (ret, 0);
     g_free (prop);
   }
@@ -1162,6 +1173,208 @@ TEST (tensorFilterOpenvino, convertGstTensorMemoryToBlobPtr0)
   g_free (test_model_bin);
 }
 
+/**
+ * @brief Data to wait for the asynchronous invoke in the test
+ */
+typedef struct {
+  GMutex lock;
+  GCond cond;
+  guint done;
+  gint status;
+} ov_async_data_s;
+
+/**
+ * @brief Callback for the asynchronous invoke in the test
+ */
+static void
+ov_async_done (int status, void *user_data)
+{
+  ov_async_data_s *data = (ov_async_data_s *) user_data;
+
+  g_mutex_lock (&data->lock);
+  if (status != 0)
+    data->status = status;
+  data->done++;
+  g_cond_signal (&data->cond);
+  g_mutex_unlock (&data->lock);
+}
+
+/**
+ * @brief A test case for the asynchronous invoke with the pool of infer requests
+ */
+TEST (tensorFilterOpenvino, invokeAsync0)
+{
+  const gchar *root_path = g_getenv ("NNSTREAMER_SOURCE_ROOT_PATH");
+  const gchar fw_name[] = "openvino";
+  const GstTensorFilterFramework *fw = nnstreamer_filter_find (fw_name);
+  const guint num_invokes = 4;
+  GstTensorFilterProperties *prop = NULL;
+  gpointer private_data = NULL;
+  gchar *test_model;
+  gint ret;
+
+  /* Check if mandatory methods are contained */
+  ASSERT_TRUE (fw && fw->open && fw->close && fw->invoke_async);
+
+  /* supposed to run test in build directory */
+  if (root_path == NULL)
+    root_path = "..";
+
+  test_model = g_build_filename (root_path, "tests", "test_models", "models",
+      MODEL_BASE_NAME_MOBINET_V2, NULL);
+  /* prepare properties */
+  prop = g_new0 (GstTensorFilterProperties, 1);
+  ASSERT_TRUE (prop != NULL);
+  prop->fwname = fw_name;
+  prop->num_models = 1;
+  prop->accl_str = "true:cpu";
+  prop->custom_properties = "NumRequests:2,ThroughputStreams:2";
+  {
+    const gchar *model_files[] = {
+      test_model, NULL,
+    };
+
+    prop->model_files = model_files;
+
+    ret = fw->open (prop, &private_data);
+  }
+
+#ifdef __OPENVINO_CPU_EXT__
+  EXPECT_EQ (ret, 0);
+  {
+    TensorFilterOpenvino *tfOv = static_cast<TensorFilterOpenvino *> (private_data);
+    GstTensorMemory input;
+    GstTensorMemory expected;
+    GstTensorMemory output[num_invokes];
+    ov_async_data_s data;
+    guint i;
+
+    EXPECT_EQ (tfOv->getNumRequests (), 2U);
+
+    ret = fw->getModelInfo (fw, prop, private_data, GET_IN_OUT_INFO,
+        &prop->input_meta, &prop->output_meta);
+    EXPECT_EQ (ret, 0);
+
+    input.size = gst_tensor_info_get_size (&prop->input_meta.info[0]);
+    input.data = g_malloc0 (input.size);
+    expected.size = gst_tensor_info_get_size (&prop->output_meta.info[0]);
+    expected.data = g_malloc0 (expected.size);
+
+    /* the result of the synchronous invoke */
+    ret = fw->invoke (fw, prop, private_data, &input, &expected);
+    EXPECT_EQ (ret, 0);
+
+    g_mutex_init (&data.lock);
+    g_cond_init (&data.cond);
+    data.done = 0;
+    data.status = 0;
+
+    /* submit more inputs than the infer requests */
+    for (i = 0; i < num_invokes; i++) {
+      output[i].size = expected.size;
+      output[i].data = g_malloc0 (output[i].size);
+
+      ret = fw->invoke_async (fw, prop, private_data, &input, &output[i],
+          ov_async_done, &data);
+      EXPECT_EQ (ret, 0);
+    }
+
+    g_mutex_lock (&data.lock);
+    while (data.done < num_invokes)
+      g_cond_wait (&data.cond, &data.lock);
+    g_mutex_unlock (&data.lock);
+
+    EXPECT_EQ (data.status, 0);
+    for (i = 0; i < num_invokes; i++) {
+      EXPECT_EQ (memcmp (output[i].data, expected.data, expected.size), 0);
+      g_free (output[i].data);
+    }
+
+    g_mutex_clear (&data.lock);
+    g_cond_clear (&data.cond);
+    g_free (input.data);
+    g_free (expected.data);
+    gst_tensors_info_free (&prop->input_meta);
+    gst_tensors_info_free (&prop->output_meta);
+  }
+#else
+  /* accelerating via CPU is rejected before loading the model */
+  EXPECT_NE (ret, 0);
+  EXPECT_EQ (ret, TensorFilterOpenvino::RetEInval);
+#endif
+
+  fw->close (prop, &private_data);
+  g_free (test_model);
+  g_free (prop);
+}
+
+/**
+ * @brief A negative test case for the custom properties with invalid values
+ */
+TEST (tensorFilterOpenvino, invokeAsync1_n)
+{
+  const gchar *root_path = g_getenv ("NNSTREAMER_SOURCE_ROOT_PATH");
+  const gchar fw_name[] = "openvino";
+  const GstTensorFilterFramework *fw = nnstreamer_filter_find (fw_name);
+  const gchar *invalid_props[] = {
+    "NumRequests:abc", "NumRequests:-1", "ThroughputStreams:0",
+    "ThroughputStreams:many", NULL,
+  };
+  GstTensorFilterProperties *prop = NULL;
+  gpointer private_data = NULL;
+  gchar *test_model;
+  gint ret;
+  guint i;
+
+  /* Check if mandatory methods are contained */
+  ASSERT_TRUE (fw && fw->open && fw->close);
+
+  /* supposed to run test in build directory */
+  if (root_path == NULL)
+    root_path = "..";
+
+  test_model = g_build_filename (root_path, "tests", "test_models", "models",
+      MODEL_BASE_NAME_MOBINET_V2, NULL);
+  /* prepare properties */
+  prop = g_new0 (GstTensorFilterProperties, 1);
+  ASSERT_TRUE (prop != NULL);
+  prop->fwname = fw_name;
+  prop->num_models = 1;
+  /* the custom properties are parsed before loading the model onto the device */
+#ifdef __OPENVINO_CPU_EXT__
+  prop->accl_str = "true:cpu";
+#else
+  prop->accl_str = "true:npu.movidius";
+#endif
+
+  for (i = 0; invalid_props[i] != NULL; i++) {
+    const gchar *model_files[] = {
+      test_model, NULL,
+    };
+    TensorFilterOpenvino *tfOv;
+
+    prop->model_files = model_files;
+    prop->custom_properties = invalid_props[i];
+
+    ret = fw->open (prop, &private_data);
+    EXPECT_EQ (ret, TensorFilterOpenvino::RetEInval);
+
+    /* the parser is what rejects the custom properties */
+    tfOv = static_cast<TensorFilterOpenvino *> (private_data);
+    ASSERT_TRUE (tfOv != nullptr);
+    EXPECT_FALSE (tfOv->isModelLoaded ());
+    EXPECT_EQ (tfOv->parseCustomProperties (invalid_props[i]),
+        TensorFilterOpenvino::RetEInval);
+    EXPECT_EQ (tfOv->parseCustomProperties ("NumRequests:2,ThroughputStreams:2"),
+        TensorFilterOpenvino::RetSuccess);
+
+    fw->close (prop, &private_data);
+  }
+
+  g_free (test_model);
+  g_free (prop);
+}
+
 /**
  * @brief Main function for unit test.
  */
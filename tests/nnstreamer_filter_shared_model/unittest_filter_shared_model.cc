@@ -138,6 +138,44 @@ TEST (nnstreamerFilterSharedModel, tfliteInvalidShape_n)
   gst_object_unref (pipeline);
 }
 
+/**
+ * @brief Test filters sharing the model with different number of threads
+ */
+TEST (nnstreamerFilterSharedModel, tfliteOptionsMismatch_n)
+{
+  const gchar *src_root = g_getenv ("NNSTREAMER_SOURCE_ROOT_PATH");
+  gchar *root_path = src_root ? g_strdup (src_root) : g_get_current_dir ();
+  gchar *model_path1 = g_build_filename (
+      root_path, "tests", "test_models", "models", model_name1, NULL);
+  gchar *image_path = g_build_filename (
+      root_path, "tests", "test_models", "data", data_name, NULL);
+  gchar *pipeline_str;
+  GstElement *pipeline;
+  ASSERT_TRUE (g_file_test (model_path1, G_FILE_TEST_EXISTS));
+  ASSERT_TRUE (g_file_test (image_path, G_FILE_TEST_EXISTS));
+
+  pipeline_str = g_strdup_printf (
+      "filesrc location=%s ! pngdec ! videoscale ! imagefreeze ! videoconvert ! "
+      "video/x-raw,format=RGB,framerate=10/1 ! tensor_converter ! tee name=t t. ! "
+      "queue ! tensor_filter name=filter1 framework=tensorflow-lite model=%s custom=NumThreads:1 "
+      "shared-tensor-filter-key=%s ! tensor_sink name=sink1 t. ! "
+      "queue ! tensor_filter name=filter2 framework=tensorflow-lite model=%s custom=NumThreads:2 "
+      "shared-tensor-filter-key=%s ! tensor_sink name=sink2",
+      image_path, model_path1, shared_key, model_path1, shared_key);
+  g_free (root_path);
+  g_free (model_path1);
+  g_free (image_path);
+
+  pipeline = gst_parse_launch (pipeline_str, NULL);
+
+  EXPECT_NE (setPipelineStateSync (pipeline, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  g_usleep (TEST_DEFAULT_SLEEP_TIME);
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  g_free (pipeline_str);
+  gst_object_unref (pipeline);
+}
+
 /**
  * @brief Test filters to reload new model
  */
@@ -205,6 +243,95 @@ TEST (nnstreamerFilterSharedModel, tfliteSharedReload)
   gst_object_unref (pipeline);
 }
 
+/**
+ * @brief Test filters share the model automatically with model cache
+ */
+TEST (nnstreamerFilterSharedModel, tfliteModelCache)
+{
+  gchar *pipeline_str;
+  GstElement *pipeline, *filter1, *filter2, *sink1, *sink2;
+  gint idx0 = 0, idx1 = 1;
+  gchar *key1, *key2;
+  gboolean cache;
+  const gchar *src_root = g_getenv ("NNSTREAMER_SOURCE_ROOT_PATH");
+  gchar *root_path = src_root ? g_strdup (src_root) : g_get_current_dir ();
+  gchar *model_path = g_build_filename (
+      root_path, "tests", "test_models", "models", model_name1, NULL);
+  gchar *image_path = g_build_filename (
+      root_path, "tests", "test_models", "data", data_name, NULL);
+
+  ASSERT_TRUE (g_file_test (model_path, G_FILE_TEST_EXISTS));
+  ASSERT_TRUE (g_file_test (image_path, G_FILE_TEST_EXISTS));
+
+  pipeline_str = g_strdup_printf (
+      "filesrc location=%s ! pngdec ! videoscale ! imagefreeze ! videoconvert ! "
+      "video/x-raw,format=RGB,framerate=10/1 ! tensor_converter ! tee name=t t. ! "
+      "queue ! tensor_filter name=filter1 framework=tensorflow-lite model=%s model-cache=true ! "
+      "tensor_sink name=sink1 t. ! "
+      "queue ! tensor_filter name=filter2 framework=tensorflow-lite model=%s model-cache=true ! "
+      "tensor_sink name=sink2",
+      image_path, model_path, model_path);
+  pipeline = gst_parse_launch (pipeline_str, NULL);
+  g_free (pipeline_str);
+  g_free (root_path);
+  g_free (model_path);
+  g_free (image_path);
+  memset (res, 0, sizeof (res));
+
+  filter1 = gst_bin_get_by_name (GST_BIN (pipeline), "filter1");
+  ASSERT_TRUE (filter1 != NULL);
+  filter2 = gst_bin_get_by_name (GST_BIN (pipeline), "filter2");
+  ASSERT_TRUE (filter2 != NULL);
+
+  g_object_get (filter1, "model-cache", &cache, NULL);
+  EXPECT_TRUE (cache);
+
+  sink1 = gst_bin_get_by_name (GST_BIN (pipeline), "sink1");
+  EXPECT_NE (sink1, nullptr);
+  g_signal_connect (sink1, "new-data", (GCallback) _new_data_cb, (gpointer) &idx0);
+  sink2 = gst_bin_get_by_name (GST_BIN (pipeline), "sink2");
+  EXPECT_NE (sink2, nullptr);
+  g_signal_connect (sink2, "new-data", (GCallback) _new_data_cb, (gpointer) &idx1);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  g_usleep (TEST_DEFAULT_SLEEP_TIME);
+
+  /* two filters have the same key generated by the model cache */
+  g_object_get (filter1, "shared-tensor-filter-key", &key1, NULL);
+  g_object_get (filter2, "shared-tensor-filter-key", &key2, NULL);
+  EXPECT_TRUE (g_str_has_prefix (key1, "model-cache:"));
+  EXPECT_STREQ (key1, key2);
+  g_free (key1);
+  g_free (key2);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PAUSED, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  g_usleep (TEST_DEFAULT_SLEEP_TIME);
+
+  /* check two filters have same output */
+  EXPECT_NE (res[0], 0U);
+  EXPECT_EQ (res[0], res[1]);
+
+  /* open again, the idle model in the cache is used */
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  memset (res, 0, sizeof (res));
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  g_usleep (TEST_DEFAULT_SLEEP_TIME);
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PAUSED, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  g_usleep (TEST_DEFAULT_SLEEP_TIME);
+
+  EXPECT_NE (res[0], 0U);
+  EXPECT_EQ (res[0], res[1]);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  gst_object_unref (filter1);
+  gst_object_unref (filter2);
+  gst_object_unref (sink1);
+  gst_object_unref (sink2);
+  gst_object_unref (pipeline);
+}
+
 /**
  * @brief Main gtest
  */
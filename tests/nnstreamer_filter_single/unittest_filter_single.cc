@@ -9,6 +9,9 @@
 
 #include <gtest/gtest.h>
 #include <glib.h>
+#include <errno.h>
+#include <string.h>
+#include <nnstreamer_plugin_api_filter.h>
 #include <nnstreamer_plugin_api_util.h>
 
 #include "../gst/nnstreamer/tensor_filter/tensor_filter_single.h"
@@ -127,6 +130,28 @@ TEST_F (NNSFilterSingleTest, invoke_p)
   klass->destroy_notify (single, &output);
 }
 
+/**
+ * @brief Test to invoke tf-lite model and get the output without memcpy.
+ */
+TEST_F (NNSFilterSingleTest, invokeNoCopy_p)
+{
+  ASSERT_TRUE (this->loaded);
+
+  /* invoke the model and check label 'orange' (index 951) */
+  EXPECT_TRUE (klass->invoke_no_copy (single, &input, &output));
+  ASSERT_TRUE (output.data != nullptr);
+  EXPECT_EQ (951U, get_max_score (&output));
+
+  klass->release_output (single, &output);
+  EXPECT_TRUE (output.data == nullptr);
+
+  /* invoke again with the released output */
+  EXPECT_TRUE (klass->invoke_no_copy (single, &input, &output));
+  EXPECT_EQ (951U, get_max_score (&output));
+
+  klass->release_output (single, &output);
+}
+
 /**
  * @brief Test to invoke tf-lite model with invalid param.
  */
@@ -248,6 +273,157 @@ TEST (testTensorFilterSingle, invokeUnknownFW_n)
   g_free (out.data);
 }
 
+static const gchar test_fw_accept_name[] = "single-accept-output";
+static gboolean test_fw_accept_output = FALSE;
+static guint test_fw_alloc_count = 0;
+
+/**
+ * @brief The mandatory callback for GstTensorFilterFramework (v1), allocates the output if not given.
+ */
+static int
+test_fw_accept_invoke (const GstTensorFilterFramework *self,
+    const GstTensorFilterProperties *prop, void *private_data,
+    const GstTensorMemory *input, GstTensorMemory *output)
+{
+  guint8 *in, *out;
+  gsize i;
+
+  if (output[0].data == NULL) {
+    output[0].data = g_malloc (output[0].size);
+    test_fw_alloc_count++;
+  }
+
+  in = (guint8 *) input[0].data;
+  out = (guint8 *) output[0].data;
+  for (i = 0; i < output[0].size; i++)
+    out[i] = in[i] + 1;
+
+  return 0;
+}
+
+/**
+ * @brief The mandatory callback for GstTensorFilterFramework (v1).
+ */
+static int
+test_fw_accept_getFWInfo (const GstTensorFilterFramework *self,
+    const GstTensorFilterProperties *prop, void *private_data,
+    GstTensorFilterFrameworkInfo *fw_info)
+{
+  memset (fw_info, 0, sizeof (GstTensorFilterFrameworkInfo));
+  fw_info->name = test_fw_accept_name;
+  fw_info->allocate_in_invoke = 1;
+  fw_info->accept_output_buffer = test_fw_accept_output ? 1 : 0;
+  fw_info->run_without_model = 1;
+  return 0;
+}
+
+/**
+ * @brief The mandatory callback for GstTensorFilterFramework (v1), a tensor uint8 4:1:1:1.
+ */
+static int
+test_fw_accept_getModelInfo (const GstTensorFilterFramework *self,
+    const GstTensorFilterProperties *prop, void *private_data,
+    model_info_ops ops, GstTensorsInfo *in_info, GstTensorsInfo *out_info)
+{
+  if (ops != GET_IN_OUT_INFO)
+    return -ENOENT;
+
+  gst_tensors_info_init (in_info);
+  in_info->num_tensors = 1U;
+  in_info->info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("4:1:1:1", in_info->info[0].dimension);
+  gst_tensors_info_copy (out_info, in_info);
+  return 0;
+}
+
+/**
+ * @brief The mandatory callback for GstTensorFilterFramework (v1).
+ */
+static int
+test_fw_accept_eventHandler (const GstTensorFilterFramework *self,
+    const GstTensorFilterProperties *prop, void *private_data, event_ops ops,
+    GstTensorFilterFrameworkEventData *data)
+{
+  return -ENOENT;
+}
+
+/**
+ * @brief Invoke the sub-plugin allocating the output in single-shot, and check the output buffer given by the caller.
+ * @param accept TRUE if the sub-plugin accepts the output buffers given by the caller.
+ * @return The number of output memory blocks allocated by the sub-plugin.
+ */
+static guint
+test_fw_accept_run (gboolean accept)
+{
+  GstTensorFilterFramework *fw = g_new0 (GstTensorFilterFramework, 1);
+  GTensorFilterSingle *single;
+  GTensorFilterSingleClass *klass;
+  GstTensorMemory in, out;
+  guint8 in_data[4] = { 1, 2, 3, 4 };
+  guint8 *out_data;
+  guint i;
+
+  fw->version = GST_TENSOR_FILTER_FRAMEWORK_V1;
+  fw->invoke = test_fw_accept_invoke;
+  fw->getFrameworkInfo = test_fw_accept_getFWInfo;
+  fw->getModelInfo = test_fw_accept_getModelInfo;
+  fw->eventHandler = test_fw_accept_eventHandler;
+
+  test_fw_accept_output = accept;
+  test_fw_alloc_count = 0;
+  EXPECT_TRUE (nnstreamer_filter_probe (fw));
+
+  single = (GTensorFilterSingle *) g_object_new (G_TYPE_TENSOR_FILTER_SINGLE, NULL);
+  klass = (GTensorFilterSingleClass *) g_type_class_ref (G_TYPE_TENSOR_FILTER_SINGLE);
+  g_object_set (G_OBJECT (single), "framework", test_fw_accept_name, NULL);
+
+  in.data = in_data;
+  in.size = out.size = sizeof (in_data);
+  out.data = out_data = (guint8 *) g_malloc0 (out.size);
+
+  /* the output should be written into the buffer given by the caller */
+  EXPECT_TRUE (klass->start (single));
+  EXPECT_TRUE (klass->allocate_in_invoke (single));
+  EXPECT_TRUE (klass->invoke (single, &in, &out, FALSE));
+  EXPECT_TRUE (out.data == out_data);
+  for (i = 0; i < out.size; i++)
+    EXPECT_EQ (out_data[i], in_data[i] + 1);
+
+  /* the sub-plugin allocates the output if the caller requests allocation */
+  EXPECT_TRUE (klass->invoke (single, &in, &out, TRUE));
+  EXPECT_TRUE (out.data != NULL && out.data != out_data);
+  EXPECT_EQ (((guint8 *) out.data)[0], in_data[0] + 1);
+  klass->destroy_notify (single, &out);
+  EXPECT_TRUE (klass->stop (single));
+
+  g_type_class_unref (klass);
+  g_object_unref (single);
+  g_free (out_data);
+
+  nnstreamer_filter_exit (test_fw_accept_name);
+  g_free (fw);
+
+  return test_fw_alloc_count;
+}
+
+/**
+ * @brief Test the sub-plugin fills the output buffers given by the caller (accept_output_buffer).
+ */
+TEST (testTensorFilterSingle, acceptOutputBuffer_p)
+{
+  /* allocated only when the caller requests allocation */
+  EXPECT_EQ (test_fw_accept_run (TRUE), 1U);
+}
+
+/**
+ * @brief Test the sub-plugin without accept_output_buffer, the output is copied into the given buffer.
+ */
+TEST (testTensorFilterSingle, acceptOutputBufferUnset_p)
+{
+  /* allocated for each invoke, the output is copied into the given buffer */
+  EXPECT_EQ (test_fw_accept_run (FALSE), 2U);
+}
+
 /**
  * @brief Main GTest.
  */
@@ -162,6 +162,102 @@ for BLOCKING in "${BLOCKING_LIST[@]}"; do
 done
 done
 
+## Test gRPC multi-streams with different IDL and dispatch policies. The receiver restores the order.
+DISPATCH_LIST=("round-robin" "least-outstanding")
+NUM_STREAMS=4
+for IDL in "${IDL_LIST[@]}"; do
+for DISPATCH in "${DISPATCH_LIST[@]}"; do
+  PORT=`python3 ../get_available_port.py`
+  # tensor_sink (client) --> tensor_src (server), other/tensor
+  gstTestBackground "--gst-plugin-path=${PATH_TO_PLUGIN} tensor_src_grpc port=${PORT} num-buffers=${NUM_BUFFERS} idl=${IDL} ! other/tensor,dimension=3:640:480,type=uint8,framerate=5/1 ! multifilesink async=false location=result_%1d.log" ${INDEX}-1 0 0 ${TIMEOUT_SEC}
+  pid=$!
+  gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc num-buffers=${NUM_BUFFERS} ! video/x-raw,width=640,height=480,framerate=5/1 ! tensor_converter ! tensor_sink_grpc port=${PORT} idl=${IDL} num-streams=${NUM_STREAMS} dispatch=${DISPATCH}" ${INDEX}-2 0 0 $PERFORMANCE
+  kill -9 $pid &> /dev/null
+  wait $pid
+
+  for i in `seq 0 $((NUM_BUFFERS-1))`
+  do
+    callCompareTest original1_${i}.log result_${i}.log GoldenTest-${INDEX} "gRPC ${IDL}/${DISPATCH} $((i+1))/${NUM_BUFFERS}" 0 0
+  done
+
+  INDEX=$((INDEX + 1))
+  rm result_*.log
+
+  PORT=`python3 ../get_available_port.py`
+  # tensor_sink (client) --> tensor_src (server), other/tensors
+  gstTestBackground "--gst-plugin-path=${PATH_TO_PLUGIN} tensor_src_grpc port=${PORT} num-buffers=$((NUM_BUFFERS/2)) idl=${IDL} ! other/tensors,num_tensors=2,dimensions=3:640:480.3:640:480,types=uint8.uint8,framerate=5/1 ! multifilesink async=false location=result_%1d.log" ${INDEX}-1 0 0 ${TIMEOUT_SEC}
+  pid=$!
+  gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc num-buffers=${NUM_BUFFERS} ! video/x-raw,width=640,height=480,framerate=5/1 ! tensor_converter frames-per-tensor=2 ! tensor_sink_grpc port=${PORT} idl=${IDL} num-streams=${NUM_STREAMS} dispatch=${DISPATCH}" ${INDEX}-2 0 0 $PERFORMANCE
+  kill -9 $pid &> /dev/null
+  wait $pid
+
+  for i in `seq 0 $((NUM_BUFFERS/2-1))`
+  do
+    callCompareTest original2_${i}.log result_${i}.log GoldenTest-${INDEX} "gRPC ${IDL}/${DISPATCH} $((i+1))/$((NUM_BUFFERS/2))" 0 0
+  done
+
+  INDEX=$((INDEX + 1))
+  rm result_*.log
+done
+
+  PORT=`python3 ../get_available_port.py`
+  # tensor_sink (server) --> tensor_src (client), other/tensor
+  gstTestBackground "--gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc num-buffers=${NUM_BUFFERS} ! video/x-raw,width=640,height=480,framerate=5/1 ! tensor_converter ! tensor_sink_grpc port=${PORT} server=true idl=${IDL} async=false" ${INDEX}-1 0 0 ${TIMEOUT_SEC}
+  pid=$!
+  gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} tensor_src_grpc port=${PORT} num-buffers=${NUM_BUFFERS} server=false idl=${IDL} num-streams=${NUM_STREAMS} ! other/tensor,dimension=3:640:480,type=uint8,framerate=5/1 ! multifilesink location=result_%1d.log" ${INDEX}-2 0 0 $PERFORMANCE
+  kill -9 $pid &> /dev/null
+  wait $pid
+
+  for i in `seq 0 $((NUM_BUFFERS-1))`
+  do
+    callCompareTest original1_${i}.log result_${i}.log GoldenTest-${INDEX} "gRPC ${IDL}/multi-streams $((i+1))/${NUM_BUFFERS}" 0 0
+  done
+
+  INDEX=$((INDEX + 1))
+  rm result_*.log
+done
+
+## Test gRPC server sending to the multi-stream clients one after another.
+## Each client numbers its buffers from the first one, so the buffers keep the order of the server.
+# moving pattern to tell the buffers apart
+NUM_SERVER_BUFFERS=$((NUM_BUFFERS * 4))
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc pattern=ball num-buffers=${NUM_SERVER_BUFFERS} ! video/x-raw,width=640,height=480,framerate=5/1 ! tensor_converter ! multifilesink location=original3_%1d.log" Initial-3 0 0 $PERFORMANCE
+
+# check the received buffers are in the order of the server (skipping the ones sent to the other client)
+function checkInOrder() {
+  j=0
+  for i in `seq 0 $((NUM_BUFFERS-1))`
+  do
+    while [[ $j -lt $NUM_SERVER_BUFFERS ]] && ! cmp -s original3_${j}.log ${1}_${i}.log; do
+      j=$((j + 1))
+    done
+    if [[ $j -ge $NUM_SERVER_BUFFERS ]]; then
+      return 1
+    fi
+    j=$((j + 1))
+  done
+  return 0
+}
+
+for IDL in "${IDL_LIST[@]}"; do
+  PORT=`python3 ../get_available_port.py`
+  # tensor_sink (server) --> tensor_src (client) x 2, other/tensor
+  gstTestBackground "--gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc pattern=ball num-buffers=${NUM_SERVER_BUFFERS} ! video/x-raw,width=640,height=480,framerate=5/1 ! tensor_converter ! tensor_sink_grpc port=${PORT} server=true idl=${IDL} async=false" ${INDEX}-1 0 0 ${TIMEOUT_SEC}
+  pid=$!
+  gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} tensor_src_grpc port=${PORT} num-buffers=${NUM_BUFFERS} server=false idl=${IDL} num-streams=${NUM_STREAMS} ! other/tensor,dimension=3:640:480,type=uint8,framerate=5/1 ! multifilesink location=result1_%1d.log" ${INDEX}-2 0 0 $PERFORMANCE
+  gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} tensor_src_grpc port=${PORT} num-buffers=${NUM_BUFFERS} server=false idl=${IDL} num-streams=${NUM_STREAMS} ! other/tensor,dimension=3:640:480,type=uint8,framerate=5/1 ! multifilesink location=result2_%1d.log" ${INDEX}-3 0 0 $PERFORMANCE
+  kill -9 $pid &> /dev/null
+  wait $pid
+
+  checkInOrder result1
+  testResult $? ${INDEX}-4 "gRPC ${IDL}/reconnect, the first client" 0 1
+  checkInOrder result2
+  testResult $? ${INDEX}-5 "gRPC ${IDL}/reconnect, the second client" 0 1
+
+  INDEX=$((INDEX + 1))
+  rm result*_*.log
+done
+
 rm original*.log
 
 report
@@ -422,6 +422,107 @@ TEST (nnstreamerGrpc, sinkInvalidPort_n)
   gst_object_unref (test_data.pipeline);
 }
 
+/**
+ * @brief Test gRPC tensor_sink multi-stream properties
+ */
+TEST (nnstreamerGrpc, sinkStreamsProperty)
+{
+  TestOption option;
+  GstElement *sink;
+  guint num_streams;
+  gchar *dispatch;
+
+  _set_default_option (option);
+  option.mode = GRPC_MODE_SINK;
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  sink = gst_bin_get_by_name (GST_BIN (test_data.pipeline), "sink");
+  ASSERT_TRUE (sink != NULL);
+
+  g_object_get (sink, "num-streams", &num_streams, NULL);
+  EXPECT_EQ (num_streams, 1U);
+
+  g_object_get (sink, "dispatch", &dispatch, NULL);
+  EXPECT_STREQ (dispatch, "least-outstanding");
+  g_free (dispatch);
+
+  g_object_set (sink, "num-streams", 4U, NULL);
+  g_object_get (sink, "num-streams", &num_streams, NULL);
+  EXPECT_EQ (num_streams, 4U);
+
+  g_object_set (sink, "dispatch", "round-robin", NULL);
+  g_object_get (sink, "dispatch", &dispatch, NULL);
+  EXPECT_STREQ (dispatch, "round-robin");
+  g_free (dispatch);
+
+  gst_object_unref (sink);
+  gst_object_unref (test_data.pipeline);
+}
+
+/**
+ * @brief Test gRPC tensor_sink invalid multi-stream properties
+ */
+TEST (nnstreamerGrpc, sinkInvalidStreamsProperty_n)
+{
+  TestOption option;
+  GstElement *sink;
+  guint num_streams;
+  gchar *dispatch;
+
+  _set_default_option (option);
+  option.mode = GRPC_MODE_SINK;
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  sink = gst_bin_get_by_name (GST_BIN (test_data.pipeline), "sink");
+  ASSERT_TRUE (sink != NULL);
+
+  g_object_set (sink, "num-streams", 0U, NULL);
+  g_object_get (sink, "num-streams", &num_streams, NULL);
+  EXPECT_EQ (num_streams, 1U);
+
+  g_object_set (sink, "num-streams", 1000U, NULL);
+  g_object_get (sink, "num-streams", &num_streams, NULL);
+  EXPECT_EQ (num_streams, 1U);
+
+  g_object_set (sink, "dispatch", "random", NULL);
+  g_object_get (sink, "dispatch", &dispatch, NULL);
+  EXPECT_STREQ (dispatch, "least-outstanding");
+  g_free (dispatch);
+
+  gst_object_unref (sink);
+  gst_object_unref (test_data.pipeline);
+}
+
+/**
+ * @brief Test gRPC tensor_src multi-stream property
+ */
+TEST (nnstreamerGrpc, srcStreamsProperty)
+{
+  TestOption option;
+  GstElement *src;
+  guint num_streams;
+
+  _set_default_option (option);
+  option.mode = GRPC_MODE_SRC;
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  src = gst_bin_get_by_name (GST_BIN (test_data.pipeline), "src");
+  ASSERT_TRUE (src != NULL);
+
+  g_object_get (src, "num-streams", &num_streams, NULL);
+  EXPECT_EQ (num_streams, 1U);
+
+  g_object_set (src, "num-streams", 4U, NULL);
+  g_object_get (src, "num-streams", &num_streams, NULL);
+  EXPECT_EQ (num_streams, 4U);
+
+  gst_object_unref (src);
+  gst_object_unref (test_data.pipeline);
+}
+
 /**
  * @brief gtest main
  */
@@ -13,6 +13,7 @@
 #include <gst/check/gstharness.h>
 #include <gst/check/gsttestclock.h>
 #include <gst/gst.h>
+#include <gst/video/video.h>
 #include <nnstreamer_plugin_api_converter.h>
 #include <nnstreamer_plugin_api_decoder.h>
 #include <nnstreamer_plugin_api_filter.h>
@@ -21,6 +22,7 @@
 #include <tensor_common.h>
 #include <tensor_meta.h>
 #include <unistd.h>
+#include <cmath>
 
 #include "../unittest_util.h"
 #include "../gst/nnstreamer/elements/gsttensor_sparseutil.h"
@@ -2139,6 +2141,503 @@ TEST (testTensorTransform, arithmeticFlexTensor)
   gst_harness_teardown (h);
 }
 
+/**
+ * @brief Internal function to transform a tensor with given mode and option.
+ */
+static GstFlowReturn
+_transform_tensor_test_run (tensor_transform_mode mode, const gchar *option,
+    const gchar *dim, tensor_type in_type, gconstpointer input,
+    tensor_type out_type, gpointer output)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorsConfig config;
+  GstFlowReturn ret;
+  gsize data_in_size, data_out_size;
+
+  h = gst_harness_new ("tensor_transform");
+  g_object_set (h->element, "mode", mode, "option", option, NULL);
+
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1U;
+  config.info.info[0].type = in_type;
+  gst_tensor_parse_dimension (dim, config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+  data_in_size = gst_tensors_info_get_size (&config.info, 0);
+
+  config.info.info[0].type = out_type;
+  data_out_size = gst_tensors_info_get_size (&config.info, 0);
+
+  in_buf = gst_harness_create_buffer (h, data_in_size);
+  gst_buffer_fill (in_buf, 0, input, data_in_size);
+
+  ret = gst_harness_push (h, in_buf);
+  if (ret == GST_FLOW_OK) {
+    out_buf = gst_harness_pull (h);
+
+    if (out_buf && gst_buffer_get_size (out_buf) == data_out_size)
+      gst_buffer_extract (out_buf, 0, output, data_out_size);
+    else
+      ret = GST_FLOW_ERROR;
+
+    if (out_buf)
+      gst_buffer_unref (out_buf);
+  }
+
+  gst_harness_teardown (h);
+  return ret;
+}
+
+/**
+ * @brief Reference implementation of quantize (round half to even, then saturate).
+ */
+static gint64
+_quantize_ref (float value, float scale, gint32 zero_point, gint64 qmin, gint64 qmax)
+{
+  float t = value / scale;
+  gint64 q;
+
+  if (std::isnan (t))
+    return qmin;
+
+  if (t < (float) G_MININT32)
+    return qmin;
+  if (t > (float) G_MAXINT32)
+    return qmax;
+
+  q = (gint64) std::nearbyint (t) + zero_point;
+  return CLAMP (q, qmin, qmax);
+}
+
+/**
+ * @brief Test for tensor_transform quantize (float32 to uint8, rounding and saturation)
+ */
+TEST (testTensorTransform, quantizeFloat32ToUint8)
+{
+  const guint array_size = 100; /* not aligned with the vector size */
+  float input[array_size];
+  uint8_t output[array_size];
+  guint i;
+
+  /* ties (x.5) and the values out of the range */
+  for (i = 0; i < array_size; i++)
+    input[i] = (i - 50.f) * 1.125f;
+  input[7] = NAN;
+  input[8] = INFINITY;
+  input[9] = -INFINITY;
+
+  ASSERT_EQ (_transform_tensor_test_run (GTT_QUANTIZE,
+                 "uint8,scale:0.25,zero-point:128", "100", _NNS_FLOAT32, input,
+                 _NNS_UINT8, output),
+      GST_FLOW_OK);
+
+  for (i = 0; i < array_size; i++)
+    EXPECT_EQ (output[i], _quantize_ref (input[i], 0.25f, 128, 0, G_MAXUINT8));
+
+  EXPECT_EQ (output[7], 0);
+  EXPECT_EQ (output[8], G_MAXUINT8);
+  EXPECT_EQ (output[9], 0);
+  /* 1.125 / 0.25 = 4.5 -> 4 and 3.375 / 0.25 = 13.5 -> 14 (half to even) */
+  EXPECT_EQ (output[51], 128 + 4);
+  EXPECT_EQ (output[53], 128 + 14);
+}
+
+/**
+ * @brief Test for tensor_transform quantize (float32 to int8, per-channel)
+ */
+TEST (testTensorTransform, quantizeFloat32ToInt8PerChannel)
+{
+  const guint array_size = 3 * 40;
+  const float scales[] = { 0.5f, 0.25f, 0.125f };
+  const gint32 zero_points[] = { -10, 0, 10 };
+  float input[array_size];
+  int8_t output[array_size];
+  guint i, ch;
+
+  for (i = 0; i < array_size; i++)
+    input[i] = ((gint) (i * 37 % 101) - 50) * 0.3f;
+
+  ASSERT_EQ (_transform_tensor_test_run (GTT_QUANTIZE,
+                 "int8,per-channel:true@0,scale:0.5:0.25:0.125,zero-point:-10:0:10",
+                 "3:40", _NNS_FLOAT32, input, _NNS_INT8, output),
+      GST_FLOW_OK);
+
+  for (i = 0; i < array_size; i++) {
+    ch = i % 3;
+    EXPECT_EQ (output[i], _quantize_ref (input[i], scales[ch],
+                              zero_points[ch], G_MININT8, G_MAXINT8));
+  }
+}
+
+/**
+ * @brief Test for tensor_transform quantize (float32 to uint8, per-channel of the innermost dimension, longer than a vector)
+ */
+TEST (testTensorTransform, quantizeFloat32ToUint8PerChannelInner)
+{
+  const guint channels = 5;
+  const guint array_size = channels * 67; /* not aligned with the row of channels */
+  const float scales[] = { 0.5f, 0.25f, 0.125f, 2.0f, 0.1f };
+  const gint32 zero_points[] = { 0, 128, 255, 10, 100 };
+  float input[array_size];
+  uint8_t output[array_size];
+  guint i, ch;
+
+  for (i = 0; i < array_size; i++)
+    input[i] = ((gint) (i * 37 % 211) - 105) * 0.375f;
+  input[11] = NAN;
+  input[12] = INFINITY;
+  input[13] = -INFINITY;
+
+  ASSERT_EQ (_transform_tensor_test_run (GTT_QUANTIZE,
+                 "uint8,per-channel:true@0,scale:0.5:0.25:0.125:2:0.1,zero-point:0:128:255:10:100",
+                 "5:67", _NNS_FLOAT32, input, _NNS_UINT8, output),
+      GST_FLOW_OK);
+
+  for (i = 0; i < array_size; i++) {
+    ch = i % channels;
+    EXPECT_EQ (output[i], _quantize_ref (input[i], scales[ch],
+                              zero_points[ch], 0, G_MAXUINT8));
+  }
+}
+
+/**
+ * @brief Test for tensor_transform quantize (float32 to int16, per-channel of the outer dimension)
+ */
+TEST (testTensorTransform, quantizeFloat32ToInt16PerChannel)
+{
+  const guint array_size = 10 * 2 * 3;
+  const float scales[] = { 0.01f, 0.001f };
+  float input[array_size];
+  int16_t output[array_size];
+  guint i, ch;
+
+  for (i = 0; i < array_size; i++)
+    input[i] = ((gint) (i * 53 % 89) - 44) * 1.5f;
+
+  ASSERT_EQ (_transform_tensor_test_run (GTT_QUANTIZE,
+                 "int16,per-channel:true@1,scale:0.01:0.001", "10:2:3",
+                 _NNS_FLOAT32, input, _NNS_INT16, output),
+      GST_FLOW_OK);
+
+  for (i = 0; i < array_size; i++) {
+    ch = (i / 10) % 2;
+    EXPECT_EQ (output[i], _quantize_ref (input[i], scales[ch], 0, G_MININT16, G_MAXINT16));
+  }
+}
+
+/**
+ * @brief Test for tensor_transform dequantize (uint8 to float32)
+ */
+TEST (testTensorTransform, dequantizeUint8ToFloat32)
+{
+  const guint array_size = 100;
+  uint8_t input[array_size];
+  float output[array_size];
+  guint i;
+
+  for (i = 0; i < array_size; i++)
+    input[i] = (uint8_t) (i * 61);
+
+  ASSERT_EQ (_transform_tensor_test_run (GTT_DEQUANTIZE,
+                 "float32,scale:0.05,zero-point:128", "100", _NNS_UINT8, input,
+                 _NNS_FLOAT32, output),
+      GST_FLOW_OK);
+
+  for (i = 0; i < array_size; i++)
+    EXPECT_FLOAT_EQ (output[i], (float) (input[i] - 128) * 0.05f);
+}
+
+/**
+ * @brief Test for tensor_transform dequantize (int8 to float32, per-channel of the innermost dimension, longer than a vector)
+ */
+TEST (testTensorTransform, dequantizeInt8ToFloat32PerChannelInner)
+{
+  const guint channels = 7;
+  const guint array_size = channels * 50;
+  const float scales[] = { 0.5f, 0.25f, 2.0f, 0.1f, 0.03f, 1.0f, 4.0f };
+  const gint32 zero_points[] = { 1, -2, 3, -128, 127, 0, -50 };
+  int8_t input[array_size];
+  float output[array_size];
+  guint i, ch;
+
+  for (i = 0; i < array_size; i++)
+    input[i] = (int8_t) (i * 61);
+
+  ASSERT_EQ (_transform_tensor_test_run (GTT_DEQUANTIZE,
+                 "float32,per-channel:true@0,scale:0.5:0.25:2:0.1:0.03:1:4,zero-point:1:-2:3:-128:127:0:-50",
+                 "7:50", _NNS_INT8, input, _NNS_FLOAT32, output),
+      GST_FLOW_OK);
+
+  for (i = 0; i < array_size; i++) {
+    ch = i % channels;
+    EXPECT_FLOAT_EQ (output[i], (float) (input[i] - zero_points[ch]) * scales[ch]);
+  }
+}
+
+/**
+ * @brief Test for tensor_transform dequantize (int8 to float64, per-channel)
+ */
+TEST (testTensorTransform, dequantizeInt8ToFloat64PerChannel)
+{
+  const guint array_size = 4 * 3;
+  const double scales[] = { 0.5, 0.25, 2.0 };
+  const gint32 zero_points[] = { 1, -2, 3 };
+  int8_t input[array_size] = { -128, -1, 0, 127, 10, 20, 30, 40, -50, -60, -70, -80 };
+  double output[array_size];
+  guint i, ch;
+
+  ASSERT_EQ (_transform_tensor_test_run (GTT_DEQUANTIZE,
+                 "float64,per-channel:true@1,scale:0.5:0.25:2,zero-point:1:-2:3",
+                 "4:3", _NNS_INT8, input, _NNS_FLOAT64, output),
+      GST_FLOW_OK);
+
+  for (i = 0; i < array_size; i++) {
+    ch = i / 4;
+    EXPECT_DOUBLE_EQ (output[i], (input[i] - zero_points[ch]) * scales[ch]);
+  }
+}
+
+/**
+ * @brief Test for tensor_transform quantize with the invalid number of channels
+ */
+TEST (testTensorTransform, quantizeInvalidChannels_n)
+{
+  float input[3 * 4] = { 0 };
+  uint8_t output[3 * 4];
+
+  EXPECT_NE (_transform_tensor_test_run (GTT_QUANTIZE,
+                 "uint8,per-channel:true@0,scale:0.5:0.25", "3:4",
+                 _NNS_FLOAT32, input, _NNS_UINT8, output),
+      GST_FLOW_OK);
+}
+
+/**
+ * @brief Test for tensor_transform dequantize with the invalid input type
+ */
+TEST (testTensorTransform, dequantizeInvalidType_n)
+{
+  float input[4] = { 0 };
+  float output[4];
+
+  EXPECT_NE (_transform_tensor_test_run (GTT_DEQUANTIZE, "float32,scale:0.5",
+                 "4", _NNS_FLOAT32, input, _NNS_FLOAT32, output),
+      GST_FLOW_OK);
+}
+
+/**
+ * @brief Test for invalid options of tensor_transform quantize and dequantize
+ */
+TEST (testTensorTransform, quantizeProperties_n)
+{
+  const struct {
+    tensor_transform_mode mode;
+    const gchar *option;
+  } invalid_options[] = {
+    /* quantized type should be an integer type */
+    { GTT_QUANTIZE, "float32,scale:0.5" },
+    /* scale is not given */
+    { GTT_QUANTIZE, "uint8,zero-point:128" },
+    /* scale should be a positive number */
+    { GTT_QUANTIZE, "uint8,scale:0" },
+    { GTT_QUANTIZE, "uint8,scale:-0.5" },
+    /* zero-point is out of the range of uint8 */
+    { GTT_QUANTIZE, "uint8,scale:0.5,zero-point:256" },
+    /* multiple scales without per-channel */
+    { GTT_QUANTIZE, "int8,scale:0.5:0.25" },
+    /* the number of scale and zero-point is different */
+    { GTT_QUANTIZE, "int8,per-channel:true@0,scale:0.5:0.25,zero-point:1:2:3" },
+    /* invalid dimension of channel */
+    { GTT_QUANTIZE, "int8,per-channel:true@99,scale:0.5" },
+    /* dequantized type should be a float type */
+    { GTT_DEQUANTIZE, "int8,scale:0.5" },
+    { GTT_DEQUANTIZE, "float32,scale:0.5,zero-point:1.5" },
+  };
+  GstHarness *h;
+  gchar *str = NULL;
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (invalid_options); i++) {
+    h = gst_harness_new ("tensor_transform");
+    ASSERT_TRUE (NULL != h);
+
+    g_object_set (h->element, "mode", invalid_options[i].mode, "option",
+        invalid_options[i].option, NULL);
+
+    g_object_get (h->element, "option", &str, NULL);
+    EXPECT_TRUE (str == NULL) << invalid_options[i].option;
+    g_free (str);
+    str = NULL;
+
+    gst_harness_teardown (h);
+  }
+}
+
+#ifdef FLOAT16_SUPPORT
+/**
+ * @brief Test for tensor_transform typecast from/to float16
+ */
+TEST (testTensorTransform, typecastFloat16)
+{
+  const guint array_size = 100; /* not aligned with the vector size */
+  float input[array_size], output[array_size];
+  float16 half[array_size];
+  uint8_t input_u8[array_size];
+  guint i;
+
+  for (i = 0; i < array_size; i++) {
+    input[i] = (i - 50.f) * 0.375f;
+    input_u8[i] = (uint8_t) (i * 2);
+  }
+  /* rounded to nearest even, and overflow */
+  input[3] = 2049.f;
+  input[4] = 2051.f;
+  input[5] = 70000.f;
+
+  ASSERT_EQ (_transform_tensor_test_run (GTT_TYPECAST, "float16", "100",
+                 _NNS_FLOAT32, input, _NNS_FLOAT16, half),
+      GST_FLOW_OK);
+  ASSERT_EQ (_transform_tensor_test_run (GTT_TYPECAST, "float32", "100",
+                 _NNS_FLOAT16, half, _NNS_FLOAT32, output),
+      GST_FLOW_OK);
+
+  for (i = 6; i < array_size; i++)
+    EXPECT_FLOAT_EQ (output[i], input[i]);
+  EXPECT_FLOAT_EQ (output[3], 2048.f);
+  EXPECT_FLOAT_EQ (output[4], 2052.f);
+  EXPECT_TRUE (std::isinf (output[5]));
+
+  ASSERT_EQ (_transform_tensor_test_run (GTT_TYPECAST, "float16", "100",
+                 _NNS_UINT8, input_u8, _NNS_FLOAT16, half),
+      GST_FLOW_OK);
+
+  for (i = 0; i < array_size; i++)
+    EXPECT_FLOAT_EQ ((float) half[i], (float) input_u8[i]);
+}
+
+/**
+ * @brief Test for tensor_transform arithmetic on float16 (rounded to float16 after each operator)
+ */
+TEST (testTensorTransform, arithmeticFloat16)
+{
+  const guint array_size = 100;
+  float16 input[array_size], output[array_size], expected;
+  guint i;
+
+  for (i = 0; i < array_size; i++)
+    input[i] = (float16) ((i - 50.f) * 0.1f);
+
+  ASSERT_EQ (_transform_tensor_test_run (GTT_ARITHMETIC, "mul:0.3,add:0.7,div:3",
+                 "100", _NNS_FLOAT16, input, _NNS_FLOAT16, output),
+      GST_FLOW_OK);
+
+  for (i = 0; i < array_size; i++) {
+    expected = (float16) ((float) input[i] * (float) (float16) 0.3f);
+    expected = (float16) ((float) expected + (float) (float16) 0.7f);
+    expected = (float16) ((float) expected / 3.f);
+
+    EXPECT_FLOAT_EQ ((float) output[i], (float) expected);
+  }
+}
+
+/**
+ * @brief Test for tensor_transform arithmetic from uint8 to float16 (typecast at first)
+ */
+TEST (testTensorTransform, arithmeticUint8ToFloat16)
+{
+  const guint array_size = 100;
+  uint8_t input[array_size];
+  float16 output[array_size];
+  guint i;
+
+  for (i = 0; i < array_size; i++)
+    input[i] = (uint8_t) (i * 2);
+
+  ASSERT_EQ (_transform_tensor_test_run (GTT_ARITHMETIC,
+                 "typecast:float16,add:-128,div:128", "100", _NNS_UINT8, input,
+                 _NNS_FLOAT16, output),
+      GST_FLOW_OK);
+
+  for (i = 0; i < array_size; i++)
+    EXPECT_FLOAT_EQ ((float) output[i], (input[i] - 128.f) / 128.f);
+}
+
+/**
+ * @brief Test for tensor_transform clamp on float16
+ */
+TEST (testTensorTransform, clampFloat16)
+{
+  const guint array_size = 100;
+  float16 input[array_size], output[array_size];
+  guint i;
+
+  for (i = 0; i < array_size; i++)
+    input[i] = (float16) ((i - 50.f) * 0.125f);
+
+  ASSERT_EQ (_transform_tensor_test_run (GTT_CLAMP, "-2.5:3.0001", "100",
+                 _NNS_FLOAT16, input, _NNS_FLOAT16, output),
+      GST_FLOW_OK);
+
+  for (i = 0; i < array_size; i++) {
+    /* 3.0001 is rounded to 3.0 in float16 */
+    EXPECT_FLOAT_EQ ((float) output[i], CLAMP ((float) input[i], -2.5f, 3.f));
+  }
+}
+
+/**
+ * @brief Test for tensor_transform stand on float16
+ */
+TEST (testTensorTransform, standFloat16)
+{
+  const guint array_size = 100;
+  float16 input[array_size], output[array_size];
+  float output_f32[array_size];
+  double output_f64[array_size];
+  double average = 0.0;
+  guint i;
+
+  for (i = 0; i < array_size; i++) {
+    input[i] = (float16) (i * 0.25f);
+    average += (double) input[i];
+  }
+  average /= array_size;
+
+  ASSERT_EQ (_transform_tensor_test_run (GTT_STAND, "dc-average", "100",
+                 _NNS_FLOAT16, input, _NNS_FLOAT16, output),
+      GST_FLOW_OK);
+  ASSERT_EQ (_transform_tensor_test_run (GTT_STAND, "dc-average:float32",
+                 "100", _NNS_FLOAT16, input, _NNS_FLOAT32, output_f32),
+      GST_FLOW_OK);
+
+  for (i = 0; i < array_size; i++) {
+    EXPECT_FLOAT_EQ ((float) output[i], (float) (float16) ((double) input[i] - average));
+    EXPECT_FLOAT_EQ (output_f32[i], (float) ((double) input[i] - average));
+  }
+
+  /**
+   * The results are not representable in float16. Those of the elements 48 and 51
+   * are rounded differently if rounded to float32 first.
+   */
+  for (i = 0; i < array_size; i++)
+    input[i] = (float16) (i * 0.069f);
+
+  ASSERT_EQ (_transform_tensor_test_run (GTT_STAND, "dc-average", "100",
+                 _NNS_FLOAT16, input, _NNS_FLOAT16, output),
+      GST_FLOW_OK);
+  ASSERT_EQ (_transform_tensor_test_run (GTT_STAND, "dc-average:float64",
+                 "100", _NNS_FLOAT16, input, _NNS_FLOAT64, output_f64),
+      GST_FLOW_OK);
+
+  for (i = 0; i < array_size; i++)
+    EXPECT_FLOAT_EQ ((float) output[i], (float) (float16) output_f64[i]);
+
+  EXPECT_NE ((float) (float16) output_f64[48], (float) (float16) (float) output_f64[48]);
+  EXPECT_NE ((float) (float16) output_f64[51], (float) (float16) (float) output_f64[51]);
+}
+#endif /* FLOAT16_SUPPORT */
+
 /**
  * @brief Test data for tensor_aggregator (2 frames with dimension 3:4:2:2)
  */
@@ -3439,6 +3938,111 @@ TEST (testTensorConverter, flexToStaticInvalidBuffer2_n)
   gst_harness_teardown (h);
 }
 
+/**
+ * @brief Test for tensor_converter (video frame with stride in video meta)
+ */
+TEST (testTensorConverter, videoMetaStride)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstMapInfo map;
+  gsize offset[GST_VIDEO_MAX_PLANES] = { 0 };
+  gint stride[GST_VIDEO_MAX_PLANES] = { 0 };
+  guint8 *data;
+  guint i, received;
+
+  h = gst_harness_new ("tensor_converter");
+
+  /* gray 3x2, default stride in caps is 4 */
+  gst_harness_set_src_caps_str (h,
+      "video/x-raw,format=GRAY8,width=3,height=2,framerate=0/1");
+
+  /* upstream describes the frame with 8 bytes stride and 2 bytes offset */
+  in_buf = gst_harness_create_buffer (h, 18);
+  ASSERT_TRUE (gst_buffer_map (in_buf, &map, GST_MAP_WRITE));
+  memset (map.data, 0xFF, 18);
+  for (i = 0; i < 3; i++) {
+    map.data[2 + i] = i + 1;
+    map.data[10 + i] = i + 11;
+  }
+  gst_buffer_unmap (in_buf, &map);
+
+  offset[0] = 2;
+  stride[0] = 8;
+  gst_buffer_add_video_meta_full (in_buf, GST_VIDEO_FRAME_FLAG_NONE,
+      GST_VIDEO_FORMAT_GRAY8, 3, 2, 1, offset, stride);
+
+  EXPECT_EQ (GST_FLOW_OK, gst_harness_push (h, in_buf));
+  received = _harness_wait_for_output_buffer (h, 1);
+  EXPECT_EQ (received, 1U);
+
+  out_buf = gst_harness_pull (h);
+  EXPECT_EQ (gst_buffer_get_size (out_buf), 6U);
+  ASSERT_TRUE (gst_buffer_map (out_buf, &map, GST_MAP_READ));
+  data = map.data;
+  for (i = 0; i < 3; i++) {
+    EXPECT_EQ (data[i], i + 1);
+    EXPECT_EQ (data[3 + i], i + 11);
+  }
+  gst_buffer_unmap (out_buf, &map);
+  gst_buffer_unref (out_buf);
+
+  /* packed frame, converter shares the memory */
+  in_buf = gst_harness_create_buffer (h, 8);
+  ASSERT_TRUE (gst_buffer_map (in_buf, &map, GST_MAP_WRITE));
+  for (i = 0; i < 8; i++)
+    map.data[i] = i;
+  data = map.data;
+  gst_buffer_unmap (in_buf, &map);
+
+  offset[0] = 2;
+  stride[0] = 3;
+  gst_buffer_add_video_meta_full (in_buf, GST_VIDEO_FRAME_FLAG_NONE,
+      GST_VIDEO_FORMAT_GRAY8, 3, 2, 1, offset, stride);
+
+  EXPECT_EQ (GST_FLOW_OK, gst_harness_push (h, in_buf));
+  received = _harness_wait_for_output_buffer (h, 2);
+  EXPECT_EQ (received, 2U);
+
+  out_buf = gst_harness_pull (h);
+  EXPECT_EQ (gst_buffer_get_size (out_buf), 6U);
+  ASSERT_TRUE (gst_buffer_map (out_buf, &map, GST_MAP_READ));
+  EXPECT_TRUE (map.data == data + 2);
+  for (i = 0; i < 6; i++)
+    EXPECT_EQ (map.data[i], i + 2);
+  gst_buffer_unmap (out_buf, &map);
+  gst_buffer_unref (out_buf);
+
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_converter (video frame with invalid stride in video meta)
+ */
+TEST (testTensorConverter, videoMetaInvalidStride_n)
+{
+  GstHarness *h;
+  GstBuffer *in_buf;
+  gsize offset[GST_VIDEO_MAX_PLANES] = { 0 };
+  gint stride[GST_VIDEO_MAX_PLANES] = { 0 };
+
+  h = gst_harness_new ("tensor_converter");
+
+  gst_harness_set_src_caps_str (h,
+      "video/x-raw,format=GRAY8,width=3,height=2,framerate=0/1");
+
+  /* stride is smaller than the row */
+  in_buf = gst_harness_create_buffer (h, 8);
+  stride[0] = 2;
+  gst_buffer_add_video_meta_full (in_buf, GST_VIDEO_FRAME_FLAG_NONE,
+      GST_VIDEO_FORMAT_GRAY8, 3, 2, 1, offset, stride);
+
+  EXPECT_NE (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  EXPECT_EQ (gst_harness_buffers_received (h), 0U);
+  gst_harness_teardown (h);
+}
+
 #ifdef HAVE_ORC
 #include "nnstreamer-orc.h"
 
@@ -5125,6 +5729,197 @@ TEST_REQUIRE_TFLITE (testTensorFilter, reloadTFliteSetProperty)
   g_free (test_model2);
 }
 
+/**
+ * @brief Test to reload tf-lite model in background thread (reload-async)
+ */
+TEST_REQUIRE_TFLITE (testTensorFilter, reloadTFliteAsync)
+{
+  GstHarness *h;
+  GstBus *bus;
+  GstMessage *msg;
+  GstBuffer *in_buf, *out_buf;
+  gsize in_size, out_size;
+  GstTensorsConfig config;
+  gboolean prop_async, success = FALSE;
+  gchar *str_launch_line, *prop_string;
+  guint i;
+
+  const gchar *root_path = g_getenv ("NNSTREAMER_SOURCE_ROOT_PATH");
+  gchar *test_model, *test_model2;
+
+  /* supposed to run test in build directory */
+  if (root_path == NULL)
+    root_path = "..";
+
+  test_model = g_build_filename (root_path, "tests", "test_models", "models",
+      "mobilenet_v1_1.0_224_quant.tflite", NULL);
+  ASSERT_TRUE (g_file_test (test_model, G_FILE_TEST_EXISTS));
+
+  test_model2 = g_build_filename (root_path, "tests", "test_models", "models",
+      "mobilenet_v2_1.0_224_quant.tflite", NULL);
+  ASSERT_TRUE (g_file_test (test_model2, G_FILE_TEST_EXISTS));
+
+  h = gst_harness_new_empty ();
+  ASSERT_TRUE (h != NULL);
+
+  str_launch_line = g_strdup_printf ("tensor_filter framework=tensorflow-lite "
+                                     "reload-async=true model=%s",
+      test_model);
+  gst_harness_add_parse (h, str_launch_line);
+  g_free (str_launch_line);
+
+  bus = gst_bus_new ();
+  gst_element_set_bus (h->element, bus);
+
+  /* input tensor info */
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1U;
+  config.info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("3:224:224:1", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+
+  gst_harness_get (h, "tensor_filter", "reload-async", &prop_async, NULL);
+  EXPECT_TRUE (prop_async);
+
+  /* push buffer (dummy input RGB 224x224, output 1001) */
+  in_size = 3 * 224 * 224;
+  out_size = 1001;
+
+  in_buf = gst_harness_create_buffer (h, in_size);
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  out_buf = gst_harness_pull (h);
+  EXPECT_EQ (gst_buffer_get_size (out_buf), out_size);
+  gst_buffer_unref (out_buf);
+
+  /* set second model file, the model is swapped between invokes */
+  gst_harness_set (h, "tensor_filter", "model", test_model2, NULL);
+
+  for (i = 0; i < 100; i++) {
+    in_buf = gst_harness_create_buffer (h, in_size);
+    EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+    out_buf = gst_harness_pull (h);
+    EXPECT_EQ (gst_buffer_get_size (out_buf), out_size);
+    gst_buffer_unref (out_buf);
+
+    gst_harness_get (h, "tensor_filter", "model", &prop_string, NULL);
+    success = g_str_equal (prop_string, test_model2);
+    g_free (prop_string);
+
+    if (success)
+      break;
+
+    g_usleep (50000);
+  }
+
+  EXPECT_TRUE (success);
+
+  /* check the element message */
+  success = FALSE;
+  while ((msg = gst_bus_pop_filtered (bus, GST_MESSAGE_ELEMENT)) != NULL) {
+    const GstStructure *s = gst_message_get_structure (msg);
+
+    if (gst_structure_has_name (s, "nnstreamer-model-reloaded")) {
+      EXPECT_STREQ (gst_structure_get_string (s, "model"), test_model2);
+      EXPECT_TRUE (gst_structure_get_boolean (s, "success", &success));
+    }
+
+    gst_message_unref (msg);
+  }
+
+  EXPECT_TRUE (success);
+
+  gst_harness_teardown (h);
+  gst_object_unref (bus);
+  g_free (test_model);
+  g_free (test_model2);
+}
+
+/**
+ * @brief Test to reload tf-lite model in background thread with invalid model (negative)
+ */
+TEST_REQUIRE_TFLITE (testTensorFilter, reloadTFliteAsyncInvalidModel_n)
+{
+  GstHarness *h;
+  GstBus *bus;
+  GstMessage *msg;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorsConfig config;
+  gboolean success = TRUE, posted = FALSE;
+  gchar *str_launch_line, *prop_string;
+
+  const gchar *root_path = g_getenv ("NNSTREAMER_SOURCE_ROOT_PATH");
+  gchar *test_model;
+
+  /* supposed to run test in build directory */
+  if (root_path == NULL)
+    root_path = "..";
+
+  test_model = g_build_filename (root_path, "tests", "test_models", "models",
+      "mobilenet_v1_1.0_224_quant.tflite", NULL);
+  ASSERT_TRUE (g_file_test (test_model, G_FILE_TEST_EXISTS));
+
+  h = gst_harness_new_empty ();
+  ASSERT_TRUE (h != NULL);
+
+  str_launch_line = g_strdup_printf ("tensor_filter framework=tensorflow-lite "
+                                     "reload-async=true model=%s",
+      test_model);
+  gst_harness_add_parse (h, str_launch_line);
+  g_free (str_launch_line);
+
+  bus = gst_bus_new ();
+  gst_element_set_bus (h->element, bus);
+
+  /* input tensor info */
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1U;
+  config.info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("3:224:224:1", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+
+  in_buf = gst_harness_create_buffer (h, 3 * 224 * 224);
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  out_buf = gst_harness_pull (h);
+  gst_buffer_unref (out_buf);
+
+  /* the model does not exist, the stream continues with the old model */
+  gst_harness_set (h, "tensor_filter", "model", "invalid_model.tflite", NULL);
+
+  msg = gst_bus_timed_pop_filtered (bus, 5 * GST_SECOND, GST_MESSAGE_ELEMENT);
+  ASSERT_TRUE (msg != NULL);
+  if (gst_structure_has_name (gst_message_get_structure (msg),
+          "nnstreamer-model-reloaded")) {
+    posted = gst_structure_get_boolean (gst_message_get_structure (msg),
+        "success", &success);
+  }
+  gst_message_unref (msg);
+
+  EXPECT_TRUE (posted);
+  EXPECT_FALSE (success);
+
+  gst_harness_get (h, "tensor_filter", "model", &prop_string, NULL);
+  EXPECT_STREQ (prop_string, test_model);
+  g_free (prop_string);
+
+  in_buf = gst_harness_create_buffer (h, 3 * 224 * 224);
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  out_buf = gst_harness_pull (h);
+  EXPECT_EQ (gst_buffer_get_size (out_buf), 1001U);
+  gst_buffer_unref (out_buf);
+
+  gst_harness_teardown (h);
+  gst_object_unref (bus);
+  g_free (test_model);
+}
+
 /**
  * @brief Test to reload tf-lite; model does not exist (negative)
  */
@@ -7518,6 +8313,207 @@ TEST (testTensorSparse, utilConvert)
   EXPECT_FALSE (failed);
 }
 
+/**
+ * @brief Test for tensor_sparse util, sparse tensor with each encoding.
+ */
+TEST (testTensorSparse, utilConvertEncoding)
+{
+  const gchar *encodings[] = { "coo", "bitmap", "delta", "csr", "auto" };
+  GstMemory *sparse, *dense, *origin;
+  GstMapInfo map;
+  GstTensorInfo info;
+  GstTensorMetaInfo meta;
+  tensor_sparse_encoding encoding;
+  gsize data_size, sparse_size;
+  gfloat *data;
+  guint e, i;
+
+  gst_tensor_info_init (&info);
+  info.type = _NNS_FLOAT32;
+  gst_tensor_parse_dimension ("30:10", info.dimension);
+  data_size = gst_tensor_info_get_size (&info);
+
+  data = (gfloat *) g_malloc0 (data_size);
+  for (i = 0; i < 300U; i += 7)
+    data[i] = (gfloat) i + 0.5f;
+  data[299] = -1.0f;
+
+  origin = gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY,
+      data, data_size, 0, data_size, data, g_free);
+
+  for (e = 0; e < G_N_ELEMENTS (encodings); e++) {
+    encoding = gst_tensor_sparse_get_encoding (encodings[e]);
+    EXPECT_TRUE (encoding <= GST_TENSOR_SPARSE_ENCODING_AUTO);
+
+    gst_tensor_info_convert_to_meta (&info, &meta);
+    meta.sparse_info.encoding = encoding;
+
+    sparse = gst_tensor_sparse_from_dense (&meta, origin);
+    ASSERT_TRUE (sparse != NULL);
+    EXPECT_EQ (meta.sparse_info.nnz, 44U);
+
+    /* exact size of sparse tensor */
+    sparse_size = gst_memory_get_sizes (sparse, NULL, NULL);
+    EXPECT_EQ (sparse_size, gst_tensor_meta_info_get_header_size (&meta)
+        + gst_tensor_meta_info_get_data_size (&meta));
+
+    /* bitmap (38 bytes) is the smallest for this tensor */
+    if (encoding == GST_TENSOR_SPARSE_ENCODING_AUTO)
+      EXPECT_EQ (meta.sparse_info.encoding, (guint) _NNS_SPARSE_ENCODING_BITMAP);
+
+    dense = gst_tensor_sparse_to_dense (&meta, sparse);
+    ASSERT_TRUE (dense != NULL);
+    EXPECT_EQ (meta.format, (guint) _NNS_TENSOR_FORMAT_STATIC);
+
+    ASSERT_TRUE (gst_memory_map (dense, &map, GST_MAP_READ));
+    EXPECT_EQ (map.size, data_size);
+    for (i = 0; i < 300U; i++)
+      EXPECT_FLOAT_EQ (((gfloat *) map.data)[i], data[i]);
+    gst_memory_unmap (dense, &map);
+
+    gst_memory_unref (sparse);
+    gst_memory_unref (dense);
+  }
+
+  gst_memory_unref (origin);
+  gst_tensor_info_free (&info);
+}
+
+/**
+ * @brief Test for tensor_sparse util, invalid encoding.
+ */
+TEST (testTensorSparse, utilInvalidEncoding_n)
+{
+  GstMemory *sparse, *dense;
+  GstMapInfo map;
+  GstTensorInfo info;
+  GstTensorMetaInfo meta;
+  gsize data_size;
+  guint8 *data;
+
+  EXPECT_TRUE (gst_tensor_sparse_get_encoding ("invalid") >
+      GST_TENSOR_SPARSE_ENCODING_AUTO);
+  EXPECT_TRUE (gst_tensor_sparse_get_encoding (NULL) >
+      GST_TENSOR_SPARSE_ENCODING_AUTO);
+
+  gst_tensor_info_init (&info);
+  info.type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("16", info.dimension);
+  data_size = gst_tensor_info_get_size (&info);
+
+  data = (guint8 *) g_malloc0 (data_size);
+  data[3] = data[10] = 1;
+  dense = gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY,
+      data, data_size, 0, data_size, data, g_free);
+
+  gst_tensor_info_convert_to_meta (&info, &meta);
+  meta.sparse_info.encoding = GST_TENSOR_SPARSE_ENCODING_AUTO + 1;
+  EXPECT_TRUE (gst_tensor_sparse_from_dense (&meta, dense) == NULL);
+
+  /* index out of range */
+  gst_tensor_info_convert_to_meta (&info, &meta);
+  meta.sparse_info.encoding = _NNS_SPARSE_ENCODING_COO;
+  sparse = gst_tensor_sparse_from_dense (&meta, dense);
+  ASSERT_TRUE (sparse != NULL);
+
+  ASSERT_TRUE (gst_memory_map (sparse, &map, GST_MAP_WRITE));
+  map.data[gst_tensor_meta_info_get_header_size (&meta) + 2] = 100;
+  gst_memory_unmap (sparse, &map);
+
+  EXPECT_TRUE (gst_tensor_sparse_to_dense (&meta, sparse) == NULL);
+
+  gst_memory_unref (sparse);
+
+  /* delta out of range (gaps 3 and 6, the second one is changed to 127) */
+  gst_tensor_info_convert_to_meta (&info, &meta);
+  meta.sparse_info.encoding = _NNS_SPARSE_ENCODING_DELTA;
+  sparse = gst_tensor_sparse_from_dense (&meta, dense);
+  ASSERT_TRUE (sparse != NULL);
+
+  ASSERT_TRUE (gst_memory_map (sparse, &map, GST_MAP_WRITE));
+  EXPECT_EQ (map.data[gst_tensor_meta_info_get_header_size (&meta) + 3], 6U);
+  map.data[gst_tensor_meta_info_get_header_size (&meta) + 3] = 0x7F;
+  gst_memory_unmap (sparse, &map);
+
+  EXPECT_TRUE (gst_tensor_sparse_to_dense (&meta, sparse) == NULL);
+
+  gst_memory_unref (sparse);
+  gst_memory_unref (dense);
+  gst_tensor_info_free (&info);
+}
+
+/**
+ * @brief Test for tensor_sparse util, the version of header with sparse encoding.
+ */
+TEST (testTensorSparse, utilHeaderVersion)
+{
+  GstMemory *sparse, *dense;
+  GstMapInfo map;
+  GstTensorInfo info;
+  GstTensorMetaInfo meta;
+  guint32 header[32], version;
+  guint major, minor;
+  gsize data_size;
+  guint8 *data;
+
+  gst_tensor_info_init (&info);
+  info.type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("16", info.dimension);
+  data_size = gst_tensor_info_get_size (&info);
+
+  data = (guint8 *) g_malloc0 (data_size);
+  data[3] = data[10] = 1;
+  dense = gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY,
+      data, data_size, 0, data_size, data, g_free);
+
+  /* COO is compatible with the version 1.0 */
+  gst_tensor_info_convert_to_meta (&info, &meta);
+  meta.sparse_info.encoding = _NNS_SPARSE_ENCODING_COO;
+  sparse = gst_tensor_sparse_from_dense (&meta, dense);
+  ASSERT_TRUE (sparse != NULL);
+  ASSERT_TRUE (gst_tensor_meta_info_parse_memory (&meta, sparse));
+  gst_tensor_meta_info_get_version (&meta, &major, &minor);
+  EXPECT_EQ (major, 1U);
+  EXPECT_EQ (minor, 0U);
+  gst_memory_unref (sparse);
+
+  /* other encodings need the version 1.1 */
+  gst_tensor_info_convert_to_meta (&info, &meta);
+  meta.sparse_info.encoding = _NNS_SPARSE_ENCODING_DELTA;
+  sparse = gst_tensor_sparse_from_dense (&meta, dense);
+  ASSERT_TRUE (sparse != NULL);
+  ASSERT_TRUE (gst_tensor_meta_info_parse_memory (&meta, sparse));
+  gst_tensor_meta_info_get_version (&meta, &major, &minor);
+  EXPECT_EQ (major, 1U);
+  EXPECT_EQ (minor, 1U);
+  EXPECT_EQ (meta.sparse_info.encoding, (guint) _NNS_SPARSE_ENCODING_DELTA);
+
+  ASSERT_TRUE (gst_memory_map (sparse, &map, GST_MAP_READ));
+  memcpy (header, map.data, sizeof (header));
+  gst_memory_unmap (sparse, &map);
+  gst_memory_unref (sparse);
+
+  version = header[0];
+
+  /* the encoding is ignored in the version 1.0 */
+  header[0] = version - 1;
+  EXPECT_TRUE (gst_tensor_meta_info_parse_header (&meta, header));
+  EXPECT_EQ (meta.sparse_info.encoding, (guint) _NNS_SPARSE_ENCODING_COO);
+
+  /* unknown encoding */
+  header[0] = version;
+  header[21] = _NNS_SPARSE_ENCODING_END;
+  EXPECT_FALSE (gst_tensor_meta_info_parse_header (&meta, header));
+
+  /* unknown version */
+  header[0] = version + 1;
+  header[21] = _NNS_SPARSE_ENCODING_DELTA;
+  EXPECT_FALSE (gst_tensor_meta_info_parse_header (&meta, header));
+
+  gst_memory_unref (dense);
+  gst_tensor_info_free (&info);
+}
+
 /**
  * @brief Test for tensor_sparse util, invalid tensor-meta.
  */
@@ -0,0 +1,222 @@
+/**
+ * @file        unittest_protobuf.cc
+ * @date        19 Oct 2026
+ * @brief       Unit test for protobuf converter and decoder
+ * @see         https://github.com/nnstreamer/nnstreamer
+ * @author      agent <agent@local>
+ * @bug         No known bugs
+ */
+
+#include <gtest/gtest.h>
+#include <glib.h>
+#include <gst/gst.h>
+#include <nnstreamer_plugin_api.h>
+#include <nnstreamer_util.h>
+#include <string>
+#include "nnstreamer.pb.h"
+#include "nnstreamer_protobuf.h"
+
+/**
+ * @brief Set the config of the test tensors.
+ */
+static void
+_set_test_config (GstTensorsConfig *config)
+{
+  gst_tensors_config_init (config);
+
+  config->rate_n = -30;
+  config->rate_d = 1;
+  config->info.num_tensors = 2;
+
+  config->info.info[0].name = g_strdup ("input");
+  config->info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("3:40:30:1", config->info.info[0].dimension);
+
+  config->info.info[1].name = NULL;
+  config->info.info[1].type = _NNS_INT32;
+  gst_tensor_parse_dimension ("10:1:1:1", config->info.info[1].dimension);
+}
+
+/**
+ * @brief Serialize the tensors with the generated classes.
+ */
+static std::string
+_serialize_with_generated (const GstTensorsConfig *config, const GstTensorMemory *mem)
+{
+  nnstreamer::protobuf::Tensors tensors;
+  nnstreamer::protobuf::Tensors::frame_rate *fr;
+  std::string serialized;
+
+  tensors.set_num_tensor (config->info.num_tensors);
+  fr = tensors.mutable_fr ();
+  fr->set_rate_n (config->rate_n);
+  fr->set_rate_d (config->rate_d);
+  tensors.set_format ((nnstreamer::protobuf::Tensors::Tensor_format) config->format);
+
+  for (guint i = 0; i < config->info.num_tensors; i++) {
+    nnstreamer::protobuf::Tensor *tensor = tensors.add_tensor ();
+    const gchar *name = config->info.info[i].name;
+
+    tensor->set_name (name ? name : "");
+    tensor->set_type ((nnstreamer::protobuf::Tensor::Tensor_type) config->info.info[i].type);
+    for (guint j = 0; j < NNS_TENSOR_RANK_LIMIT; j++)
+      tensor->add_dimension (config->info.info[i].dimension[j]);
+    tensor->set_data (mem[i].data, mem[i].size);
+  }
+
+  tensors.SerializeToString (&serialized);
+  return serialized;
+}
+
+/**
+ * @brief Test for protobuf decoder, the wire format should be the same with the generated classes.
+ */
+TEST (testProtobuf, decoderWireFormat)
+{
+  GstTensorsConfig config;
+  GstTensorMemory mem[2];
+  GstBuffer *outbuf;
+  GstMapInfo map;
+  std::string expected;
+  guint i;
+
+  _set_test_config (&config);
+
+  for (i = 0; i < config.info.num_tensors; i++) {
+    mem[i].size = gst_tensor_info_get_size (&config.info.info[i]);
+    mem[i].data = g_malloc (mem[i].size);
+    for (gsize j = 0; j < mem[i].size; j++)
+      ((guint8 *) mem[i].data)[j] = (guint8) (j * 7 + i);
+  }
+
+  expected = _serialize_with_generated (&config, mem);
+
+  outbuf = gst_buffer_new ();
+  EXPECT_EQ (GST_FLOW_OK, gst_tensor_decoder_protobuf (&config, mem, outbuf));
+
+  ASSERT_TRUE (gst_buffer_map (outbuf, &map, GST_MAP_READ));
+  ASSERT_EQ (map.size, expected.size ());
+  EXPECT_EQ (0, memcmp (map.data, expected.data (), map.size));
+  gst_buffer_unmap (outbuf, &map);
+
+  gst_buffer_unref (outbuf);
+  for (i = 0; i < config.info.num_tensors; i++)
+    g_free (mem[i].data);
+  gst_tensors_config_free (&config);
+}
+
+/**
+ * @brief Test for protobuf converter, the tensor data should be shared with the input buffer.
+ */
+TEST (testProtobuf, converterSharedMemory)
+{
+  GstTensorsConfig config, parsed;
+  GstTensorMemory mem[2];
+  GstBuffer *inbuf, *outbuf;
+  GstMapInfo in_map, out_map;
+  std::string serialized;
+  guint i;
+
+  _set_test_config (&config);
+
+  for (i = 0; i < config.info.num_tensors; i++) {
+    mem[i].size = gst_tensor_info_get_size (&config.info.info[i]);
+    mem[i].data = g_malloc (mem[i].size);
+    for (gsize j = 0; j < mem[i].size; j++)
+      ((guint8 *) mem[i].data)[j] = (guint8) (j * 3 + i);
+  }
+
+  serialized = _serialize_with_generated (&config, mem);
+  inbuf = gst_buffer_new_wrapped (
+      _g_memdup (serialized.data (), serialized.size ()), serialized.size ());
+
+  gst_tensors_config_init (&parsed);
+  outbuf = gst_tensor_converter_protobuf (inbuf, &parsed, NULL);
+  ASSERT_TRUE (outbuf != NULL);
+
+  EXPECT_EQ (parsed.rate_n, config.rate_n);
+  EXPECT_EQ (parsed.rate_d, config.rate_d);
+  EXPECT_EQ (parsed.format, config.format);
+  EXPECT_TRUE (gst_tensors_info_is_equal (&parsed.info, &config.info));
+  ASSERT_EQ (gst_buffer_n_memory (outbuf), config.info.num_tensors);
+
+  ASSERT_TRUE (gst_buffer_map (inbuf, &in_map, GST_MAP_READ));
+  for (i = 0; i < config.info.num_tensors; i++) {
+    GstMemory *out_mem = gst_buffer_peek_memory (outbuf, i);
+
+    ASSERT_TRUE (gst_memory_map (out_mem, &out_map, GST_MAP_READ));
+    ASSERT_EQ (out_map.size, mem[i].size);
+    EXPECT_EQ (0, memcmp (out_map.data, mem[i].data, out_map.size));
+
+    /* no copy, the data is in the input buffer */
+    EXPECT_TRUE (out_map.data > in_map.data);
+    EXPECT_TRUE (out_map.data + out_map.size <= in_map.data + in_map.size);
+    gst_memory_unmap (out_mem, &out_map);
+  }
+  gst_buffer_unmap (inbuf, &in_map);
+
+  gst_buffer_unref (outbuf);
+  gst_buffer_unref (inbuf);
+  for (i = 0; i < config.info.num_tensors; i++)
+    g_free (mem[i].data);
+  gst_tensors_config_free (&parsed);
+  gst_tensors_config_free (&config);
+}
+
+/**
+ * @brief Test for protobuf converter with the truncated message.
+ */
+TEST (testProtobuf, converterTruncated_n)
+{
+  GstTensorsConfig config, parsed;
+  GstTensorMemory mem[2];
+  GstBuffer *inbuf, *outbuf;
+  std::string serialized;
+  guint i;
+
+  _set_test_config (&config);
+
+  for (i = 0; i < config.info.num_tensors; i++) {
+    mem[i].size = gst_tensor_info_get_size (&config.info.info[i]);
+    mem[i].data = g_malloc0 (mem[i].size);
+  }
+
+  serialized = _serialize_with_generated (&config, mem);
+  inbuf = gst_buffer_new_wrapped (
+      _g_memdup (serialized.data (), serialized.size () / 2), serialized.size () / 2);
+
+  gst_tensors_config_init (&parsed);
+  outbuf = gst_tensor_converter_protobuf (inbuf, &parsed, NULL);
+  EXPECT_TRUE (outbuf == NULL);
+
+  gst_buffer_unref (inbuf);
+  for (i = 0; i < config.info.num_tensors; i++)
+    g_free (mem[i].data);
+  gst_tensors_config_free (&parsed);
+  gst_tensors_config_free (&config);
+}
+
+/**
+ * @brief Main GTest
+ */
+int
+main (int argc, char **argv)
+{
+  int result = -1;
+
+  try {
+    testing::InitGoogleTest (&argc, argv);
+  } catch (...) {
+    g_warning ("catch 'testing::internal::<unnamed>::ClassUniqueToAlwaysTrue'");
+  }
+
+  gst_init (&argc, &argv);
+
+  try {
+    result = RUN_ALL_TESTS ();
+  } catch (...) {
+    g_warning ("catch `testing::internal::GoogleTestFailureException`");
+  }
+
+  return result;
+}
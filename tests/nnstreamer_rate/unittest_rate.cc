@@ -13,6 +13,7 @@
 
 #include <nnstreamer_plugin_api_filter.h>
 #include <nnstreamer_plugin_api.h>
+#include <tensor_filter_custom_easy.h>
 
 #define NNS_TENSOR_RATE_NAME "tensor_rate"
 
@@ -54,6 +55,7 @@ protected:
     TENSOR_RATE_MODE_PASSTHROUGH = 0,
     TENSOR_RATE_MODE_NO_THROTTLE,
     TENSOR_RATE_MODE_THROTTLE,
+    TENSOR_RATE_MODE_TARGET_LATENCY,
   };
 
   guint source_num_buffers;
@@ -65,6 +67,7 @@ protected:
   gchar *source_framerate;
   GstElement *rate;
   TestMode mode;
+  guint target_latency;
 
   const gboolean DEFAULT_SILENT = TRUE;
   const gboolean DEFAULT_THROTTLE = FALSE;
@@ -75,6 +78,7 @@ protected:
   const guint64 DEFAULT_OUT = 0;
   const guint64 DEFAULT_DUP = 0;
   const guint64 DEFAULT_DROP = 0;
+  const guint DEFAULT_TARGET_LATENCY = 0;
 
   /**
    * @brief Construct a new NNSRateTest object
@@ -82,7 +86,8 @@ protected:
   NNSRateTest() :
     source_num_buffers (0), target_framerate (nullptr), framework (nullptr),
     modelpath (nullptr), pipeline (nullptr), silent (FALSE), throttle (FALSE),
-    source_framerate (nullptr), rate (nullptr), mode (TENSOR_RATE_MODE_PASSTHROUGH) {}
+    source_framerate (nullptr), rate (nullptr), mode (TENSOR_RATE_MODE_PASSTHROUGH),
+    target_latency (0) {}
 
   /**
    * @brief Wait until the EOS message is received or the timeout is expired.
@@ -133,6 +138,7 @@ protected:
     source_framerate = const_cast<char *>(DEFAULT_SOURCE_FRAMERATE.c_str());
     target_framerate = const_cast<char *>(DEFAULT_TARGET_FRAMERATE.c_str());
     mode = TENSOR_RATE_MODE_PASSTHROUGH;
+    target_latency = DEFAULT_TARGET_LATENCY;
   }
 
   /**
@@ -195,6 +201,18 @@ protected:
           silent ? "TRUE" : "FALSE");
         break;
 
+      case TENSOR_RATE_MODE_TARGET_LATENCY:
+        str_pipeline = g_strdup_printf (
+          "videotestsrc num-buffers=%u ! video/x-raw,format=RGB,width=16,height=16,framerate=%s ! "
+          "tensor_converter ! tensor_rate name=rate throttle=FALSE target-latency=%u silent=%s ! "
+          "queue ! tensor_filter framework=custom-easy model=%s ! fakesink",
+          source_num_buffers,
+          source_framerate,
+          target_latency,
+          silent ? "TRUE" : "FALSE",
+          modelpath);
+        break;
+
       default:
         return FALSE;
     }
@@ -211,6 +229,7 @@ TEST_F (NNSRateTest, getPropertyDefault)
 {
   gboolean silent, throttle;
   guint64 in, out, dup, drop;
+  guint target_latency;
   g_autofree gchar *framerate = nullptr;
 
   ASSERT_TRUE (setupPipeline());
@@ -238,6 +257,9 @@ TEST_F (NNSRateTest, getPropertyDefault)
 
   g_object_get (rate, "drop", &drop, NULL);
   EXPECT_EQ (drop, DEFAULT_DROP);
+
+  g_object_get (rate, "target-latency", &target_latency, NULL);
+  EXPECT_EQ (target_latency, DEFAULT_TARGET_LATENCY);
 }
 
 /**
@@ -246,6 +268,7 @@ TEST_F (NNSRateTest, getPropertyDefault)
 TEST_F (NNSRateTest, setProperty)
 {
   gboolean silent, throttle;
+  guint target_latency;
   g_autofree gchar *framerate = nullptr;
 
   ASSERT_TRUE (setupPipeline());
@@ -264,6 +287,10 @@ TEST_F (NNSRateTest, setProperty)
   g_object_set (rate, "framerate", "15/1", NULL);
   g_object_get (rate, "framerate", &framerate, NULL);
   EXPECT_STREQ ("15/1", framerate);
+
+  g_object_set (rate, "target-latency", 30U, NULL);
+  g_object_get (rate, "target-latency", &target_latency, NULL);
+  EXPECT_EQ (30U, target_latency);
 }
 
 /**
@@ -435,6 +462,114 @@ TEST_F (NNSRateTest, throttling)
   g_free (framework);
 }
 
+/**
+ * @brief Custom-easy invoke function which takes a long time.
+ */
+static int
+slow_passthrough_invoke (void *data, const GstTensorFilterProperties *prop,
+    const GstTensorMemory *in, GstTensorMemory *out)
+{
+  UNUSED (data);
+  UNUSED (prop);
+
+  g_usleep (10000);
+  memcpy (out[0].data, in[0].data, MIN (in[0].size, out[0].size));
+  return 0;
+}
+
+/**
+ * @brief Register the slow custom-easy filter.
+ */
+static int
+register_slow_filter (const gchar *name)
+{
+  GstTensorsInfo info;
+
+  gst_tensors_info_init (&info);
+  info.num_tensors = 1U;
+  info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("3:16:16:1", info.info[0].dimension);
+
+  return NNS_custom_easy_register (name, slow_passthrough_invoke, NULL, &info, &info);
+}
+
+/**
+ * @brief Test tensor_rate drops frames when downstream filter is slower than the target latency
+ */
+TEST_F (NNSRateTest, targetLatency)
+{
+  guint64 in, out, dup, drop;
+
+  ASSERT_EQ (register_slow_filter ("rate_slow_filter"), 0);
+
+  modelpath = g_strdup ("rate_slow_filter");
+  mode = NNSRateTest::TENSOR_RATE_MODE_TARGET_LATENCY;
+  source_num_buffers = 100;
+  target_latency = 5;
+  ASSERT_TRUE (setupPipeline ());
+
+  GstElement *rate = getRateElem ();
+  ASSERT_TRUE (rate != NULL);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PLAYING,
+        UNITTEST_STATECHANGE_TIMEOUT), 0);
+  EXPECT_TRUE (NNSRateTest::wait_pipeline_eos (pipeline));
+
+  g_object_get (rate, "in", &in, NULL);
+  g_object_get (rate, "out", &out, NULL);
+  g_object_get (rate, "duplicate", &dup, NULL);
+  g_object_get (rate, "drop", &drop, NULL);
+
+  /** the source is not live, frames are queued and should be dropped */
+  EXPECT_EQ (in, source_num_buffers);
+  EXPECT_EQ (0U, dup);
+  EXPECT_GT (drop, 0U);
+  EXPECT_EQ (in, out + drop);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_NULL,
+        UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  g_free (modelpath);
+  EXPECT_EQ (NNS_custom_easy_unregister ("rate_slow_filter"), 0);
+}
+
+/**
+ * @brief Test tensor_rate does not drop frames without target latency
+ */
+TEST_F (NNSRateTest, targetLatencyDisabled)
+{
+  guint64 in, out, drop;
+
+  ASSERT_EQ (register_slow_filter ("rate_slow_filter"), 0);
+
+  modelpath = g_strdup ("rate_slow_filter");
+  mode = NNSRateTest::TENSOR_RATE_MODE_TARGET_LATENCY;
+  source_num_buffers = 30;
+  target_latency = 0;
+  ASSERT_TRUE (setupPipeline ());
+
+  GstElement *rate = getRateElem ();
+  ASSERT_TRUE (rate != NULL);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PLAYING,
+        UNITTEST_STATECHANGE_TIMEOUT), 0);
+  EXPECT_TRUE (NNSRateTest::wait_pipeline_eos (pipeline));
+
+  g_object_get (rate, "in", &in, NULL);
+  g_object_get (rate, "out", &out, NULL);
+  g_object_get (rate, "drop", &drop, NULL);
+
+  EXPECT_EQ (in, source_num_buffers);
+  EXPECT_EQ (out, source_num_buffers);
+  EXPECT_EQ (0U, drop);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_NULL,
+        UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  g_free (modelpath);
+  EXPECT_EQ (NNS_custom_easy_unregister ("rate_slow_filter"), 0);
+}
+
 /**
  * @brief gtest main
  */
@@ -116,6 +116,7 @@ typedef enum {
   TEST_TYPE_CUSTOM_MULTI, /**< pipeline with multiple custom filters */
   TEST_TYPE_CUSTOM_BUF_DROP, /**< pipeline to test buffer-drop in tensor_filter using custom filter */
   TEST_TYPE_CUSTOM_PASSTHROUGH, /**< pipeline to test custom passthrough without so file */
+  TEST_TYPE_CUSTOM_PASSTHROUGH_ASYNC, /**< pipeline to test asynchronous invoke of custom passthrough without so file */
   TEST_TYPE_NEGO_FAILED, /**< pipeline to test caps negotiation */
   TEST_TYPE_VIDEO_RGB_SPLIT, /**< pipeline to test tensor_split */
   TEST_TYPE_VIDEO_RGB_AGGR_1, /**< pipeline to test tensor_aggregator (change dimension index 3 : 1 > 10)*/
@@ -165,6 +166,8 @@ typedef struct {
   guint mem_blocks; /**< memory blocks in received buffer */
   gsize received_size; /**< received buffer size */
   gboolean invalid_timestamp; /**< flag to check timestamp */
+  gboolean unordered_timestamp; /**< flag to check the order of timestamp */
+  GstClockTime last_pts; /**< timestamp of the last received buffer */
   gboolean test_failed; /**< flag to indicate error */
   gboolean start; /**< stream started (for tensor_sink signal) */
   gboolean end; /**< eos reached (for tensor_sink signal) */
@@ -298,6 +301,12 @@ _new_data_cb (GstElement *element, GstBuffer *buffer, gpointer user_data)
     g_test_data.invalid_timestamp = TRUE;
   }
 
+  if (GST_CLOCK_TIME_IS_VALID (g_test_data.last_pts) &&
+      GST_BUFFER_PTS (buffer) <= g_test_data.last_pts) {
+    g_test_data.unordered_timestamp = TRUE;
+  }
+  g_test_data.last_pts = GST_BUFFER_PTS (buffer);
+
   g_test_data.received++;
   g_test_data.received_size = buf_size;
   g_test_data.mem_blocks = mem_blocks;
@@ -527,6 +536,8 @@ _setup_pipeline (TestOption &option)
   g_test_data.mem_blocks = 0;
   g_test_data.received_size = 0;
   g_test_data.invalid_timestamp = FALSE;
+  g_test_data.unordered_timestamp = FALSE;
+  g_test_data.last_pts = GST_CLOCK_TIME_NONE;
   g_test_data.test_failed = FALSE;
   g_test_data.start = FALSE;
   g_test_data.end = FALSE;
@@ -945,6 +956,13 @@ _setup_pipeline (TestOption &option)
         "tensor_converter ! tensor_filter framework=custom-passthrough ! tensor_sink name=test_sink",
         option.num_buffers, fps);
     break;
+  case TEST_TYPE_CUSTOM_PASSTHROUGH_ASYNC:
+    /* video 160x120 RGB, passthrough custom filter without so file, asynchronous invoke */
+    str_pipeline = g_strdup_printf (
+        "videotestsrc num-buffers=%d ! videoconvert ! video/x-raw,width=160,height=120,format=RGB,framerate=(fraction)%lu/1 ! "
+        "tensor_converter ! tensor_filter framework=custom-passthrough max-inflight=4 ! tensor_sink name=test_sink",
+        option.num_buffers, fps);
+    break;
   case TEST_TYPE_NEGO_FAILED:
     /** caps negotiation failed */
     str_pipeline = g_strdup_printf ("videotestsrc num-buffers=%d ! videoconvert ! video/x-raw,width=160,height=120,format=RGB,framerate=(fraction)%lu/1 ! "
@@ -4106,6 +4124,52 @@ test_custom_v1_getFWInfo (const GstTensorFilterFramework *self,
   return 0;
 }
 
+/**
+ * @brief The number of in-place invokes (output == input) of the custom filter.
+ */
+static guint test_custom_in_place_count = 0;
+
+/**
+ * @brief The mandatory callback for GstTensorFilterFramework (v1), in-place invoke.
+ */
+static int
+test_custom_v1_invoke_in_place (const GstTensorFilterFramework *self,
+    const GstTensorFilterProperties *prop, void *private_data,
+    const GstTensorMemory *input, GstTensorMemory *output)
+{
+  guint i, num;
+  gboolean in_place = TRUE;
+
+  num = prop->input_meta.num_tensors;
+
+  for (i = 0; i < num; i++) {
+    g_assert (input[i].size == output[i].size);
+
+    if (input[i].data != output[i].data) {
+      in_place = FALSE;
+      memcpy (output[i].data, input[i].data, input[i].size);
+    }
+  }
+
+  if (in_place)
+    test_custom_in_place_count++;
+
+  return 0;
+}
+
+/**
+ * @brief The mandatory callback for GstTensorFilterFramework (v1), allows in-place invoke.
+ */
+static int
+test_custom_v1_getFWInfo_in_place (const GstTensorFilterFramework *self,
+    const GstTensorFilterProperties *prop, void *private_data,
+    GstTensorFilterFrameworkInfo *fw_info)
+{
+  test_custom_v1_getFWInfo (self, prop, private_data, fw_info);
+  fw_info->allow_in_place = 1;
+  return 0;
+}
+
 /**
  * @brief Invalid callback for GstTensorFilterFramework (v1).
  */
@@ -4157,6 +4221,61 @@ test_custom_v1_eventHandler (const GstTensorFilterFramework *self,
   return -ENOENT;
 }
 
+/**
+ * @brief Data of the asynchronous invoke for the custom filter (v1).
+ */
+typedef struct {
+  const GstTensorMemory *input; /**< input tensor */
+  GstTensorMemory *output; /**< output tensor */
+  GstTensorFilterInvokeDoneCallback done_cb; /**< callback to notify the invoke is done */
+  void *user_data; /**< user data of the callback */
+  guint delay; /**< delay (usec) to complete the invoke */
+} test_custom_async_data;
+
+static guint test_custom_async_count = 0;
+
+/**
+ * @brief Thread to complete the asynchronous invoke of the custom filter (v1).
+ */
+static gpointer
+test_custom_v1_async_thread (gpointer data)
+{
+  test_custom_async_data *async_data = (test_custom_async_data *) data;
+
+  g_usleep (async_data->delay);
+  memcpy (async_data->output[0].data, async_data->input[0].data,
+      async_data->input[0].size);
+
+  async_data->done_cb (0, async_data->user_data);
+  g_free (async_data);
+  return NULL;
+}
+
+/**
+ * @brief The optional callback for GstTensorFilterFramework (v1), asynchronous invoke.
+ */
+static int
+test_custom_v1_invoke_async (const GstTensorFilterFramework *self,
+    const GstTensorFilterProperties *prop, void *private_data,
+    const GstTensorMemory *input, GstTensorMemory *output,
+    GstTensorFilterInvokeDoneCallback done_cb, void *user_data)
+{
+  test_custom_async_data *async_data = g_new0 (test_custom_async_data, 1);
+  GThread *thread;
+
+  async_data->input = input;
+  async_data->output = output;
+  async_data->done_cb = done_cb;
+  async_data->user_data = user_data;
+  /* later inputs may be done first */
+  async_data->delay = (3 - (test_custom_async_count % 4)) * 5000;
+  test_custom_async_count++;
+
+  thread = g_thread_new ("test_custom_async", test_custom_v1_async_thread, async_data);
+  g_thread_unref (thread);
+  return 0;
+}
+
 /**
  * @brief Test for passthrough custom filter without model.
  */
@@ -4399,6 +4518,79 @@ TEST (tensorStreamTest, subpluginV1Run)
   g_free (fw);
 }
 
+/**
+ * @brief Test for in-place invoke of custom filter without model (v1).
+ */
+TEST (tensorStreamTest, subpluginV1RunInPlace)
+{
+  GstTensorFilterFramework *fw = g_new0 (GstTensorFilterFramework, 1);
+
+  ASSERT_TRUE (fw != NULL);
+  fw->version = GST_TENSOR_FILTER_FRAMEWORK_V1;
+  fw->invoke = test_custom_v1_invoke_in_place;
+  fw->getFrameworkInfo = test_custom_v1_getFWInfo_in_place;
+  fw->getModelInfo = test_custom_v1_getModelInfo;
+  fw->eventHandler = test_custom_v1_eventHandler;
+
+  /* register custom filter */
+  EXPECT_TRUE (nnstreamer_filter_probe (fw));
+
+  test_custom_in_place_count = 0;
+  test_custom_run_pipeline ();
+
+  /* input and output have the same info, all buffers are invoked in-place. */
+  EXPECT_EQ (test_custom_in_place_count, 10U);
+
+  /* unregister custom filter */
+  nnstreamer_filter_exit (test_fw_custom_name);
+  g_free (fw);
+}
+
+/**
+ * @brief Test for asynchronous invoke of custom filter without model (v1).
+ */
+TEST (tensorStreamTest, subpluginV1RunAsync)
+{
+  const guint num_buffers = 10;
+  TestOption option = { num_buffers, TEST_TYPE_CUSTOM_PASSTHROUGH_ASYNC };
+  GstTensorFilterFramework *fw = g_new0 (GstTensorFilterFramework, 1);
+
+  ASSERT_TRUE (fw != NULL);
+  fw->version = GST_TENSOR_FILTER_FRAMEWORK_V1;
+  fw->invoke = test_custom_v1_invoke;
+  fw->invoke_async = test_custom_v1_invoke_async;
+  fw->getFrameworkInfo = test_custom_v1_getFWInfo;
+  fw->getModelInfo = test_custom_v1_getModelInfo;
+  fw->eventHandler = test_custom_v1_eventHandler;
+
+  /* register custom filter */
+  EXPECT_TRUE (nnstreamer_filter_probe (fw));
+
+  test_custom_async_count = 0;
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+
+  EXPECT_TRUE (_wait_pipeline_process_buffers (num_buffers));
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  /* all buffers are invoked asynchronously, and pushed in order before eos */
+  EXPECT_EQ (test_custom_async_count, num_buffers);
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+  EXPECT_EQ (g_test_data.received, num_buffers);
+  EXPECT_EQ (g_test_data.received_size, 3U * 160 * 120);
+  EXPECT_FALSE (g_test_data.invalid_timestamp);
+  EXPECT_FALSE (g_test_data.unordered_timestamp);
+
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+
+  /* unregister custom filter */
+  nnstreamer_filter_exit (test_fw_custom_name);
+  g_free (fw);
+}
+
 /**
  * @brief Test for plugin registration with invalid param (v1).
  */
@@ -0,0 +1,54 @@
+##
+# SPDX-License-Identifier: LGPL-2.1-only
+#
+# Copyright (C) 2026 agent <agent@local>
+#
+# @file    passthrough_into.py
+# @brief   Python custom filter example: passthrough, writes the output into preallocated memory
+# @author  agent <agent@local>
+
+import numpy as np
+import nnstreamer_python as nns
+
+D1 = 3
+D2 = 280
+D3 = 40
+D4 = 1
+
+
+##
+# @brief  User-defined custom filter; DO NOT CHANGE CLASS NAME
+class CustomFilter(object):
+    ##
+    # @brief  Receive the tensors as read-only numpy arrays with the tensor shape
+    shaped_tensors = True
+
+    ##
+    # @brief  The constructor for custom filter: passthrough
+    def __init__(self, *args):
+        self.input_dims = [nns.TensorShape([D1, D2, D3, D4], np.uint8)]
+        self.output_dims = [nns.TensorShape([D1, D2, D3, D4], np.uint8)]
+
+    ##
+    # @brief  python callback: getInputDim
+    # @param  None
+    # @return user-assigned input dimensions
+    def getInputDim(self):
+        return self.input_dims
+
+    ##
+    # @brief  Python callback: getOutputDim
+    # @param  None
+    # @return user-assigned output dimensions
+    def getOutputDim(self):
+        return self.output_dims
+
+    ##
+    # @brief  Python callback: invoke_into
+    # @param  Input tensors: list of input numpy array (read-only, shape is the reverse of tensor dimension)
+    # @param  Output tensors: list of numpy array of the output memory
+    # @return None
+    def invoke_into(self, input_array, output_array):
+        assert input_array[0].shape == (D3, D2, D1)
+        assert not input_array[0].flags.writeable
+        np.copyto(output_array[0], input_array[0])
@@ -0,0 +1,55 @@
+#!/usr/bin/env python3
+
+##
+# SPDX-License-Identifier: LGPL-2.1-only
+#
+# Copyright (C) 2026 agent <agent@local>
+#
+# @file generateTest.py
+# @brief Generate golden test results for quantize and dequantize test cases
+# @author agent <agent@local>
+
+import numpy as np
+
+
+def quantize(data, dtype, scale, zero_point):
+    info = np.iinfo(dtype)
+    scale = np.asarray(scale, dtype=np.float32)
+    zero_point = np.asarray(zero_point, dtype=np.int64)
+    # round half to even, then saturate
+    q = np.rint(data / scale).astype(np.int64) + zero_point
+    return np.clip(q, info.min, info.max).astype(dtype)
+
+
+def dequantize(data, dtype, scale, zero_point):
+    diff = data.astype(np.int64) - np.asarray(zero_point, dtype=np.int64)
+    return diff.astype(dtype) * np.asarray(scale, dtype=dtype)
+
+
+def save(filename, data):
+    with open(filename, 'wb') as file:
+        file.write(data.tobytes())
+
+
+np.random.seed(0)
+
+# float32 to uint8, the values out of the range are saturated
+data = np.random.uniform(-10.0, 10.0, size=[100, 50]).astype(np.float32)
+save('test_00.dat', data)
+save('test_00.dat.golden', quantize(data, np.uint8, 0.05, 128))
+
+# float32 to int8, per-channel (0th dim)
+data = np.random.uniform(-30.0, 30.0, size=[100, 3]).astype(np.float32)
+save('test_01.dat', data)
+save('test_01.dat.golden',
+     quantize(data, np.int8, [0.1, 0.2, 0.3], [-1, 0, 1]))
+
+# uint8 to float32
+data = np.random.randint(0, 256, size=[100, 50]).astype(np.uint8)
+save('test_02.dat', data)
+save('test_02.dat.golden', dequantize(data, np.float32, 0.05, 128))
+
+# float32 to uint8 to float32
+data = np.fromfile('test_00.dat', dtype=np.float32)
+save('test_03.dat.golden',
+     dequantize(quantize(data, np.uint8, 0.05, 128), np.float32, 0.05, 128))
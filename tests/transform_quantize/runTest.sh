@@ -0,0 +1,47 @@
+#!/usr/bin/env bash
+##
+## SPDX-License-Identifier: LGPL-2.1-only
+##
+## @file runTest.sh
+## @author agent <agent@local>
+## @date Oct 19 2026
+## @brief SSAT Test Cases for transform quantize and dequantize
+##
+
+if [[ "$SSATAPILOADED" != "1" ]]; then
+    SILENT=0
+    INDEPENDENT=1
+    search="ssat-api.sh"
+    source $search
+    printf "${Blue}Independent Mode${NC}"
+fi
+
+# This is compatible with SSAT (https://github.com/myungjoo/SSAT)
+testInit $1
+
+PATH_TO_PLUGIN="../../build"
+
+if [ "$SKIPGEN" == "YES" ]; then
+    echo "Test Case Generation Skipped"
+    sopath=$2
+else
+    echo "Test Case Generation Started"
+    python3 generateTest.py
+    sopath=$1
+fi
+
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=\"test_00.dat\" blocksize=-1 ! application/octet-stream ! tensor_converter input-dim=50:100:1:1 input-type=float32 ! tensor_transform mode=quantize option=uint8,scale:0.05,zero-point:128 ! filesink location=\"./result_00.dat\" sync=true" 1 0 0 $PERFORMANCE
+callCompareTest result_00.dat test_00.dat.golden 1 "Golden test comparison 1" 1 0
+
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=\"test_01.dat\" blocksize=-1 ! application/octet-stream ! tensor_converter input-dim=3:100:1:1 input-type=float32 ! tensor_transform mode=quantize option=int8,per-channel:true@0,scale:0.1:0.2:0.3,zero-point:-1:0:1 ! filesink location=\"./result_01.dat\" sync=true" 2 0 0 $PERFORMANCE
+callCompareTest result_01.dat test_01.dat.golden 2 "Golden test comparison 2" 1 0
+
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=\"test_02.dat\" blocksize=-1 ! application/octet-stream ! tensor_converter input-dim=50:100:1:1 input-type=uint8 ! tensor_transform mode=dequantize option=float32,scale:0.05,zero-point:128 ! filesink location=\"./result_02.dat\" sync=true" 3 0 0 $PERFORMANCE
+callCompareTest result_02.dat test_02.dat.golden 3 "Golden test comparison 3" 1 0
+
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=\"test_00.dat\" blocksize=-1 ! application/octet-stream ! tensor_converter input-dim=50:100:1:1 input-type=float32 ! tensor_transform mode=quantize option=uint8,scale:0.05,zero-point:128 ! tensor_transform mode=dequantize option=float32,scale:0.05,zero-point:128 ! filesink location=\"./result_03.dat\" sync=true" 4 0 0 $PERFORMANCE
+callCompareTest result_03.dat test_03.dat.golden 4 "Golden test comparison 4" 1 0
+
+rm *.log *.golden *.dat
+
+report